@@ -4,6 +4,7 @@
 #error "Linux platform file is part of non-Linux build."
 #endif
 
+#include <fcntl.h>
 #include <sched.h>
 
 #include "envoy/api/os_sys_calls_common.h"
@@ -25,6 +26,24 @@ public:
    * @see sched_getaffinity (man 2 sched_getaffinity)
    */
   virtual SysCallIntResult sched_getaffinity(pid_t pid, size_t cpusetsize, cpu_set_t* mask) PURE;
+
+  /**
+   * @see man 2 pipe2
+   */
+  virtual SysCallIntResult pipe2(int pipefd[2], int flags) PURE;
+
+  /**
+   * @see man 2 splice
+   */
+  virtual SysCallSizeResult splice(int fd_in, off64_t* off_in, int fd_out, off64_t* off_out,
+                                   size_t len, unsigned int flags) PURE;
+
+  /**
+   * Sets the capacity of a pipe with fcntl(F_SETPIPE_SZ).
+   * @see man 2 fcntl
+   * @return the capacity of the pipe on success, which may be larger than requested.
+   */
+  virtual SysCallIntResult setPipeSize(int fd, int size) PURE;
 };
 
 using LinuxOsSysCallsPtr = std::unique_ptr<LinuxOsSysCalls>;
@@ -13,6 +13,7 @@
 #include "absl/status/statusor.h"
 #include "absl/strings/string_view.h"
 #include "absl/types/optional.h"
+#include "absl/types/span.h"
 
 namespace Envoy {
 namespace Filesystem {
@@ -77,6 +78,14 @@ public:
    */
   virtual Api::IoCallSizeResult write(absl::string_view buffer) PURE;
 
+  /**
+   * Write several buffers to the file, in order, with as few system calls as possible. The file
+   * must be explicitly opened before writing.
+   *
+   * @return ssize_t number of bytes written, or -1 for failure
+   */
+  virtual Api::IoCallSizeResult writev(absl::Span<const absl::string_view> buffers) PURE;
+
   /**
    * Get additional details about the file. May or may not require a file system operation.
    *
@@ -29,11 +29,52 @@ public:
    */
   virtual std::string format(const Context& context,
                              const StreamInfo::StreamInfo& stream_info) const PURE;
+
+  /**
+   * Append a formatted substitution line to the output. Unlike format(), this lets the caller
+   * reuse the output buffer across lines.
+   * @param context supplies the formatter context.
+   * @param stream_info supplies the stream info.
+   * @param output supplies the string to which the formatted line is appended.
+   */
+  virtual void formatTo(const Context& context, const StreamInfo::StreamInfo& stream_info,
+                        std::string& output) const {
+    output.append(format(context, stream_info));
+  }
 };
 
 using FormatterPtr = std::unique_ptr<Formatter>;
 using FormatterConstSharedPtr = std::shared_ptr<const Formatter>;
 
+/**
+ * Receives a single typed value from a FormatterProvider, so that the value can be written to the
+ * output of a formatter without building a Protobuf::Value first.
+ */
+class FormatterValueSink {
+public:
+  virtual ~FormatterValueSink() = default;
+
+  /**
+   * Add a string value.
+   */
+  virtual void addString(absl::string_view value) PURE;
+
+  /**
+   * Add a number value.
+   */
+  virtual void addNumber(double value) PURE;
+
+  /**
+   * Add a null value, which is used if there is no value.
+   */
+  virtual void addNull() PURE;
+
+  /**
+   * Add any other value.
+   */
+  virtual void addValue(const Protobuf::Value& value) PURE;
+};
+
 /**
  * Interface for multiple protocols/modules formatter providers.
  */
@@ -60,6 +101,36 @@ public:
    */
   virtual Protobuf::Value formatValue(const Context& context,
                                       const StreamInfo::StreamInfo& stream_info) const PURE;
+
+  /**
+   * Append the value to the output. This is equivalent to format(), and providers can override it
+   * to avoid the temporary string.
+   * @param context supplies the formatter context.
+   * @param stream_info supplies the stream info.
+   * @param output supplies the string to which the value is appended.
+   * @return bool whether there was a value to append.
+   */
+  virtual bool formatTo(const Context& context, const StreamInfo::StreamInfo& stream_info,
+                        std::string& output) const {
+    const absl::optional<std::string> value = format(context, stream_info);
+    if (!value.has_value()) {
+      return false;
+    }
+    output.append(value.value());
+    return true;
+  }
+
+  /**
+   * Pass the value to the sink. This is equivalent to formatValue(), and providers can override
+   * it to avoid the temporary Protobuf::Value.
+   * @param context supplies the formatter context.
+   * @param stream_info supplies the stream info.
+   * @param sink supplies the sink that receives the value.
+   */
+  virtual void formatValueTo(const Context& context, const StreamInfo::StreamInfo& stream_info,
+                             FormatterValueSink& sink) const {
+    sink.addValue(formatValue(context, stream_info));
+  }
 };
 
 using FormatterProviderPtr = std::unique_ptr<FormatterProvider>;
@@ -564,6 +564,10 @@ struct Http1Settings {
   // If false, only methods from a hard-coded list of known methods are accepted.
   // Only implemented in BalsaParser. http-parser only accepts known methods.
   bool allow_custom_methods_{false};
+
+  // The maximum number of pipelined requests of a downstream connection that are processed
+  // concurrently. Values of 0 and 1 process pipelined requests one at a time.
+  uint32_t max_pipelined_requests_{0};
 };
 
 /**
@@ -662,7 +666,15 @@ public:
 /**
  * A server side HTTP connection.
  */
-class ServerConnection : public virtual Connection {};
+class ServerConnection : public virtual Connection {
+public:
+  /**
+   * Indicate that the connection will be closed once the active streams are complete. No new
+   * streams are created for requests that the remote has already sent beyond this point, e.g.
+   * pipelined HTTP/1 requests.
+   */
+  virtual void closeAfterActiveStreams() PURE;
+};
 using ServerConnectionPtr = std::unique_ptr<ServerConnection>;
 
 /**
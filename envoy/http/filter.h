@@ -13,6 +13,7 @@
 #include "envoy/http/codec.h"
 #include "envoy/http/filter_factory.h"
 #include "envoy/http/header_map.h"
+#include "envoy/http/stream_arena.h"
 #include "envoy/matcher/matcher.h"
 #include "envoy/router/router.h"
 #include "envoy/router/scopes.h"
@@ -513,6 +514,12 @@ public:
    */
   virtual absl::string_view filterConfigName() const PURE;
 
+  /**
+   * @return StreamArena& memory owned by the stream, which filters can use for per-stream state
+   *         that does not need to outlive the stream.
+   */
+  virtual StreamArena& streamArena() PURE;
+
   /**
    * The downstream request headers if present.
    */
@@ -1210,6 +1217,80 @@ class StreamFilter : public virtual StreamDecoderFilter, public virtual StreamEn
 
 using StreamFilterSharedPtr = std::shared_ptr<StreamFilter>;
 
+/**
+ * Stream decoder filter that keeps no per-stream state. A single instance is created with the
+ * filter config and shared by all streams on all workers, so no filter object has to be created for
+ * every stream. The callbacks of the stream are passed to every call instead of being stored by the
+ * filter. All methods are const and must be thread safe. Filters that need per-stream state must
+ * keep it in the filter state of the stream or in its StreamArena.
+ */
+class StatelessStreamDecoderFilter {
+public:
+  virtual ~StatelessStreamDecoderFilter() = default;
+
+  /**
+   * Called with decoded headers, see StreamDecoderFilter::decodeHeaders().
+   * @param callbacks supplies the decoder filter callbacks of the stream.
+   */
+  virtual FilterHeadersStatus decodeHeaders(StreamDecoderFilterCallbacks& callbacks,
+                                            RequestHeaderMap& headers, bool end_stream) const PURE;
+
+  /**
+   * Called with a decoded data frame, see StreamDecoderFilter::decodeData().
+   * @param callbacks supplies the decoder filter callbacks of the stream.
+   */
+  virtual FilterDataStatus decodeData(StreamDecoderFilterCallbacks&, Buffer::Instance&,
+                                      bool) const {
+    return FilterDataStatus::Continue;
+  }
+
+  /**
+   * Called with decoded trailers, see StreamDecoderFilter::decodeTrailers().
+   * @param callbacks supplies the decoder filter callbacks of the stream.
+   */
+  virtual FilterTrailersStatus decodeTrailers(StreamDecoderFilterCallbacks&,
+                                              RequestTrailerMap&) const {
+    return FilterTrailersStatus::Continue;
+  }
+};
+
+using StatelessStreamDecoderFilterSharedPtr = std::shared_ptr<const StatelessStreamDecoderFilter>;
+
+/**
+ * Stream encoder filter that keeps no per-stream state, see StatelessStreamDecoderFilter.
+ */
+class StatelessStreamEncoderFilter {
+public:
+  virtual ~StatelessStreamEncoderFilter() = default;
+
+  /**
+   * Called with headers to be encoded, see StreamEncoderFilter::encodeHeaders().
+   * @param callbacks supplies the encoder filter callbacks of the stream.
+   */
+  virtual FilterHeadersStatus encodeHeaders(StreamEncoderFilterCallbacks& callbacks,
+                                            ResponseHeaderMap& headers, bool end_stream) const PURE;
+
+  /**
+   * Called with data to be encoded, see StreamEncoderFilter::encodeData().
+   * @param callbacks supplies the encoder filter callbacks of the stream.
+   */
+  virtual FilterDataStatus encodeData(StreamEncoderFilterCallbacks&, Buffer::Instance&,
+                                      bool) const {
+    return FilterDataStatus::Continue;
+  }
+
+  /**
+   * Called with trailers to be encoded, see StreamEncoderFilter::encodeTrailers().
+   * @param callbacks supplies the encoder filter callbacks of the stream.
+   */
+  virtual FilterTrailersStatus encodeTrailers(StreamEncoderFilterCallbacks&,
+                                              ResponseTrailerMap&) const {
+    return FilterTrailersStatus::Continue;
+  }
+};
+
+using StatelessStreamEncoderFilterSharedPtr = std::shared_ptr<const StatelessStreamEncoderFilter>;
+
 class HttpMatchingData {
 public:
   static absl::string_view name() { return "http"; }
@@ -1265,6 +1346,19 @@ public:
    */
   virtual void addStreamFilter(Http::StreamFilterSharedPtr filter) PURE;
 
+  /**
+   * Add a decoder filter without per-stream state. The filter is shared by all streams and is not
+   * copied, so adding it is cheaper than creating a StreamDecoderFilter for every stream.
+   * @param filter supplies the filter to add.
+   */
+  virtual void addStatelessStreamDecoderFilter(StatelessStreamDecoderFilterSharedPtr filter) PURE;
+
+  /**
+   * Add an encoder filter without per-stream state, see addStatelessStreamDecoderFilter().
+   * @param filter supplies the filter to add.
+   */
+  virtual void addStatelessStreamEncoderFilter(StatelessStreamEncoderFilterSharedPtr filter) PURE;
+
   /**
    * Add an access log handler that is called when the stream is destroyed.
    * @param handler supplies the handler to add.
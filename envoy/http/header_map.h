@@ -127,6 +127,12 @@ public:
    * @param move_value moveable UnionString. The string value MUST be valid header string.
    */
   explicit HeaderString(UnionString&& move_value) noexcept;
+
+  /**
+   * Converts the upper case ASCII characters of the InlinedString to lower case. Only supported by
+   * the "Inline" InlinedString representation.
+   */
+  void inlineToLower();
 };
 
 /**
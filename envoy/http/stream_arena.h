@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "envoy/common/pure.h"
+
+namespace Envoy {
+namespace Http {
+
+/**
+ * Memory that is owned by an HTTP stream. Objects allocated from the arena are released all at
+ * once when the stream is destroyed, which is cheaper than freeing them one by one and keeps the
+ * per-stream state of all filters close together. Objects must not be accessed after the filters
+ * of the stream have been destroyed.
+ */
+class StreamArena {
+public:
+  virtual ~StreamArena() = default;
+
+  /**
+   * Allocates uninitialized memory that lives as long as the stream.
+   * @param size supplies the number of bytes to allocate.
+   * @param alignment supplies the alignment of the memory, which must be a power of two that is
+   *        not larger than alignof(std::max_align_t).
+   * @return void* the allocated memory.
+   */
+  virtual void* allocate(size_t size, size_t alignment) PURE;
+
+  /**
+   * Registers a function that is called with the supplied object when the arena is released.
+   * Functions are called in the reverse order of registration.
+   * @param object supplies the object to pass to the function.
+   * @param destroy supplies the function to call.
+   */
+  virtual void addDestructor(void* object, void (*destroy)(void*)) PURE;
+
+  /**
+   * Constructs an object in the arena. The destructor of the object runs when the arena is
+   * released, unless it is trivial.
+   * @return T& the constructed object.
+   */
+  template <class T, class... Args> T& create(Args&&... args) {
+    T* object = new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+    if constexpr (!std::is_trivially_destructible_v<T>) {
+      addDestructor(object, [](void* object) { static_cast<T*>(object)->~T(); });
+    }
+    return *object;
+  }
+};
+
+} // namespace Http
+} // namespace Envoy
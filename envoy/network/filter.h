@@ -207,6 +207,13 @@ public:
    */
   virtual bool startUpstreamSecureTransport() PURE;
 
+  /**
+   * @return true if this filter is the only read filter of the connection and the connection has
+   *         no write filters, so that no other filter sees the data read from or written to the
+   *         connection.
+   */
+  virtual bool soleFilter() PURE;
+
   /**
    * Control the filter close status for read filters.
    *
@@ -188,6 +188,13 @@ public:
    */
   virtual Ssl::ConnectionInfoConstSharedPtr ssl() const PURE;
 
+  /**
+   * @return bool whether this is a raw buffer transport socket, which reads and writes the bytes of
+   *         the connection unchanged and keeps no state about them. Only then may the bytes of the
+   *         connection bypass the transport socket, e.g. when they are moved with splice(2).
+   */
+  virtual bool isRawBuffer() const { return false; }
+
   /**
    * Instructs a transport socket to start using secure transport.
    * It is up to the caller of this method to manage the coordination between the client
@@ -64,6 +64,25 @@ public:
   virtual ConfigConstSharedPtr createConfig(const Protobuf::Message& rc,
                                             Server::Configuration::ServerFactoryContext& context,
                                             bool validate_clusters_default) const PURE;
+
+  /**
+   * Create a config object based on a route configuration which replaces a previously created
+   * config object. Implementations may reuse the parts of the previous config object that are
+   * unchanged by the new route configuration instead of rebuilding them. The default
+   * implementation ignores the previous config object.
+   * @param rc supplies the RouteConfiguration.
+   * @param context supplies the context of the server factory.
+   * @param validate_clusters_default see createConfig().
+   * @param previous_config supplies the config object being replaced.
+   * @throw EnvoyException if the new config can't be applied.
+   */
+  virtual ConfigConstSharedPtr
+  createConfigFromPrevious(const Protobuf::Message& rc,
+                           Server::Configuration::ServerFactoryContext& context,
+                           bool validate_clusters_default,
+                           const ConfigConstSharedPtr& /*previous_config*/) const {
+    return createConfig(rc, context, validate_clusters_default);
+  }
 };
 
 } // namespace Rds
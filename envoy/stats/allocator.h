@@ -99,6 +99,22 @@ public:
    */
   virtual void setSinkPredicates(std::unique_ptr<SinkPredicates>&& sink_predicates) PURE;
 
+  /**
+   * Sets up per-thread storage for counter increments made on the calling thread. Once any thread
+   * registered, new counters are incremented without atomic read-modify-write operations on
+   * registered threads, at the cost of memory per counter and per registered thread. Increments
+   * made on registered threads are only reflected in the counter values after the next call to
+   * foldCounterSlabs(). Calling this more than once on the same thread has no effect.
+   */
+  virtual void registerCounterSlab() PURE;
+
+  /**
+   * Sums the per-thread storage of all counters created with registered threads into their
+   * values. This is O(counters * registered threads), and is intended to be called once per
+   * stats flush.
+   */
+  virtual void foldCounterSlabs() PURE;
+
   // TODO(jmarantz): create a parallel mechanism to instantiate histograms. At
   // the moment, histograms don't fit the same pattern of counters and gauges
   // as they are not actually created in the context of a stats allocator.
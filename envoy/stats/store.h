@@ -242,6 +242,13 @@ public:
    */
   virtual void setHistogramSettings(HistogramSettingsConstPtr&& histogram_settings) PURE;
 
+  /**
+   * Enables per-worker counter slabs, so that counters are incremented on worker threads without
+   * contending on shared cache lines. Must be called before initializeThreading().
+   * @param enabled supplies whether per-worker counter slabs are used.
+   */
+  virtual void setPerWorkerCounters(bool enabled) PURE;
+
   /**
    * Initialize the store for threading. This will be called once after all worker threads have
    * been initialized. At this point the store can initialize itself for multi-threaded operation.
@@ -130,6 +130,13 @@ public:
    */
   virtual bool useLocalDecision() const PURE;
 
+  /**
+   * @return whether the span is going to be reported to the tracing system. When false, callers
+   * may skip computing tags, logs and other attributes that would only be discarded. Note that
+   * setSampled() may change the returned value.
+   */
+  virtual bool isRecording() const { return true; }
+
   /**
    * Retrieve a key's value from the span's baggage.
    * This baggage data could've been set by this span or any parent spans.
@@ -1246,6 +1246,11 @@ public:
    */
   virtual void createNetworkFilterChain(Network::Connection& connection) const PURE;
 
+  /**
+   * @return true if network filters are configured for upstream connections of the cluster.
+   */
+  virtual bool hasNetworkFilters() const PURE;
+
   /**
    * Calculate upstream protocol(s) based on features.
    */
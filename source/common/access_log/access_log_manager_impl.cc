@@ -1,5 +1,7 @@
 #include "source/common/access_log/access_log_manager_impl.h"
 
+#include <limits>
+#include <set>
 #include <string>
 
 #include "envoy/common/exception.h"
@@ -7,6 +9,8 @@
 #include "source/common/common/assert.h"
 #include "source/common/common/fmt.h"
 #include "source/common/common/lock_guard.h"
+#include "source/common/common/macros.h"
+#include "source/common/runtime/runtime_features.h"
 
 #include "absl/container/fixed_array.h"
 
@@ -16,6 +20,77 @@ namespace {
 static constexpr Filesystem::FlagSet default_flags{1 << Filesystem::File::Operation::Write |
                                                    1 << Filesystem::File::Operation::Create |
                                                    1 << Filesystem::File::Operation::Append};
+
+// Both are at least SharedAccessLogFileImpl::MAX_RINGS, so such threads write to the overflow
+// buffer.
+constexpr uint32_t UnassignedWriterIndex = std::numeric_limits<uint32_t>::max() - 1;
+constexpr uint32_t ReleasedWriterIndex = std::numeric_limits<uint32_t>::max();
+
+// Indices of the threads that write to shared access log files. The index of a thread is reused
+// once the thread exits, lowest first, so that threads get a ring as long as there are no more
+// than MAX_RINGS writing threads at a time.
+class WriterIndices {
+public:
+  uint32_t acquire() {
+    Thread::LockGuard lock(lock_);
+    if (free_.empty()) {
+      return next_++;
+    }
+    const uint32_t index = *free_.begin();
+    free_.erase(free_.begin());
+    return index;
+  }
+
+  void release(uint32_t index) {
+    Thread::LockGuard lock(lock_);
+    free_.insert(index);
+  }
+
+private:
+  Thread::MutexBasicLockable lock_;
+  std::set<uint32_t> free_ ABSL_GUARDED_BY(lock_);
+  uint32_t next_ ABSL_GUARDED_BY(lock_){0};
+};
+
+// Never destroyed, as threads may exit during static destruction.
+WriterIndices& writerIndices() { MUTABLE_CONSTRUCT_ON_FIRST_USE(WriterIndices); }
+
+// Releases the index of a thread when the thread exits.
+class WriterIndexReleaser {
+public:
+  explicit WriterIndexReleaser(uint32_t& index) : index_(index) {}
+  ~WriterIndexReleaser() {
+    writerIndices().release(index_);
+    index_ = ReleasedWriterIndex;
+  }
+
+private:
+  uint32_t& index_;
+};
+
+// Index of the calling thread among the threads that currently write to shared access log files.
+uint32_t writerIndex() {
+  // Trivially destructible, so that it is still valid in destructors of thread locals that run
+  // after the index has been released.
+  static thread_local uint32_t index = UnassignedWriterIndex;
+  if (index == UnassignedWriterIndex) {
+    index = writerIndices().acquire();
+    static thread_local WriterIndexReleaser releaser(index);
+  }
+  return index;
+}
+
+void reopenFile(Filesystem::File& file, AccessLogFileStats& stats) {
+  if (file.isOpen()) {
+    const Api::IoCallBoolResult result = file.close();
+    ASSERT(result.return_value_, fmt::format("unable to close file '{}': {}", file.path(),
+                                             result.err_->getErrorDetails()));
+  }
+  const Api::IoCallBoolResult open_result = file.open(default_flags);
+  if (!open_result.return_value_) {
+    stats.reopen_failed_.inc();
+  }
+}
 } // namespace
 
 AccessLogManagerImpl::~AccessLogManagerImpl() {
@@ -46,6 +121,19 @@ AccessLogManagerImpl::createAccessLog(const Filesystem::FilePathAndType& file_in
                                                   open_result.err_->getErrorDetails()));
   }
 
+  if (Runtime::runtimeFeatureEnabled(
+          "envoy.reloadable_features.shared_access_log_flush_thread")) {
+    AccessLogFlushThreadSharedPtr flush_thread = flush_thread_.lock();
+    if (flush_thread == nullptr) {
+      flush_thread = std::make_shared<AccessLogFlushThread>(
+          api_.threadFactory(), file_flush_interval_msec_, file_stats_);
+      flush_thread_ = flush_thread;
+    }
+    access_logs_[file_name] = std::make_shared<SharedAccessLogFileImpl>(
+        std::move(file), lock_, file_stats_, std::move(flush_thread));
+    return access_logs_[file_name];
+  }
+
   access_logs_[file_name] =
       std::make_shared<AccessLogFileImpl>(std::move(file), dispatcher_, lock_, file_stats_,
                                           file_flush_interval_msec_, api_.threadFactory());
@@ -223,5 +311,243 @@ void AccessLogFileImpl::createFlushStructures() {
                                                Thread::Options{"AccessLogFlush"});
 }
 
+AccessLogRing::AccessLogRing(uint32_t capacity)
+    : buffer_(new char[capacity]), capacity_(capacity) {}
+
+bool AccessLogRing::push(absl::string_view data) {
+  const uint64_t head = head_.load(std::memory_order_relaxed);
+  const uint64_t tail = tail_.load(std::memory_order_acquire);
+  if (data.size() > capacity_ - (head - tail)) {
+    return false;
+  }
+  const uint64_t offset = head % capacity_;
+  const size_t first = std::min<uint64_t>(data.size(), capacity_ - offset);
+  memcpy(buffer_.get() + offset, data.data(), first);
+  memcpy(buffer_.get(), data.data() + first, data.size() - first);
+  // Publishes the data to the consumer.
+  head_.store(head + data.size(), std::memory_order_release);
+  return true;
+}
+
+uint64_t AccessLogRing::peek(absl::InlinedVector<absl::string_view, 16>& output) const {
+  const uint64_t tail = tail_.load(std::memory_order_relaxed);
+  const uint64_t head = head_.load(std::memory_order_acquire);
+  if (head == tail) {
+    return head;
+  }
+  const uint64_t offset = tail % capacity_;
+  const uint64_t size = head - tail;
+  const uint64_t first = std::min<uint64_t>(size, capacity_ - offset);
+  output.emplace_back(buffer_.get() + offset, first);
+  if (first < size) {
+    output.emplace_back(buffer_.get(), size - first);
+  }
+  return head;
+}
+
+AccessLogFlushThread::AccessLogFlushThread(Thread::ThreadFactory& thread_factory,
+                                           std::chrono::milliseconds flush_interval,
+                                           AccessLogFileStats& stats)
+    : flush_interval_(flush_interval), stats_(stats),
+      thread_(thread_factory.createThread([this]() -> void { threadFunc(); },
+                                          Thread::Options{"AccessLogFlush"})) {}
+
+AccessLogFlushThread::~AccessLogFlushThread() {
+  {
+    Thread::LockGuard lock(wake_lock_);
+    exit_ = true;
+    wake_event_.notifyOne();
+  }
+  thread_->join();
+}
+
+void AccessLogFlushThread::addFile(SharedAccessLogFileImpl& file) {
+  Thread::LockGuard lock(files_lock_);
+  files_.insert(&file);
+}
+
+void AccessLogFlushThread::removeFile(SharedAccessLogFileImpl& file) {
+  Thread::LockGuard lock(files_lock_);
+  files_.erase(&file);
+}
+
+void AccessLogFlushThread::requestFlush() {
+  if (flush_pending_.exchange(true, std::memory_order_acq_rel)) {
+    return;
+  }
+  Thread::LockGuard lock(wake_lock_);
+  flush_requested_ = true;
+  wake_event_.notifyOne();
+}
+
+void AccessLogFlushThread::threadFunc() {
+  while (true) {
+    {
+      Thread::LockGuard lock(wake_lock_);
+      if (!flush_requested_ && !exit_ &&
+          wake_event_.waitFor(wake_lock_, flush_interval_) ==
+              Thread::CondVar::WaitStatus::Timeout) {
+        stats_.flushed_by_timer_.inc();
+      }
+      if (exit_) {
+        return;
+      }
+      flush_requested_ = false;
+    }
+    // Cleared before flushing, so that data written during the flush requests another one.
+    flush_pending_.store(false, std::memory_order_release);
+
+    Thread::LockGuard lock(files_lock_);
+    for (SharedAccessLogFileImpl* file : files_) {
+      file->flush();
+    }
+  }
+}
+
+SharedAccessLogFileImpl::SharedAccessLogFileImpl(Filesystem::FilePtr&& file,
+                                                 Thread::BasicLockable& lock,
+                                                 AccessLogFileStats& stats,
+                                                 AccessLogFlushThreadSharedPtr flush_thread,
+                                                 uint32_t ring_size, uint64_t max_overflow_size)
+    : file_(std::move(file)), file_lock_(lock), stats_(stats),
+      flush_thread_(std::move(flush_thread)), ring_size_(ring_size),
+      max_overflow_size_(max_overflow_size) {
+  flush_thread_->addFile(*this);
+}
+
+SharedAccessLogFileImpl::~SharedAccessLogFileImpl() {
+  flush_thread_->removeFile(*this);
+
+  // Flush any remaining data. If file was not opened for some reason, skip flushing part.
+  if (file_->isOpen()) {
+    {
+      Thread::LockGuard lock(flush_lock_);
+      doFlush();
+    }
+    const Api::IoCallBoolResult result = file_->close();
+    ASSERT(result.return_value_, fmt::format("unable to close file '{}': {}", file_->path(),
+                                             result.err_->getErrorDetails()));
+  }
+  for (std::atomic<Writer*>& writer : writers_) {
+    delete writer.load(std::memory_order_acquire);
+  }
+}
+
+SharedAccessLogFileImpl::Writer* SharedAccessLogFileImpl::writerForThisThread() {
+  const uint32_t index = writerIndex();
+  if (index >= MAX_RINGS) {
+    return nullptr;
+  }
+  Writer* writer = writers_[index].load(std::memory_order_acquire);
+  if (writer == nullptr) {
+    // Only the thread holding this index creates the writer, so there is no race to create it.
+    writer = new Writer(ring_size_);
+    writers_[index].store(writer, std::memory_order_release);
+  }
+  return writer;
+}
+
+void SharedAccessLogFileImpl::write(absl::string_view data) {
+  Writer* writer = writerForThisThread();
+  if (writer != nullptr && writer->overflow_generation_.has_value() &&
+      writer->overflow_generation_.value() !=
+          overflow_generation_.load(std::memory_order_acquire)) {
+    // The data this thread wrote to the overflow buffer has been taken by a flush.
+    writer->overflow_generation_.reset();
+  }
+  // While data of this thread is pending in the overflow buffer, later data goes there as well, so
+  // that the data of a thread is written in order.
+  if (writer != nullptr && !writer->overflow_generation_.has_value() && writer->ring_.push(data)) {
+    stats_.write_buffered_.inc();
+    stats_.write_total_buffered_.add(data.length());
+    // Flushes before the ring is full, so the writer does not have to overflow.
+    if (writer->ring_.size() > writer->ring_.capacity() / 2) {
+      flush_thread_->requestFlush();
+    }
+    return;
+  }
+
+  {
+    Thread::LockGuard lock(overflow_lock_);
+    if (overflow_buffer_.length() + data.length() > max_overflow_size_) {
+      stats_.write_dropped_.inc();
+    } else {
+      stats_.write_buffered_.inc();
+      stats_.write_overflowed_.inc();
+      stats_.write_total_buffered_.add(data.length());
+      overflow_buffer_.add(data.data(), data.size());
+      if (writer != nullptr) {
+        writer->overflow_generation_ = overflow_generation_.load(std::memory_order_relaxed);
+      }
+    }
+  }
+  flush_thread_->requestFlush();
+}
+
+void SharedAccessLogFileImpl::reopen() {
+  reopen_file_ = true;
+  flush_thread_->requestFlush();
+}
+
+void SharedAccessLogFileImpl::flush() {
+  Thread::LockGuard lock(flush_lock_);
+  doFlush();
+}
+
+void SharedAccessLogFileImpl::doFlush() {
+  // Collects the data of all rings and the overflow buffer, so it is written with a single
+  // system call in most cases.
+  absl::InlinedVector<absl::string_view, 16> slices;
+  absl::InlinedVector<std::pair<AccessLogRing*, uint64_t>, 16> consumed;
+  {
+    // The rings are read under the overflow lock, so that a thread cannot add data to its ring
+    // between the two reads after writing to the overflow buffer. The ring data of a thread is then
+    // always older than its data in the overflow buffer, which is written after it.
+    Thread::LockGuard lock(overflow_lock_);
+    for (std::atomic<Writer*>& writer_slot : writers_) {
+      Writer* writer = writer_slot.load(std::memory_order_acquire);
+      if (writer != nullptr) {
+        consumed.emplace_back(&writer->ring_, writer->ring_.peek(slices));
+      }
+    }
+    about_to_write_buffer_.move(overflow_buffer_);
+    overflow_generation_.fetch_add(1, std::memory_order_release);
+  }
+  for (const Buffer::RawSlice& slice : about_to_write_buffer_.getRawSlices()) {
+    slices.emplace_back(static_cast<const char*>(slice.mem_), slice.len_);
+  }
+
+  if (reopen_file_.exchange(false)) {
+    reopenFile(*file_, stats_);
+    if (!file_->isOpen()) {
+      // Retried with the next flush.
+      reopen_file_ = true;
+    }
+  }
+
+  uint64_t length = 0;
+  for (absl::string_view slice : slices) {
+    length += slice.size();
+  }
+  if (length > 0) {
+    // See AccessLogFileImpl::doWrite() for why writes happen under the cross process lock.
+    Thread::LockGuard lock(file_lock_);
+    // Written no matter whether the file is open, so that the buffers are drained.
+    const Api::IoCallSizeResult result = file_->writev(slices);
+    if (result.ok() && result.return_value_ == static_cast<ssize_t>(length)) {
+      stats_.write_completed_.inc();
+    } else {
+      // Probably disk full.
+      stats_.write_failed_.inc();
+    }
+  }
+
+  for (const auto& [ring, position] : consumed) {
+    ring->release(position);
+  }
+  about_to_write_buffer_.drain(about_to_write_buffer_.length());
+  stats_.write_total_buffered_.sub(length);
+}
+
 } // namespace AccessLog
 } // namespace Envoy
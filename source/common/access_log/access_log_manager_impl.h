@@ -1,5 +1,8 @@
 #pragma once
 
+#include <array>
+#include <atomic>
+#include <memory>
 #include <string>
 
 #include "envoy/access_log/access_log.h"
@@ -13,7 +16,10 @@
 #include "source/common/common/logger.h"
 #include "source/common/common/thread.h"
 
+#include "absl/container/flat_hash_set.h"
+#include "absl/container/inlined_vector.h"
 #include "absl/container/node_hash_map.h"
+#include "absl/types/optional.h"
 
 namespace Envoy {
 
@@ -22,7 +28,9 @@ namespace Envoy {
   COUNTER(reopen_failed)                                                                           \
   COUNTER(write_buffered)                                                                          \
   COUNTER(write_completed)                                                                         \
+  COUNTER(write_dropped)                                                                           \
   COUNTER(write_failed)                                                                            \
+  COUNTER(write_overflowed)                                                                        \
   GAUGE(write_total_buffered, Accumulate)
 
 struct AccessLogFileStats {
@@ -31,6 +39,8 @@ struct AccessLogFileStats {
 
 namespace AccessLog {
 
+class AccessLogFlushThread;
+
 class AccessLogManagerImpl : public AccessLogManager, Logger::Loggable<Logger::Id::main> {
 public:
   AccessLogManagerImpl(std::chrono::milliseconds file_flush_interval_msec, Api::Api& api,
@@ -53,6 +63,8 @@ private:
   Event::Dispatcher& dispatcher_;
   Thread::BasicLockable& lock_;
   AccessLogFileStats file_stats_;
+  // Shared by all files that use it, and destroyed with the last of them.
+  std::weak_ptr<AccessLogFlushThread> flush_thread_;
   absl::node_hash_map<std::string, AccessLogFileSharedPtr> access_logs_;
 };
 
@@ -60,8 +72,7 @@ private:
  * This is a file implementation geared for writing out access logs. It turn out that in certain
  * cases even if a standard file is opened with O_NONBLOCK, the kernel can still block when writing.
  * This implementation uses a flush thread per file, with the idea there aren't that many
- * files. If this turns out to be a good implementation we can potentially have a single flush
- * thread that flushes all files, but we will start with this.
+ * files. SharedAccessLogFileImpl uses a single flush thread for all files instead.
  */
 class AccessLogFileImpl : public AccessLogFile {
 public:
@@ -133,5 +144,149 @@ private:
   AccessLogFileStats& stats_;
 };
 
+/**
+ * Byte ring with a single producer and a single consumer, which need no lock. The consumer reads
+ * the data as at most two contiguous regions, so it can be written without copying it first.
+ */
+class AccessLogRing {
+public:
+  explicit AccessLogRing(uint32_t capacity);
+
+  /**
+   * Adds data to the ring. Called by the producer.
+   * @return bool whether there was room for all of the data. Nothing is added otherwise.
+   */
+  bool push(absl::string_view data);
+
+  /**
+   * @return uint64_t the number of bytes in the ring.
+   */
+  uint64_t size() const {
+    return head_.load(std::memory_order_acquire) - tail_.load(std::memory_order_acquire);
+  }
+  uint32_t capacity() const { return capacity_; }
+
+  /**
+   * Appends the regions with the data in the ring to the output. Called by the consumer.
+   * @return uint64_t the position to pass to release() once the data has been consumed.
+   */
+  uint64_t peek(absl::InlinedVector<absl::string_view, 16>& output) const;
+
+  /**
+   * Releases the data up to a position returned by peek(). Called by the consumer.
+   */
+  void release(uint64_t position) { tail_.store(position, std::memory_order_release); }
+
+private:
+  const std::unique_ptr<char[]> buffer_;
+  const uint32_t capacity_;
+  // Written by the producer only. Padded so that the producer and consumer do not share a cache
+  // line.
+  alignas(64) std::atomic<uint64_t> head_{0};
+  // Written by the consumer only.
+  alignas(64) std::atomic<uint64_t> tail_{0};
+};
+
+class SharedAccessLogFileImpl;
+
+/**
+ * Thread that flushes all access log files of the process that use it, instead of a thread per
+ * file. It flushes all files whenever one of them asks for it, and at least once per flush
+ * interval.
+ */
+class AccessLogFlushThread {
+public:
+  AccessLogFlushThread(Thread::ThreadFactory& thread_factory,
+                       std::chrono::milliseconds flush_interval, AccessLogFileStats& stats);
+  ~AccessLogFlushThread();
+
+  void addFile(SharedAccessLogFileImpl& file);
+  void removeFile(SharedAccessLogFileImpl& file);
+
+  /**
+   * Wakes up the thread to flush all files. This is cheap if a flush has already been requested.
+   */
+  void requestFlush();
+
+private:
+  void threadFunc();
+
+  const std::chrono::milliseconds flush_interval_;
+  AccessLogFileStats& stats_;
+  // Held while flushing, so a file is never removed during its flush.
+  Thread::MutexBasicLockable files_lock_;
+  absl::flat_hash_set<SharedAccessLogFileImpl*> files_ ABSL_GUARDED_BY(files_lock_);
+  // Only held to wait for and to signal flush requests, never during a flush, so writers that
+  // request a flush are not blocked by disk writes.
+  Thread::MutexBasicLockable wake_lock_;
+  Thread::CondVar wake_event_;
+  bool exit_ ABSL_GUARDED_BY(wake_lock_){false};
+  bool flush_requested_ ABSL_GUARDED_BY(wake_lock_){false};
+  // Set while a flush request is pending, so writers only take wake_lock_ once per flush.
+  std::atomic<bool> flush_pending_{false};
+  Thread::ThreadPtr thread_;
+};
+
+using AccessLogFlushThreadSharedPtr = std::shared_ptr<AccessLogFlushThread>;
+
+/**
+ * Access log file that is flushed by an AccessLogFlushThread shared with other files. Every
+ * writing thread gets a ring of its own, so writers do not contend on a lock. Rings of exited
+ * threads are reused by new threads. If the ring of a thread is full, or there are more writing
+ * threads than rings, the data goes to an overflow buffer under a lock. The overflow buffer is
+ * limited in size, and data is dropped once it is full, so a stalled disk cannot use up all memory.
+ */
+class SharedAccessLogFileImpl : public AccessLogFile {
+public:
+  SharedAccessLogFileImpl(Filesystem::FilePtr&& file, Thread::BasicLockable& lock,
+                          AccessLogFileStats& stats, AccessLogFlushThreadSharedPtr flush_thread,
+                          uint32_t ring_size = DEFAULT_RING_SIZE,
+                          uint64_t max_overflow_size = DEFAULT_MAX_OVERFLOW_SIZE);
+  ~SharedAccessLogFileImpl() override;
+
+  // AccessLog::AccessLogFile
+  void write(absl::string_view data) override;
+  void reopen() override;
+  void flush() override;
+
+  // Maximum number of threads with a ring at a time. Further threads write to the overflow buffer.
+  static constexpr uint32_t MAX_RINGS = 64;
+  static constexpr uint32_t DEFAULT_RING_SIZE = 16 * 1024;
+  static constexpr uint64_t DEFAULT_MAX_OVERFLOW_SIZE = 16 * 1024 * 1024;
+
+private:
+  // The ring of a writing thread.
+  struct Writer {
+    explicit Writer(uint32_t ring_size) : ring_(ring_size) {}
+
+    AccessLogRing ring_;
+    // Set to the overflow generation while data of the thread is in the overflow buffer. Only
+    // accessed by the writing thread.
+    absl::optional<uint64_t> overflow_generation_;
+  };
+
+  Writer* writerForThisThread();
+  void doFlush() ABSL_EXCLUSIVE_LOCKS_REQUIRED(flush_lock_);
+
+  Filesystem::FilePtr file_;
+  // Serializes writes to the file across processes, see AccessLogFileImpl.
+  Thread::BasicLockable& file_lock_;
+  AccessLogFileStats& stats_;
+  const AccessLogFlushThreadSharedPtr flush_thread_;
+  const uint32_t ring_size_;
+  const uint64_t max_overflow_size_;
+  // Writers are created by their thread on first write, and deleted with the file.
+  std::array<std::atomic<Writer*>, MAX_RINGS> writers_{};
+  Thread::MutexBasicLockable overflow_lock_;
+  Buffer::OwnedImpl overflow_buffer_ ABSL_GUARDED_BY(overflow_lock_);
+  // Incremented whenever a flush takes the data in the overflow buffer. Only changed under
+  // overflow_lock_.
+  std::atomic<uint64_t> overflow_generation_{0};
+  // Held while flushing. The flush is the only consumer of the rings.
+  Thread::MutexBasicLockable flush_lock_;
+  Buffer::OwnedImpl about_to_write_buffer_ ABSL_GUARDED_BY(flush_lock_);
+  std::atomic<bool> reopen_file_{false};
+};
+
 } // namespace AccessLog
 } // namespace Envoy
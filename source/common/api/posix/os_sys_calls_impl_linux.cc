@@ -2,6 +2,7 @@
 #error "Linux platform file is part of non-Linux build."
 #endif
 
+#include <fcntl.h>
 #include <sched.h>
 
 #include <cerrno>
@@ -22,5 +23,21 @@ SysCallIntResult LinuxOsSysCallsImpl::setns(int fd, int nstype) const {
   return {rc, errno};
 }
 
+SysCallIntResult LinuxOsSysCallsImpl::pipe2(int pipefd[2], int flags) {
+  const int rc = ::pipe2(pipefd, flags);
+  return {rc, rc != -1 ? 0 : errno};
+}
+
+SysCallSizeResult LinuxOsSysCallsImpl::splice(int fd_in, off64_t* off_in, int fd_out,
+                                              off64_t* off_out, size_t len, unsigned int flags) {
+  const ssize_t rc = ::splice(fd_in, off_in, fd_out, off_out, len, flags);
+  return {rc, rc != -1 ? 0 : errno};
+}
+
+SysCallIntResult LinuxOsSysCallsImpl::setPipeSize(int fd, int size) {
+  const int rc = ::fcntl(fd, F_SETPIPE_SZ, size);
+  return {rc, rc != -1 ? 0 : errno};
+}
+
 } // namespace Api
 } // namespace Envoy
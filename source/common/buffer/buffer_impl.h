@@ -9,6 +9,7 @@
 #include "envoy/buffer/buffer.h"
 #include "envoy/http/stream_reset_handler.h"
 
+#include "source/common/buffer/slice_pool.h"
 #include "source/common/common/assert.h"
 #include "source/common/common/non_copyable.h"
 #include "source/common/common/utility.h"
@@ -37,7 +38,7 @@ namespace Buffer {
 class Slice {
 public:
   using Reservation = RawSlice;
-  using StoragePtr = std::unique_ptr<uint8_t[]>;
+  using StoragePtr = SlicePool::StoragePtr;
 
   struct SizedStorage {
     StoragePtr mem_{};
@@ -57,7 +58,7 @@ public:
    * @param account the account to charge.
    */
   Slice(uint64_t min_capacity, const BufferMemoryAccountSharedPtr& account)
-      : capacity_(sliceSize(min_capacity)), storage_(new uint8_t[capacity_]),
+      : capacity_(sliceSize(min_capacity)), storage_(allocateStorage(capacity_)),
         base_(storage_.get()) {
     if (account) {
       account->charge(capacity_);
@@ -114,6 +115,9 @@ public:
   Slice& operator=(Slice&& rhs) noexcept {
     if (this != &rhs) {
       callAndClearDrainTrackersAndCharges();
+      if (storage_ != nullptr) {
+        releaseStorage(std::move(storage_), capacity_);
+      }
 
       capacity_ = rhs.capacity_;
       storage_ = std::move(rhs.storage_);
@@ -142,6 +146,9 @@ public:
     if (releasor_) {
       releasor_();
     }
+    if (storage_ != nullptr) {
+      releaseStorage(std::move(storage_), capacity_);
+    }
   }
 
   /**
@@ -343,6 +350,8 @@ public:
   }
 
   static constexpr uint32_t default_slice_size_ = 16384;
+  static_assert(default_slice_size_ == SlicePool::MaxPooledSize,
+                "default sized slices must be pooled");
 
 public:
   /**
@@ -365,7 +374,31 @@ public:
    */
   static inline SizedStorage newStorage(uint64_t min_capacity) {
     const uint64_t slice_size = sliceSize(min_capacity);
-    return {StoragePtr{new uint8_t[slice_size]}, static_cast<size_t>(slice_size)};
+    return {allocateStorage(slice_size), static_cast<size_t>(slice_size)};
+  }
+
+  /**
+   * Allocate backend storage from the slice pool of the dispatcher running on the calling thread,
+   * or from the heap if there is none.
+   * @param capacity the exact size of the storage.
+   * @return the backend storage.
+   */
+  static StoragePtr allocateStorage(uint64_t capacity) {
+    SlicePool* pool = SlicePool::current();
+    return pool != nullptr ? pool->allocate(capacity) : StoragePtr{new uint8_t[capacity]};
+  }
+
+  /**
+   * Return backend storage to the slice pool of the dispatcher running on the calling thread, or
+   * free it if there is none.
+   * @param storage the backend storage.
+   * @param capacity the size of the storage.
+   */
+  static void releaseStorage(StoragePtr storage, uint64_t capacity) {
+    SlicePool* pool = SlicePool::current();
+    if (pool != nullptr) {
+      pool->release(std::move(storage), capacity);
+    }
   }
 
 protected:
@@ -772,6 +805,8 @@ private:
           ASSERT(r->len_ == Slice::default_slice_size_);
           if (free_list_ref_.size() < free_list_max_) {
             free_list_ref_.push_back(std::move(r->mem_));
+          } else {
+            Slice::releaseStorage(std::move(r->mem_), r->len_);
           }
         }
       }
@@ -785,7 +820,7 @@ private:
         storage.mem_ = std::move(free_list_ref_.back());
         free_list_ref_.pop_back();
       } else {
-        storage.mem_.reset(new uint8_t[Slice::default_slice_size_]);
+        storage.mem_ = Slice::allocateStorage(Slice::default_slice_size_);
       }
 
       return storage;
@@ -0,0 +1,79 @@
+#include "source/common/buffer/slice_pool.h"
+
+#include "source/common/common/assert.h"
+
+namespace Envoy {
+namespace Buffer {
+
+thread_local SlicePool* SlicePool::current_ = nullptr;
+
+SlicePool::SlicePool(uint64_t high_watermark, uint64_t low_watermark)
+    : high_watermark_(high_watermark), low_watermark_(low_watermark) {
+  ASSERT(low_watermark_ <= high_watermark_);
+}
+
+SlicePool::StoragePtr SlicePool::allocate(uint64_t capacity) {
+  if (!pooled(capacity)) {
+    return StoragePtr{new uint8_t[capacity]};
+  }
+
+  std::vector<StoragePtr>& free_list = free_lists_[sizeIndex(capacity)];
+  if (free_list.empty()) {
+    if (stats_ != nullptr) {
+      stats_->misses_.inc();
+    }
+    return StoragePtr{new uint8_t[capacity]};
+  }
+
+  StoragePtr storage = std::move(free_list.back());
+  free_list.pop_back();
+  if (stats_ != nullptr) {
+    stats_->hits_.inc();
+  }
+  updateBytesCached(bytes_cached_ - capacity);
+  return storage;
+}
+
+void SlicePool::release(StoragePtr storage, uint64_t capacity) {
+  ASSERT(storage != nullptr);
+  if (!pooled(capacity)) {
+    return;
+  }
+  if (bytes_cached_ + capacity > high_watermark_) {
+    trim(low_watermark_);
+    if (bytes_cached_ + capacity > high_watermark_) {
+      return;
+    }
+  }
+
+  free_lists_[sizeIndex(capacity)].push_back(std::move(storage));
+  updateBytesCached(bytes_cached_ + capacity);
+}
+
+void SlicePool::trim(uint64_t target_bytes) {
+  uint64_t bytes_cached = bytes_cached_;
+  for (uint32_t index = NumSizes; index > 0 && bytes_cached > target_bytes; --index) {
+    std::vector<StoragePtr>& free_list = free_lists_[index - 1];
+    const uint64_t capacity = index * PageSize;
+    while (!free_list.empty() && bytes_cached > target_bytes) {
+      free_list.pop_back();
+      bytes_cached -= capacity;
+    }
+  }
+  updateBytesCached(bytes_cached);
+}
+
+void SlicePool::setStats(SlicePoolStats* stats) {
+  stats_ = stats;
+  updateBytesCached(bytes_cached_);
+}
+
+void SlicePool::updateBytesCached(uint64_t bytes_cached) {
+  bytes_cached_ = bytes_cached;
+  if (stats_ != nullptr) {
+    stats_->bytes_cached_.set(bytes_cached_);
+  }
+}
+
+} // namespace Buffer
+} // namespace Envoy
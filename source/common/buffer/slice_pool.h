@@ -0,0 +1,126 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "envoy/stats/stats_macros.h"
+
+#include "source/common/common/non_copyable.h"
+
+namespace Envoy {
+namespace Buffer {
+
+/**
+ * All slice pool stats. @see stats_macros.h
+ */
+#define ALL_SLICE_POOL_STATS(COUNTER, GAUGE)                                                       \
+  COUNTER(hits)                                                                                    \
+  COUNTER(misses)                                                                                  \
+  GAUGE(bytes_cached, NeverImport)
+
+/**
+ * Struct definition for all slice pool stats. @see stats_macros.h
+ */
+struct SlicePoolStats {
+  ALL_SLICE_POOL_STATS(GENERATE_COUNTER_STRUCT, GENERATE_GAUGE_STRUCT)
+};
+
+using SlicePoolStatsPtr = std::unique_ptr<SlicePoolStats>;
+
+/**
+ * A cache of slice storage, owned by a dispatcher and used by the thread running it. Storage of
+ * every page multiple up to MaxPooledSize bytes is kept in a freelist per size, so that a
+ * read/drain cycle on a worker reuses the storage of drained slices instead of going through the
+ * general purpose allocator.
+ *
+ * The bytes held by all freelists are bounded by a high watermark. When releasing storage would
+ * go above it, the pool is first trimmed down to the low watermark, so that trimming happens in
+ * batches rather than on every release once the pool is full.
+ *
+ * Storage is plain heap memory, so storage allocated by one pool may be released to another pool
+ * or to the heap; the pool only avoids the allocator round trip.
+ */
+class SlicePool : NonCopyable {
+public:
+  using StoragePtr = std::unique_ptr<uint8_t[]>;
+
+  static constexpr uint64_t PageSize = 4096;
+  static constexpr uint64_t MaxPooledSize = 16384;
+  static constexpr uint64_t DefaultHighWatermark = 4 * 1024 * 1024;
+  static constexpr uint64_t DefaultLowWatermark = 2 * 1024 * 1024;
+
+  SlicePool(uint64_t high_watermark = DefaultHighWatermark,
+            uint64_t low_watermark = DefaultLowWatermark);
+
+  /**
+   * Makes a pool the current pool of the calling thread for the lifetime of the object, and
+   * restores the previous one on destruction.
+   */
+  class ScopedActivation : NonCopyable {
+  public:
+    explicit ScopedActivation(SlicePool* pool) : previous_(current_) { current_ = pool; }
+    ~ScopedActivation() { current_ = previous_; }
+
+  private:
+    SlicePool* const previous_;
+  };
+
+  /**
+   * @return the pool of the dispatcher running on the calling thread, or nullptr if there is none.
+   */
+  static SlicePool* current() { return current_; }
+
+  /**
+   * Allocates storage of exactly the given capacity.
+   * @param capacity supplies the size of the storage, which must be a multiple of PageSize.
+   * @return the storage, which is taken from a freelist if possible.
+   */
+  StoragePtr allocate(uint64_t capacity);
+
+  /**
+   * Returns storage to the pool, or frees it if it cannot be cached.
+   * @param storage supplies the storage.
+   * @param capacity supplies the size of the storage.
+   */
+  void release(StoragePtr storage, uint64_t capacity);
+
+  /**
+   * Frees cached storage, largest sizes first, until at most target_bytes are cached.
+   */
+  void trim(uint64_t target_bytes);
+
+  /**
+   * Sets the stats to update, or nullptr to stop updating stats. The stats must outlive the
+   * pool, or be unset before they are destroyed.
+   */
+  void setStats(SlicePoolStats* stats);
+
+  /**
+   * @return the number of bytes held by the freelists.
+   */
+  uint64_t bytesCached() const { return bytes_cached_; }
+
+private:
+  static constexpr uint32_t NumSizes = MaxPooledSize / PageSize;
+
+  static bool pooled(uint64_t capacity) {
+    return capacity != 0 && capacity <= MaxPooledSize && capacity % PageSize == 0;
+  }
+  static uint32_t sizeIndex(uint64_t capacity) { return capacity / PageSize - 1; }
+  void updateBytesCached(uint64_t bytes_cached);
+
+  static thread_local SlicePool* current_;
+
+  const uint64_t high_watermark_;
+  const uint64_t low_watermark_;
+  std::array<std::vector<StoragePtr>, NumSizes> free_lists_;
+  uint64_t bytes_cached_{0};
+  SlicePoolStats* stats_{nullptr};
+};
+
+using SlicePoolPtr = std::unique_ptr<SlicePool>;
+
+} // namespace Buffer
+} // namespace Envoy
@@ -0,0 +1,191 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+
+#include "source/common/common/assert.h"
+#include "source/common/common/non_copyable.h"
+
+namespace Envoy {
+
+/**
+ * Hands out fixed size slots from a few slabs of growing size, for node based containers whose
+ * nodes would otherwise each be a separate heap allocation. Slots never move once handed out, so
+ * pointers to nodes stay valid for as long as the node exists. Released slots are reused before
+ * new slabs are allocated, and once all slots are released the slabs are handed out again from
+ * the start. The memory of the slabs is only returned when the arena is destroyed.
+ *
+ * The slot size is set by the first allocation. Every later allocation must have the same size,
+ * which is the case for the nodes of a std::list or std::set.
+ */
+class SlabArena : NonCopyable {
+public:
+  /**
+   * @param first_slab_slots supplies the number of slots of the first slab, unless reserve() is
+   *        called first. Every further slab has twice the slots of the previous one, up to
+   *        max_slab_slots.
+   * @param max_slab_slots supplies the maximum number of slots of a slab.
+   */
+  explicit SlabArena(uint16_t first_slab_slots = 1, uint16_t max_slab_slots = 64)
+      : next_slab_slots_(first_slab_slots), max_slab_slots_(max_slab_slots) {
+    ASSERT(first_slab_slots > 0 && first_slab_slots <= max_slab_slots);
+  }
+
+  ~SlabArena() {
+    while (first_ != nullptr) {
+      Slab* slab = first_;
+      first_ = slab->next_;
+      ::operator delete(slab);
+    }
+  }
+
+  /**
+   * Sizes the first slab for the supplied number of slots, up to the maximum slab size. Has no
+   * effect once a slab was allocated.
+   * @param slots supplies the number of slots expected to be allocated.
+   */
+  void reserve(size_t slots) {
+    if (first_ == nullptr && slots > 0) {
+      next_slab_slots_ = static_cast<uint16_t>(std::min<size_t>(slots, max_slab_slots_));
+    }
+  }
+
+  void* allocate(size_t size) {
+    ASSERT(slot_size_ == 0 || slotSize(size) == slot_size_);
+    ++allocated_slots_;
+    if (free_ != nullptr) {
+      FreeSlot* slot = free_;
+      free_ = slot->next_;
+      return slot;
+    }
+    if (current_ == nullptr || next_ == current_->end_) {
+      if (current_ != nullptr && current_->next_ != nullptr) {
+        useSlab(current_->next_);
+      } else {
+        addSlab(size);
+      }
+    }
+    void* slot = next_;
+    next_ += slot_size_;
+    return slot;
+  }
+
+  void deallocate(void* slot) {
+    ASSERT(allocated_slots_ > 0);
+    if (--allocated_slots_ == 0) {
+      // Hand out the slabs from the start again, so that the next nodes are contiguous.
+      free_ = nullptr;
+      useSlab(first_);
+      return;
+    }
+    FreeSlot* free_slot = new (slot) FreeSlot{free_};
+    free_ = free_slot;
+  }
+
+  /**
+   * @return the number of slabs allocated.
+   */
+  size_t slabs() const {
+    size_t slabs = 0;
+    for (const Slab* slab = first_; slab != nullptr; slab = slab->next_) {
+      ++slabs;
+    }
+    return slabs;
+  }
+
+private:
+  struct FreeSlot {
+    FreeSlot* next_;
+  };
+
+  // Header of a slab, followed by its slots.
+  struct alignas(std::max_align_t) Slab {
+    Slab* next_;
+    char* end_;
+  };
+
+  static uint32_t slotSize(size_t size) {
+    constexpr size_t alignment = alignof(std::max_align_t);
+    const size_t slot_size = size < sizeof(FreeSlot) ? sizeof(FreeSlot) : size;
+    return static_cast<uint32_t>((slot_size + alignment - 1) / alignment * alignment);
+  }
+
+  void useSlab(Slab* slab) {
+    current_ = slab;
+    next_ = reinterpret_cast<char*>(slab + 1);
+  }
+
+  void addSlab(size_t size) {
+    slot_size_ = slotSize(size);
+    const size_t bytes = size_t{slot_size_} * next_slab_slots_;
+    Slab* slab = static_cast<Slab*>(::operator new(sizeof(Slab) + bytes));
+    slab->next_ = nullptr;
+    slab->end_ = reinterpret_cast<char*>(slab + 1) + bytes;
+    if (current_ == nullptr) {
+      first_ = slab;
+    } else {
+      current_->next_ = slab;
+    }
+    useSlab(slab);
+    next_slab_slots_ =
+        static_cast<uint16_t>(std::min<uint32_t>(next_slab_slots_ * 2U, max_slab_slots_));
+  }
+
+  // The slabs in allocation order, and the one slots are currently handed out from. The arena is
+  // kept small, as it is embedded in objects such as header maps that are often created empty.
+  Slab* first_{nullptr};
+  Slab* current_{nullptr};
+  FreeSlot* free_{nullptr};
+  char* next_{nullptr};
+  uint32_t slot_size_{0};
+  uint32_t allocated_slots_{0};
+  uint16_t next_slab_slots_;
+  const uint16_t max_slab_slots_;
+};
+
+/**
+ * Standard allocator that allocates single objects from a SlabArena, which must outlive all
+ * containers using the allocator. Allocations of more than one object, e.g. by containers that
+ * allocate arrays, fall back to the heap, as do all allocations of a default constructed allocator.
+ */
+template <class T> class SlabAllocator {
+public:
+  using value_type = T;
+
+  SlabAllocator() = default;
+  explicit SlabAllocator(SlabArena& arena) : arena_(&arena) {}
+  template <class U> SlabAllocator(const SlabAllocator<U>& other) : arena_(other.arena_) {}
+
+  T* allocate(size_t n) {
+    static_assert(alignof(T) <= alignof(std::max_align_t), "over-aligned types are not supported");
+    if (n != 1 || arena_ == nullptr) {
+      return std::allocator<T>().allocate(n);
+    }
+    return static_cast<T*>(arena_->allocate(sizeof(T)));
+  }
+
+  void deallocate(T* p, size_t n) {
+    if (n != 1 || arena_ == nullptr) {
+      std::allocator<T>().deallocate(p, n);
+      return;
+    }
+    arena_->deallocate(p);
+  }
+
+  template <class U> bool operator==(const SlabAllocator<U>& other) const {
+    return arena_ == other.arena_;
+  }
+  template <class U> bool operator!=(const SlabAllocator<U>& other) const {
+    return arena_ != other.arena_;
+  }
+
+private:
+  template <class U> friend class SlabAllocator;
+
+  SlabArena* arena_{nullptr};
+};
+
+} // namespace Envoy
@@ -107,6 +107,12 @@ void DispatcherImpl::initializeStats(Stats::Scope& scope,
     stats_ = std::make_unique<DispatcherStats>(
         DispatcherStats{ALL_DISPATCHER_STATS(POOL_HISTOGRAM_PREFIX(scope, stats_prefix_ + "."))});
     base_scheduler_.initializeStats(stats_.get());
+    if (slice_pool_ != nullptr) {
+      slice_pool_stats_ = std::make_unique<Buffer::SlicePoolStats>(Buffer::SlicePoolStats{
+          ALL_SLICE_POOL_STATS(POOL_COUNTER_PREFIX(scope, stats_prefix_ + ".slice_pool."),
+                               POOL_GAUGE_PREFIX(scope, stats_prefix_ + ".slice_pool."))});
+      slice_pool_->setStats(slice_pool_stats_.get());
+    }
     ENVOY_LOG(debug, "running {} on thread {}", stats_prefix_, run_tid_.debugString());
   });
 }
@@ -290,6 +296,14 @@ void DispatcherImpl::deleteInDispatcherThread(DispatcherThreadDeletableConstPtr
 
 void DispatcherImpl::run(RunType type) {
   run_tid_ = thread_factory_.currentThreadId();
+  // The pool is created on the first run, as runtime is not yet loaded when the server's main
+  // dispatcher is constructed. Buffer slices allocated and freed on this thread while the loop runs
+  // use the pool.
+  if (slice_pool_ == nullptr &&
+      Runtime::runtimeFeatureEnabled("envoy.reloadable_features.buffer_slice_pool")) {
+    slice_pool_ = std::make_unique<Buffer::SlicePool>();
+  }
+  Buffer::SlicePool::ScopedActivation slice_pool_activation(slice_pool_.get());
   // Flush all post callbacks before we run the event loop. We do this because there are post
   // callbacks that have to get run before the initial event loop starts running. libevent does
   // not guarantee that events are run in any particular order. So even if we post() and call
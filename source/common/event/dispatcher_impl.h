@@ -14,6 +14,7 @@
 #include "envoy/network/connection_handler.h"
 #include "envoy/stats/scope.h"
 
+#include "source/common/buffer/slice_pool.h"
 #include "source/common/common/logger.h"
 #include "source/common/common/thread.h"
 #include "source/common/event/libevent.h"
@@ -146,6 +147,9 @@ private:
   Filesystem::Instance& file_system_;
   std::string stats_prefix_;
   DispatcherStatsPtr stats_;
+  // Declared before slice_pool_, which refers to the stats.
+  Buffer::SlicePoolStatsPtr slice_pool_stats_;
+  Buffer::SlicePoolPtr slice_pool_;
   Thread::ThreadId run_tid_;
   Buffer::WatermarkFactorySharedPtr buffer_factory_;
   LibeventScheduler base_scheduler_;
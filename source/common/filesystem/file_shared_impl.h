@@ -43,6 +43,8 @@ public:
 
   ~FileSharedImpl() override = default;
 
+  // Writes the buffers one by one.
+  Api::IoCallSizeResult writev(absl::Span<const absl::string_view> buffers) override;
   bool isOpen() const override;
   std::string path() const override;
   DestinationType destinationType() const override;
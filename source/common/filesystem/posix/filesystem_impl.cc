@@ -1,6 +1,7 @@
 #include <dirent.h>
 #include <fcntl.h>
 #include <sys/stat.h>
+#include <sys/uio.h>
 #include <unistd.h>
 
 #include <cstdlib>
@@ -19,6 +20,7 @@
 #include "source/common/filesystem/filesystem_impl.h"
 #include "source/common/runtime/runtime_features.h"
 
+#include "absl/container/fixed_array.h"
 #include "absl/strings/match.h"
 #include "absl/strings/str_cat.h"
 
@@ -100,6 +102,31 @@ Api::IoCallSizeResult FileImplPosix::write(absl::string_view buffer) {
   return rc != -1 ? resultSuccess(rc) : resultFailure(rc, errno);
 };
 
+Api::IoCallSizeResult FileImplPosix::writev(absl::Span<const absl::string_view> buffers) {
+  ssize_t written = 0;
+  while (!buffers.empty()) {
+    // Writes at most IOV_MAX buffers per system call.
+    const size_t num_iov = std::min<size_t>(buffers.size(), IOV_MAX);
+    absl::FixedArray<iovec> iov(num_iov);
+    size_t expected = 0;
+    for (size_t i = 0; i < num_iov; ++i) {
+      iov[i].iov_base = const_cast<char*>(buffers[i].data());
+      iov[i].iov_len = buffers[i].size();
+      expected += buffers[i].size();
+    }
+    const ssize_t rc = ::writev(fd_, iov.data(), num_iov);
+    if (rc == -1) {
+      return resultFailure(rc, errno);
+    }
+    written += rc;
+    if (static_cast<size_t>(rc) != expected) {
+      break;
+    }
+    buffers.remove_prefix(num_iov);
+  }
+  return resultSuccess(written);
+}
+
 Api::IoCallBoolResult FileImplPosix::close() {
   ASSERT(isOpen());
   int rc = ::close(fd_);
@@ -81,6 +81,29 @@ Protobuf::Value HeaderFormatter::formatValue(OptRef<const Http::HeaderMap> heade
   return ValueUtil::stringValue(std::string(val));
 }
 
+bool HeaderFormatter::formatTo(OptRef<const Http::HeaderMap> headers, std::string& output) const {
+  const Http::HeaderEntry* header = findHeader(headers);
+  if (!header) {
+    return false;
+  }
+
+  absl::string_view val = header->value().getStringView();
+  output.append(SubstitutionFormatUtils::truncateStringView(val, max_length_));
+  return true;
+}
+
+void HeaderFormatter::formatValueTo(OptRef<const Http::HeaderMap> headers,
+                                    FormatterValueSink& sink) const {
+  const Http::HeaderEntry* header = findHeader(headers);
+  if (!header) {
+    sink.addNull();
+    return;
+  }
+
+  absl::string_view val = header->value().getStringView();
+  sink.addString(SubstitutionFormatUtils::truncateStringView(val, max_length_));
+}
+
 ResponseHeaderFormatter::ResponseHeaderFormatter(absl::string_view main_header,
                                                  absl::string_view alternative_header,
                                                  absl::optional<size_t> max_length)
@@ -96,6 +119,16 @@ Protobuf::Value ResponseHeaderFormatter::formatValue(const Context& context,
   return HeaderFormatter::formatValue(context.responseHeaders());
 }
 
+bool ResponseHeaderFormatter::formatTo(const Context& context, const StreamInfo::StreamInfo&,
+                                       std::string& output) const {
+  return HeaderFormatter::formatTo(context.responseHeaders(), output);
+}
+
+void ResponseHeaderFormatter::formatValueTo(const Context& context, const StreamInfo::StreamInfo&,
+                                            FormatterValueSink& sink) const {
+  HeaderFormatter::formatValueTo(context.responseHeaders(), sink);
+}
+
 RequestHeaderFormatter::RequestHeaderFormatter(absl::string_view main_header,
                                                absl::string_view alternative_header,
                                                absl::optional<size_t> max_length)
@@ -111,6 +144,16 @@ Protobuf::Value RequestHeaderFormatter::formatValue(const Context& context,
   return HeaderFormatter::formatValue(context.requestHeaders());
 }
 
+bool RequestHeaderFormatter::formatTo(const Context& context, const StreamInfo::StreamInfo&,
+                                      std::string& output) const {
+  return HeaderFormatter::formatTo(context.requestHeaders(), output);
+}
+
+void RequestHeaderFormatter::formatValueTo(const Context& context, const StreamInfo::StreamInfo&,
+                                           FormatterValueSink& sink) const {
+  HeaderFormatter::formatValueTo(context.requestHeaders(), sink);
+}
+
 ResponseTrailerFormatter::ResponseTrailerFormatter(absl::string_view main_header,
                                                    absl::string_view alternative_header,
                                                    absl::optional<size_t> max_length)
@@ -126,6 +169,16 @@ Protobuf::Value ResponseTrailerFormatter::formatValue(const Context& context,
   return HeaderFormatter::formatValue(context.responseTrailers());
 }
 
+bool ResponseTrailerFormatter::formatTo(const Context& context, const StreamInfo::StreamInfo&,
+                                        std::string& output) const {
+  return HeaderFormatter::formatTo(context.responseTrailers(), output);
+}
+
+void ResponseTrailerFormatter::formatValueTo(const Context& context, const StreamInfo::StreamInfo&,
+                                             FormatterValueSink& sink) const {
+  HeaderFormatter::formatValueTo(context.responseTrailers(), sink);
+}
+
 HeadersByteSizeFormatter::HeadersByteSizeFormatter(const HeaderType header_type)
     : header_type_(header_type) {}
 
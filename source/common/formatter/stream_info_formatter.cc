@@ -642,6 +642,8 @@ public:
   // Don't hide the other structure of format and formatValue.
   using StreamInfoFormatterProvider::format;
   using StreamInfoFormatterProvider::formatValue;
+  using StreamInfoFormatterProvider::formatTo;
+  using StreamInfoFormatterProvider::formatValueTo;
   absl::optional<std::string> format(const StreamInfo::StreamInfo& stream_info) const override {
     const auto millis = extractMillis(stream_info);
     if (!millis) {
@@ -658,6 +660,25 @@ public:
 
     return ValueUtil::numberValue(millis.value());
   }
+  bool formatTo(const StreamInfo::StreamInfo& stream_info, std::string& output) const override {
+    const auto millis = extractMillis(stream_info);
+    if (!millis) {
+      return false;
+    }
+
+    absl::StrAppend(&output, millis.value());
+    return true;
+  }
+  void formatValueTo(const StreamInfo::StreamInfo& stream_info,
+                     FormatterValueSink& sink) const override {
+    const auto millis = extractMillis(stream_info);
+    if (!millis) {
+      sink.addNull();
+      return;
+    }
+
+    sink.addNumber(millis.value());
+  }
 
 private:
   absl::optional<int64_t> extractMillis(const StreamInfo::StreamInfo& stream_info) const {
@@ -682,12 +703,22 @@ public:
   // Don't hide the other structure of format and formatValue.
   using StreamInfoFormatterProvider::format;
   using StreamInfoFormatterProvider::formatValue;
+  using StreamInfoFormatterProvider::formatTo;
+  using StreamInfoFormatterProvider::formatValueTo;
   absl::optional<std::string> format(const StreamInfo::StreamInfo& stream_info) const override {
     return fmt::format_int(field_extractor_(stream_info)).str();
   }
   Protobuf::Value formatValue(const StreamInfo::StreamInfo& stream_info) const override {
     return ValueUtil::numberValue(field_extractor_(stream_info));
   }
+  bool formatTo(const StreamInfo::StreamInfo& stream_info, std::string& output) const override {
+    absl::StrAppend(&output, field_extractor_(stream_info));
+    return true;
+  }
+  void formatValueTo(const StreamInfo::StreamInfo& stream_info,
+                     FormatterValueSink& sink) const override {
+    sink.addNumber(field_extractor_(stream_info));
+  }
 
 private:
   FieldExtractor field_extractor_;
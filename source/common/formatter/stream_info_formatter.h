@@ -30,6 +30,14 @@ public:
                               const StreamInfo::StreamInfo& stream_info) const override {
     return formatValue(stream_info);
   }
+  bool formatTo(const Context&, const StreamInfo::StreamInfo& stream_info,
+                std::string& output) const override {
+    return formatTo(stream_info, output);
+  }
+  void formatValueTo(const Context&, const StreamInfo::StreamInfo& stream_info,
+                     FormatterValueSink& sink) const override {
+    formatValueTo(stream_info, sink);
+  }
 
   /**
    * Format the value with the given stream info.
@@ -45,6 +53,31 @@ public:
    * @return Protobuf::Value containing a single value extracted from the given stream info.
    */
   virtual Protobuf::Value formatValue(const StreamInfo::StreamInfo& stream_info) const PURE;
+
+  /**
+   * Append the value to the output, see FormatterProvider::formatTo().
+   * @param stream_info supplies the stream info.
+   * @param output supplies the string to which the value is appended.
+   * @return bool whether there was a value to append.
+   */
+  virtual bool formatTo(const StreamInfo::StreamInfo& stream_info, std::string& output) const {
+    const absl::optional<std::string> value = format(stream_info);
+    if (!value.has_value()) {
+      return false;
+    }
+    output.append(value.value());
+    return true;
+  }
+
+  /**
+   * Pass the value to the sink, see FormatterProvider::formatValueTo().
+   * @param stream_info supplies the stream info.
+   * @param sink supplies the sink that receives the value.
+   */
+  virtual void formatValueTo(const StreamInfo::StreamInfo& stream_info,
+                             FormatterValueSink& sink) const {
+    sink.addValue(formatValue(stream_info));
+  }
 };
 
 using StreamInfoFormatterProviderPtr = std::unique_ptr<StreamInfoFormatterProvider>;
@@ -366,36 +366,63 @@ FormatterImpl::create(absl::string_view format, bool omit_empty_values,
 std::string FormatterImpl::format(const Context& context,
                                   const StreamInfo::StreamInfo& stream_info) const {
   std::string log_line;
-  log_line.reserve(256);
+  formatTo(context, stream_info, log_line);
+  return log_line;
+}
+
+void FormatterImpl::formatTo(const Context& context, const StreamInfo::StreamInfo& stream_info,
+                             std::string& output) const {
+  const size_t start = output.size();
+  output.reserve(start + size_hint_.get());
 
   for (const auto& provider : providers_) {
-    const absl::optional<std::string> bit = provider->format(context, stream_info);
     // Add the formatted value if there is one. Otherwise add a default value
     // of "-" if omit_empty_values_ is not set.
-    if (bit.has_value()) {
-      log_line += bit.value();
-    } else if (!omit_empty_values_) {
-      log_line += DefaultUnspecifiedValueStringView;
+    if (!provider->formatTo(context, stream_info, output) && !omit_empty_values_) {
+      output.append(DefaultUnspecifiedValueStringView);
     }
   }
 
-  return log_line;
+  size_hint_.update(output.size() - start);
 }
 
+namespace {
+
+// Writes the typed values of formatter providers to the log line as JSON.
+class JsonValueSink : public FormatterValueSink {
+public:
+  explicit JsonValueSink(std::string& log_line) : log_line_(log_line), streamer_(log_line) {}
+
+  // FormatterValueSink
+  void addString(absl::string_view value) override { streamer_.addString(value); }
+  void addNumber(double value) override { streamer_.addNumber(value); }
+  void addNull() override { streamer_.addNull(); }
+  void addValue(const Protobuf::Value& value) override {
+    Json::Utility::appendValueToString(value, log_line_);
+  }
+
+private:
+  std::string& log_line_;
+  Json::StringStreamer streamer_;
+};
+
+} // namespace
+
 void stringValueToLogLine(const JsonFormatterImpl::Formatters& formatters, const Context& context,
                           const StreamInfo::StreamInfo& info, std::string& log_line,
-                          std::string& sanitize, bool omit_empty_values) {
+                          std::string& value, std::string& sanitize, bool omit_empty_values) {
   log_line.push_back('"'); // Start the JSON string.
   for (const JsonFormatterImpl::Formatter& formatter : formatters) {
-    const absl::optional<std::string> value = formatter->format(context, info);
-    if (!value.has_value()) {
+    // The value buffer is reused for all values of the log line.
+    value.clear();
+    if (!formatter->formatTo(context, info, value)) {
       // Add the empty value. This needn't be sanitized.
       log_line.append(omit_empty_values ? EMPTY_STRING : DefaultUnspecifiedValueStringView);
       continue;
     }
     // Sanitize the string value and add it to the buffer. The string value will not be quoted
     // since we handle the quoting by ourselves at the outer level.
-    log_line.append(Json::sanitize(sanitize, value.value()));
+    log_line.append(Json::sanitize(sanitize, value));
   }
   log_line.push_back('"'); // End the JSON string.
 }
@@ -403,29 +430,44 @@ void stringValueToLogLine(const JsonFormatterImpl::Formatters& formatters, const
 JsonFormatterImpl::JsonFormatterImpl(const Protobuf::Struct& struct_format, bool omit_empty_values,
                                      const CommandParsers& commands)
     : omit_empty_values_(omit_empty_values) {
+  size_t size_hint = 1; // The trailing newline.
   for (JsonFormatBuilder::FormatElement& element : JsonFormatBuilder().fromStruct(struct_format)) {
     if (element.is_template_) {
-      parsed_elements_.emplace_back(
+      auto& formatters = absl::get<Formatters>(parsed_elements_.emplace_back(
           THROW_OR_RETURN_VALUE(SubstitutionFormatParser::parse(element.value_, commands),
-                                std::vector<FormatterProviderPtr>));
+                                std::vector<FormatterProviderPtr>)));
+      size_hint += formatters.size() * FormatSizeHint::ValueSize;
     } else {
+      size_hint += element.value_.size();
       parsed_elements_.emplace_back(std::move(element.value_));
     }
   }
+  size_hint_.initialize(size_hint);
 }
 
 std::string JsonFormatterImpl::format(const Context& context,
                                       const StreamInfo::StreamInfo& info) const {
   std::string log_line;
-  log_line.reserve(2048);
-  std::string sanitize; // Helper to serialize the value to log line.
+  formatTo(context, info, log_line);
+  return log_line;
+}
+
+void JsonFormatterImpl::formatTo(const Context& context, const StreamInfo::StreamInfo& info,
+                                 std::string& output) const {
+  const size_t start = output.size();
+  output.reserve(start + size_hint_.get());
+  // Helpers to serialize the values to the log line. They only allocate for values that are not
+  // written to the log line directly.
+  std::string value;
+  std::string sanitize;
+  JsonValueSink sink(output);
 
   for (const ParsedFormatElement& element : parsed_elements_) {
     // 1. Handle the raw string element.
     if (absl::holds_alternative<std::string>(element)) {
       // The raw string element will be added to the buffer directly.
       // It is sanitized when loading the configuration.
-      log_line.append(absl::get<std::string>(element));
+      output.append(absl::get<std::string>(element));
       continue;
     }
 
@@ -435,17 +477,16 @@ std::string JsonFormatterImpl::format(const Context& context,
 
     if (formatters.size() != 1) {
       // 2. Handle the formatter element with multiple or zero providers.
-      stringValueToLogLine(formatters, context, info, log_line, sanitize, omit_empty_values_);
+      stringValueToLogLine(formatters, context, info, output, value, sanitize, omit_empty_values_);
     } else {
       // 3. Handle the formatter element with a single provider and value
       //    type needs to be kept.
-      const auto value = formatters[0]->formatValue(context, info);
-      Json::Utility::appendValueToString(value, log_line);
+      formatters[0]->formatValueTo(context, info, sink);
     }
   }
 
-  log_line.push_back('\n');
-  return log_line;
+  output.push_back('\n');
+  size_hint_.update(output.size() - start);
 }
 
 } // namespace Formatter
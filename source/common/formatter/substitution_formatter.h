@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include <bitset>
 #include <functional>
 #include <list>
@@ -39,6 +40,15 @@ public:
   Protobuf::Value formatValue(const Context&, const StreamInfo::StreamInfo&) const override {
     return str_;
   }
+  bool formatTo(const Context&, const StreamInfo::StreamInfo&,
+                std::string& output) const override {
+    output.append(str_.string_value());
+    return true;
+  }
+  void formatValueTo(const Context&, const StreamInfo::StreamInfo&,
+                     FormatterValueSink& sink) const override {
+    sink.addString(str_.string_value());
+  }
 
 private:
   Protobuf::Value str_;
@@ -59,6 +69,15 @@ public:
   Protobuf::Value formatValue(const Context&, const StreamInfo::StreamInfo&) const override {
     return num_;
   }
+  bool formatTo(const Context&, const StreamInfo::StreamInfo&,
+                std::string& output) const override {
+    absl::StrAppendFormat(&output, "%g", num_.number_value());
+    return true;
+  }
+  void formatValueTo(const Context&, const StreamInfo::StreamInfo&,
+                     FormatterValueSink& sink) const override {
+    sink.addNumber(num_.number_value());
+  }
 
 private:
   Protobuf::Value num_;
@@ -75,6 +94,30 @@ public:
 
 inline constexpr absl::string_view DefaultUnspecifiedValueStringView = "-";
 
+/**
+ * Estimate of the size of the lines of a formatter, so the output is allocated once per line. The
+ * estimate starts from the size of the format and grows to the largest line seen, which is good
+ * enough for access logs whose lines are of similar length.
+ */
+class FormatSizeHint {
+public:
+  // Estimated size of a single substituted value.
+  static constexpr size_t ValueSize = 16;
+
+  void initialize(size_t size) { size_.store(size, std::memory_order_relaxed); }
+  size_t get() const { return size_.load(std::memory_order_relaxed); }
+  void update(size_t size) const {
+    if (size > get()) {
+      size_.store(size, std::memory_order_relaxed);
+    }
+  }
+
+private:
+  // Shared by all workers. Racing updates may lose a larger size, which is only picked up again
+  // by a later line.
+  mutable std::atomic<size_t> size_{0};
+};
+
 /**
  * Composite formatter implementation.
  */
@@ -89,6 +132,8 @@ public:
   // Formatter
   std::string format(const Context& context,
                      const StreamInfo::StreamInfo& stream_info) const override;
+  void formatTo(const Context& context, const StreamInfo::StreamInfo& stream_info,
+                std::string& output) const override;
 
 protected:
   FormatterImpl(absl::Status& creation_status, absl::string_view format,
@@ -97,11 +142,13 @@ protected:
     auto providers_or_error = SubstitutionFormatParser::parse(format, command_parsers);
     SET_AND_RETURN_IF_NOT_OK(providers_or_error.status(), creation_status);
     providers_ = std::move(*providers_or_error);
+    size_hint_.initialize(format.size() + providers_.size() * FormatSizeHint::ValueSize);
   }
 
 private:
   const bool omit_empty_values_;
   std::vector<FormatterProviderPtr> providers_;
+  FormatSizeHint size_hint_;
 };
 
 class JsonFormatterImpl : public Formatter {
@@ -115,11 +162,14 @@ public:
 
   // Formatter
   std::string format(const Context& context, const StreamInfo::StreamInfo& info) const override;
+  void formatTo(const Context& context, const StreamInfo::StreamInfo& info,
+                std::string& output) const override;
 
 private:
   const bool omit_empty_values_;
   using ParsedFormatElement = absl::variant<std::string, Formatters>;
   std::vector<ParsedFormatElement> parsed_elements_;
+  FormatSizeHint size_hint_;
 };
 
 } // namespace Formatter
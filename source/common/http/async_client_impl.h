@@ -38,6 +38,7 @@
 #include "source/common/common/linked_object.h"
 #include "source/common/http/message_impl.h"
 #include "source/common/http/null_route_impl.h"
+#include "source/common/http/stream_arena_impl.h"
 #include "source/common/local_reply/local_reply.h"
 #include "source/common/router/config_impl.h"
 #include "source/common/router/router.h"
@@ -277,6 +278,7 @@ private:
   }
   bool shouldLoadShed() const override { return false; }
   absl::string_view filterConfigName() const override { return ""; }
+  StreamArena& streamArena() override { return stream_arena_; }
   RequestHeaderMapOptRef requestHeaders() override { return makeOptRefFromPtr(request_headers_); }
   RequestTrailerMapOptRef requestTrailers() override {
     return makeOptRefFromPtr(request_trailers_);
@@ -294,6 +296,8 @@ private:
 
   AsyncClient::StreamCallbacks& stream_callbacks_;
   const uint64_t stream_id_;
+  // Must outlive the router filter.
+  StreamArenaImpl stream_arena_;
   Router::ProdFilter router_;
   StreamInfo::StreamInfoImpl stream_info_;
   Tracing::NullSpan active_span_;
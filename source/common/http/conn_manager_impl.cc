@@ -310,6 +310,7 @@ void ConnectionManagerImpl::doEndStream(ActiveStream& stream, bool check_for_def
 
   if (reset_stream && codec_->protocol() < Protocol::Http2) {
     drain_state_ = DrainState::Closing;
+    codec_->closeAfterActiveStreams();
   }
 
   if (check_for_deferred_close) {
@@ -438,6 +439,7 @@ RequestDecoder& ConnectionManagerImpl::newStream(ResponseEncoder& response_encod
       new_stream->filter_manager_.streamInfo().setShouldDrainConnectionUponCompletion(true);
       // Prevent erroneous debug log of closing due to incoming connection close header.
       drain_state_ = DrainState::Closing;
+      codec_->closeAfterActiveStreams();
     } else if (drain_state_ == DrainState::NotDraining) {
       startDrainSequence();
     }
@@ -449,6 +451,7 @@ RequestDecoder& ConnectionManagerImpl::newStream(ResponseEncoder& response_encod
     new_stream->filter_manager_.streamInfo().setShouldDrainConnectionUponCompletion(true);
     // Prevent erroneous debug log of closing due to incoming connection close header.
     drain_state_ = DrainState::Closing;
+    codec_->closeAfterActiveStreams();
   }
 
   new_stream->state_.is_internally_created_ = is_internally_created;
@@ -548,10 +551,10 @@ Network::FilterStatus ConnectionManagerImpl::onData(Buffer::Instance& data, bool
     // Processing incoming data may release outbound data so check for closure here as well.
     checkForDeferredClose(false);
 
-    // The HTTP/1 codec will pause dispatch after a single message is complete. We want to
-    // either redispatch if there are no streams and we have more data. If we have a single
-    // complete non-WebSocket stream but have not responded yet we will pause socket reads
-    // to apply back pressure.
+    // The HTTP/1 codec will pause dispatch after a single message is complete, or after the
+    // configured number of pipelined messages. We want to either redispatch if there are no
+    // streams and we have more data. If we have complete non-WebSocket streams but have not
+    // responded yet the codec will pause socket reads to apply back pressure.
     if (codec_->protocol() < Protocol::Http2) {
       if (read_callbacks_->connection().state() == Network::Connection::State::Open &&
           data.length() > 0 && streams_.empty()) {
@@ -1677,6 +1680,7 @@ void ConnectionManagerImpl::startDrainSequence() {
   ASSERT(drain_state_ == DrainState::NotDraining);
   drain_state_ = DrainState::Draining;
   codec_->shutdownNotice();
+  codec_->closeAfterActiveStreams();
   drain_timer_ = dispatcher_->createTimer([this]() -> void { onDrainTimeout(); });
   drain_timer_->enableTimer(config_->drainTimeout());
 }
@@ -1967,6 +1971,7 @@ void ConnectionManagerImpl::ActiveStream::encodeHeaders(ResponseHeaderMap& heade
       connection_manager_.startDrainSequence();
     } else {
       connection_manager_.drain_state_ = DrainState::Closing;
+      connection_manager_.codec_->closeAfterActiveStreams();
     }
   }
 
@@ -1976,6 +1981,7 @@ void ConnectionManagerImpl::ActiveStream::encodeHeaders(ResponseHeaderMap& heade
   if (!filter_manager_.hasLastDownstreamByteReceived()) {
     if (connection_manager_.codec_->protocol() < Protocol::Http2) {
       connection_manager_.drain_state_ = DrainState::Closing;
+      connection_manager_.codec_->closeAfterActiveStreams();
     }
 
     connection_manager_.stats_.named_.downstream_rq_response_before_rq_complete_.inc();
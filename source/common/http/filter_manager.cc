@@ -340,6 +340,8 @@ OptRef<UpstreamStreamFilterCallbacks> ActiveStreamFilterBase::upstreamCallbacks(
   return parent_.filter_manager_callbacks_.upstreamCallbacks();
 }
 
+StreamArena& ActiveStreamFilterBase::streamArena() { return parent_.stream_arena_; }
+
 RequestHeaderMapOptRef ActiveStreamFilterBase::requestHeaders() {
   return parent_.filter_manager_callbacks_.requestHeaders();
 }
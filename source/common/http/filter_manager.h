@@ -21,6 +21,8 @@
 #include "source/common/http/header_utility.h"
 #include "source/common/http/headers.h"
 #include "source/common/http/matching/data_impl.h"
+#include "source/common/http/stateless_filter_adapter.h"
+#include "source/common/http/stream_arena_impl.h"
 #include "source/common/http/utility.h"
 #include "source/common/local_reply/local_reply.h"
 #include "source/common/matcher/matcher.h"
@@ -37,8 +39,8 @@ class DownstreamFilterManager;
 struct ActiveStreamFilterBase;
 struct ActiveStreamDecoderFilter;
 struct ActiveStreamEncoderFilter;
-using ActiveStreamDecoderFilterPtr = std::unique_ptr<ActiveStreamDecoderFilter>;
-using ActiveStreamEncoderFilterPtr = std::unique_ptr<ActiveStreamEncoderFilter>;
+using ActiveStreamDecoderFilterPtr = StreamArenaPtr<ActiveStreamDecoderFilter>;
+using ActiveStreamEncoderFilterPtr = StreamArenaPtr<ActiveStreamEncoderFilter>;
 
 constexpr absl::string_view LocalReplyFilterStateKey =
     "envoy.filters.network.http_connection_manager.local_reply_owner";
@@ -163,6 +165,7 @@ struct ActiveStreamFilterBase : public virtual StreamFilterCallbacks,
   OptRef<DownstreamStreamFilterCallbacks> downstreamCallbacks() override;
   OptRef<UpstreamStreamFilterCallbacks> upstreamCallbacks() override;
   absl::string_view filterConfigName() const override { return filter_context_.config_name; }
+  StreamArena& streamArena() override;
   RequestHeaderMapOptRef requestHeaders() override;
   RequestTrailerMapOptRef requestTrailers() override;
   ResponseHeaderMapOptRef informationalHeaders() override;
@@ -688,7 +691,10 @@ public:
                 uint64_t buffer_limit)
       : filter_manager_callbacks_(filter_manager_callbacks), dispatcher_(dispatcher),
         connection_(connection), stream_id_(stream_id), account_(std::move(account)),
-        proxy_100_continue_(proxy_100_continue), buffer_limit_(buffer_limit) {}
+        proxy_100_continue_(proxy_100_continue),
+        use_stream_arena_(
+            Runtime::runtimeFeatureEnabled("envoy.reloadable_features.http_stream_arena")),
+        buffer_limit_(buffer_limit) {}
 
   ~FilterManager() override {
     ASSERT(state_.destroyed_);
@@ -994,23 +1000,35 @@ private:
       manager_.filters_.push_back(filter.get());
 
       manager_.decoder_filters_.entries_.emplace_back(
-          std::make_unique<ActiveStreamDecoderFilter>(manager_, std::move(filter), context_));
+          manager_.makeActiveFilter<ActiveStreamDecoderFilter>(std::move(filter), context_));
     }
 
     void addStreamEncoderFilter(Http::StreamEncoderFilterSharedPtr filter) override {
       manager_.filters_.push_back(filter.get());
 
       manager_.encoder_filters_.entries_.emplace_back(
-          std::make_unique<ActiveStreamEncoderFilter>(manager_, std::move(filter), context_));
+          manager_.makeActiveFilter<ActiveStreamEncoderFilter>(std::move(filter), context_));
     }
 
     void addStreamFilter(Http::StreamFilterSharedPtr filter) override {
       manager_.filters_.push_back(filter.get());
 
       manager_.decoder_filters_.entries_.emplace_back(
-          std::make_unique<ActiveStreamDecoderFilter>(manager_, filter, context_));
+          manager_.makeActiveFilter<ActiveStreamDecoderFilter>(filter, context_));
       manager_.encoder_filters_.entries_.emplace_back(
-          std::make_unique<ActiveStreamEncoderFilter>(manager_, std::move(filter), context_));
+          manager_.makeActiveFilter<ActiveStreamEncoderFilter>(std::move(filter), context_));
+    }
+
+    void addStatelessStreamDecoderFilter(StatelessStreamDecoderFilterSharedPtr filter) override {
+      addStreamDecoderFilter(
+          manager_.makeStatelessFilterAdapter<StatelessStreamDecoderFilterAdapter>(
+              std::move(filter)));
+    }
+
+    void addStatelessStreamEncoderFilter(StatelessStreamEncoderFilterSharedPtr filter) override {
+      addStreamEncoderFilter(
+          manager_.makeStatelessFilterAdapter<StatelessStreamEncoderFilterAdapter>(
+              std::move(filter)));
     }
 
     void addAccessLogHandler(AccessLog::InstanceSharedPtr handler) override {
@@ -1102,6 +1120,22 @@ private:
 
   bool isTerminalDecoderFilter(const ActiveStreamDecoderFilter& filter) const;
 
+  // Creates a filter wrapper, in the stream arena if enabled.
+  template <class T, class... Args> StreamArenaPtr<T> makeActiveFilter(Args&&... args) {
+    return makeStreamArenaPtr<T>(use_stream_arena_ ? &stream_arena_ : nullptr, *this,
+                                 std::forward<Args>(args)...);
+  }
+
+  // Creates the per-stream adapter of a stateless filter. In the stream arena the adapter needs no
+  // allocation of its own, and the returned pointer does not own it, so there is no control block
+  // either. The arena outlives the filter wrappers that hold the pointer.
+  template <class T, class Filter> std::shared_ptr<T> makeStatelessFilterAdapter(Filter&& filter) {
+    if (!use_stream_arena_) {
+      return std::make_shared<T>(std::forward<Filter>(filter));
+    }
+    return {std::shared_ptr<void>(), &stream_arena_.create<T>(std::forward<Filter>(filter))};
+  }
+
   FilterManagerCallbacks& filter_manager_callbacks_;
   Event::Dispatcher& dispatcher_;
   // This is unset if there is no downstream connection, e.g. for health check or
@@ -1110,7 +1144,10 @@ private:
   const uint64_t stream_id_;
   Buffer::BufferMemoryAccountSharedPtr account_;
   const bool proxy_100_continue_;
+  const bool use_stream_arena_;
 
+  // Must outlive the filter wrappers and the filters, which may hold objects in the arena.
+  StreamArenaImpl stream_arena_;
   StreamDecoderFilters decoder_filters_;
   StreamEncoderFilters encoder_filters_;
   std::vector<StreamFilterBase*> filters_;
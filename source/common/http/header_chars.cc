@@ -0,0 +1,262 @@
+#include "source/common/http/header_chars.h"
+
+#include <cstdint>
+
+#include "source/common/http/character_set_validation.h"
+
+#include "absl/strings/ascii.h"
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__)) && !defined(_MSC_VER)
+#define ENVOY_HEADER_CHARS_X86
+#include <immintrin.h>
+#endif
+
+namespace Envoy {
+namespace Http {
+
+namespace {
+
+inline bool isValueChar(char c) {
+  const uint8_t byte = static_cast<uint8_t>(c);
+  return byte == '\t' || (byte >= 0x20 && byte != 0x7f);
+}
+
+#if defined(ENVOY_HEADER_CHARS_X86)
+
+// SSE2 is part of the x86-64 baseline, so the 16 byte versions need no runtime check. The 32 byte
+// AVX2 versions are only used for strings of at least 32 bytes on CPUs that support AVX2.
+//
+// All comparisons below are signed, so bytes of 0x80 and above are negative and fall outside of
+// every ASCII range.
+bool cpuHasAvx2() {
+  static const bool has_avx2 = __builtin_cpu_supports("avx2");
+  return has_avx2;
+}
+
+// Sets the lanes of letters, digits and '-', which make up nearly all header names in practice.
+// Blocks with other characters are checked with the lookup table.
+inline __m128i commonNameChars(__m128i v) {
+  const __m128i folded = _mm_or_si128(v, _mm_set1_epi8(0x20));
+  const __m128i letter = _mm_and_si128(_mm_cmpgt_epi8(folded, _mm_set1_epi8('a' - 1)),
+                                       _mm_cmplt_epi8(folded, _mm_set1_epi8('z' + 1)));
+  const __m128i digit = _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8('0' - 1)),
+                                      _mm_cmplt_epi8(v, _mm_set1_epi8('9' + 1)));
+  const __m128i dash = _mm_cmpeq_epi8(v, _mm_set1_epi8('-'));
+  return _mm_or_si128(_mm_or_si128(letter, digit), dash);
+}
+
+// Sets the lanes of field value characters. Unlike commonNameChars() this is exact.
+inline __m128i valueChars(__m128i v) {
+  const __m128i visible = _mm_andnot_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8(0x7f)),
+                                           _mm_cmpgt_epi8(v, _mm_set1_epi8(0x1f)));
+  const __m128i obs_text = _mm_cmplt_epi8(v, _mm_setzero_si128());
+  const __m128i tab = _mm_cmpeq_epi8(v, _mm_set1_epi8('\t'));
+  return _mm_or_si128(_mm_or_si128(visible, obs_text), tab);
+}
+
+inline __m128i lower(__m128i v) {
+  const __m128i upper = _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8('A' - 1)),
+                                      _mm_cmplt_epi8(v, _mm_set1_epi8('Z' + 1)));
+  return _mm_or_si128(v, _mm_and_si128(upper, _mm_set1_epi8(0x20)));
+}
+
+__attribute__((target("avx2"))) inline __m256i commonNameChars(__m256i v) {
+  const __m256i folded = _mm256_or_si256(v, _mm256_set1_epi8(0x20));
+  const __m256i letter = _mm256_and_si256(_mm256_cmpgt_epi8(folded, _mm256_set1_epi8('a' - 1)),
+                                          _mm256_cmpgt_epi8(_mm256_set1_epi8('z' + 1), folded));
+  const __m256i digit = _mm256_and_si256(_mm256_cmpgt_epi8(v, _mm256_set1_epi8('0' - 1)),
+                                         _mm256_cmpgt_epi8(_mm256_set1_epi8('9' + 1), v));
+  const __m256i dash = _mm256_cmpeq_epi8(v, _mm256_set1_epi8('-'));
+  return _mm256_or_si256(_mm256_or_si256(letter, digit), dash);
+}
+
+__attribute__((target("avx2"))) inline __m256i valueChars(__m256i v) {
+  const __m256i visible = _mm256_andnot_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8(0x7f)),
+                                              _mm256_cmpgt_epi8(v, _mm256_set1_epi8(0x1f)));
+  const __m256i obs_text = _mm256_cmpgt_epi8(_mm256_setzero_si256(), v);
+  const __m256i tab = _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\t'));
+  return _mm256_or_si256(_mm256_or_si256(visible, obs_text), tab);
+}
+
+__attribute__((target("avx2"))) inline __m256i lower(__m256i v) {
+  const __m256i upper = _mm256_and_si256(_mm256_cmpgt_epi8(v, _mm256_set1_epi8('A' - 1)),
+                                         _mm256_cmpgt_epi8(_mm256_set1_epi8('Z' + 1), v));
+  return _mm256_or_si256(v, _mm256_and_si256(upper, _mm256_set1_epi8(0x20)));
+}
+
+inline __m128i load8(const char* data) {
+  return _mm_loadl_epi64(reinterpret_cast<const __m128i*>(data));
+}
+inline __m128i load16(const char* data) {
+  return _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+}
+__attribute__((target("avx2"))) inline __m256i load32(const char* data) {
+  return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data));
+}
+
+inline bool allSet8(__m128i mask) { return (_mm_movemask_epi8(mask) & 0xff) == 0xff; }
+inline bool allSet16(__m128i mask) { return _mm_movemask_epi8(mask) == 0xffff; }
+__attribute__((target("avx2"))) inline bool allSet32(__m256i mask) {
+  return _mm256_movemask_epi8(mask) == -1;
+}
+
+// Strings that are not a multiple of the block size are finished with a last block that ends at
+// the end of the string and overlaps the previous block. Checking or lower casing a byte twice
+// gives the same result as doing it once.
+
+inline bool isValidName8(const char* block) {
+  return allSet8(commonNameChars(load8(block))) || HeaderChars::isValidNameScalar({block, 8});
+}
+inline bool isValidName16(const char* block) {
+  return allSet16(commonNameChars(load16(block))) || HeaderChars::isValidNameScalar({block, 16});
+}
+__attribute__((target("avx2"))) inline bool isValidName32(const char* block) {
+  return allSet32(commonNameChars(load32(block))) || HeaderChars::isValidNameScalar({block, 32});
+}
+
+bool isValidNameSse2(const char* data, size_t size) {
+  if (size < 8) {
+    return HeaderChars::isValidNameScalar({data, size});
+  }
+  if (size < 16) {
+    return isValidName8(data) && isValidName8(data + size - 8);
+  }
+  size_t i = 0;
+  for (; i + 16 <= size; i += 16) {
+    if (!isValidName16(data + i)) {
+      return false;
+    }
+  }
+  return i == size || isValidName16(data + size - 16);
+}
+
+__attribute__((target("avx2"))) bool isValidNameAvx2(const char* data, size_t size) {
+  size_t i = 0;
+  for (; i + 32 <= size; i += 32) {
+    if (!isValidName32(data + i)) {
+      return false;
+    }
+  }
+  return i == size || isValidName32(data + size - 32);
+}
+
+bool isValidValueSse2(const char* data, size_t size) {
+  if (size < 8) {
+    return HeaderChars::isValidValueScalar({data, size});
+  }
+  if (size < 16) {
+    return allSet8(_mm_and_si128(valueChars(load8(data)), valueChars(load8(data + size - 8))));
+  }
+  size_t i = 0;
+  for (; i + 16 <= size; i += 16) {
+    if (!allSet16(valueChars(load16(data + i)))) {
+      return false;
+    }
+  }
+  return i == size || allSet16(valueChars(load16(data + size - 16)));
+}
+
+__attribute__((target("avx2"))) bool isValidValueAvx2(const char* data, size_t size) {
+  size_t i = 0;
+  for (; i + 32 <= size; i += 32) {
+    if (!allSet32(valueChars(load32(data + i)))) {
+      return false;
+    }
+  }
+  return i == size || allSet32(valueChars(load32(data + size - 32)));
+}
+
+void toLowerSse2(char* data, size_t size) {
+  if (size < 8) {
+    HeaderChars::toLowerScalar(data, size);
+    return;
+  }
+  if (size < 16) {
+    const __m128i head = lower(load8(data));
+    const __m128i tail = lower(load8(data + size - 8));
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(data), head);
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(data + size - 8), tail);
+    return;
+  }
+  size_t i = 0;
+  for (; i + 16 <= size; i += 16) {
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(data + i), lower(load16(data + i)));
+  }
+  if (i != size) {
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(data + size - 16), lower(load16(data + size - 16)));
+  }
+}
+
+__attribute__((target("avx2"))) void toLowerAvx2(char* data, size_t size) {
+  size_t i = 0;
+  for (; i + 32 <= size; i += 32) {
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(data + i), lower(load32(data + i)));
+  }
+  if (i != size) {
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(data + size - 32),
+                        lower(load32(data + size - 32)));
+  }
+}
+
+#endif
+
+} // namespace
+
+bool HeaderChars::isValidName(absl::string_view name) {
+#if defined(ENVOY_HEADER_CHARS_X86)
+  if (name.size() >= 32 && cpuHasAvx2()) {
+    return isValidNameAvx2(name.data(), name.size());
+  }
+  return isValidNameSse2(name.data(), name.size());
+#else
+  return isValidNameScalar(name);
+#endif
+}
+
+bool HeaderChars::isValidValue(absl::string_view value) {
+#if defined(ENVOY_HEADER_CHARS_X86)
+  if (value.size() >= 32 && cpuHasAvx2()) {
+    return isValidValueAvx2(value.data(), value.size());
+  }
+  return isValidValueSse2(value.data(), value.size());
+#else
+  return isValidValueScalar(value);
+#endif
+}
+
+void HeaderChars::toLower(char* data, size_t size) {
+#if defined(ENVOY_HEADER_CHARS_X86)
+  if (size >= 32 && cpuHasAvx2()) {
+    toLowerAvx2(data, size);
+    return;
+  }
+  toLowerSse2(data, size);
+#else
+  toLowerScalar(data, size);
+#endif
+}
+
+bool HeaderChars::isValidNameScalar(absl::string_view name) {
+  bool is_valid = true;
+  for (const char c : name) {
+    is_valid &= testCharInTable(kGenericHeaderNameCharTable, c);
+  }
+  return is_valid;
+}
+
+bool HeaderChars::isValidValueScalar(absl::string_view value) {
+  bool is_valid = true;
+  for (const char c : value) {
+    is_valid &= isValueChar(c);
+  }
+  return is_valid;
+}
+
+void HeaderChars::toLowerScalar(char* data, size_t size) {
+  for (size_t i = 0; i < size; ++i) {
+    data[i] = absl::ascii_tolower(data[i]);
+  }
+}
+
+} // namespace Http
+} // namespace Envoy
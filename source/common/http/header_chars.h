@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstddef>
+
+#include "absl/strings/string_view.h"
+
+namespace Envoy {
+namespace Http {
+
+/**
+ * Character level checks and transformations of header names and values, which are applied to
+ * every header of every request and response. On x86-64 they process 16 bytes at a time with SSE2,
+ * or 32 bytes at a time with AVX2 if the CPU supports it. Other platforms use the scalar versions.
+ */
+class HeaderChars final {
+public:
+  /**
+   * @param name supplies the header name, without the ':' prefix of a pseudo header.
+   * @return true if every character is a token character as defined by RFC 9110. Upper case
+   *         characters are allowed.
+   */
+  static bool isValidName(absl::string_view name);
+
+  /**
+   * @param value supplies the header value.
+   * @return true if every character is a field value character as defined by RFC 9110, i.e. a
+   *         visible character, space, horizontal tab or obs-text.
+   */
+  static bool isValidValue(absl::string_view value);
+
+  /**
+   * Converts the upper case ASCII characters of a string to lower case in place.
+   * @param data supplies the string.
+   * @param size supplies the size of the string.
+   */
+  static void toLower(char* data, size_t size);
+
+  // Scalar versions of the above, used for short strings and by tests and benchmarks.
+  static bool isValidNameScalar(absl::string_view name);
+  static bool isValidValueScalar(absl::string_view value);
+  static void toLowerScalar(char* data, size_t size);
+};
+
+} // namespace Http
+} // namespace Envoy
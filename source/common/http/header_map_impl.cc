@@ -10,6 +10,8 @@
 #include "source/common/common/assert.h"
 #include "source/common/common/dump_state_utils.h"
 #include "source/common/common/empty_string.h"
+#include "source/common/http/header_chars.h"
+#include "source/common/runtime/runtime_features.h"
 #include "source/common/singleton/const_singleton.h"
 
 #include "absl/strings/match.h"
@@ -46,6 +48,12 @@ HeaderString::HeaderString(UnionString&& move_value) noexcept {
   ASSERT(valid());
 }
 
+void HeaderString::inlineToLower() {
+  ASSERT(type() == Type::Inline);
+  InlinedStringVector& buffer = getInVec(buffer_);
+  HeaderChars::toLower(buffer.data(), buffer.size());
+}
+
 // Specialization needed for HeaderMapImpl::HeaderList::insert() when key is LowerCaseString.
 // A fully specialized template must be defined once in the program, hence this may not be in
 // a header file.
@@ -53,6 +61,11 @@ template <> bool HeaderMapImpl::HeaderList::isPseudoHeader(const LowerCaseString
   return key.get().c_str()[0] == ':';
 }
 
+HeaderMapImpl::HeaderList::HeaderList()
+    : headers_(Runtime::httpStreamArenaEnabled() ? SlabAllocator<HeaderEntryImpl>(arena_)
+                                                 : SlabAllocator<HeaderEntryImpl>()),
+      pseudo_headers_end_(headers_.end()) {}
+
 bool HeaderMapImpl::HeaderList::maybeMakeMap() {
   if (lazy_map_.empty()) {
     if (headers_.size() < kMinHeadersForLazyMap) {
@@ -13,6 +13,7 @@
 
 #include "source/common/common/compiled_string_map.h"
 #include "source/common/common/non_copyable.h"
+#include "source/common/common/slab_allocator.h"
 #include "source/common/common/utility.h"
 #include "source/common/http/headers.h"
 
@@ -106,6 +107,8 @@ public:
   size_t removePrefix(const LowerCaseString& key);
   size_t size() const { return headers_.size(); }
   bool empty() const { return headers_.empty(); }
+  // Sizes the storage of an empty map for the supplied number of headers.
+  void reserve(size_t size) { headers_.reserve(size); }
   void dumpState(std::ostream& os, int indent_level = 0) const;
   StatefulHeaderKeyFormatterOptConstRef formatter() const {
     return StatefulHeaderKeyFormatterOptConstRef(makeOptRefFromPtr(formatter_.get()));
@@ -113,6 +116,10 @@ public:
   StatefulHeaderKeyFormatterOptRef formatter() { return makeOptRefFromPtr(formatter_.get()); }
 
 protected:
+  struct HeaderEntryImpl;
+  using HeaderEntryList = std::list<HeaderEntryImpl, SlabAllocator<HeaderEntryImpl>>;
+  using HeaderNode = HeaderEntryList::iterator;
+
   struct HeaderEntryImpl : public HeaderEntry, NonCopyable {
     HeaderEntryImpl(const LowerCaseString& key);
     HeaderEntryImpl(const LowerCaseString& key, HeaderString&& value);
@@ -128,9 +135,8 @@ protected:
 
     HeaderString key_;
     HeaderString value_;
-    std::list<HeaderEntryImpl>::iterator entry_;
+    HeaderNode entry_;
   };
-  using HeaderNode = std::list<HeaderEntryImpl>::iterator;
 
   /**
    * This is the static lookup table that is used to determine whether a header is one of the O(1)
@@ -197,6 +203,11 @@ protected:
    * access given a header key. Once the map is initialized, it will be used even
    * if the number of headers decreases below the threshold.
    *
+   * If envoy.reloadable_features.http_stream_arena is enabled, the list nodes are allocated from a
+   * few slabs owned by the list rather than one at a time from the heap, so that creating, copying
+   * and iterating a header map touches a few contiguous blocks of memory. Nodes never move, so the
+   * pointers to the O(1) headers stay valid.
+   *
    * Note: the internal iterators held in fields make this unsafe to copy and move, since the
    * reference to end() is not preserved across a move (see Notes in
    * https://en.cppreference.com/w/cpp/container/list/list). The NonCopyable will suppress both copy
@@ -209,7 +220,7 @@ protected:
     using HeaderNodeVector = absl::InlinedVector<HeaderNode, 1>;
     using HeaderLazyMap = absl::flat_hash_map<absl::string_view, HeaderNodeVector>;
 
-    HeaderList() : pseudo_headers_end_(headers_.end()) {}
+    HeaderList();
 
     template <class Key> bool isPseudoHeader(const Key& key) {
       return !key.getStringView().empty() && key.getStringView()[0] == ':';
@@ -299,16 +310,17 @@ protected:
      */
     size_t remove(absl::string_view key);
 
-    std::list<HeaderEntryImpl>::iterator begin() { return headers_.begin(); }
-    std::list<HeaderEntryImpl>::iterator end() { return headers_.end(); }
-    std::list<HeaderEntryImpl>::const_iterator begin() const { return headers_.begin(); }
-    std::list<HeaderEntryImpl>::const_iterator end() const { return headers_.end(); }
-    std::list<HeaderEntryImpl>::const_reverse_iterator rbegin() const { return headers_.rbegin(); }
-    std::list<HeaderEntryImpl>::const_reverse_iterator rend() const { return headers_.rend(); }
+    HeaderEntryList::iterator begin() { return headers_.begin(); }
+    HeaderEntryList::iterator end() { return headers_.end(); }
+    HeaderEntryList::const_iterator begin() const { return headers_.begin(); }
+    HeaderEntryList::const_iterator end() const { return headers_.end(); }
+    HeaderEntryList::const_reverse_iterator rbegin() const { return headers_.rbegin(); }
+    HeaderEntryList::const_reverse_iterator rend() const { return headers_.rend(); }
     HeaderLazyMap::iterator mapFind(absl::string_view key) { return lazy_map_.find(key); }
     HeaderLazyMap::iterator mapEnd() { return lazy_map_.end(); }
     size_t size() const { return headers_.size(); }
     bool empty() const { return headers_.empty(); }
+    void reserve(size_t size) { arena_.reserve(size); }
     void clear() {
       headers_.clear();
       pseudo_headers_end_ = headers_.end();
@@ -316,7 +328,10 @@ protected:
     }
 
   private:
-    std::list<HeaderEntryImpl> headers_;
+    // Must outlive headers_, whose nodes it holds. Unless reserve() sizes it, the first slab holds
+    // a single entry, so that small maps allocate no more than they would from the heap.
+    SlabArena arena_;
+    HeaderEntryList headers_;
     HeaderNode pseudo_headers_end_;
     HeaderLazyMap lazy_map_;
   };
@@ -672,6 +687,7 @@ template <class T> std::unique_ptr<T> createHeaderMap(const HeaderMap& rhs) {
   // We should revisit this to figure how to make this a bit safer as a non-intentional conversion
   // may have surprising results with different O(1) headers, implementations, etc.
   auto new_header_map = T::create();
+  new_header_map->reserve(rhs.size());
   HeaderMapImpl::copyFrom(*new_header_map, rhs);
   return new_header_map;
 }
@@ -6,7 +6,7 @@
 #include "source/common/common/matchers.h"
 #include "source/common/common/regex.h"
 #include "source/common/common/utility.h"
-#include "source/common/http/character_set_validation.h"
+#include "source/common/http/header_chars.h"
 #include "source/common/http/header_map_impl.h"
 #include "source/common/http/utility.h"
 #include "source/common/protobuf/utility.h"
@@ -20,7 +20,6 @@
 #ifdef ENVOY_ENABLE_HTTP_DATAGRAMS
 #include "quiche/common/structured_headers.h"
 #endif
-#include "quiche/http2/adapter/header_validator.h"
 
 namespace Envoy {
 namespace Http {
@@ -125,8 +124,7 @@ HeaderUtility::createHeaderData(const envoy::config::route::v3::HeaderMatcher& c
 }
 
 bool HeaderUtility::headerValueIsValid(const absl::string_view header_value) {
-  return http2::adapter::HeaderValidator::IsValidHeaderValue(header_value,
-                                                             http2::adapter::ObsTextOption::kAllow);
+  return HeaderChars::isValidValue(header_value);
 }
 
 bool HeaderUtility::headerNameIsValid(absl::string_view header_key) {
@@ -142,11 +140,7 @@ bool HeaderUtility::headerNameIsValid(absl::string_view header_key) {
   // However the HTTP/2 codec will NOT convert these to lowercase when serializing the
   // header map, thus producing an invalid request.
   // TODO(yanavlasov): make validation in HTTP/2 case stricter.
-  bool is_valid = true;
-  for (auto iter = header_key.begin(); iter != header_key.end() && is_valid; ++iter) {
-    is_valid &= testCharInTable(kGenericHeaderNameCharTable, *iter);
-  }
-  return is_valid;
+  return HeaderChars::isValidName(header_key);
 }
 
 bool HeaderUtility::headerNameContainsUnderscore(const absl::string_view header_name) {
@@ -1,5 +1,6 @@
 #include "source/common/http/http1/codec_impl.h"
 
+#include <algorithm>
 #include <cstdint>
 #include <memory>
 #include <string>
@@ -51,6 +52,7 @@ struct Http1ResponseCodeDetailValues {
   const absl::string_view ChunkedContentLength = "http1.content_length_and_chunked_not_allowed";
   const absl::string_view HttpsInPlaintext = "http1.https_url_on_plaintext_connection";
   const absl::string_view InvalidScheme = "http1.invalid_scheme";
+  const absl::string_view PipelinedUpgrade = "http1.pipelined_upgrade";
 };
 
 struct Http1HeaderTypesValues {
@@ -59,7 +61,7 @@ struct Http1HeaderTypesValues {
 };
 
 // Pipelining is generally not well supported on the internet and has a series of dangerous
-// overflow bugs. As such Envoy disabled it.
+// overflow bugs. As such Envoy disables it unless max_pipelined_requests is configured.
 static constexpr uint32_t kMaxOutboundResponses = 2;
 
 using Http1ResponseCodeDetails = ConstSingleton<Http1ResponseCodeDetailValues>;
@@ -118,7 +120,7 @@ StreamEncoderImpl::StreamEncoderImpl(ConnectionImpl& connection,
 void StreamEncoderImpl::encodeHeader(absl::string_view key, absl::string_view value) {
   ASSERT(!key.empty());
 
-  const uint64_t header_size = connection_.buffer().addFragments({key, COLON_SPACE, value, CRLF});
+  const uint64_t header_size = outputBuffer().addFragments({key, COLON_SPACE, value, CRLF});
 
   // There is no header field compression in HTTP/1.1, so the wire representation is the same as the
   // decompressed representation.
@@ -234,7 +236,7 @@ void StreamEncoderImpl::encodeHeadersBase(const RequestOrResponseHeaderMap& head
     }
   }
 
-  connection_.buffer().add(CRLF);
+  outputBuffer().add(CRLF);
 
   if (end_stream) {
     endEncode();
@@ -249,13 +251,13 @@ void StreamEncoderImpl::encodeData(Buffer::Instance& data, bool end_stream) {
   if (data.length() > 0) {
     if (chunk_encoding_) {
       std::string chunk_header = absl::StrCat(absl::Hex(data.length()), CRLF);
-      connection_.buffer().add(std::move(chunk_header));
+      outputBuffer().add(std::move(chunk_header));
     }
 
-    connection_.buffer().move(data);
+    outputBuffer().move(data);
 
     if (chunk_encoding_) {
-      connection_.buffer().add(CRLF);
+      outputBuffer().add(CRLF);
     }
   }
 
@@ -266,7 +268,20 @@ void StreamEncoderImpl::encodeData(Buffer::Instance& data, bool end_stream) {
   }
 }
 
+Buffer::Instance& StreamEncoderImpl::outputBuffer() {
+  return held_output_ != nullptr ? *held_output_ : connection_.buffer();
+}
+
 void StreamEncoderImpl::flushOutput(bool end_encode) {
+  if (held_output_ != nullptr) {
+    // The output is written once the responses to all earlier requests have been written. Count
+    // it now, as the stream may be complete by then.
+    const uint64_t added = held_output_->length() - held_output_counted_;
+    bytes_meter_->addWireBytesSent(added);
+    held_output_counted_ = held_output_->length();
+    connection_.onHeldOutputChanged(added, 0);
+    return;
+  }
   auto encoded_bytes = connection_.flushOutput(end_encode);
   bytes_meter_->addWireBytesSent(encoded_bytes);
 }
@@ -279,7 +294,7 @@ void StreamEncoderImpl::encodeTrailersBase(const HeaderMap& trailers) {
   // https://tools.ietf.org/html/rfc7230#section-4.4
   if (chunk_encoding_) {
     // Finalize the body
-    connection_.buffer().add(LAST_CHUNK);
+    outputBuffer().add(LAST_CHUNK);
 
     // TODO(mattklein123): Wire up the formatter if someone actually asks for this (very unlikely).
     trailers.iterate([this](const HeaderEntry& header) -> HeaderMap::Iterate {
@@ -288,7 +303,7 @@ void StreamEncoderImpl::encodeTrailersBase(const HeaderMap& trailers) {
       return HeaderMap::Iterate::Continue;
     });
 
-    connection_.buffer().add(CRLF);
+    outputBuffer().add(CRLF);
   }
 
   flushOutput();
@@ -301,7 +316,7 @@ void StreamEncoderImpl::encodeMetadata(const MetadataMapVector&) {
 
 void StreamEncoderImpl::endEncode() {
   if (chunk_encoding_) {
-    connection_.buffer().addFragments({LAST_CHUNK, CRLF});
+    outputBuffer().addFragments({LAST_CHUNK, CRLF});
   }
 
   flushOutput(true);
@@ -319,7 +334,7 @@ void StreamEncoderImpl::notifyEncodeComplete() {
   if (codec_callbacks_) {
     codec_callbacks_->onCodecEncodeComplete();
   }
-  connection_.onEncodeComplete();
+  connection_.onEncodeComplete(*this);
 }
 
 void ServerConnectionImpl::maybeAddSentinelBufferFragment(Buffer::Instance& output_buffer) {
@@ -331,7 +346,8 @@ void ServerConnectionImpl::maybeAddSentinelBufferFragment(Buffer::Instance& outp
   auto fragment =
       Buffer::OwnedBufferFragmentImpl::create(absl::string_view("", 0), response_buffer_releasor_);
   output_buffer.addBufferFragment(*fragment.release());
-  ASSERT(outbound_responses_ < kMaxOutboundResponses);
+  // With pipelining, the responses to all pipelined requests may be released at once.
+  ASSERT(outbound_responses_ < max_outbound_responses_ || pipeliningEnabled());
   outbound_responses_++;
 }
 
@@ -339,7 +355,7 @@ Status ServerConnectionImpl::doFloodProtectionChecks() const {
   ASSERT(dispatching_);
   // Before processing another request, make sure that we are below the response flood protection
   // threshold.
-  if (outbound_responses_ >= kMaxOutboundResponses) {
+  if (outbound_responses_ >= max_outbound_responses_) {
     ENVOY_CONN_LOG(trace, "error accepting request: too many pending responses queued",
                    connection_);
     stats_.response_flood_.inc();
@@ -399,6 +415,54 @@ void StreamEncoderImpl::readDisable(bool disable) {
 
 uint32_t StreamEncoderImpl::bufferLimit() const { return connection_.bufferLimit(); }
 
+void ResponseEncoderImpl::holdOutput() {
+  ASSERT(held_output_ == nullptr);
+  // The connection accounts for the held output of all its responses, see onHeldOutputChanged().
+  held_output_ = std::make_unique<Buffer::OwnedImpl>();
+  held_output_counted_ = 0;
+  connection_.stats().pipelined_responses_held_.inc();
+}
+
+void ResponseEncoderImpl::releaseHeldOutput(bool end_encode) {
+  if (held_output_ == nullptr) {
+    return;
+  }
+  connection_.stats().pipelined_responses_held_.dec();
+  // The bytes were already counted when they were encoded.
+  Buffer::InstancePtr held_output = std::move(held_output_);
+  connection_.buffer().move(*held_output);
+  onHeldOutputBelowLowWatermark();
+  connection_.onHeldOutputChanged(0, held_output_counted_);
+  connection_.flushOutput(end_encode);
+  if (!end_encode && connection_.connection().aboveHighWatermark()) {
+    runHighWatermarkCallbacks();
+  }
+}
+
+void ResponseEncoderImpl::discardHeldOutput() {
+  if (held_output_ != nullptr) {
+    connection_.stats().pipelined_responses_held_.dec();
+    held_output_.reset();
+    // The stream is reset, so its watermark callbacks no longer run.
+    held_output_above_high_watermark_ = false;
+    connection_.onHeldOutputChanged(0, held_output_counted_);
+  }
+}
+
+void ResponseEncoderImpl::onHeldOutputAboveHighWatermark() {
+  if (held_output_ != nullptr && !held_output_above_high_watermark_) {
+    held_output_above_high_watermark_ = true;
+    runHighWatermarkCallbacks();
+  }
+}
+
+void ResponseEncoderImpl::onHeldOutputBelowLowWatermark() {
+  if (held_output_above_high_watermark_) {
+    held_output_above_high_watermark_ = false;
+    runLowWatermarkCallbacks();
+  }
+}
+
 const Network::ConnectionInfoProvider& StreamEncoderImpl::connectionInfoProvider() {
   return connection_.connection().connectionInfoProvider();
 }
@@ -431,7 +495,7 @@ void ResponseEncoderImpl::encodeHeaders(const ResponseHeaderMap& headers, bool e
     reason_phrase = {status_string, status_string_len};
   }
 
-  connection_.buffer().addFragments(
+  outputBuffer().addFragments(
       {response_prefix, absl::StrCat(numeric_status), SPACE, reason_phrase, CRLF});
 
   if (numeric_status >= 300) {
@@ -494,7 +558,7 @@ Status RequestEncoderImpl::encodeHeaders(const RequestHeaderMap& headers, bool e
     std::string url = absl::StrCat(scheme->value().getStringView(), "://",
                                    host->value().getStringView(), path->value().getStringView());
     ENVOY_CONN_LOG(trace, "Sending fully qualified URL: {}", connection_.connection(), url);
-    connection_.buffer().addFragments(
+    outputBuffer().addFragments(
         {method->value().getStringView(), SPACE, url, REQUEST_POSTFIX});
   } else {
     absl::string_view host_or_path_view;
@@ -504,7 +568,7 @@ Status RequestEncoderImpl::encodeHeaders(const RequestHeaderMap& headers, bool e
       host_or_path_view = path->value().getStringView();
     }
 
-    connection_.buffer().addFragments(
+    outputBuffer().addFragments(
         {method->value().getStringView(), SPACE, host_or_path_view, REQUEST_POSTFIX});
   }
 
@@ -565,7 +629,7 @@ Status ConnectionImpl::completeCurrentHeader() {
     if (formatter.has_value()) {
       formatter->processKey(current_header_field_.getStringView());
     }
-    current_header_field_.inlineTransform([](char c) { return absl::ascii_tolower(c); });
+    current_header_field_.inlineToLower();
 
     headers_or_trailers.addViaMove(std::move(current_header_field_),
                                    std::move(current_header_value_));
@@ -1038,6 +1102,7 @@ void ServerConnectionImpl::dumpAdditionalState(std::ostream& os, int indent_leve
 
   DUMP_DETAILS(active_request_);
   os << '\n';
+  os << spaces << "pipelined_requests_.size(): " << pipelined_requests_.size() << '\n';
 
   // Dump header map, it may be null if it was moved to the request, and
   // request_url.
@@ -1081,6 +1146,9 @@ ServerConnectionImpl::ServerConnectionImpl(
       response_buffer_releasor_([this](const Buffer::OwnedBufferFragmentImpl* fragment) {
         releaseOutboundResponse(fragment);
       }),
+      // Allow the responses to a full pipeline to be queued in addition to the one being written.
+      max_outbound_responses_(std::max<uint64_t>(
+          kMaxOutboundResponses, uint64_t{settings.max_pipelined_requests_} + 1)),
       owned_output_buffer_(connection.dispatcher().getWatermarkFactory().createBuffer(
           [&]() -> void { this->onBelowLowWatermark(); },
           [&]() -> void { this->onAboveHighWatermark(); },
@@ -1103,12 +1171,49 @@ uint32_t ServerConnectionImpl::getHeadersSize() {
   return url_size + ConnectionImpl::getHeadersSize();
 }
 
-void ServerConnectionImpl::onEncodeComplete() {
-  if (active_request_->remote_complete_) {
-    // Only do this if remote is complete. If we are replying before the request is complete the
-    // only logical thing to do is for higher level code to reset() / close the connection so we
-    // leave the request around so that it can fire reset callbacks.
-    connection_.dispatcher().deferredDelete(std::move(active_request_));
+void ServerConnectionImpl::onEncodeComplete(StreamEncoderImpl& encoder) {
+  if (pipelined_requests_.empty()) {
+    ASSERT(&active_request_->response_encoder_ == &encoder);
+    active_request_->encode_complete_ = true;
+    if (active_request_->remote_complete_) {
+      // Only do this if remote is complete. If we are replying before the request is complete the
+      // only logical thing to do is for higher level code to reset() / close the connection so we
+      // leave the request around so that it can fire reset callbacks.
+      connection_.dispatcher().deferredDelete(std::move(active_request_));
+    }
+    return;
+  }
+
+  // The request being received is behind the pipelined requests, so its response is held until
+  // it is moved to the pipeline on message complete.
+  if (active_request_ != nullptr && &active_request_->response_encoder_ == &encoder) {
+    active_request_->encode_complete_ = true;
+    stats_.pipelined_responses_buffered_.inc();
+    return;
+  }
+
+  auto it = std::find_if(pipelined_requests_.begin(), pipelined_requests_.end(),
+                         [&encoder](const std::unique_ptr<ActiveRequest>& request) {
+                           return &request->response_encoder_ == &encoder;
+                         });
+  ASSERT(it != pipelined_requests_.end());
+  (*it)->encode_complete_ = true;
+  if (it != pipelined_requests_.begin()) {
+    stats_.pipelined_responses_buffered_.inc();
+    return;
+  }
+  releaseCompletedResponses();
+}
+
+void ServerConnectionImpl::releaseCompletedResponses() {
+  while (!pipelined_requests_.empty() && pipelined_requests_.front()->encode_complete_) {
+    connection_.dispatcher().deferredDelete(std::move(pipelined_requests_.front()));
+    pipelined_requests_.pop_front();
+
+    ActiveRequest* head = responseHead();
+    if (head != nullptr) {
+      head->response_encoder_.releaseHeldOutput(head->encode_complete_);
+    }
   }
 }
 
@@ -1206,6 +1311,14 @@ Envoy::StatusOr<CallbackResult> ServerConnectionImpl::onHeadersCompleteBase() {
     auto& headers = absl::get<RequestHeaderMapPtr>(headers_or_trailers_);
     ENVOY_CONN_LOG(trace, "Server: onHeadersComplete size={}", connection_, headers->size());
 
+    // An upgraded connection carries a different protocol once the upgrade has been responded to,
+    // so upgrades must wait for the responses to all earlier requests.
+    if (handling_upgrade_ && !pipelined_requests_.empty()) {
+      error_code_ = Http::Code::BadRequest;
+      RETURN_IF_ERROR(sendProtocolError(Http1ResponseCodeDetails::get().PipelinedUpgrade));
+      return codecProtocolError("http/1.1 protocol error: pipelined upgrade request");
+    }
+
     if (!handling_upgrade_ && headers->Connection()) {
       // If we fail to sanitize the request, return a 400 to the client
       if (!Utility::sanitizeConnectionHeader(*headers)) {
@@ -1233,6 +1346,12 @@ Envoy::StatusOr<CallbackResult> ServerConnectionImpl::onHeadersCompleteBase() {
     headers->setMethod(parser_->methodName());
     RETURN_IF_ERROR(checkProtocolVersion(*headers));
 
+    // The response to this request closes the connection, so later pipelined requests must not be
+    // processed.
+    if (pipeliningEnabled() && HeaderUtility::shouldCloseConnection(protocol_, *headers)) {
+      pipelining_stopped_ = true;
+    }
+
     // Make sure the host is valid.
     auto details = HeaderUtility::requestHeadersValid(*headers);
     if (details.has_value()) {
@@ -1269,6 +1388,14 @@ Status ServerConnectionImpl::onMessageBeginBase() {
   if (!resetStreamCalled()) {
     ASSERT(active_request_ == nullptr);
     active_request_ = std::make_unique<ActiveRequest>(*this, std::move(bytes_meter_before_stream_));
+    if (!pipelined_requests_.empty()) {
+      // The response must wait for the responses to the earlier requests.
+      stats_.pipelined_requests_.inc();
+      active_request_->response_encoder_.holdOutput();
+      if (held_output_above_high_watermark_) {
+        active_request_->response_encoder_.onHeldOutputAboveHighWatermark();
+      }
+    }
     active_request_->request_decoder_ = &callbacks_.newStream(active_request_->response_encoder_);
 
     // Check for pipelined request flood as we prepare to accept a new request.
@@ -1310,6 +1437,12 @@ Http::Status ServerConnectionImpl::dispatch(Buffer::Instance& data) {
     active_request_->response_encoder_.readDisable(true);
     return okStatus();
   }
+  if (pipeliningEnabled() && pipelinePaused()) {
+    // Likewise if the pipeline is full or no more requests are accepted. Reading is re-enabled
+    // once the response at the head of the pipeline is completed.
+    pipelined_requests_.front()->response_encoder_.readDisable(true);
+    return okStatus();
+  }
 
   Http::Status status = ConnectionImpl::dispatch(data);
 
@@ -1320,6 +1453,8 @@ Http::Status ServerConnectionImpl::dispatch(Buffer::Instance& data) {
     if (data.length() > 0) {
       active_request_->response_encoder_.readDisable(true);
     }
+  } else if (pipeliningEnabled() && pipelinePaused() && data.length() > 0) {
+    pipelined_requests_.front()->response_encoder_.readDisable(true);
   }
   return status;
 }
@@ -1346,16 +1481,38 @@ CallbackResult ServerConnectionImpl::onMessageCompleteBase() {
 
     // Reset to ensure no information from one requests persists to the next.
     headers_or_trailers_.emplace<RequestHeaderMapPtr>(nullptr);
+
+    // The response may have been completed while decoding.
+    if (active_request_ != nullptr && pipeliningEnabled()) {
+      pipelined_requests_.push_back(std::move(active_request_));
+      releaseCompletedResponses();
+    }
   }
 
-  // Always pause the parser so that the calling code can process 1 request at a time and apply
+  // With pipelining, keep parsing the next request until the pipeline is full, unless the
+  // connection is closed after this request.
+  if (pipeliningEnabled() && !pipelineFull() && !pipelining_stopped_ &&
+      connection_.state() == Network::Connection::State::Open) {
+    return CallbackResult::Success;
+  }
+
+  // Otherwise pause the parser so that the calling code can process 1 request at a time and apply
   // back pressure. However this means that the calling code needs to detect if there is more data
   // in the buffer and dispatch it again.
   return parser_->pause();
 }
 
 void ServerConnectionImpl::onResetStream(StreamResetReason reason) {
+  // There is no way to skip a response in HTTP/1, so resetting any stream resets all of them.
+  std::list<std::unique_ptr<ActiveRequest>> pipelined_requests;
+  pipelined_requests.swap(pipelined_requests_);
+  for (auto& request : pipelined_requests) {
+    request->response_encoder_.discardHeldOutput();
+    request->response_encoder_.runResetCallbacks(reason, absl::string_view());
+    connection_.dispatcher().deferredDelete(std::move(request));
+  }
   if (active_request_) {
+    active_request_->response_encoder_.discardHeldOutput();
     active_request_->response_encoder_.runResetCallbacks(reason, absl::string_view());
     connection_.dispatcher().deferredDelete(std::move(active_request_));
   }
@@ -1393,13 +1550,43 @@ Status ServerConnectionImpl::sendProtocolError(absl::string_view details) {
 }
 
 void ServerConnectionImpl::onAboveHighWatermark() {
-  if (active_request_) {
-    active_request_->response_encoder_.runHighWatermarkCallbacks();
+  ActiveRequest* head = responseHead();
+  if (head != nullptr) {
+    head->response_encoder_.runHighWatermarkCallbacks();
   }
 }
 void ServerConnectionImpl::onBelowLowWatermark() {
-  if (active_request_) {
-    active_request_->response_encoder_.runLowWatermarkCallbacks();
+  ActiveRequest* head = responseHead();
+  if (head != nullptr) {
+    head->response_encoder_.runLowWatermarkCallbacks();
+  }
+}
+
+void ServerConnectionImpl::onHeldOutputChanged(uint64_t added, uint64_t removed) {
+  ASSERT(held_output_bytes_ + added >= removed);
+  held_output_bytes_ = held_output_bytes_ + added - removed;
+  // The held output of all responses counts against one budget, the connection's buffer limit, so
+  // that a deep pipeline cannot buffer a full buffer limit per response.
+  const uint64_t high_watermark = bufferLimit();
+  if (high_watermark == 0) {
+    return;
+  }
+  if (!held_output_above_high_watermark_ && held_output_bytes_ > high_watermark) {
+    held_output_above_high_watermark_ = true;
+    for (auto& request : pipelined_requests_) {
+      request->response_encoder_.onHeldOutputAboveHighWatermark();
+    }
+    if (active_request_ != nullptr) {
+      active_request_->response_encoder_.onHeldOutputAboveHighWatermark();
+    }
+  } else if (held_output_above_high_watermark_ && held_output_bytes_ <= high_watermark / 2) {
+    held_output_above_high_watermark_ = false;
+    for (auto& request : pipelined_requests_) {
+      request->response_encoder_.onHeldOutputBelowLowWatermark();
+    }
+    if (active_request_ != nullptr) {
+      active_request_->response_encoder_.onHeldOutputBelowLowWatermark();
+    }
   }
 }
 
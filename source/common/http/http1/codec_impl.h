@@ -96,8 +96,18 @@ protected:
                          bool end_stream, bool bodiless_request);
   void encodeTrailersBase(const HeaderMap& headers);
 
+  /**
+   * @return the buffer to encode into. This is the connection's output buffer, unless the output
+   * is held back because this is the response to a pipelined request.
+   */
+  Buffer::Instance& outputBuffer();
+
   Buffer::BufferMemoryAccountSharedPtr buffer_memory_account_;
   ConnectionImpl& connection_;
+  // Output of a response that must wait for the responses to earlier pipelined requests.
+  Buffer::InstancePtr held_output_;
+  // The number of bytes of held_output_ that were already counted as sent.
+  uint64_t held_output_counted_{};
   uint32_t read_disable_calls_{};
   bool disable_chunk_encoding_ : 1;
   bool chunk_encoding_ : 1;
@@ -154,10 +164,42 @@ public:
     if (buffer_memory_account_) {
       buffer_memory_account_->clearDownstream();
     }
+    // The connection drops the requests it still tracks when it is destroyed, so it is not told
+    // about the discarded output here.
+    if (held_output_ != nullptr) {
+      connection_.stats().pipelined_responses_held_.dec();
+    }
   }
 
   bool startedResponse() { return started_response_; }
 
+  /**
+   * Holds back the output of the response until releaseHeldOutput() is called. The held output of
+   * all responses of the connection counts against the connection's buffer limit.
+   */
+  void holdOutput();
+
+  /**
+   * Writes any held output to the connection, and writes all further output directly.
+   * @param end_encode supplies whether the response has been completely encoded.
+   */
+  void releaseHeldOutput(bool end_encode);
+
+  /**
+   * Drops any held output, e.g. when the stream is reset.
+   */
+  void discardHeldOutput();
+
+  /**
+   * Runs the high watermark callbacks if output is held and they have not run for it yet.
+   */
+  void onHeldOutputAboveHighWatermark();
+
+  /**
+   * Runs the low watermark callbacks if the high watermark callbacks ran for the held output.
+   */
+  void onHeldOutputBelowLowWatermark();
+
   // Http::ResponseEncoder
   void encode1xxHeaders(const ResponseHeaderMap& headers) override;
   void encodeHeaders(const ResponseHeaderMap& headers, bool end_stream) override;
@@ -181,6 +223,8 @@ public:
 
 private:
   bool started_response_{};
+  // Set while the high watermark callbacks ran because of the held output of the connection.
+  bool held_output_above_high_watermark_{};
   const bool stream_error_on_invalid_http_message_;
 };
 
@@ -222,12 +266,24 @@ public:
   const Network::Connection& connection() const { return connection_; }
 
   /**
-   * Called when the active encoder has completed encoding the outbound half of the stream.
+   * Called when an encoder has completed encoding the outbound half of the stream.
+   * @param encoder supplies the encoder that has completed.
    */
-  virtual void onEncodeComplete() PURE;
+  virtual void onEncodeComplete(StreamEncoderImpl& encoder) PURE;
 
   virtual StreamInfo::BytesMeter& getBytesMeter() PURE;
 
+  /**
+   * Called when output held back by the response to a pipelined request is added or removed.
+   * All held output of a connection counts against the connection's buffer limit.
+   * @param added supplies the number of bytes that were added to the held output.
+   * @param removed supplies the number of bytes that were removed from the held output.
+   */
+  virtual void onHeldOutputChanged(uint64_t added, uint64_t removed) {
+    UNREFERENCED_PARAMETER(added);
+    UNREFERENCED_PARAMETER(removed);
+  }
+
   /**
    * Called when resetStream() has been called on an active stream. In HTTP/1.1 the only
    * valid operation after this point is for the connection to get blown away, but we will not
@@ -460,6 +516,9 @@ public:
                        Server::OverloadManager& overload_manager);
   bool supportsHttp10() override { return codec_settings_.accept_http_10_; }
 
+  // Http::ServerConnection
+  void closeAfterActiveStreams() override { pipelining_stopped_ = true; }
+
 protected:
   /**
    * An active HTTP/1.1 request.
@@ -475,6 +534,7 @@ protected:
     RequestDecoder* request_decoder_{};
     ResponseEncoderImpl response_encoder_;
     bool remote_complete_{};
+    bool encode_complete_{};
   };
   // ConnectionImpl
   CallbackResult onMessageCompleteBase() override;
@@ -498,7 +558,7 @@ private:
   Status onStatusBase(const char*, size_t) override { return okStatus(); }
   // ConnectionImpl
   Http::Status dispatch(Buffer::Instance& data) override;
-  void onEncodeComplete() override;
+  void onEncodeComplete(StreamEncoderImpl& encoder) override;
   StreamInfo::BytesMeter& getBytesMeter() override {
     if (active_request_) {
       return *(active_request_->response_encoder_.getStream().bytesMeter());
@@ -518,6 +578,7 @@ private:
   Status sendOverloadError();
   void onAboveHighWatermark() override;
   void onBelowLowWatermark() override;
+  void onHeldOutputChanged(uint64_t added, uint64_t removed) override;
   HeaderMap& headersOrTrailers() override {
     if (absl::holds_alternative<RequestHeaderMapPtr>(headers_or_trailers_)) {
       return *absl::get<RequestHeaderMapPtr>(headers_or_trailers_);
@@ -547,13 +608,39 @@ private:
   void maybeAddSentinelBufferFragment(Buffer::Instance& output_buffer) override;
 
   Status doFloodProtectionChecks() const;
+  bool pipeliningEnabled() const { return codec_settings_.max_pipelined_requests_ > 1; }
+  bool pipelineFull() const {
+    return pipelined_requests_.size() >= codec_settings_.max_pipelined_requests_;
+  }
+  // Returns whether parsing must wait for the responses to the pipelined requests.
+  bool pipelinePaused() const {
+    return !pipelined_requests_.empty() && (pipelineFull() || pipelining_stopped_);
+  }
+  // Returns the request whose response is written to the connection, if any.
+  ActiveRequest* responseHead() {
+    return pipelined_requests_.empty() ? active_request_.get() : pipelined_requests_.front().get();
+  }
+  // Removes the completed responses at the head of the pipeline and writes the output of the next
+  // response.
+  void releaseCompletedResponses();
   Status checkHeaderNameForUnderscores() override;
   Status checkProtocolVersion(RequestHeaderMap& headers);
 
   ServerConnectionCallbacks& callbacks_;
   std::unique_ptr<ActiveRequest> active_request_;
+  // Completely received requests that wait for their response to be written, in request order. Only
+  // used if pipelining is enabled, in which case active_request_ is the request being received.
+  std::list<std::unique_ptr<ActiveRequest>> pipelined_requests_;
+  // Set once a request asks for the connection to be closed, or once the connection is draining.
+  // No requests are parsed beyond that request.
+  bool pipelining_stopped_{};
   const Buffer::OwnedBufferFragmentImpl::Releasor response_buffer_releasor_;
   uint32_t outbound_responses_{};
+  const uint64_t max_outbound_responses_;
+  // The output held by all responses to pipelined requests, and whether it went above the
+  // connection's buffer limit without dropping below half of it since.
+  uint64_t held_output_bytes_{};
+  bool held_output_above_high_watermark_{};
   // Buffer used to encode the HTTP message before moving it to the network connection's output
   // buffer. This buffer is always allocated, never nullptr.
   Buffer::InstancePtr owned_output_buffer_;
@@ -605,7 +692,7 @@ private:
   Status onStatusBase(const char* data, size_t length) override;
   // ConnectionImpl
   Http::Status dispatch(Buffer::Instance& data) override;
-  void onEncodeComplete() override { encode_complete_ = true; }
+  void onEncodeComplete(StreamEncoderImpl&) override { encode_complete_ = true; }
   StreamInfo::BytesMeter& getBytesMeter() override {
     if (pending_response_.has_value()) {
       return *(pending_response_->encoder_.getStream().bytesMeter());
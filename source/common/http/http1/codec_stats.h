@@ -13,11 +13,14 @@ namespace Http1 {
 /**
  * All stats for the HTTP/1 codec. @see stats_macros.h
  */
-#define ALL_HTTP1_CODEC_STATS(COUNTER)                                                             \
+#define ALL_HTTP1_CODEC_STATS(COUNTER, GAUGE)                                                      \
   COUNTER(dropped_headers_with_underscores)                                                        \
   COUNTER(metadata_not_supported_error)                                                            \
+  COUNTER(pipelined_requests)                                                                      \
+  COUNTER(pipelined_responses_buffered)                                                            \
   COUNTER(requests_rejected_with_underscores_in_headers)                                           \
-  COUNTER(response_flood)
+  COUNTER(response_flood)                                                                          \
+  GAUGE(pipelined_responses_held, Accumulate)
 
 /**
  * Wrapper struct for the HTTP/1 codec stats. @see stats_macros.h
@@ -25,13 +28,15 @@ namespace Http1 {
 struct CodecStats : public ::Envoy::Http::HeaderValidatorStats {
   using AtomicPtr = Thread::AtomicPtr<CodecStats, Thread::AtomicPtrAllocMode::DeleteOnDestruct>;
 
-  CodecStats(ALL_HTTP1_CODEC_STATS(GENERATE_CONSTRUCTOR_COUNTER_PARAM)...)
+  CodecStats(ALL_HTTP1_CODEC_STATS(GENERATE_CONSTRUCTOR_COUNTER_PARAM,
+                                   GENERATE_CONSTRUCTOR_GAUGE_PARAM)...)
       : ::Envoy::Http::HeaderValidatorStats()
-            ALL_HTTP1_CODEC_STATS(GENERATE_CONSTRUCTOR_INIT_LIST) {}
+            ALL_HTTP1_CODEC_STATS(GENERATE_CONSTRUCTOR_INIT_LIST, GENERATE_CONSTRUCTOR_INIT_LIST) {}
 
   static CodecStats& atomicGet(AtomicPtr& ptr, Stats::Scope& scope) {
     return *ptr.get([&scope]() -> CodecStats* {
-      return new CodecStats{ALL_HTTP1_CODEC_STATS(POOL_COUNTER_PREFIX(scope, "http1."))};
+      return new CodecStats{ALL_HTTP1_CODEC_STATS(POOL_COUNTER_PREFIX(scope, "http1."),
+                                                  POOL_GAUGE_PREFIX(scope, "http1."))};
     });
   }
 
@@ -42,7 +47,7 @@ struct CodecStats : public ::Envoy::Http::HeaderValidatorStats {
   // TODO(yanavlasov): add corresponding counter for H/1 codec.
   void incMessagingError() override {}
 
-  ALL_HTTP1_CODEC_STATS(GENERATE_COUNTER_STRUCT)
+  ALL_HTTP1_CODEC_STATS(GENERATE_COUNTER_STRUCT, GENERATE_GAUGE_STRUCT)
 };
 
 } // namespace Http1
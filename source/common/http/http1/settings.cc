@@ -45,6 +45,7 @@ Http1Settings parseHttp1Settings(const envoy::config::core::v3::Http1ProtocolOpt
   }
 
   ret.allow_custom_methods_ = config.allow_custom_methods();
+  ret.max_pipelined_requests_ = PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, max_pipelined_requests, 0);
 
   return ret;
 }
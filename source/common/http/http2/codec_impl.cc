@@ -985,7 +985,8 @@ ConnectionImpl::ConnectionImpl(Network::Connection& connection, CodecStats& stat
           http2_options.override_stream_error_on_invalid_http_message().value()),
       protocol_constraints_(stats, http2_options), dispatching_(false), raised_goaway_(false),
       random_(random_generator),
-      last_received_data_time_(connection_.dispatcher().timeSource().monotonicTime()) {
+      last_received_data_time_(connection_.dispatcher().timeSource().monotonicTime()),
+      coalesce_writes_(http2_options.has_write_coalescing()) {
   if (http2_options.has_use_oghttp2_codec()) {
     use_oghttp2_library_ = http2_options.use_oghttp2_codec().value();
   } else {
@@ -1009,6 +1010,19 @@ ConnectionImpl::ConnectionImpl(Network::Connection& connection, CodecStats& stat
     // This call schedules the initial interval, with jitter.
     onKeepaliveResponse();
   }
+  if (coalesce_writes_) {
+    coalesce_max_bytes_ = PROTOBUF_GET_WRAPPED_OR_DEFAULT(http2_options.write_coalescing(),
+                                                          max_bytes, 64 * 1024);
+    coalesce_max_delay_ = std::chrono::milliseconds(
+        PROTOBUF_GET_MS_OR_DEFAULT(http2_options.write_coalescing(), max_delay, 0));
+    if (coalesce_max_delay_.count() > 0) {
+      coalesce_flush_timer_ =
+          connection.dispatcher().createTimer([this]() { flushCoalescedFrames(); });
+    } else {
+      coalesce_flush_callback_ =
+          connection.dispatcher().createSchedulableCallback([this]() { flushCoalescedFrames(); });
+    }
+  }
 }
 
 ConnectionImpl::~ConnectionImpl() {
@@ -1163,6 +1177,8 @@ void ConnectionImpl::goAway() {
     // Intended to check through coverage that this error case is tested
     return;
   }
+  // The connection is likely to be closed soon, so don't hold back the GOAWAY.
+  flushCoalescedFrames();
 }
 
 void ConnectionImpl::shutdownNotice() {
@@ -1172,6 +1188,7 @@ void ConnectionImpl::shutdownNotice() {
     // Intended to check through coverage that this error case is tested
     return;
   }
+  flushCoalescedFrames();
 }
 
 Status ConnectionImpl::protocolErrorForTest() {
@@ -1495,7 +1512,8 @@ Status ConnectionImpl::trackInboundFrames(int32_t stream_id, size_t length, uint
 
 ssize_t ConnectionImpl::onSend(const uint8_t* data, size_t length) {
   ENVOY_CONN_LOG(trace, "send data: bytes={}", connection_, length);
-  Buffer::OwnedImpl buffer;
+  Buffer::OwnedImpl transient;
+  Buffer::OwnedImpl& buffer = frameOutput(transient);
   addOutboundFrameFragment(buffer, data, length);
 
   // While the buffer is transient the fragment it contains will be moved into the
@@ -1505,10 +1523,46 @@ ssize_t ConnectionImpl::onSend(const uint8_t* data, size_t length) {
   // deleted before the codec object is deleted. This is presently guaranteed by the
   // destruction order of the Network::ConnectionImpl object where write_buffer_ is
   // destroyed before the filter_manager_ which owns the codec through Http::ConnectionManagerImpl.
-  connection_.write(buffer, false);
+  writeFrame(buffer);
   return length;
 }
 
+void ConnectionImpl::writeFrame(Buffer::OwnedImpl& output) {
+  if (!coalesce_writes_) {
+    connection_.write(output, false);
+    return;
+  }
+  ASSERT(&output == &coalesced_output_);
+  ++coalesced_frames_;
+  if (coalesced_output_.length() >= coalesce_max_bytes_) {
+    flushCoalescedFrames();
+  } else if (coalesce_flush_timer_ != nullptr) {
+    if (!coalesce_flush_timer_->enabled()) {
+      coalesce_flush_timer_->enableTimer(coalesce_max_delay_);
+    }
+  } else if (!coalesce_flush_callback_->enabled()) {
+    coalesce_flush_callback_->scheduleCallbackCurrentIteration();
+  }
+}
+
+void ConnectionImpl::flushCoalescedFrames() {
+  if (coalesced_frames_ == 0) {
+    return;
+  }
+  if (coalesce_flush_timer_ != nullptr) {
+    coalesce_flush_timer_->disableTimer();
+  } else {
+    coalesce_flush_callback_->cancel();
+  }
+  stats_.frames_per_write_.recordValue(coalesced_frames_);
+  coalesced_frames_ = 0;
+  if (connection_.state() == Network::Connection::State::Closed) {
+    coalesced_output_.drain(coalesced_output_.length());
+    return;
+  }
+  connection_.write(coalesced_output_, false);
+}
+
 Status ConnectionImpl::onStreamClose(StreamImpl* stream, uint32_t error_code) {
   if (stream) {
     const int32_t stream_id = stream->stream_id_;
@@ -1709,6 +1763,12 @@ Status ConnectionImpl::sendPendingFrames() {
     RETURN_IF_ERROR(sendPendingFrames());
   }
 
+  // Frames are not held back once the last stream is gone, as the connection may be closed
+  // right away.
+  if (active_streams_.empty()) {
+    flushCoalescedFrames();
+  }
+
   // After all pending frames have been written into the outbound buffer check if any of
   // protocol constraints had been violated.
   Status status = protocol_constraints_.checkOutboundFrameLimits();
@@ -1867,7 +1927,8 @@ bool ConnectionImpl::Http2Visitor::SendDataFrame(Http2StreamId stream_id,
                    stream_id);
     return false;
   }
-  Buffer::OwnedImpl output;
+  Buffer::OwnedImpl transient;
+  Buffer::OwnedImpl& output = connection_->frameOutput(transient);
   connection_->addOutboundFrameFragment(
       output, reinterpret_cast<const uint8_t*>(frame_header.data()), frame_header.size());
   if (!connection_->protocol_constraints_.checkOutboundFrameLimits().ok()) {
@@ -1878,7 +1939,7 @@ bool ConnectionImpl::Http2Visitor::SendDataFrame(Http2StreamId stream_id,
 
   connection_->stats_.pending_send_bytes_.sub(payload_length);
   output.move(*stream->pending_send_data_, payload_length);
-  connection_->connection_.write(output, false);
+  connection_->writeFrame(output);
   return true;
 }
 
@@ -788,6 +788,15 @@ private:
 
   // Adds buffer fragment for a new outbound frame to the supplied Buffer::OwnedImpl.
   void addOutboundFrameFragment(Buffer::OwnedImpl& output, const uint8_t* data, size_t length);
+  // Returns the buffer to serialize an outbound frame into. This is the coalescing buffer if
+  // writes are coalesced, or the supplied transient buffer otherwise.
+  Buffer::OwnedImpl& frameOutput(Buffer::OwnedImpl& transient) {
+    return coalesce_writes_ ? coalesced_output_ : transient;
+  }
+  // Writes a serialized frame to the connection, or schedules the write of the coalesced frames.
+  void writeFrame(Buffer::OwnedImpl& output);
+  // Writes all coalesced frames to the connection.
+  void flushCoalescedFrames();
   Status trackInboundFrames(int32_t stream_id, size_t length, uint8_t type, uint8_t flags,
                             uint32_t padding_length);
   void onKeepaliveResponse();
@@ -812,6 +821,15 @@ private:
   std::chrono::milliseconds keepalive_interval_;
   std::chrono::milliseconds keepalive_timeout_;
   uint32_t keepalive_interval_jitter_percent_;
+  // Write coalescing. The coalesced frames hold drain trackers that refer to
+  // protocol_constraints_, so the buffer must be destroyed first.
+  const bool coalesce_writes_;
+  uint32_t coalesce_max_bytes_{};
+  std::chrono::milliseconds coalesce_max_delay_{};
+  Buffer::OwnedImpl coalesced_output_;
+  uint32_t coalesced_frames_{};
+  Event::SchedulableCallbackPtr coalesce_flush_callback_;
+  Event::TimerPtr coalesce_flush_timer_;
 };
 
 /**
@@ -855,6 +873,9 @@ public:
                            headers_with_underscores_action,
                        Server::OverloadManager& overload_manager);
 
+  // Http::ServerConnection
+  void closeAfterActiveStreams() override {} // New streams are refused with GOAWAY instead.
+
 private:
   // ConnectionImpl
   ConnectionCallbacks& callbacks() override { return callbacks_; }
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <memory>
+
+#include "envoy/http/filter.h"
+
+namespace Envoy {
+namespace Http {
+
+/**
+ * Per-stream StreamDecoderFilter that forwards to a StatelessStreamDecoderFilter shared by all
+ * streams, passing it the callbacks of the stream.
+ */
+class StatelessStreamDecoderFilterAdapter : public StreamDecoderFilter {
+public:
+  explicit StatelessStreamDecoderFilterAdapter(StatelessStreamDecoderFilterSharedPtr filter)
+      : filter_(std::move(filter)) {}
+
+  // Http::StreamFilterBase
+  void onDestroy() override {}
+
+  // Http::StreamDecoderFilter
+  FilterHeadersStatus decodeHeaders(RequestHeaderMap& headers, bool end_stream) override {
+    return filter_->decodeHeaders(*callbacks_, headers, end_stream);
+  }
+  FilterDataStatus decodeData(Buffer::Instance& data, bool end_stream) override {
+    return filter_->decodeData(*callbacks_, data, end_stream);
+  }
+  FilterTrailersStatus decodeTrailers(RequestTrailerMap& trailers) override {
+    return filter_->decodeTrailers(*callbacks_, trailers);
+  }
+  void setDecoderFilterCallbacks(StreamDecoderFilterCallbacks& callbacks) override {
+    callbacks_ = &callbacks;
+  }
+
+private:
+  // Keeps the filter alive for the stream if its config is replaced meanwhile.
+  const StatelessStreamDecoderFilterSharedPtr filter_;
+  StreamDecoderFilterCallbacks* callbacks_{};
+};
+
+/**
+ * Per-stream StreamEncoderFilter that forwards to a StatelessStreamEncoderFilter shared by all
+ * streams, passing it the callbacks of the stream.
+ */
+class StatelessStreamEncoderFilterAdapter : public StreamEncoderFilter {
+public:
+  explicit StatelessStreamEncoderFilterAdapter(StatelessStreamEncoderFilterSharedPtr filter)
+      : filter_(std::move(filter)) {}
+
+  // Http::StreamFilterBase
+  void onDestroy() override {}
+
+  // Http::StreamEncoderFilter
+  Filter1xxHeadersStatus encode1xxHeaders(ResponseHeaderMap&) override {
+    return Filter1xxHeadersStatus::Continue;
+  }
+  FilterHeadersStatus encodeHeaders(ResponseHeaderMap& headers, bool end_stream) override {
+    return filter_->encodeHeaders(*callbacks_, headers, end_stream);
+  }
+  FilterDataStatus encodeData(Buffer::Instance& data, bool end_stream) override {
+    return filter_->encodeData(*callbacks_, data, end_stream);
+  }
+  FilterTrailersStatus encodeTrailers(ResponseTrailerMap& trailers) override {
+    return filter_->encodeTrailers(*callbacks_, trailers);
+  }
+  FilterMetadataStatus encodeMetadata(MetadataMap&) override {
+    return FilterMetadataStatus::Continue;
+  }
+  void setEncoderFilterCallbacks(StreamEncoderFilterCallbacks& callbacks) override {
+    callbacks_ = &callbacks;
+  }
+
+private:
+  // Keeps the filter alive for the stream if its config is replaced meanwhile.
+  const StatelessStreamEncoderFilterSharedPtr filter_;
+  StreamEncoderFilterCallbacks* callbacks_{};
+};
+
+} // namespace Http
+} // namespace Envoy
@@ -0,0 +1,58 @@
+#include "source/common/http/stream_arena_impl.h"
+
+#include <algorithm>
+
+#include "source/common/common/assert.h"
+
+namespace Envoy {
+namespace Http {
+
+StreamArenaImpl::StreamArenaImpl(uint32_t first_block_size, uint32_t max_block_size)
+    : next_block_size_(first_block_size), max_block_size_(max_block_size) {
+  ASSERT(first_block_size > 0 && first_block_size <= max_block_size);
+}
+
+StreamArenaImpl::~StreamArenaImpl() {
+  // Destructors are registered after their object has been constructed, so walking the list from
+  // its head destroys objects in the reverse order of construction.
+  while (destructors_ != nullptr) {
+    Destructor* destructor = destructors_;
+    destructors_ = destructor->next_;
+    destructor->destroy_(destructor->object_);
+  }
+}
+
+void* StreamArenaImpl::allocate(size_t size, size_t alignment) {
+  ASSERT(alignment > 0 && (alignment & (alignment - 1)) == 0 &&
+         alignment <= alignof(std::max_align_t));
+  if (size > max_block_size_ / 4) {
+    // A block of its own, so the remainder of the current block is not wasted.
+    blocks_.emplace_back(new char[size]);
+    return blocks_.back().get();
+  }
+  size_t padding = -reinterpret_cast<uintptr_t>(next_) & (alignment - 1);
+  if (next_ == nullptr || padding + size > static_cast<size_t>(end_ - next_)) {
+    next_ = addBlock(size);
+    padding = 0;
+  }
+  void* memory = next_ + padding;
+  next_ += padding + size;
+  return memory;
+}
+
+void StreamArenaImpl::addDestructor(void* object, void (*destroy)(void*)) {
+  destructors_ = new (allocate(sizeof(Destructor), alignof(Destructor)))
+      Destructor{object, destroy, destructors_};
+}
+
+char* StreamArenaImpl::addBlock(size_t size) {
+  const size_t block_size = std::max<size_t>(next_block_size_, size);
+  blocks_.emplace_back(new char[block_size]);
+  next_block_size_ = std::min(next_block_size_ * 2, max_block_size_);
+  char* block = blocks_.back().get();
+  end_ = block + block_size;
+  return block;
+}
+
+} // namespace Http
+} // namespace Envoy
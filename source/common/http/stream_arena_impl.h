@@ -0,0 +1,91 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+#include "envoy/http/stream_arena.h"
+
+#include "source/common/common/non_copyable.h"
+
+#include "absl/container/inlined_vector.h"
+
+namespace Envoy {
+namespace Http {
+
+/**
+ * StreamArena that hands out memory from blocks of growing size. The first block is only allocated
+ * on first use, so an arena that is never used costs no allocation. Allocations larger than a
+ * quarter of the maximum block size get a block of their own.
+ */
+class StreamArenaImpl : public StreamArena, NonCopyable {
+public:
+  /**
+   * @param first_block_size supplies the size in bytes of the first block. Every further block is
+   *        twice the size of the previous one, up to max_block_size.
+   * @param max_block_size supplies the maximum size in bytes of a block.
+   */
+  explicit StreamArenaImpl(uint32_t first_block_size = 1024, uint32_t max_block_size = 16384);
+  ~StreamArenaImpl() override;
+
+  // StreamArena
+  void* allocate(size_t size, size_t alignment) override;
+  void addDestructor(void* object, void (*destroy)(void*)) override;
+
+  /**
+   * @return the number of blocks allocated.
+   */
+  size_t blocks() const { return blocks_.size(); }
+
+private:
+  struct Destructor {
+    void* object_;
+    void (*destroy_)(void*);
+    Destructor* next_;
+  };
+
+  char* addBlock(size_t size);
+
+  absl::InlinedVector<std::unique_ptr<char[]>, 4> blocks_;
+  Destructor* destructors_{nullptr};
+  char* next_{nullptr};
+  char* end_{nullptr};
+  uint32_t next_block_size_;
+  const uint32_t max_block_size_;
+};
+
+/**
+ * Deleter for objects that are either heap allocated or constructed in a StreamArena. Objects in
+ * an arena are only destroyed, as their memory is released with the arena.
+ */
+template <class T> struct StreamArenaDeleter {
+  void operator()(T* object) const {
+    if (in_arena_) {
+      object->~T();
+    } else {
+      delete object;
+    }
+  }
+
+  bool in_arena_{false};
+};
+
+template <class T> using StreamArenaPtr = std::unique_ptr<T, StreamArenaDeleter<T>>;
+
+/**
+ * Constructs an object in the supplied arena, or on the heap if there is no arena. The returned
+ * pointer must be destroyed before the arena.
+ */
+template <class T, class... Args>
+StreamArenaPtr<T> makeStreamArenaPtr(StreamArena* arena, Args&&... args) {
+  if (arena == nullptr) {
+    return StreamArenaPtr<T>(new T(std::forward<Args>(args)...));
+  }
+  return StreamArenaPtr<T>(new (arena->allocate(sizeof(T), alignof(T)))
+                               T(std::forward<Args>(args)...),
+                           StreamArenaDeleter<T>{true});
+}
+
+} // namespace Http
+} // namespace Envoy
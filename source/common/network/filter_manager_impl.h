@@ -156,6 +156,9 @@ private:
       parent_.host_description_ = host;
     }
     bool startUpstreamSecureTransport() override { return parent_.startUpstreamSecureTransport(); }
+    bool soleFilter() override {
+      return parent_.upstream_filters_.size() == 1 && parent_.downstream_filters_.empty();
+    }
 
     FilterManagerImpl& parent_;
     ReadFilterSharedPtr filter_;
@@ -31,6 +31,9 @@ public:
   void onUnderlyingConnectionAboveWriteBufferHighWatermark() override;
   void onUnderlyingConnectionBelowWriteBufferLowWatermark() override;
 
+  // Http::ServerConnection
+  void closeAfterActiveStreams() override {} // New streams are refused with GOAWAY instead.
+
   EnvoyQuicServerSession& quicServerSession() { return quic_server_session_; }
 
 private:
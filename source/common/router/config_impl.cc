@@ -1761,6 +1761,15 @@ VirtualHostImpl::VirtualHostImpl(const envoy::config::route::v3::VirtualHost& vi
       SET_AND_RETURN_IF_NOT_OK(route_or_error.status(), creation_status);
       routes_.emplace_back(route_or_error.value());
     }
+
+    if (Runtime::runtimeFeatureEnabled("envoy.reloadable_features.compiled_route_table")) {
+      auto route_index = std::make_unique<RouteIndex>();
+      for (uint32_t i = 0; i < routes_.size(); ++i) {
+        const RouteEntryImplBase& route = *routes_[i];
+        route_index->addRoute(i, route.matchType(), route.matcher(), route.case_sensitive());
+      }
+      route_index_ = std::move(route_index);
+    }
   }
 }
 
@@ -1801,6 +1810,52 @@ RouteConstSharedPtr VirtualHostImpl::getRouteFromRoutes(
   return nullptr;
 }
 
+RouteConstSharedPtr VirtualHostImpl::getRouteFromIndex(const RouteCallback& cb,
+                                                       const Http::RequestHeaderMap& headers,
+                                                       const StreamInfo::StreamInfo& stream_info,
+                                                       uint64_t random_value) const {
+  ASSERT(route_index_ != nullptr && headers.Path() != nullptr);
+
+  // Derive the lookup key the same way the prefix and path matchers do.
+  absl::string_view path = Http::PathUtil::removeQueryAndFragment(headers.getPathValue());
+  if (shared_virtual_host_->globalRouteConfig().ignorePathParametersInPathMatching()) {
+    path = path.substr(0, path.find_first_of(';'));
+  }
+
+  RouteIndex::Candidates candidates;
+  route_index_->findCandidates(path, candidates);
+
+  for (const uint32_t index : candidates) {
+    RouteConstSharedPtr route_entry = routes_[index]->matches(headers, stream_info, random_value);
+    if (route_entry == nullptr) {
+      continue;
+    }
+
+    if (cb == nullptr) {
+      return route_entry;
+    }
+
+    // Routes that were skipped by the index can never match this request, so the evaluation
+    // status is reported relative to the full route list to keep callbacks behaving exactly as
+    // they would with a linear scan.
+    RouteEvalStatus eval_status = (index + 1 == routes_.size()) ? RouteEvalStatus::NoMoreRoutes
+                                                                 : RouteEvalStatus::HasMoreRoutes;
+    RouteMatchStatus match_status = cb(route_entry, eval_status);
+    if (match_status == RouteMatchStatus::Accept) {
+      return route_entry;
+    }
+    if (match_status == RouteMatchStatus::Continue &&
+        eval_status == RouteEvalStatus::NoMoreRoutes) {
+      ENVOY_LOG(debug,
+                "return null when route match status is Continue but there is no more routes");
+      return nullptr;
+    }
+  }
+
+  ENVOY_LOG(debug, "route was resolved but final route list did not match incoming request");
+  return nullptr;
+}
+
 RouteConstSharedPtr VirtualHostImpl::getRouteFromEntries(const RouteCallback& cb,
                                                          const Http::RequestHeaderMap& headers,
                                                          const StreamInfo::StreamInfo& stream_info,
@@ -1850,40 +1905,24 @@ RouteConstSharedPtr VirtualHostImpl::getRouteFromEntries(const RouteCallback& cb
     return nullptr;
   }
 
-  // Check for a route that matches the request.
+  // Check for a route that matches the request. Requests without a path can only be matched by
+  // CONNECT routes, which are always evaluated linearly.
+  if (route_index_ != nullptr && headers.Path() != nullptr) {
+    return getRouteFromIndex(cb, headers, stream_info, random_value);
+  }
   return getRouteFromRoutes(cb, headers, stream_info, random_value, routes_);
 }
 
-const VirtualHostImpl* RouteMatcher::findWildcardVirtualHost(
-    absl::string_view host, const RouteMatcher::WildcardVirtualHosts& wildcard_virtual_hosts,
-    RouteMatcher::SubstringFunction substring_function) const {
-  // We do a longest wildcard match against the host that's passed in
-  // (e.g. "foo-bar.baz.com" should match "*-bar.baz.com" before matching "*.baz.com" for suffix
-  // wildcards). This is done by scanning the length => wildcards map looking for every wildcard
-  // whose size is < length.
-  for (const auto& iter : wildcard_virtual_hosts) {
-    const uint32_t wildcard_length = iter.first;
-    const auto& wildcard_map = iter.second;
-    // >= because *.foo.com shouldn't match .foo.com.
-    if (wildcard_length >= host.size()) {
-      continue;
-    }
-    const auto match = wildcard_map.find(substring_function(host, wildcard_length));
-    if (match != wildcard_map.end()) {
-      return match->second.get();
-    }
-  }
-  return nullptr;
-}
 absl::StatusOr<std::unique_ptr<RouteMatcher>>
 RouteMatcher::create(const envoy::config::route::v3::RouteConfiguration& route_config,
                      const CommonConfigSharedPtr& global_route_config,
                      Server::Configuration::ServerFactoryContext& factory_context,
-                     ProtobufMessage::ValidationVisitor& validator, bool validate_clusters) {
+                     ProtobufMessage::ValidationVisitor& validator, bool validate_clusters,
+                     const RouteMatcher* previous_matcher, bool hash_virtual_hosts) {
   absl::Status creation_status = absl::OkStatus();
-  auto ret = std::unique_ptr<RouteMatcher>{new RouteMatcher(route_config, global_route_config,
-                                                            factory_context, validator,
-                                                            validate_clusters, creation_status)};
+  auto ret = std::unique_ptr<RouteMatcher>{
+      new RouteMatcher(route_config, global_route_config, factory_context, validator,
+                       validate_clusters, previous_matcher, hash_virtual_hosts, creation_status)};
   RETURN_IF_NOT_OK(creation_status);
   return ret;
 }
@@ -1891,16 +1930,37 @@ RouteMatcher::RouteMatcher(const envoy::config::route::v3::RouteConfiguration& r
                            const CommonConfigSharedPtr& global_route_config,
                            Server::Configuration::ServerFactoryContext& factory_context,
                            ProtobufMessage::ValidationVisitor& validator, bool validate_clusters,
+                           const RouteMatcher* previous_matcher, bool hash_virtual_hosts,
                            absl::Status& creation_status)
     : vhost_scope_(factory_context.scope().scopeFromStatName(
           factory_context.routerContext().virtualClusterStatNames().vhost_)),
       ignore_port_in_host_matching_(route_config.ignore_port_in_host_matching()),
       vhost_header_(route_config.vhost_header()) {
+  ASSERT(previous_matcher == nullptr || hash_virtual_hosts);
   for (const auto& virtual_host_config : route_config.virtual_hosts()) {
-    VirtualHostImplSharedPtr virtual_host = std::make_shared<VirtualHostImpl>(
-        virtual_host_config, global_route_config, factory_context, *vhost_scope_, validator,
-        validate_clusters, creation_status);
-    SET_AND_RETURN_IF_NOT_OK(creation_status, creation_status);
+    VirtualHostImplSharedPtr virtual_host;
+    uint64_t virtual_host_hash = 0;
+    if (hash_virtual_hosts) {
+      virtual_host_hash = MessageUtil::hash(virtual_host_config);
+      if (previous_matcher != nullptr) {
+        const auto it = previous_matcher->virtual_hosts_by_hash_.find(virtual_host_hash);
+        if (it != previous_matcher->virtual_hosts_by_hash_.end()) {
+          virtual_host = it->second;
+        }
+      }
+    }
+    if (virtual_host != nullptr) {
+      reused_virtual_hosts_++;
+    } else {
+      virtual_host = std::make_shared<VirtualHostImpl>(virtual_host_config, global_route_config,
+                                                       factory_context, *vhost_scope_, validator,
+                                                       validate_clusters, creation_status);
+      SET_AND_RETURN_IF_NOT_OK(creation_status, creation_status);
+      rebuilt_virtual_hosts_++;
+    }
+    if (hash_virtual_hosts) {
+      virtual_hosts_by_hash_.emplace(virtual_host_hash, virtual_host);
+    }
     for (const std::string& domain_name : virtual_host_config.domains()) {
       const Http::LowerCaseString lower_case_domain_name(domain_name);
       absl::string_view domain = lower_case_domain_name;
@@ -1913,13 +1973,10 @@ RouteMatcher::RouteMatcher(const envoy::config::route::v3::RouteConfiguration& r
         }
         default_virtual_host_ = virtual_host;
       } else if (!domain.empty() && '*' == domain[0]) {
-        duplicate_found = !wildcard_virtual_host_suffixes_[domain.size() - 1]
-                               .emplace(domain.substr(1), virtual_host)
-                               .second;
+        duplicate_found = !wildcard_virtual_host_suffixes_.add(domain.substr(1), virtual_host);
       } else if (!domain.empty() && '*' == domain[domain.size() - 1]) {
-        duplicate_found = !wildcard_virtual_host_prefixes_[domain.size() - 1]
-                               .emplace(domain.substr(0, domain.size() - 1), virtual_host)
-                               .second;
+        duplicate_found = !wildcard_virtual_host_prefixes_.add(
+            domain.substr(0, domain.size() - 1), virtual_host);
       } else {
         duplicate_found = !virtual_hosts_.emplace(domain, virtual_host).second;
       }
@@ -1974,19 +2031,15 @@ const VirtualHostImpl* RouteMatcher::findVirtualHost(const Http::RequestHeaderMa
     return iter->second.get();
   }
   if (!wildcard_virtual_host_suffixes_.empty()) {
-    const VirtualHostImpl* vhost = findWildcardVirtualHost(
-        host, wildcard_virtual_host_suffixes_,
-        [](absl::string_view h, int l) -> absl::string_view { return h.substr(h.size() - l); });
+    const VirtualHostImplSharedPtr* vhost = wildcard_virtual_host_suffixes_.find(host);
     if (vhost != nullptr) {
-      return vhost;
+      return vhost->get();
     }
   }
   if (!wildcard_virtual_host_prefixes_.empty()) {
-    const VirtualHostImpl* vhost = findWildcardVirtualHost(
-        host, wildcard_virtual_host_prefixes_,
-        [](absl::string_view h, int l) -> absl::string_view { return h.substr(0, l); });
+    const VirtualHostImplSharedPtr* vhost = wildcard_virtual_host_prefixes_.find(host);
     if (vhost != nullptr) {
-      return vhost;
+      return vhost->get();
     }
   }
   return default_virtual_host_.get();
@@ -2121,25 +2174,70 @@ create(const envoy::config::route::v3::RouteConfiguration& config,
 absl::StatusOr<std::shared_ptr<ConfigImpl>>
 ConfigImpl::create(const envoy::config::route::v3::RouteConfiguration& config,
                    Server::Configuration::ServerFactoryContext& factory_context,
-                   ProtobufMessage::ValidationVisitor& validator, bool validate_clusters_default) {
+                   ProtobufMessage::ValidationVisitor& validator, bool validate_clusters_default,
+                   const ConfigImpl* previous_config) {
   absl::Status creation_status = absl::OkStatus();
-  auto ret = std::shared_ptr<ConfigImpl>(new ConfigImpl(
-      config, factory_context, validator, validate_clusters_default, creation_status));
+  auto ret = std::shared_ptr<ConfigImpl>(new ConfigImpl(config, factory_context, validator,
+                                                        validate_clusters_default, creation_status,
+                                                        previous_config));
   RETURN_IF_NOT_OK(creation_status);
   return ret;
 }
 
+namespace {
+
+// Hashes everything in the route configuration except for the virtual hosts, i.e. everything
+// that is captured by CommonConfigImpl.
+uint64_t hashWithoutVirtualHosts(const envoy::config::route::v3::RouteConfiguration& config) {
+  std::vector<const Protobuf::FieldDescriptor*> fields;
+  config.GetReflection()->ListFields(config, &fields);
+  Protobuf::FieldMask field_mask;
+  for (const Protobuf::FieldDescriptor* field : fields) {
+    if (field->number() != envoy::config::route::v3::RouteConfiguration::kVirtualHostsFieldNumber) {
+      field_mask.add_paths(field->name());
+    }
+  }
+  envoy::config::route::v3::RouteConfiguration without_virtual_hosts;
+  ProtobufUtil::FieldMaskUtil::MergeMessageTo(config, field_mask,
+                                              ProtobufUtil::FieldMaskUtil::MergeOptions(),
+                                              &without_virtual_hosts);
+  return MessageUtil::hash(without_virtual_hosts);
+}
+
+} // namespace
+
 ConfigImpl::ConfigImpl(const envoy::config::route::v3::RouteConfiguration& config,
                        Server::Configuration::ServerFactoryContext& factory_context,
                        ProtobufMessage::ValidationVisitor& validator,
-                       bool validate_clusters_default, absl::Status& creation_status) {
-  auto config_or_error = CommonConfigImpl::create(config, factory_context, validator);
-  SET_AND_RETURN_IF_NOT_OK(config_or_error.status(), creation_status);
-  shared_config_ = std::move(config_or_error.value());
+                       bool validate_clusters_default, absl::Status& creation_status,
+                       const ConfigImpl* previous_config) {
+  const bool validate_clusters =
+      PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, validate_clusters, validate_clusters_default);
+
+  // Virtual hosts validate the clusters they refer to when they are built, so they are only
+  // reused when cluster validation is disabled, which is the default for RDS.
+  const RouteMatcher* previous_matcher = nullptr;
+  if (!validate_clusters &&
+      Runtime::runtimeFeatureEnabled(
+          "envoy.reloadable_features.rds_reuse_unchanged_virtual_hosts")) {
+    shared_config_hash_ = hashWithoutVirtualHosts(config);
+    // Virtual hosts hold on to the shared config they were built with, so they can only be reused
+    // if the shared config is unchanged as well.
+    if (previous_config != nullptr && previous_config->shared_config_hash_ == shared_config_hash_) {
+      shared_config_ = previous_config->shared_config_;
+      previous_matcher = previous_config->route_matcher_.get();
+    }
+  }
+
+  if (shared_config_ == nullptr) {
+    auto config_or_error = CommonConfigImpl::create(config, factory_context, validator);
+    SET_AND_RETURN_IF_NOT_OK(config_or_error.status(), creation_status);
+    shared_config_ = std::move(config_or_error.value());
+  }
 
-  auto matcher_or_error = RouteMatcher::create(
-      config, shared_config_, factory_context, validator,
-      PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, validate_clusters, validate_clusters_default));
+  auto matcher_or_error =
+      RouteMatcher::create(config, shared_config_, factory_context, validator, validate_clusters,
+                           previous_matcher, shared_config_hash_.has_value());
   SET_AND_RETURN_IF_NOT_OK(matcher_or_error.status(), creation_status);
   route_matcher_ = std::move(matcher_or_error.value());
 }
@@ -34,8 +34,10 @@
 #include "source/common/router/metadatamatchcriteria_impl.h"
 #include "source/common/router/per_filter_config.h"
 #include "source/common/router/retry_policy_impl.h"
+#include "source/common/router/route_index.h"
 #include "source/common/router/router_ratelimit.h"
 #include "source/common/router/tls_context_match_criteria_impl.h"
+#include "source/common/router/wildcard_domain_trie.h"
 #include "source/common/stats/symbol_table.h"
 
 #include "absl/container/node_hash_map.h"
@@ -384,12 +386,23 @@ public:
 private:
   enum class SslRequirements : uint8_t { None, ExternalOnly, All };
 
+  /**
+   * Same as getRouteFromRoutes() over routes_, but only evaluates the routes returned by the
+   * compiled route_index_ for the request path.
+   */
+  RouteConstSharedPtr getRouteFromIndex(const RouteCallback& cb,
+                                        const Http::RequestHeaderMap& headers,
+                                        const StreamInfo::StreamInfo& stream_info,
+                                        uint64_t random_value) const;
+
   CommonVirtualHostSharedPtr shared_virtual_host_;
 
   std::shared_ptr<const SslRedirectRoute> ssl_redirect_route_;
   SslRequirements ssl_requirements_;
 
   std::vector<RouteEntryImplBaseConstSharedPtr> routes_;
+  // Only set when the envoy.reloadable_features.compiled_route_table runtime feature is enabled.
+  std::unique_ptr<const RouteIndex> route_index_;
   Matcher::MatchTreeSharedPtr<Http::HttpMatchingData> matcher_;
 };
 
@@ -1192,47 +1205,53 @@ DECLARE_FACTORY(RouteListMatchActionFactory);
  */
 class RouteMatcher {
 public:
+  /**
+   * @param previous_matcher supplies an optional matcher built from a previous version of the
+   *        route configuration with the same global_route_config. Virtual hosts of the previous
+   *        matcher whose configuration is unchanged are reused instead of being rebuilt.
+   * @param hash_virtual_hosts supplies whether to record the hash of every virtual host so that
+   *        this matcher can be used as the previous_matcher of a later matcher.
+   */
   static absl::StatusOr<std::unique_ptr<RouteMatcher>>
   create(const envoy::config::route::v3::RouteConfiguration& config,
          const CommonConfigSharedPtr& global_route_config,
          Server::Configuration::ServerFactoryContext& factory_context,
-         ProtobufMessage::ValidationVisitor& validator, bool validate_clusters);
+         ProtobufMessage::ValidationVisitor& validator, bool validate_clusters,
+         const RouteMatcher* previous_matcher = nullptr, bool hash_virtual_hosts = false);
 
   VirtualHostRoute route(const RouteCallback& cb, const Http::RequestHeaderMap& headers,
                          const StreamInfo::StreamInfo& stream_info, uint64_t random_value) const;
 
   const VirtualHostImpl* findVirtualHost(const Http::RequestHeaderMap& headers) const;
 
+  uint32_t rebuiltVirtualHosts() const { return rebuilt_virtual_hosts_; }
+  uint32_t reusedVirtualHosts() const { return reused_virtual_hosts_; }
+
 private:
   RouteMatcher(const envoy::config::route::v3::RouteConfiguration& config,
                const CommonConfigSharedPtr& global_route_config,
                Server::Configuration::ServerFactoryContext& factory_context,
                ProtobufMessage::ValidationVisitor& validator, bool validate_clusters,
+               const RouteMatcher* previous_matcher, bool hash_virtual_hosts,
                absl::Status& creation_status);
 
-  using WildcardVirtualHosts =
-      std::map<int64_t, absl::node_hash_map<std::string, VirtualHostImplSharedPtr>, std::greater<>>;
-  using SubstringFunction = std::function<absl::string_view(absl::string_view, int)>;
-  const VirtualHostImpl* findWildcardVirtualHost(absl::string_view host,
-                                                 const WildcardVirtualHosts& wildcard_virtual_hosts,
-                                                 SubstringFunction substring_function) const;
+  using WildcardVirtualHosts = WildcardDomainTrie<VirtualHostImplSharedPtr>;
   bool ignorePortInHostMatching() const { return ignore_port_in_host_matching_; }
 
   Stats::ScopeSharedPtr vhost_scope_;
   absl::node_hash_map<std::string, VirtualHostImplSharedPtr> virtual_hosts_;
-  // std::greater as a minor optimization to iterate from more to less specific
-  //
-  // A note on using an unordered_map versus a vector of (string, VirtualHostImplSharedPtr) pairs:
-  //
-  // Based on local benchmarks, each vector entry costs around 20ns for recall and (string)
-  // comparison with a fixed cost of about 25ns. For unordered_map, the empty map costs about 65ns
-  // and climbs to about 110ns once there are any entries.
-  //
-  // The break-even is 4 entries.
-  WildcardVirtualHosts wildcard_virtual_host_suffixes_;
-  WildcardVirtualHosts wildcard_virtual_host_prefixes_;
+  // Wildcard domains are resolved with one trie walk per wildcard kind, which yields the longest
+  // matching wildcard (e.g. "foo-bar.baz.com" matches "*-bar.baz.com" before "*.baz.com")
+  // without hashing every candidate substring of the host.
+  WildcardVirtualHosts wildcard_virtual_host_suffixes_{WildcardVirtualHosts::Direction::Backward};
+  WildcardVirtualHosts wildcard_virtual_host_prefixes_{WildcardVirtualHosts::Direction::Forward};
 
   VirtualHostImplSharedPtr default_virtual_host_;
+  // Virtual hosts keyed by the hash of their configuration, only populated when the matcher was
+  // created with hash_virtual_hosts.
+  absl::flat_hash_map<uint64_t, VirtualHostImplSharedPtr> virtual_hosts_by_hash_;
+  uint32_t rebuilt_virtual_hosts_{0};
+  uint32_t reused_virtual_hosts_{0};
   const bool ignore_port_in_host_matching_{false};
   const Http::LowerCaseString vhost_header_;
 };
@@ -1314,10 +1333,17 @@ private:
  */
 class ConfigImpl : public Config {
 public:
+  /**
+   * @param previous_config supplies an optional config built from a previous version of the route
+   *        configuration. When the envoy.reloadable_features.rds_reuse_unchanged_virtual_hosts
+   *        runtime feature is enabled and only virtual hosts changed between the two versions,
+   *        the unchanged virtual hosts of previous_config are shared with the new config.
+   */
   static absl::StatusOr<std::shared_ptr<ConfigImpl>>
   create(const envoy::config::route::v3::RouteConfiguration& config,
          Server::Configuration::ServerFactoryContext& factory_context,
-         ProtobufMessage::ValidationVisitor& validator, bool validate_clusters_default);
+         ProtobufMessage::ValidationVisitor& validator, bool validate_clusters_default,
+         const ConfigImpl* previous_config = nullptr);
 
   bool virtualHostExists(const Http::RequestHeaderMap& headers) const {
     return route_matcher_->findVirtualHost(headers) != nullptr;
@@ -1356,15 +1382,27 @@ public:
     return shared_config_->typedMetadata();
   }
 
+  /**
+   * @return the number of virtual hosts built when creating this config.
+   */
+  uint32_t rebuiltVirtualHosts() const { return route_matcher_->rebuiltVirtualHosts(); }
+  /**
+   * @return the number of virtual hosts reused from the previous config when creating this config.
+   */
+  uint32_t reusedVirtualHosts() const { return route_matcher_->reusedVirtualHosts(); }
+
 protected:
   ConfigImpl(const envoy::config::route::v3::RouteConfiguration& config,
              Server::Configuration::ServerFactoryContext& factory_context,
              ProtobufMessage::ValidationVisitor& validator, bool validate_clusters_default,
-             absl::Status& creation_status);
+             absl::Status& creation_status, const ConfigImpl* previous_config = nullptr);
 
 private:
   CommonConfigSharedPtr shared_config_;
   std::unique_ptr<RouteMatcher> route_matcher_;
+  // Hash of the route configuration without its virtual hosts. Only set when virtual host reuse
+  // is enabled for this config.
+  absl::optional<uint64_t> shared_config_hash_;
 };
 
 /**
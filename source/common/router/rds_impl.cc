@@ -50,7 +50,8 @@ RdsRouteConfigSubscription::RdsRouteConfigSubscription(
                                       manager_identifier, factory_context, stat_prefix + "rds.",
                                       "RDS", route_config_provider_manager, creation_status),
       config_update_info_(static_cast<RouteConfigUpdateReceiver*>(
-          Rds::RdsRouteConfigSubscription::config_update_info_.get())) {}
+          Rds::RdsRouteConfigSubscription::config_update_info_.get())),
+      virtual_host_stats_({ALL_RDS_VIRTUAL_HOST_STATS(POOL_COUNTER(*scope_))}) {}
 
 RdsRouteConfigSubscription::~RdsRouteConfigSubscription() { config_update_info_.release(); }
 
@@ -132,14 +133,18 @@ absl::Status RdsRouteConfigProviderImpl::onConfigUpdate() {
     return status;
   }
 
+  const auto config =
+      std::static_pointer_cast<const ConfigImpl>(config_update_info_->parsedConfiguration());
+  RdsVirtualHostStats& virtual_host_stats = subscription().virtualHostStats();
+  virtual_host_stats.vhost_rebuilt_.add(config->rebuiltVirtualHosts());
+  virtual_host_stats.vhost_reused_.add(config->reusedVirtualHosts());
+
   const auto aliases = config_update_info_->resourceIdsInLastVhdsUpdate();
   // Regular (non-VHDS) RDS updates don't populate aliases fields in resources.
   if (aliases.empty()) {
     return absl::OkStatus();
   }
 
-  const auto config =
-      std::static_pointer_cast<const ConfigImpl>(config_update_info_->parsedConfiguration());
   // Notifies connections that RouteConfiguration update has been propagated.
   // Callbacks processing is performed in FIFO order. The callback is skipped if alias used in
   // the VHDS update request do not match the aliases in the update response
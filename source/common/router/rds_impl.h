@@ -22,6 +22,7 @@
 #include "envoy/service/discovery/v3/discovery.pb.h"
 #include "envoy/singleton/instance.h"
 #include "envoy/stats/scope.h"
+#include "envoy/stats/stats_macros.h"
 #include "envoy/thread_local/thread_local.h"
 
 #include "source/common/common/callback_impl.h"
@@ -49,6 +50,20 @@ namespace Router {
 // For friend class declaration in RdsRouteConfigSubscription.
 class ScopedRdsConfigSubscription;
 
+/**
+ * All RDS virtual host stats. @see stats_macros.h
+ */
+#define ALL_RDS_VIRTUAL_HOST_STATS(COUNTER)                                                        \
+  COUNTER(vhost_rebuilt)                                                                           \
+  COUNTER(vhost_reused)
+
+/**
+ * Struct definition for all RDS virtual host stats. @see stats_macros.h
+ */
+struct RdsVirtualHostStats {
+  ALL_RDS_VIRTUAL_HOST_STATS(GENERATE_COUNTER_STRUCT)
+};
+
 /**
  * A class that fetches the route configuration dynamically using the RDS API and updates them to
  * RDS config providers.
@@ -67,6 +82,7 @@ public:
   ~RdsRouteConfigSubscription() override;
 
   RouteConfigUpdatePtr& routeConfigUpdate() { return config_update_info_; }
+  RdsVirtualHostStats& virtualHostStats() { return virtual_host_stats_; }
   void updateOnDemand(const std::string& aliases);
   void maybeCreateInitManager(const std::string& version_info,
                               std::unique_ptr<Init::ManagerImpl>& init_manager,
@@ -95,6 +111,7 @@ private:
   VhdsSubscriptionPtr vhds_subscription_;
   RouteConfigUpdatePtr config_update_info_;
   Common::CallbackManager<absl::Status> update_callback_manager_;
+  RdsVirtualHostStats virtual_host_stats_;
 
   // Access to addUpdateCallback
   friend class ScopedRdsConfigSubscription;
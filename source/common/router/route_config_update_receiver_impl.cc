@@ -50,6 +50,18 @@ ConfigTraitsImpl::createConfig(const Protobuf::Message& rc,
       std::shared_ptr<ConfigImpl>);
 }
 
+Rds::ConfigConstSharedPtr ConfigTraitsImpl::createConfigFromPrevious(
+    const Protobuf::Message& rc, Server::Configuration::ServerFactoryContext& factory_context,
+    bool validate_clusters_default, const Rds::ConfigConstSharedPtr& previous_config) const {
+  ASSERT(dynamic_cast<const envoy::config::route::v3::RouteConfiguration*>(&rc));
+  // The previous config is a NullConfigImpl until the first update has been applied.
+  const auto* previous = dynamic_cast<const ConfigImpl*>(previous_config.get());
+  return THROW_OR_RETURN_VALUE(
+      ConfigImpl::create(static_cast<const envoy::config::route::v3::RouteConfiguration&>(rc),
+                         factory_context, validator_, validate_clusters_default, previous),
+      std::shared_ptr<ConfigImpl>);
+}
+
 bool RouteConfigUpdateReceiverImpl::onRdsUpdate(const Protobuf::Message& rc,
                                                 const std::string& version_info) {
   uint64_t new_hash = base_.getHash(rc);
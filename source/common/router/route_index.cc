@@ -0,0 +1,83 @@
+#include "source/common/router/route_index.h"
+
+#include <algorithm>
+
+#include "source/common/common/assert.h"
+
+#include "absl/strings/ascii.h"
+
+namespace Envoy {
+namespace Router {
+
+void RouteIndex::Table::add(uint32_t index, PathMatchType match_type, absl::string_view key) {
+  empty_ = false;
+  if (match_type == PathMatchType::Exact) {
+    exact_[std::string(key)].push_back(index);
+    return;
+  }
+
+  ASSERT(match_type == PathMatchType::Prefix || match_type == PathMatchType::PathSeparatedPrefix);
+  auto [it, inserted] = prefix_buckets_.try_emplace(std::string(key));
+  it->second.push_back(index);
+  if (inserted) {
+    prefixes_.add(key, &it->second);
+  }
+}
+
+void RouteIndex::Table::findCandidates(absl::string_view path, Candidates& candidates) const {
+  if (empty_) {
+    return;
+  }
+
+  const auto exact = exact_.find(path);
+  if (exact != exact_.end()) {
+    candidates.insert(candidates.end(), exact->second.begin(), exact->second.end());
+  }
+
+  // Path separated prefixes are returned for every matching prefix, the path segment boundary is
+  // checked by the route itself.
+  for (const Bucket* bucket : prefixes_.findMatchingPrefixes(path)) {
+    candidates.insert(candidates.end(), bucket->begin(), bucket->end());
+  }
+}
+
+void RouteIndex::addRoute(uint32_t index, PathMatchType match_type, absl::string_view matcher,
+                          bool case_sensitive) {
+  ASSERT(size_ == 0 || index > last_index_);
+  last_index_ = index;
+  size_++;
+
+  switch (match_type) {
+  case PathMatchType::Prefix:
+  case PathMatchType::Exact:
+  case PathMatchType::PathSeparatedPrefix:
+    if (case_sensitive) {
+      case_sensitive_.add(index, match_type, matcher);
+    } else {
+      case_insensitive_.add(index, match_type, absl::AsciiStrToLower(matcher));
+    }
+    return;
+  case PathMatchType::None:
+  case PathMatchType::Regex:
+  case PathMatchType::Template:
+    unindexed_.push_back(index);
+    return;
+  }
+  PANIC_DUE_TO_CORRUPT_ENUM;
+}
+
+void RouteIndex::findCandidates(absl::string_view path, Candidates& candidates) const {
+  const size_t start = candidates.size();
+  candidates.insert(candidates.end(), unindexed_.begin(), unindexed_.end());
+  case_sensitive_.findCandidates(path, candidates);
+  if (!case_insensitive_.empty_) {
+    case_insensitive_.findCandidates(absl::AsciiStrToLower(path), candidates);
+  }
+
+  // Every bucket is sorted and every route lives in exactly one bucket, so a sort restores the
+  // original route order without duplicates.
+  std::sort(candidates.begin() + start, candidates.end());
+}
+
+} // namespace Router
+} // namespace Envoy
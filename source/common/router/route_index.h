@@ -0,0 +1,89 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "envoy/router/router.h"
+
+#include "source/common/common/radix_tree.h"
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/container/inlined_vector.h"
+#include "absl/container/node_hash_map.h"
+#include "absl/strings/string_view.h"
+
+namespace Envoy {
+namespace Router {
+
+/**
+ * A compiled index over the path matchers of an ordered route list. Prefix, exact path and path
+ * separated prefix matchers are grouped into a radix tree and a hash table keyed by the matcher
+ * string, so that the set of routes whose path criterion may accept a request can be found in
+ * time proportional to the length of the path rather than the number of routes. All other matcher
+ * types (regex, URI template, CONNECT) are kept in an "unindexed" list and are always returned as
+ * candidates.
+ *
+ * The index only narrows down the routes that need to be evaluated; it never decides a match.
+ * Callers still run the full route predicate (headers, query parameters, runtime, etc.) for each
+ * candidate, in ascending route order, which preserves first-match semantics.
+ */
+class RouteIndex {
+public:
+  using Candidates = absl::InlinedVector<uint32_t, 16>;
+
+  /**
+   * Adds the route at position index of the route list. Routes must be added in ascending index
+   * order.
+   * @param index supplies the position of the route in the route list.
+   * @param match_type supplies the path match type of the route.
+   * @param matcher supplies the prefix or path the route matches on, if any.
+   * @param case_sensitive supplies whether the path matcher of the route is case sensitive.
+   */
+  void addRoute(uint32_t index, PathMatchType match_type, absl::string_view matcher,
+                bool case_sensitive);
+
+  /**
+   * Finds the routes that may match the given path.
+   * @param path supplies the request path with the query string and fragment removed. The path
+   *        must have been sanitized the same way the route matchers sanitize it.
+   * @param candidates supplies the output vector. The indices of the routes that may match are
+   *        appended in ascending order.
+   */
+  void findCandidates(absl::string_view path, Candidates& candidates) const;
+
+  /**
+   * @return the number of routes which are evaluated on every lookup.
+   */
+  size_t unindexedRoutes() const { return unindexed_.size(); }
+
+  /**
+   * @return the total number of routes added to the index.
+   */
+  size_t size() const { return size_; }
+
+private:
+  using Bucket = std::vector<uint32_t>;
+
+  struct Table {
+    void add(uint32_t index, PathMatchType match_type, absl::string_view key);
+    void findCandidates(absl::string_view path, Candidates& candidates) const;
+
+    // Prefix and path separated prefix routes keyed by their prefix. The bucket storage lives in
+    // prefix_buckets_ so that the tree can hold stable raw pointers.
+    RadixTree<const Bucket*> prefixes_;
+    absl::node_hash_map<std::string, Bucket> prefix_buckets_;
+    // Exact path routes keyed by their path.
+    absl::flat_hash_map<std::string, Bucket> exact_;
+    bool empty_{true};
+  };
+
+  Table case_sensitive_;
+  Table case_insensitive_;
+  Bucket unindexed_;
+  uint32_t last_index_{0};
+  uint32_t size_{0};
+};
+
+} // namespace Router
+} // namespace Envoy
@@ -0,0 +1,178 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "source/common/common/assert.h"
+
+#include "absl/container/inlined_vector.h"
+#include "absl/strings/string_view.h"
+
+namespace Envoy {
+namespace Router {
+
+/**
+ * A path compressed character trie used to resolve wildcard virtual host domains. Suffix
+ * wildcards ("*.foo.com", "*-bar.foo.com") are stored in a Direction::Backward trie which walks the
+ * host from its last character, and prefix wildcards ("foo.*") in a Direction::Forward trie which
+ * walks the host from its first character.
+ *
+ * The longest matching wildcard is resolved in a single pass over the host, without allocating and
+ * without hashing substrings of the host.
+ *
+ * Template parameter Value must be default-constructible, moveable and convertible to bool.
+ */
+template <class Value> class WildcardDomainTrie {
+public:
+  enum class Direction { Forward, Backward };
+
+  explicit WildcardDomainTrie(Direction direction) : direction_(direction) {
+    // The root node, which never holds a value.
+    nodes_.emplace_back();
+  }
+
+  /**
+   * Adds a wildcard domain with the wildcard character already stripped, e.g. ".foo.com" for
+   * "*.foo.com" or "foo." for "foo.*".
+   * @param key supplies the non-wildcard part of the domain.
+   * @param value supplies the value associated with the key.
+   * @return false if a value already exists for the key, in which case the trie is not modified.
+   */
+  bool add(absl::string_view key, Value value) {
+    ASSERT(!key.empty());
+    std::string search(key);
+    if (direction_ == Direction::Backward) {
+      std::reverse(search.begin(), search.end());
+    }
+    return insert(search, std::move(value));
+  }
+
+  /**
+   * Finds the value of the longest key which matches the host. As a wildcard must match at least
+   * one character, keys as long as the host itself are ignored.
+   * @param host supplies the lower cased host.
+   * @return a pointer to the value of the longest matching key, or nullptr if none match.
+   */
+  const Value* find(absl::string_view host) const {
+    const Value* best = nullptr;
+    const Node* node = &nodes_[0];
+    size_t pos = 0;
+
+    while (true) {
+      if (node->value_ && pos < host.size()) {
+        best = &node->value_;
+      }
+      if (pos >= host.size()) {
+        break;
+      }
+
+      const Node* child = findChild(*node, charAt(host, pos));
+      if (child == nullptr || host.size() - pos < child->fragment_.size()) {
+        break;
+      }
+      for (size_t i = 1; i < child->fragment_.size(); ++i) {
+        if (child->fragment_[i] != charAt(host, pos + i)) {
+          return best;
+        }
+      }
+      pos += child->fragment_.size();
+      node = child;
+    }
+    return best;
+  }
+
+  /**
+   * @return true if no keys were added to the trie.
+   */
+  bool empty() const { return nodes_.size() == 1; }
+
+private:
+  struct Node {
+    // Characters of the edge leading to this node, in traversal order.
+    std::string fragment_;
+    Value value_{};
+    // Indices of the child nodes in nodes_. The fragments of the children all start with a
+    // different character.
+    absl::InlinedVector<uint32_t, 2> children_;
+  };
+
+  char charAt(absl::string_view host, size_t pos) const {
+    return direction_ == Direction::Forward ? host[pos] : host[host.size() - 1 - pos];
+  }
+
+  const Node* findChild(const Node& node, char c) const {
+    for (const uint32_t child : node.children_) {
+      if (nodes_[child].fragment_[0] == c) {
+        return &nodes_[child];
+      }
+    }
+    return nullptr;
+  }
+
+  uint32_t newNode(std::string fragment) {
+    nodes_.emplace_back();
+    nodes_.back().fragment_ = std::move(fragment);
+    return nodes_.size() - 1;
+  }
+
+  // Nodes are referenced by index as inserting may reallocate nodes_.
+  bool insert(absl::string_view search, Value value) {
+    uint32_t current = 0;
+    while (!search.empty()) {
+      uint32_t child = 0;
+      bool found = false;
+      for (const uint32_t index : nodes_[current].children_) {
+        if (nodes_[index].fragment_[0] == search[0]) {
+          child = index;
+          found = true;
+          break;
+        }
+      }
+
+      if (!found) {
+        const uint32_t leaf = newNode(std::string(search));
+        nodes_[leaf].value_ = std::move(value);
+        nodes_[current].children_.push_back(leaf);
+        return true;
+      }
+
+      const absl::string_view fragment = nodes_[child].fragment_;
+      size_t common = 0;
+      while (common < fragment.size() && common < search.size() &&
+             fragment[common] == search[common]) {
+        common++;
+      }
+
+      if (common < fragment.size()) {
+        // Split the edge: the new intermediate node takes over the common part of the fragment.
+        const uint32_t split = newNode(std::string(fragment.substr(0, common)));
+        nodes_[child].fragment_.erase(0, common);
+        nodes_[split].children_.push_back(child);
+        for (uint32_t& index : nodes_[current].children_) {
+          if (index == child) {
+            index = split;
+            break;
+          }
+        }
+        child = split;
+      }
+
+      current = child;
+      search.remove_prefix(common);
+    }
+
+    if (nodes_[current].value_) {
+      return false;
+    }
+    nodes_[current].value_ = std::move(value);
+    return true;
+  }
+
+  const Direction direction_;
+  std::vector<Node> nodes_;
+};
+
+} // namespace Router
+} // namespace Envoy
@@ -197,6 +197,27 @@ FALSE_RUNTIME_GUARD(envoy_reloadable_features_reject_early_connect_data);
 // Flip back to true once performance aligns with nghttp2 and
 // https://github.com/envoyproxy/envoy/issues/40070 is resolved.
 FALSE_RUNTIME_GUARD(envoy_reloadable_features_http2_use_oghttp2);
+// Evaluate virtual host routes through a compiled path index instead of a linear scan. Flip to
+// true once the index has been validated against large production route tables.
+FALSE_RUNTIME_GUARD(envoy_reloadable_features_compiled_route_table);
+// Share unchanged virtual hosts between successive RDS/VHDS route configurations instead of
+// rebuilding every virtual host on each update.
+FALSE_RUNTIME_GUARD(envoy_reloadable_features_rds_reuse_unchanged_virtual_hosts);
+// Cache buffer slice storage in a bounded per-dispatcher pool. Flip to true once the memory
+// retained by idle workers has been evaluated.
+FALSE_RUNTIME_GUARD(envoy_reloadable_features_buffer_slice_pool);
+// Allocate the HTTP filter wrappers of a stream from the per-stream arena, and the entries of each
+// header map from slabs owned by the map, instead of one heap allocation each.
+FALSE_RUNTIME_GUARD(envoy_reloadable_features_http_stream_arena);
+// Serve all file access logs from one shared flush thread fed by per-worker lock-free rings and
+// flushed with a single vectored write, instead of one flush thread and lock per file.
+FALSE_RUNTIME_GUARD(envoy_reloadable_features_shared_access_log_flush_thread);
+// Keep the weighted schedulers of client side weighted round robin worker load balancers when
+// host weights are updated, instead of rebuilding them. This changes the pick sequences.
+FALSE_RUNTIME_GUARD(envoy_reloadable_features_client_side_weighted_round_robin_in_place_weights);
+// Create the host sets and load balancer of a subset of the subset load balancer when a request is
+// first routed to it, instead of when the subset is created by a host update.
+FALSE_RUNTIME_GUARD(envoy_reloadable_features_subset_lb_lazy_subsets);
 
 // Block of non-boolean flags. Use of int flags is deprecated. Do not add more.
 ABSL_FLAG(uint64_t, re2_max_program_size_error_level, 100, ""); // NOLINT
@@ -277,6 +298,10 @@ bool runtimeFeatureEnabled(absl::string_view feature) {
   return flag->TryGet<bool>().value();
 }
 
+bool httpStreamArenaEnabled() {
+  return absl::GetFlag(FLAGS_envoy_reloadable_features_http_stream_arena);
+}
+
 uint64_t getInteger(absl::string_view feature, uint64_t default_value) {
   // DO NOT ADD MORE FLAGS HERE. This function deprecated.
   if (absl::StartsWith(feature, "re2.")) {
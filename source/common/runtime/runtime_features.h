@@ -18,6 +18,10 @@ bool isRuntimeFeature(absl::string_view feature);
 bool isLegacyRuntimeFeature(absl::string_view feature);
 
 bool runtimeFeatureEnabled(absl::string_view feature);
+
+// Returns whether envoy.reloadable_features.http_stream_arena is enabled. Unlike
+// runtimeFeatureEnabled() the flag is not looked up by name, as it is read for every header map.
+bool httpStreamArenaEnabled();
 uint64_t getInteger(absl::string_view feature, uint64_t default_value);
 
 void markRuntimeInitialized();
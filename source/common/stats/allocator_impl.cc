@@ -167,6 +167,56 @@ private:
   std::atomic<uint64_t> pending_increment_{0};
 };
 
+// A counter whose increments are recorded in the counter slab of the incrementing thread, see
+// CounterSlabs. Threads without a slab, such as threads which are not registered with the
+// ThreadLocalStoreImpl, add to shared_value_ instead.
+class SlabCounterImpl : public StatsSharedImpl<Counter> {
+public:
+  SlabCounterImpl(StatName name, AllocatorImpl& alloc, StatName tag_extracted_name,
+                  const StatNameTagVector& stat_name_tags, uint32_t cell)
+      : StatsSharedImpl(name, alloc, tag_extracted_name, stat_name_tags), cell_(cell) {}
+
+  ~SlabCounterImpl() override { alloc_.counter_slabs_.releaseCell(cell_); }
+
+  void removeFromSetLockHeld() ABSL_EXCLUSIVE_LOCKS_REQUIRED(alloc_.mutex_) override {
+    const size_t count = alloc_.counters_.erase(statName());
+    ASSERT(count == 1);
+    alloc_.sinked_counters_.erase(this);
+  }
+
+  // Stats::Counter
+  void add(uint64_t amount) override {
+    if (!alloc_.counter_slabs_.add(cell_, amount)) {
+      shared_value_ += amount;
+    }
+    // Avoid dirtying the shared cache line once the counter is marked as used.
+    if (!(flags_.load(std::memory_order_relaxed) & Flags::Used)) {
+      flags_ |= Flags::Used;
+    }
+  }
+  void inc() override { add(1); }
+  // The slabs are folded once per stats flush rather than on every read, so the value seen by
+  // admin and sinks includes increments on threads with slabs up to the last flush.
+  uint64_t latch() override {
+    const uint64_t total = value();
+    return total - latched_value_.exchange(total);
+  }
+  void reset() override {
+    // Slab cells can only be written by their owning thread, so the reset is applied as an offset
+    // on the shared value. The values wrap around, which leaves the sum at zero. The increment
+    // pending for the next latch() is preserved, as in CounterImpl::reset().
+    const uint64_t total = value();
+    shared_value_ -= total;
+    latched_value_ -= total;
+  }
+  uint64_t value() const override { return shared_value_ + alloc_.counter_slabs_.folded(cell_); }
+
+private:
+  const uint32_t cell_;
+  std::atomic<uint64_t> shared_value_{0};
+  std::atomic<uint64_t> latched_value_{0};
+};
+
 class GaugeImpl : public StatsSharedImpl<Gauge> {
 public:
   GaugeImpl(StatName name, AllocatorImpl& alloc, StatName tag_extracted_name,
@@ -367,9 +417,19 @@ bool AllocatorImpl::isMutexLockedForTest() {
 
 Counter* AllocatorImpl::makeCounterInternal(StatName name, StatName tag_extracted_name,
                                             const StatNameTagVector& stat_name_tags) {
+  if (counter_slabs_.enabled()) {
+    const absl::optional<uint32_t> cell = counter_slabs_.allocateCell();
+    if (cell.has_value()) {
+      return new SlabCounterImpl(name, *this, tag_extracted_name, stat_name_tags, cell.value());
+    }
+  }
   return new CounterImpl(name, *this, tag_extracted_name, stat_name_tags);
 }
 
+void AllocatorImpl::registerCounterSlab() { counter_slabs_.registerThread(); }
+
+void AllocatorImpl::foldCounterSlabs() { counter_slabs_.fold(); }
+
 void AllocatorImpl::forEachCounter(SizeFn f_size, StatFn<Counter> f_stat) const {
   Thread::LockGuard lock(mutex_);
   if (f_size != nullptr) {
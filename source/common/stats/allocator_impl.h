@@ -8,6 +8,7 @@
 #include "envoy/stats/stats.h"
 
 #include "source/common/common/thread_synchronizer.h"
+#include "source/common/stats/counter_slabs.h"
 #include "source/common/stats/metric_impl.h"
 
 #include "absl/container/flat_hash_set.h"
@@ -45,6 +46,8 @@ public:
   void forEachSinkedTextReadout(SizeFn f_size, StatFn<TextReadout> f_stat) const override;
 
   void setSinkPredicates(std::unique_ptr<SinkPredicates>&& sink_predicates) override;
+  void registerCounterSlab() override;
+  void foldCounterSlabs() override;
 #ifndef ENVOY_CONFIG_COVERAGE
   void debugPrint();
 #endif
@@ -70,6 +73,7 @@ protected:
 private:
   template <class BaseClass> friend class StatsSharedImpl;
   friend class CounterImpl;
+  friend class SlabCounterImpl;
   friend class GaugeImpl;
   friend class TextReadoutImpl;
   friend class NotifyingAllocatorImpl;
@@ -90,6 +94,9 @@ private:
   StatPointerSet<Gauge> sinked_gauges_ ABSL_GUARDED_BY(mutex_);
   StatPointerSet<TextReadout> sinked_text_readouts_ ABSL_GUARDED_BY(mutex_);
 
+  // Per-thread storage for counters created after the first thread registered a slab.
+  CounterSlabs counter_slabs_;
+
   // Predicates used to filter stats to be flushed.
   std::unique_ptr<SinkPredicates> sink_predicates_;
   SymbolTable& symbol_table_;
@@ -0,0 +1,127 @@
+#include "source/common/stats/counter_slabs.h"
+
+#include "source/common/common/assert.h"
+#include "source/common/common/lock_guard.h"
+#include "source/common/common/logger.h"
+
+namespace Envoy {
+namespace Stats {
+
+namespace {
+
+uint64_t nextId() {
+  static std::atomic<uint64_t> next_id{1};
+  return next_id++;
+}
+
+} // namespace
+
+CounterSlabs::CounterSlabs() : id_(nextId()) {}
+
+CounterSlabs::~CounterSlabs() = default;
+
+CounterSlabs::ThreadSlab& CounterSlabs::threadSlab() {
+  // A thread owns at most one slab. If it registers with another CounterSlabs, counters of the
+  // first one fall back to shared storage on this thread.
+  static thread_local ThreadSlab thread_slab;
+  return thread_slab;
+}
+
+void CounterSlabs::addChunk(Slab& slab, uint32_t chunk) {
+  ASSERT(chunk < MaxChunks);
+  ASSERT(slab.chunks_[chunk].load(std::memory_order_relaxed) == nullptr);
+  slab.chunk_storage_.push_back(std::make_unique<Chunk>());
+  slab.chunks_[chunk].store(slab.chunk_storage_.back().get(), std::memory_order_release);
+}
+
+void CounterSlabs::registerThread() {
+  ThreadSlab& thread_slab = threadSlab();
+  if (thread_slab.owner_id_ == id_) {
+    return;
+  }
+
+  Thread::LockGuard lock(mutex_);
+  const uint32_t index = slab_storage_.size();
+  if (index == MaxSlabs) {
+    ENVOY_LOG_MISC(warn, "counter slabs exhausted, counters are shared on this thread");
+    return;
+  }
+
+  auto slab = std::make_unique<Slab>();
+  for (uint32_t chunk = 0; chunk < num_chunks_; ++chunk) {
+    addChunk(*slab, chunk);
+  }
+  num_slabs_.store(index + 1, std::memory_order_release);
+  thread_slab.owner_id_ = id_;
+  thread_slab.slab_ = slab.get();
+  slab_storage_.push_back(std::move(slab));
+}
+
+absl::optional<uint32_t> CounterSlabs::allocateCell() {
+  Thread::LockGuard lock(mutex_);
+  if (slab_storage_.empty()) {
+    return absl::nullopt;
+  }
+  if (free_cells_.empty()) {
+    if (num_chunks_ == MaxChunks) {
+      return absl::nullopt;
+    }
+    const uint32_t chunk = num_chunks_++;
+    for (auto& slab : slab_storage_) {
+      addChunk(*slab, chunk);
+    }
+    addChunk(folded_, chunk);
+    // Push in descending order so cells are handed out in ascending order.
+    for (uint32_t i = CellsPerChunk; i > 0; --i) {
+      free_cells_.push_back(chunk * CellsPerChunk + i - 1);
+    }
+  }
+
+  const uint32_t cell = free_cells_.back();
+  free_cells_.pop_back();
+  return cell;
+}
+
+void CounterSlabs::releaseCell(uint32_t cell) {
+  Thread::LockGuard lock(mutex_);
+  ASSERT(cell < num_chunks_ * CellsPerChunk);
+  for (auto& slab : slab_storage_) {
+    slab->cell(cell).store(0, std::memory_order_relaxed);
+  }
+  folded_.cell(cell).store(0, std::memory_order_relaxed);
+  free_cells_.push_back(cell);
+}
+
+bool CounterSlabs::add(uint32_t cell, uint64_t amount) const {
+  const ThreadSlab& thread_slab = threadSlab();
+  if (thread_slab.owner_id_ != id_) {
+    return false;
+  }
+  // Only the owning thread writes to its slab, so the cell can be updated without a
+  // read-modify-write. The atomic only keeps concurrent reads in fold() well defined.
+  std::atomic<uint64_t>& value = thread_slab.slab_->cell(cell);
+  value.store(value.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+  return true;
+}
+
+void CounterSlabs::fold() {
+  Thread::LockGuard lock(mutex_);
+  // Walk each slab sequentially one chunk at a time, rather than every slab for each cell.
+  std::array<uint64_t, CellsPerChunk> totals;
+  for (uint32_t chunk = 0; chunk < num_chunks_; ++chunk) {
+    totals.fill(0);
+    for (const auto& slab : slab_storage_) {
+      const Chunk& cells = *slab->chunks_[chunk].load(std::memory_order_relaxed);
+      for (uint32_t i = 0; i < CellsPerChunk; ++i) {
+        totals[i] += cells[i].load(std::memory_order_relaxed);
+      }
+    }
+    Chunk& folded = *folded_.chunks_[chunk].load(std::memory_order_relaxed);
+    for (uint32_t i = 0; i < CellsPerChunk; ++i) {
+      folded[i].store(totals[i], std::memory_order_relaxed);
+    }
+  }
+}
+
+} // namespace Stats
+} // namespace Envoy
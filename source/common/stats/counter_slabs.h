@@ -0,0 +1,124 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "source/common/common/thread.h"
+#include "source/common/common/thread_annotations.h"
+
+#include "absl/types/optional.h"
+
+namespace Envoy {
+namespace Stats {
+
+/**
+ * Per-thread storage for counter increments. Every counter allocated in slab mode is assigned a
+ * cell index which is valid in the slab of every registered thread. A slab is only written by the
+ * thread that owns it, so an increment is a plain load and store to a cache line private to that
+ * thread, rather than an atomic read-modify-write on a cache line shared by all workers. The value
+ * of a counter is the sum of its cell across all slabs, which is computed for all cells at once by
+ * fold(), so that reading a counter does not depend on the number of slabs.
+ *
+ * Cells are grouped in fixed size chunks, so slabs can grow while other threads are reading or
+ * writing cells of existing counters.
+ */
+class CounterSlabs {
+public:
+  static constexpr uint32_t CellsPerChunk = 1024;
+  static constexpr uint32_t MaxChunks = 4096;
+  static constexpr uint32_t MaxSlabs = 1024;
+
+  CounterSlabs();
+  ~CounterSlabs();
+
+  /**
+   * Creates a slab for the calling thread, unless it already has one. Increments made by a thread
+   * without a slab are not recorded in slabs; see add().
+   */
+  void registerThread();
+
+  /**
+   * @return true if at least one thread has registered a slab.
+   */
+  bool enabled() const { return num_slabs_.load(std::memory_order_acquire) > 0; }
+
+  /**
+   * Assigns a cell to a new counter. The cell starts out as zero in every slab.
+   * @return the cell index, or absl::nullopt if no thread registered a slab or all cells are in
+   *         use.
+   */
+  absl::optional<uint32_t> allocateCell();
+
+  /**
+   * Returns a cell to the free list. The cell must no longer be updated by any thread.
+   * @param cell supplies the cell index returned by allocateCell().
+   */
+  void releaseCell(uint32_t cell);
+
+  /**
+   * Adds to the cell in the slab of the calling thread.
+   * @param cell supplies the cell index.
+   * @param amount supplies the amount to add.
+   * @return false if the calling thread has no slab, in which case the caller must record the
+   *         increment elsewhere.
+   */
+  bool add(uint32_t cell, uint64_t amount) const;
+
+  /**
+   * Sums every cell across all slabs, making the totals available through folded(). Increments
+   * are only guaranteed to be included if they happen before the call, e.g. if the incrementing
+   * thread posted to the folding thread afterwards.
+   */
+  void fold();
+
+  /**
+   * @return the sum of the cell across all slabs as of the last fold(). Each slab only grows
+   *         between calls, so successive values are monotonic.
+   */
+  uint64_t folded(uint32_t cell) const {
+    return folded_.cell(cell).load(std::memory_order_relaxed);
+  }
+
+private:
+  using Chunk = std::array<std::atomic<uint64_t>, CellsPerChunk>;
+
+  struct Slab {
+    std::atomic<uint64_t>& cell(uint32_t cell) const {
+      return (*chunks_[cell / CellsPerChunk].load(std::memory_order_acquire))[cell % CellsPerChunk];
+    }
+
+    std::array<std::atomic<Chunk*>, MaxChunks> chunks_{};
+    std::vector<std::unique_ptr<Chunk>> chunk_storage_;
+  };
+
+  // The slab of the calling thread, and the id of the CounterSlabs it belongs to.
+  struct ThreadSlab {
+    uint64_t owner_id_{0};
+    Slab* slab_{nullptr};
+  };
+
+  static ThreadSlab& threadSlab();
+  void addChunk(Slab& slab, uint32_t chunk) ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
+  // Distinguishes slabs of different instances in the thread local lookup.
+  const uint64_t id_;
+
+  // Slabs are only appended, and are not destroyed before this object, so that the owning threads
+  // do not need to take mutex_.
+  std::atomic<uint32_t> num_slabs_{0};
+
+  // The totals of every cell as of the last fold(). Only written with mutex_ held, but read
+  // without it.
+  Slab folded_;
+
+  mutable Thread::MutexBasicLockable mutex_;
+  std::vector<std::unique_ptr<Slab>> slab_storage_ ABSL_GUARDED_BY(mutex_);
+  std::vector<uint32_t> free_cells_ ABSL_GUARDED_BY(mutex_);
+  uint32_t num_chunks_ ABSL_GUARDED_BY(mutex_){0};
+};
+
+} // namespace Stats
+} // namespace Envoy
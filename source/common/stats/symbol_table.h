@@ -1,6 +1,7 @@
 #pragma once
 
 #include <algorithm>
+#include <atomic>
 #include <memory>
 #include <stack>
 #include <string>
@@ -19,6 +20,8 @@
 #include "absl/container/inlined_vector.h"
 #include "absl/strings/str_join.h"
 #include "absl/strings/str_split.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/types/optional.h"
 
 namespace Envoy {
 namespace Stats {
@@ -324,6 +327,21 @@ public:
    */
   DynamicSpans getDynamicSpans(StatName stat_name) const;
 
+  /**
+   * @return the number of times a thread had to wait for the symbol table lock because another
+   *         thread held it exclusively. Lookups of existing symbols only hold the lock in shared
+   *         mode, so this is driven by symbol creation and deletion.
+   */
+  uint64_t lockContentions() const { return lock_contentions_.load(std::memory_order_relaxed); }
+
+  /**
+   * @return the number of times the symbol table lock was taken exclusively, which happens when
+   *         a symbol is created, or when the last reference to a symbol is freed.
+   */
+  uint64_t exclusiveLockAcquisitions() const {
+    return exclusive_lock_acquisitions_.load(std::memory_order_relaxed);
+  }
+
   bool lessThanLockHeld(const StatName& a, const StatName& b) const;
 
   template <class GetStatName, class Obj> struct StatNameCompare {
@@ -349,7 +367,7 @@ public:
   void sortByStatNames(Iter begin, Iter end, GetStatName get_stat_name) const {
     // Grab the lock once before sorting begins, so we don't have to re-take
     // it on every comparison.
-    Thread::LockGuard lock(lock_);
+    absl::ReaderMutexLock lock(lock_);
     StatNameCompare<GetStatName, Obj> compare(*this, get_stat_name);
     std::sort(begin, end, compare);
   }
@@ -397,13 +415,42 @@ private:
 
   struct SharedSymbol {
     SharedSymbol(Symbol symbol) : symbol_(symbol) {}
+    // Only moved by the encode map while lock_ is held exclusively.
+    SharedSymbol(SharedSymbol&& other) noexcept
+        : symbol_(other.symbol_), ref_count_(other.ref_count_.load(std::memory_order_relaxed)) {}
+
+    /**
+     * Adds a reference to a symbol which is still referenced. This is safe to call with lock_
+     * held in shared mode.
+     * @return false if the reference count already dropped to zero, in which case the symbol may
+     *         be about to be removed, and the reference must be added with lock_ held exclusively.
+     */
+    bool tryIncRefCount() const {
+      uint32_t ref_count = ref_count_.load(std::memory_order_relaxed);
+      while (ref_count != 0) {
+        if (ref_count_.compare_exchange_weak(ref_count, ref_count + 1,
+                                             std::memory_order_relaxed)) {
+          return true;
+        }
+      }
+      return false;
+    }
 
     Symbol symbol_;
-    uint32_t ref_count_{1};
+    // Reference counts are adjusted with lock_ held in shared mode, so that encoding existing
+    // symbols and freeing symbols which are still referenced elsewhere do not serialize on the
+    // symbol table. A symbol is only removed with lock_ held exclusively, once its count is zero.
+    mutable std::atomic<uint32_t> ref_count_{1};
   };
 
-  // This must be held during both encode() and free().
-  mutable Thread::MutexBasicLockable lock_;
+  // Held exclusively when symbols are added or removed, and in shared mode for
+  // everything else, including reference count updates.
+  mutable absl::Mutex lock_;
+  mutable std::atomic<uint64_t> lock_contentions_{0};
+  std::atomic<uint64_t> exclusive_lock_acquisitions_{0};
+
+  void lockShared() const ABSL_SHARED_LOCK_FUNCTION(lock_);
+  void lockExclusive() ABSL_EXCLUSIVE_LOCK_FUNCTION(lock_);
 
   /**
    * Decodes a uint8_t array into an array of period-delimited strings. Note
@@ -428,13 +475,22 @@ private:
    */
   Symbol toSymbol(absl::string_view sv) ABSL_EXCLUSIVE_LOCKS_REQUIRED(lock_);
 
+  /**
+   * Looks up a symbol which already exists and is referenced, and adds a reference to it.
+   *
+   * @param sv the individual string to be looked up.
+   * @return the symbol, or absl::nullopt if the symbol must be created by toSymbol().
+   */
+  absl::optional<Symbol> toExistingSymbol(absl::string_view sv) const
+      ABSL_SHARED_LOCKS_REQUIRED(lock_);
+
   /**
    * Convenience function for decode(), decoding one symbol at a time.
    *
    * @param symbol the individual symbol to be decoded.
    * @return absl::string_view the decoded string.
    */
-  absl::string_view fromSymbol(Symbol symbol) const ABSL_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+  absl::string_view fromSymbol(Symbol symbol) const ABSL_SHARED_LOCKS_REQUIRED(lock_);
 
   /**
    * Stages a new symbol for use. To be called after a successful insertion.
@@ -451,7 +507,7 @@ private:
   void addTokensToEncoding(absl::string_view name, Encoding& encoding);
 
   Symbol monotonicCounter() {
-    Thread::LockGuard lock(lock_);
+    absl::ReaderMutexLock lock(lock_);
     return monotonic_counter_;
   }
 
@@ -460,7 +516,7 @@ private:
   Symbol next_symbol_ ABSL_GUARDED_BY(lock_);
 
   // If the free pool is exhausted, we monotonically increase this counter.
-  Symbol monotonic_counter_;
+  Symbol monotonic_counter_ ABSL_GUARDED_BY(lock_);
 
   // Bitmap implementation.
   // The encode map stores both the symbol and the ref count of that symbol.
@@ -474,7 +530,13 @@ private:
   // TODO(ambuc): There might be an optimization here relating to storing ranges of freed symbols
   // using an Envoy::IntervalSet.
   std::stack<Symbol> pool_ ABSL_GUARDED_BY(lock_);
-  RecentLookups recent_lookups_ ABSL_GUARDED_BY(lock_);
+
+  // Recent lookups are tracked under their own lock, which is only taken when
+  // tracking is enabled. Otherwise lookups are only counted.
+  mutable Thread::MutexBasicLockable recent_lookups_lock_;
+  RecentLookups recent_lookups_ ABSL_GUARDED_BY(recent_lookups_lock_);
+  std::atomic<bool> recent_lookups_enabled_{false};
+  std::atomic<uint64_t> untracked_lookups_{0};
 };
 
 // Base class for holding the backing-storing for a StatName. The two derived
@@ -203,8 +203,12 @@ void ThreadLocalStoreImpl::initializeThreading(Event::Dispatcher& main_thread_di
   threading_ever_initialized_ = true;
   main_thread_dispatcher_ = &main_thread_dispatcher;
   tls_cache_ = ThreadLocal::TypedSlot<TlsCache>::makeUnique(tls);
-  tls_cache_->set(
-      [](Event::Dispatcher&) -> std::shared_ptr<TlsCache> { return std::make_shared<TlsCache>(); });
+  tls_cache_->set([this](Event::Dispatcher&) -> std::shared_ptr<TlsCache> {
+    if (per_worker_counters_) {
+      alloc_.registerCounterSlab();
+    }
+    return std::make_shared<TlsCache>();
+  });
   tls_ = tls;
 }
 
@@ -251,6 +255,10 @@ void ThreadLocalStoreImpl::mergeHistograms(PostMergeCb merge_complete_cb) {
 void ThreadLocalStoreImpl::mergeInternal(PostMergeCb merge_complete_cb) {
   if (!shutting_down_) {
     forEachHistogram(nullptr, [](ParentHistogram& histogram) { histogram.merge(); });
+    if (per_worker_counters_) {
+      // Every thread has run beginMerge() above, so the increments they made before are visible.
+      alloc_.foldCounterSlabs();
+    }
     merge_complete_cb();
     merge_in_progress_ = false;
   }
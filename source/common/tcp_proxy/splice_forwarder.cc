@@ -0,0 +1,231 @@
+#include "source/common/tcp_proxy/splice_forwarder.h"
+
+#include <cerrno>
+
+#include "source/common/api/os_sys_calls_impl.h"
+#include "source/common/common/assert.h"
+#include "source/common/common/macros.h"
+
+#if defined(__linux__)
+#include <fcntl.h>
+
+#include "source/common/api/os_sys_calls_impl_linux.h"
+#endif
+
+namespace Envoy {
+namespace TcpProxy {
+
+namespace {
+
+// The capacity of a pipe when it cannot be changed, see pipe(7).
+constexpr uint64_t DefaultPipeSize = 65536;
+
+void closeDescriptor(os_fd_t& fd) {
+  if (SOCKET_VALID(fd)) {
+    Api::OsSysCallsSingleton::get().close(fd);
+    SET_SOCKET_INVALID(fd);
+  }
+}
+
+} // namespace
+
+SpliceForwarderPtr SpliceForwarder::create(Event::Dispatcher& dispatcher, os_fd_t downstream_fd,
+                                           os_fd_t upstream_fd, uint32_t pipe_size,
+                                           Callbacks& callbacks) {
+#if defined(__linux__)
+  SpliceForwarderPtr forwarder(new SpliceForwarder(callbacks));
+  if (!forwarder->initialize(dispatcher, downstream_fd, upstream_fd, pipe_size)) {
+    return nullptr;
+  }
+  return forwarder;
+#else
+  UNREFERENCED_PARAMETER(dispatcher);
+  UNREFERENCED_PARAMETER(downstream_fd);
+  UNREFERENCED_PARAMETER(upstream_fd);
+  UNREFERENCED_PARAMETER(pipe_size);
+  UNREFERENCED_PARAMETER(callbacks);
+  return nullptr;
+#endif
+}
+
+SpliceForwarder::SpliceForwarder(Callbacks& callbacks) : callbacks_(callbacks) {}
+
+SpliceForwarder::~SpliceForwarder() { stop(); }
+
+bool SpliceForwarder::initialize(Event::Dispatcher& dispatcher, os_fd_t downstream_fd,
+                                 os_fd_t upstream_fd, uint32_t pipe_size) {
+#if defined(__linux__)
+  Api::OsSysCalls& os_sys_calls = Api::OsSysCallsSingleton::get();
+  Api::LinuxOsSysCalls& linux_os_sys_calls = Api::LinuxOsSysCallsSingleton::get();
+
+  const Api::SysCallSocketResult downstream = os_sys_calls.duplicate(downstream_fd);
+  if (!SOCKET_VALID(downstream.return_value_)) {
+    ENVOY_LOG(debug, "splice: failed to duplicate downstream socket: {}", downstream.errno_);
+    return false;
+  }
+  downstream_fd_ = downstream.return_value_;
+  const Api::SysCallSocketResult upstream = os_sys_calls.duplicate(upstream_fd);
+  if (!SOCKET_VALID(upstream.return_value_)) {
+    ENVOY_LOG(debug, "splice: failed to duplicate upstream socket: {}", upstream.errno_);
+    return false;
+  }
+  upstream_fd_ = upstream.return_value_;
+
+  pipe_size_ = DefaultPipeSize;
+  for (Stream& stream : streams_) {
+    int fds[2];
+    const Api::SysCallIntResult result = linux_os_sys_calls.pipe2(fds, O_NONBLOCK | O_CLOEXEC);
+    if (result.return_value_ != 0) {
+      ENVOY_LOG(debug, "splice: failed to create pipe: {}", result.errno_);
+      return false;
+    }
+    stream.pipe_read_ = fds[0];
+    stream.pipe_write_ = fds[1];
+    // Both pipes get the same capacity, so a failure to resize keeps the default for both.
+    if (pipe_size > 0) {
+      const Api::SysCallIntResult size = linux_os_sys_calls.setPipeSize(fds[1], pipe_size);
+      if (size.return_value_ > 0) {
+        pipe_size_ = size.return_value_;
+      }
+    }
+    if (stream.direction_ == Direction::Upstream) {
+      stream.source_ = downstream_fd_;
+      stream.destination_ = upstream_fd_;
+    } else {
+      stream.source_ = upstream_fd_;
+      stream.destination_ = downstream_fd_;
+    }
+  }
+
+  // Any event on either socket may unblock either direction, so both directions are pumped on
+  // every event.
+  const uint32_t events = Event::FileReadyType::Read | Event::FileReadyType::Write;
+  downstream_event_ = dispatcher.createFileEvent(
+      downstream_fd_, [this](uint32_t) { return onFileEvent(); }, Event::FileTriggerType::Edge,
+      events);
+  upstream_event_ = dispatcher.createFileEvent(
+      upstream_fd_, [this](uint32_t) { return onFileEvent(); }, Event::FileTriggerType::Edge,
+      events);
+  // Bytes may already be waiting in the socket buffers, for which no edge will be reported.
+  downstream_event_->activate(Event::FileReadyType::Read);
+  return true;
+#else
+  UNREFERENCED_PARAMETER(dispatcher);
+  UNREFERENCED_PARAMETER(downstream_fd);
+  UNREFERENCED_PARAMETER(upstream_fd);
+  UNREFERENCED_PARAMETER(pipe_size);
+  return false;
+#endif
+}
+
+void SpliceForwarder::stop() {
+  stopped_ = true;
+  downstream_event_.reset();
+  upstream_event_.reset();
+  for (Stream& stream : streams_) {
+    closeDescriptor(stream.pipe_read_);
+    closeDescriptor(stream.pipe_write_);
+  }
+  closeDescriptor(downstream_fd_);
+  closeDescriptor(upstream_fd_);
+}
+
+uint64_t SpliceForwarder::bufferedBytes(Direction direction) const {
+  return streams_[direction == Direction::Upstream ? 0 : 1].buffered_;
+}
+
+absl::Status SpliceForwarder::onFileEvent() {
+  ASSERT(!stopped_);
+  for (Stream& stream : streams_) {
+    const PumpResult result = pump(stream);
+    if (result.bytes_read_ > 0 || result.bytes_written_ > 0) {
+      forwarded_ = true;
+      callbacks_.onSpliceBytes(stream.direction_, result.bytes_read_, result.bytes_written_);
+    }
+
+    if (result.error_ != 0) {
+      ENVOY_LOG(debug, "splice: direction {} failed: {}", static_cast<int>(stream.direction_),
+                result.error_);
+      Callbacks& callbacks = callbacks_;
+      stop();
+      callbacks.onSpliceError(stream.direction_, result.error_);
+      return absl::OkStatus();
+    }
+
+    // Reading is paused from the time the destination pushes back until the pipe is drained
+    // again, which gives the same hysteresis as the high and low watermarks of a buffer.
+    if (!stream.paused_ && result.destination_blocked_) {
+      stream.paused_ = true;
+      callbacks_.onSpliceFlowControl(stream.direction_, true);
+    } else if (stream.paused_ && stream.buffered_ == 0) {
+      stream.paused_ = false;
+      callbacks_.onSpliceFlowControl(stream.direction_, false);
+    }
+
+    if (stream.source_closed_ && stream.buffered_ == 0 && !stream.end_stream_raised_) {
+      stream.end_stream_raised_ = true;
+      callbacks_.onSpliceEndStream(stream.direction_);
+      if (stopped_) {
+        return absl::OkStatus();
+      }
+    }
+  }
+  return absl::OkStatus();
+}
+
+SpliceForwarder::PumpResult SpliceForwarder::pump(Stream& stream) {
+  PumpResult result;
+#if defined(__linux__)
+  Api::LinuxOsSysCalls& os_sys_calls = Api::LinuxOsSysCallsSingleton::get();
+  constexpr unsigned int flags = SPLICE_F_MOVE | SPLICE_F_NONBLOCK;
+
+  // Alternate between filling and draining the pipe until neither makes progress. The file
+  // events are edge triggered, so the source must be read until it would block, unless the pipe
+  // is full, in which case the next write event on the destination resumes the loop.
+  bool progress = true;
+  while (progress) {
+    progress = false;
+    if (!stream.source_closed_ && stream.buffered_ < pipe_size_) {
+      const Api::SysCallSizeResult rc = os_sys_calls.splice(
+          stream.source_, nullptr, stream.pipe_write_, nullptr, pipe_size_ - stream.buffered_,
+          flags);
+      if (rc.return_value_ > 0) {
+        stream.buffered_ += rc.return_value_;
+        result.bytes_read_ += rc.return_value_;
+        progress = true;
+      } else if (rc.return_value_ == 0) {
+        stream.source_closed_ = true;
+      } else if (rc.errno_ == EINTR) {
+        progress = true;
+      } else if (rc.errno_ != EAGAIN) {
+        result.error_ = rc.errno_;
+        return result;
+      }
+    }
+
+    if (stream.buffered_ > 0) {
+      const Api::SysCallSizeResult rc = os_sys_calls.splice(
+          stream.pipe_read_, nullptr, stream.destination_, nullptr, stream.buffered_, flags);
+      if (rc.return_value_ > 0) {
+        stream.buffered_ -= rc.return_value_;
+        result.bytes_written_ += rc.return_value_;
+        result.destination_blocked_ = false;
+        progress = true;
+      } else if (rc.return_value_ < 0 && rc.errno_ == EINTR) {
+        progress = true;
+      } else if (rc.return_value_ < 0 && rc.errno_ != EAGAIN) {
+        result.error_ = rc.errno_;
+        return result;
+      } else {
+        result.destination_blocked_ = true;
+      }
+    }
+  }
+#else
+  UNREFERENCED_PARAMETER(stream);
+#endif
+  return result;
+}
+
+} // namespace TcpProxy
+} // namespace Envoy
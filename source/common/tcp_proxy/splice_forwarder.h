@@ -0,0 +1,155 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <memory>
+
+#include "envoy/common/platform.h"
+#include "envoy/common/pure.h"
+#include "envoy/event/deferred_deletable.h"
+#include "envoy/event/dispatcher.h"
+#include "envoy/event/file_event.h"
+
+#include "source/common/common/logger.h"
+
+#include "absl/status/status.h"
+
+namespace Envoy {
+namespace TcpProxy {
+
+class SpliceForwarder;
+using SpliceForwarderPtr = std::unique_ptr<SpliceForwarder>;
+
+/**
+ * Moves bytes between the sockets of a downstream and an upstream connection with splice(2), so
+ * that proxied bytes are not copied into and out of userspace buffers. Each direction moves bytes
+ * from its source socket into a pipe, and from the pipe into its destination socket. The pipe is
+ * the only buffer between the two sockets: once the destination stops accepting bytes and the pipe
+ * is full, the source socket is no longer read and the peer is flow controlled by the kernel
+ * socket buffers.
+ *
+ * The forwarder registers its own file events on duplicates of the socket descriptors. While it is
+ * active, both connections must stay read disabled, and must not write to their sockets other than
+ * to half close them when the forwarder reports the end of a direction.
+ */
+class SpliceForwarder : public Event::DeferredDeletable, Logger::Loggable<Logger::Id::filter> {
+public:
+  enum class Direction {
+    // From the downstream socket to the upstream socket.
+    Upstream,
+    // From the upstream socket to the downstream socket.
+    Downstream,
+  };
+
+  class Callbacks {
+  public:
+    virtual ~Callbacks() = default;
+
+    /**
+     * Called after bytes were moved in a direction.
+     * @param direction supplies the direction.
+     * @param bytes_read supplies the number of bytes read from the source socket.
+     * @param bytes_written supplies the number of bytes written to the destination socket.
+     */
+    virtual void onSpliceBytes(Direction direction, uint64_t bytes_read,
+                               uint64_t bytes_written) PURE;
+
+    /**
+     * Called when the destination socket of a direction stops accepting bytes while some are
+     * still in the pipe, and again once the pipe has been drained.
+     * @param direction supplies the direction.
+     * @param paused supplies true when reading the source socket is paused, false when resumed.
+     */
+    virtual void onSpliceFlowControl(Direction direction, bool paused) PURE;
+
+    /**
+     * Called once the source socket of a direction reached end of stream and every byte read from
+     * it has been written. The destination connection should be half closed.
+     * @param direction supplies the direction.
+     */
+    virtual void onSpliceEndStream(Direction direction) PURE;
+
+    /**
+     * Called when moving bytes failed, e.g. because a peer reset its connection. The forwarder is
+     * stopped before this is called.
+     * @param direction supplies the direction that failed.
+     * @param error supplies the errno of the failed splice(2) call.
+     */
+    virtual void onSpliceError(Direction direction, int error) PURE;
+  };
+
+  /**
+   * @param dispatcher supplies the dispatcher of both connections.
+   * @param downstream_fd supplies the descriptor of the downstream socket.
+   * @param upstream_fd supplies the descriptor of the upstream socket.
+   * @param pipe_size supplies the requested capacity of each pipe, or 0 for the default capacity.
+   *        The kernel rounds it up to a power of two pages, and keeps the default capacity if it
+   *        is above the system limit.
+   * @param callbacks supplies the callbacks, which must outlive the forwarder or stop it.
+   * @return the forwarder, which starts moving bytes on the next dispatcher iteration, or nullptr
+   *         if splice(2) is not supported on this platform or the descriptors could not be created.
+   */
+  static SpliceForwarderPtr create(Event::Dispatcher& dispatcher, os_fd_t downstream_fd,
+                                   os_fd_t upstream_fd, uint32_t pipe_size, Callbacks& callbacks);
+
+  ~SpliceForwarder() override;
+
+  /**
+   * Stops moving bytes and closes all descriptors owned by the forwarder. No callbacks are called
+   * afterwards. Bytes still in the pipes are discarded. This may be called from a callback.
+   */
+  void stop();
+
+  /**
+   * @return true if any byte has been read or written.
+   */
+  bool forwarded() const { return forwarded_; }
+
+  /**
+   * @return the number of bytes read from the source socket of a direction and not yet written
+   *         to its destination socket.
+   */
+  uint64_t bufferedBytes(Direction direction) const;
+
+private:
+  struct Stream {
+    Direction direction_;
+    os_fd_t source_{INVALID_SOCKET};
+    os_fd_t destination_{INVALID_SOCKET};
+    os_fd_t pipe_read_{INVALID_SOCKET};
+    os_fd_t pipe_write_{INVALID_SOCKET};
+    uint64_t buffered_{0};
+    bool source_closed_{false};
+    bool end_stream_raised_{false};
+    bool paused_{false};
+  };
+
+  struct PumpResult {
+    uint64_t bytes_read_{0};
+    uint64_t bytes_written_{0};
+    bool destination_blocked_{false};
+    int error_{0};
+  };
+
+  explicit SpliceForwarder(Callbacks& callbacks);
+
+  bool initialize(Event::Dispatcher& dispatcher, os_fd_t downstream_fd, os_fd_t upstream_fd,
+                  uint32_t pipe_size);
+  absl::Status onFileEvent();
+  PumpResult pump(Stream& stream);
+
+  Callbacks& callbacks_;
+  // Duplicates of the socket descriptors, so that the file events of the forwarder never outlive
+  // the descriptors they are registered on.
+  os_fd_t downstream_fd_{INVALID_SOCKET};
+  os_fd_t upstream_fd_{INVALID_SOCKET};
+  std::array<Stream, 2> streams_{Stream{Direction::Upstream}, Stream{Direction::Downstream}};
+  uint64_t pipe_size_{0};
+  Event::FileEventPtr downstream_event_;
+  Event::FileEventPtr upstream_event_;
+  bool forwarded_{false};
+  bool stopped_{false};
+};
+
+} // namespace TcpProxy
+} // namespace Envoy
@@ -29,6 +29,7 @@
 #include "source/common/config/well_known_names.h"
 #include "source/common/http/request_id_extension_impl.h"
 #include "source/common/network/application_protocol.h"
+#include "source/common/network/connection_impl.h"
 #include "source/common/network/proxy_protocol_filter_state.h"
 #include "source/common/network/socket_option_factory.h"
 #include "source/common/network/transport_socket_options_impl.h"
@@ -202,7 +203,8 @@ Config::Config(const envoy::extensions::filters::network::tcp_proxy::v3::TcpProx
       upstream_drain_manager_slot_(context.serverFactoryContext().threadLocal().allocateSlot()),
       shared_config_(std::make_shared<SharedConfig>(config, context)),
       random_generator_(context.serverFactoryContext().api().randomGenerator()),
-      regex_engine_(context.serverFactoryContext().regexEngine()) {
+      regex_engine_(context.serverFactoryContext().regexEngine()),
+      use_splice_(config.use_splice()) {
   upstream_drain_manager_slot_->set([](Event::Dispatcher&) {
     ThreadLocal::ThreadLocalObjectSharedPtr drain_manager =
         std::make_shared<UpstreamDrainManager>();
@@ -1124,6 +1126,7 @@ void Filter::onDownstreamEvent(Network::ConnectionEvent event) {
     downstream_closed_ = true;
     // Cancel the potential odcds callback.
     cluster_discovery_handle_ = nullptr;
+    stopSplicing();
   }
 
   ENVOY_CONN_LOG(trace, "on downstream event {}, has upstream = {}", read_callbacks_->connection(),
@@ -1156,6 +1159,11 @@ void Filter::onDownstreamEvent(Network::ConnectionEvent event) {
 void Filter::onUpstreamData(Buffer::Instance& data, bool end_stream) {
   ENVOY_CONN_LOG(trace, "upstream connection received {} bytes, end_stream={}",
                  read_callbacks_->connection(), data.length(), end_stream);
+  if (splice_forwarder_ != nullptr) {
+    // The upstream connection read in the same event in which it connected, before splicing had a
+    // chance to start. Keep the bytes in order by forwarding through buffers from now on.
+    fallBackFromSplicing();
+  }
   getStreamInfo().getUpstreamBytesMeter()->addWireBytesReceived(data.length());
   getStreamInfo().getDownstreamBytesMeter()->addWireBytesSent(data.length());
   read_callbacks_->connection().write(data, end_stream);
@@ -1174,6 +1182,7 @@ void Filter::onUpstreamEvent(Network::ConnectionEvent event) {
 
   if (event == Network::ConnectionEvent::RemoteClose ||
       event == Network::ConnectionEvent::LocalClose) {
+    stopSplicing();
     if (Runtime::runtimeFeatureEnabled(
             "envoy.restart_features.upstream_http_filters_with_tcp_proxy")) {
       read_callbacks_->connection().dispatcher().deferredDelete(std::move(upstream_));
@@ -1243,10 +1252,11 @@ void Filter::onUpstreamConnection() {
   // 1. Buffer overflow when receive_before_connect is enabled (tracked by
   // read_disabled_due_to_buffer_)
   // 2. In establishUpstreamConnection() when receive_before_connect is disabled
+  // When splicing, reads stay disabled for the lifetime of the connection.
   if (read_disabled_due_to_buffer_) {
     read_callbacks_->connection().readDisable(false);
     read_disabled_due_to_buffer_ = false;
-  } else if (!receive_before_connect_) {
+  } else if (!receive_before_connect_ && !maybeStartSplicing()) {
     // Re-enable downstream reads that were disabled in establishUpstreamConnection()
     // when early data reception was NOT enabled.
     read_callbacks_->connection().readDisable(false);
@@ -1278,6 +1288,125 @@ void Filter::onUpstreamConnection() {
   }
 }
 
+namespace {
+
+// Returns whether the connection reads and writes its bytes through a raw buffer transport socket.
+bool hasRawBufferTransportSocket(Network::Connection& connection) {
+  auto* connection_impl = dynamic_cast<Network::ConnectionImpl*>(&connection);
+  return connection_impl != nullptr && connection_impl->transportSocket() != nullptr &&
+         connection_impl->transportSocket()->isRawBuffer();
+}
+
+} // namespace
+
+bool Filter::maybeStartSplicing() {
+  if (!config_->useSplice()) {
+    return false;
+  }
+
+  // Spliced bytes bypass the transport sockets and all filters, so only connections with raw
+  // buffer transport sockets and without other network filters on either side qualify, and no
+  // byte may have been buffered on the way to the upstream yet.
+  Network::Connection& downstream = read_callbacks_->connection();
+  auto* tcp_upstream = dynamic_cast<TcpUpstream*>(upstream_.get());
+  Network::ClientConnection* upstream =
+      tcp_upstream != nullptr ? tcp_upstream->connection() : nullptr;
+  if (upstream == nullptr || !hasRawBufferTransportSocket(downstream) ||
+      !hasRawBufferTransportSocket(*upstream) || !read_callbacks_->soleFilter() ||
+      read_callbacks_->upstreamHost()->cluster().hasNetworkFilters() || receive_before_connect_ ||
+      connect_mode_ != UpstreamConnectMode::IMMEDIATE) {
+    config_->stats().downstream_cx_splice_fallback_.inc();
+    return false;
+  }
+
+  // The pipes hold as many bytes as the connection buffers would before applying back pressure.
+  splice_forwarder_ = SpliceForwarder::create(
+      downstream.dispatcher(), downstream.getSocket()->ioHandle().fdDoNotUse(),
+      upstream->getSocket()->ioHandle().fdDoNotUse(), downstream.bufferLimit(), *this);
+  if (splice_forwarder_ == nullptr) {
+    config_->stats().downstream_cx_splice_fallback_.inc();
+    return false;
+  }
+
+  ENVOY_CONN_LOG(debug, "forwarding with splice", downstream);
+  config_->stats().downstream_cx_splice_total_.inc();
+  upstream_->readDisable(true);
+  return true;
+}
+
+void Filter::stopSplicing() {
+  if (splice_forwarder_ != nullptr) {
+    // The forwarder may be the caller, so it is only deleted after the current event.
+    splice_forwarder_->stop();
+    read_callbacks_->connection().dispatcher().deferredDelete(std::move(splice_forwarder_));
+  }
+}
+
+void Filter::fallBackFromSplicing() {
+  ASSERT(!splice_forwarder_->forwarded());
+  stopSplicing();
+  config_->stats().downstream_cx_splice_fallback_.inc();
+  upstream_->readDisable(false);
+  read_callbacks_->connection().readDisable(false);
+}
+
+void Filter::onSpliceBytes(SpliceForwarder::Direction direction, uint64_t bytes_read,
+                           uint64_t bytes_written) {
+  // The connections do not see spliced bytes, so account for them here like they would.
+  auto& cluster_stats = read_callbacks_->upstreamHost()->cluster().trafficStats();
+  if (direction == SpliceForwarder::Direction::Upstream) {
+    config_->stats().downstream_cx_rx_bytes_total_.add(bytes_read);
+    getStreamInfo().getDownstreamBytesMeter()->addWireBytesReceived(bytes_read);
+    cluster_stats->upstream_cx_tx_bytes_total_.add(bytes_written);
+    getStreamInfo().getUpstreamBytesMeter()->addWireBytesSent(bytes_written);
+  } else {
+    cluster_stats->upstream_cx_rx_bytes_total_.add(bytes_read);
+    getStreamInfo().getUpstreamBytesMeter()->addWireBytesReceived(bytes_read);
+    config_->stats().downstream_cx_tx_bytes_total_.add(bytes_written);
+    getStreamInfo().getDownstreamBytesMeter()->addWireBytesSent(bytes_written);
+  }
+  resetIdleTimer();
+}
+
+void Filter::onSpliceFlowControl(SpliceForwarder::Direction direction, bool paused) {
+  if (direction == SpliceForwarder::Direction::Upstream) {
+    if (paused) {
+      config_->stats().downstream_flow_control_paused_reading_total_.inc();
+    } else {
+      config_->stats().downstream_flow_control_resumed_reading_total_.inc();
+    }
+  } else {
+    auto& cluster_stats = read_callbacks_->upstreamHost()->cluster().trafficStats();
+    if (paused) {
+      cluster_stats->upstream_flow_control_paused_reading_total_.inc();
+    } else {
+      cluster_stats->upstream_flow_control_resumed_reading_total_.inc();
+    }
+  }
+}
+
+void Filter::onSpliceEndStream(SpliceForwarder::Direction direction) {
+  Buffer::OwnedImpl empty;
+  if (direction == SpliceForwarder::Direction::Upstream) {
+    upstream_->encodeData(empty, true);
+  } else {
+    read_callbacks_->connection().write(empty, true);
+  }
+
+  // With reads disabled, the connections never see the end of stream of their peers, so they do
+  // not close by themselves once both directions are done.
+  if (++splice_end_streams_ == 2) {
+    read_callbacks_->connection().close(Network::ConnectionCloseType::FlushWrite);
+  }
+}
+
+void Filter::onSpliceError(SpliceForwarder::Direction direction, int error) {
+  ENVOY_CONN_LOG(debug, "splice towards {} failed: {}", read_callbacks_->connection(),
+                 direction == SpliceForwarder::Direction::Upstream ? "upstream" : "downstream",
+                 errorDetails(error));
+  read_callbacks_->connection().close(Network::ConnectionCloseType::NoFlush);
+}
+
 void Filter::onIdleTimeout() {
   ENVOY_CONN_LOG(debug, "Session timed out", read_callbacks_->connection());
   config_->stats().idle_timeout_.inc();
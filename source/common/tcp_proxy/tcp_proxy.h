@@ -29,11 +29,13 @@
 #include "source/common/common/logger.h"
 #include "source/common/formatter/substitution_format_string.h"
 #include "source/common/http/header_map_impl.h"
+#include "source/common/http/stream_arena_impl.h"
 #include "source/common/network/cidr_range.h"
 #include "source/common/network/filter_impl.h"
 #include "source/common/network/hash_policy.h"
 #include "source/common/network/utility.h"
 #include "source/common/stream_info/stream_info_impl.h"
+#include "source/common/tcp_proxy/splice_forwarder.h"
 #include "source/common/tcp_proxy/upstream.h"
 #include "source/common/upstream/load_balancer_context_base.h"
 #include "source/common/upstream/od_cds_api_impl.h"
@@ -61,6 +63,8 @@ constexpr absl::string_view ReceiveBeforeConnectKey = "envoy.tcp_proxy.receive_b
 #define ALL_TCP_PROXY_STATS(COUNTER, GAUGE)                                                        \
   COUNTER(downstream_cx_no_route)                                                                  \
   COUNTER(downstream_cx_rx_bytes_total)                                                            \
+  COUNTER(downstream_cx_splice_fallback)                                                           \
+  COUNTER(downstream_cx_splice_total)                                                              \
   COUNTER(downstream_cx_total)                                                                     \
   COUNTER(downstream_cx_tx_bytes_total)                                                            \
   COUNTER(downstream_flow_control_paused_reading_total)                                            \
@@ -368,6 +372,8 @@ public:
 
   const absl::optional<uint32_t>& maxEarlyDataBytes() const { return max_early_data_bytes_; }
 
+  bool useSplice() const { return use_splice_; }
+
 private:
   struct SimpleRouteImpl : public Route {
     SimpleRouteImpl(const Config& parent, absl::string_view cluster_name);
@@ -423,6 +429,7 @@ private:
   envoy::extensions::filters::network::tcp_proxy::v3::UpstreamConnectMode upstream_connect_mode_{
       envoy::extensions::filters::network::tcp_proxy::v3::IMMEDIATE};
   absl::optional<uint32_t> max_early_data_bytes_;
+  const bool use_splice_;
 };
 
 using ConfigSharedPtr = std::shared_ptr<Config>;
@@ -449,7 +456,8 @@ private:
 class Filter : public Network::ReadFilter,
                public Upstream::LoadBalancerContextBase,
                protected Logger::Loggable<Logger::Id::filter>,
-               public GenericConnectionPoolCallbacks {
+               public GenericConnectionPoolCallbacks,
+               public SpliceForwarder::Callbacks {
 public:
   Filter(ConfigSharedPtr config, Upstream::ClusterManager& cluster_manager);
   ~Filter() override;
@@ -469,6 +477,13 @@ public:
                             absl::string_view failure_reason,
                             Upstream::HostDescriptionConstSharedPtr host) override;
 
+  // SpliceForwarder::Callbacks
+  void onSpliceBytes(SpliceForwarder::Direction direction, uint64_t bytes_read,
+                     uint64_t bytes_written) override;
+  void onSpliceFlowControl(SpliceForwarder::Direction direction, bool paused) override;
+  void onSpliceEndStream(SpliceForwarder::Direction direction) override;
+  void onSpliceError(SpliceForwarder::Direction direction, int error) override;
+
   // Upstream::LoadBalancerContext
   const Router::MetadataMatchCriteria* metadataMatchCriteria() override;
   absl::optional<uint64_t> computeHashKey() override {
@@ -619,6 +634,7 @@ public:
     //   return absl::nullopt;
     // }
     absl::string_view filterConfigName() const override { return ""; }
+    Http::StreamArena& streamArena() override { return stream_arena_; }
 
     // ScopeTrackedObject
     void dumpState(std::ostream& os, int indent_level) const override {
@@ -629,6 +645,7 @@ public:
     Filter* parent_{};
     Http::RequestTrailerMapPtr request_trailer_map_;
     std::shared_ptr<Http::NullRouteImpl> route_;
+    Http::StreamArenaImpl stream_arena_;
   };
   Tracing::NullSpan active_span_;
   const Tracing::Config& tracing_config_;
@@ -675,6 +692,12 @@ protected:
   void onUpstreamData(Buffer::Instance& data, bool end_stream);
   void onUpstreamEvent(Network::ConnectionEvent event);
   void onUpstreamConnection();
+  // Starts forwarding with splice(2) if it is enabled and both connections are plain TCP.
+  // Returns true if splicing started, in which case both connections stay read disabled.
+  bool maybeStartSplicing();
+  void stopSplicing();
+  // Forwards through buffers after splicing was started but before any byte was spliced.
+  void fallBackFromSplicing();
   void onIdleTimeout();
   void resetIdleTimer();
   void disableIdleTimer();
@@ -744,6 +767,10 @@ protected:
   bool initial_data_received_{false};
   bool read_disabled_due_to_buffer_{false}; // Track if we disabled reading due to buffer overflow.
   uint32_t max_buffered_bytes_{65536};      // Default 64KB.
+
+  // Set while bytes are forwarded with splice(2) rather than through the connection buffers.
+  SpliceForwarderPtr splice_forwarder_;
+  uint32_t splice_end_streams_{0};
 };
 
 // This class deals with an upstream connection that needs to finish flushing, when the downstream
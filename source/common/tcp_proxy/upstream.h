@@ -179,6 +179,13 @@ public:
   bool startUpstreamSecureTransport() override;
   Ssl::ConnectionInfoConstSharedPtr getUpstreamConnectionSslInfo() override;
 
+  /**
+   * @return the upstream connection, or nullptr once it has been handed over for draining.
+   */
+  Network::ClientConnection* connection() {
+    return upstream_conn_data_ != nullptr ? &upstream_conn_data_->connection() : nullptr;
+  }
+
 private:
   Tcp::ConnectionPool::ConnectionDataPtr upstream_conn_data_;
 };
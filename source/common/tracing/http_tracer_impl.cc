@@ -151,6 +151,13 @@ void HttpTracerUtility::finalizeDownstreamSpan(Span& span,
                                                const Http::ResponseTrailerMap* response_trailers,
                                                const StreamInfo::StreamInfo& stream_info,
                                                const Config& tracing_config) {
+  // Tags of a span that is not going to be reported would only be discarded by the driver, so
+  // skip building them.
+  if (!span.isRecording()) {
+    span.finishSpan();
+    return;
+  }
+
   // Pre response data.
   if (request_headers) {
     if (request_headers->RequestId()) {
@@ -198,6 +205,11 @@ void HttpTracerUtility::finalizeDownstreamSpan(Span& span,
 
 void HttpTracerUtility::finalizeUpstreamSpan(Span& span, const StreamInfo::StreamInfo& stream_info,
                                              const Config& tracing_config) {
+  if (!span.isRecording()) {
+    span.finishSpan();
+    return;
+  }
+
   span.setTag(
       Tracing::Tags::get().HttpProtocol,
       Formatter::SubstitutionFormatUtils::protocolToStringOrDefault(stream_info.protocol()));
@@ -32,6 +32,7 @@ public:
   }
   void setSampled(bool) override {}
   bool useLocalDecision() const override { return false; }
+  bool isRecording() const override { return false; }
 };
 
 } // namespace Tracing
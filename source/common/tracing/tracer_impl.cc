@@ -86,6 +86,11 @@ Decision TracerUtility::shouldTraceRequest(const StreamInfo::StreamInfo& stream_
 
 void TracerUtility::finalizeSpan(Span& span, const StreamInfo::StreamInfo& stream_info,
                                  const Config& tracing_config, bool upstream_span) {
+  if (!span.isRecording()) {
+    span.finishSpan();
+    return;
+  }
+
   span.setTag(Tracing::Tags::get().Component, Tracing::Tags::get().Proxy);
 
   // Response flag.
@@ -144,8 +149,9 @@ SpanPtr TracerImpl::startSpan(const Config& config, TraceContext& trace_context,
   SpanPtr active_span =
       driver_->startSpan(config, trace_context, stream_info, span_name, tracing_decision);
 
-  // Set tags related to the local environment
-  if (active_span) {
+  // Set tags related to the local environment. They are skipped if the span will never be
+  // reported, i.e. it is not recording and the sampling decision cannot be refreshed later.
+  if (active_span && (active_span->isRecording() || active_span->useLocalDecision())) {
     active_span->setTag(Tracing::Tags::get().NodeId, local_info_.nodeName());
     active_span->setTag(Tracing::Tags::get().Zone, local_info_.zoneName());
   }
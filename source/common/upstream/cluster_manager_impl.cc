@@ -43,6 +43,7 @@
 #include "source/common/upstream/load_balancer_context_base.h"
 #include "source/common/upstream/priority_conn_pool_map_impl.h"
 
+#include "absl/container/flat_hash_set.h"
 #include "absl/status/status.h"
 
 #ifdef ENVOY_ENABLE_QUIC
@@ -1188,13 +1189,18 @@ void ClusterManagerImpl::postThreadLocalClusterUpdate(ClusterManagerCluster& cm_
 
   const UnitFloat drop_overload = cm_cluster.cluster().dropOverload();
   const std::string drop_category = cm_cluster.cluster().dropCategory();
+  // The update is shared by all workers. The callback below is copied once per worker when it is
+  // posted, and capturing the host vectors by value would copy every added and removed host
+  // for each worker.
+  const std::shared_ptr<const ThreadLocalClusterUpdateParams> shared_params =
+      std::make_shared<const ThreadLocalClusterUpdateParams>(std::move(params));
   // Populate the cluster initialization object based on this update.
   ClusterInitializationObjectConstSharedPtr cluster_initialization_object =
-      addOrUpdateClusterInitializationObjectIfSupported(params, cm_cluster.cluster().info(),
+      addOrUpdateClusterInitializationObjectIfSupported(*shared_params, cm_cluster.cluster().info(),
                                                         load_balancer_factory, host_map,
                                                         drop_overload, drop_category);
 
-  tls_.runOnAllThreads([info = cm_cluster.cluster().info(), params = std::move(params),
+  tls_.runOnAllThreads([info = cm_cluster.cluster().info(), params = shared_params,
                         add_or_update_cluster, load_balancer_factory, map = std::move(host_map),
                         cluster_initialization_object = std::move(cluster_initialization_object),
                         drop_overload, drop_category = std::move(drop_category)](
@@ -1258,7 +1264,7 @@ void ClusterManagerImpl::postThreadLocalClusterUpdate(ClusterManagerCluster& cm_
         cluster_manager->thread_local_clusters_[info->name()]->setDropOverload(drop_overload);
         cluster_manager->thread_local_clusters_[info->name()]->setDropCategory(drop_category);
       }
-      for (const auto& per_priority : params.per_priority_update_params_) {
+      for (const auto& per_priority : params->per_priority_update_params_) {
         cluster_manager->updateClusterMembership(
             info->name(), per_priority.priority_, per_priority.update_hosts_params_,
             per_priority.locality_weights_, per_priority.hosts_added_, per_priority.hosts_removed_,
@@ -1413,17 +1419,20 @@ ClusterManagerImpl::ClusterInitializationObject::ClusterInitializationObject(
              "Cluster Initialization Object should apply hosts "
              "removed updates to hosts_added vector!");
 
-      // TODO(kbaichoo): replace with a more efficient algorithm. For example
-      // if the EDS cluster exposed the LoadAssignment we could just merge by
+      // TODO(kbaichoo): if the EDS cluster exposed the LoadAssignment we could just merge by
       // overwriting hosts_added.
       if (!update.hosts_removed_.empty()) {
-        // Remove all hosts to be removed from the old host_added.
+        // Remove all hosts to be removed from the old host_added. The removed hosts are looked up
+        // in a set, so that a small update to a large cluster stays linear in the cluster size.
+        absl::flat_hash_set<const Host*> hosts_removed;
+        hosts_removed.reserve(update.hosts_removed_.size());
+        for (const HostSharedPtr& host : update.hosts_removed_) {
+          hosts_removed.insert(host.get());
+        }
         auto& host_added = priority_state.hosts_added_;
-        auto removed_section = std::remove_if(
-            host_added.begin(), host_added.end(),
-            [hosts_removed = std::cref(update.hosts_removed_)](const HostSharedPtr& ptr) {
-              return std::find(hosts_removed.get().begin(), hosts_removed.get().end(), ptr) !=
-                     hosts_removed.get().end();
+        auto removed_section =
+            std::remove_if(host_added.begin(), host_added.end(), [&](const HostSharedPtr& ptr) {
+              return hosts_removed.contains(ptr.get());
             });
         priority_state.hosts_added_.erase(removed_section, priority_state.hosts_added_.end());
       }
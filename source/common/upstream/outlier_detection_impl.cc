@@ -23,6 +23,27 @@ namespace Envoy {
 namespace Upstream {
 namespace Outlier {
 
+namespace {
+
+// Sums fn(value) over all values. Four independent partial sums are used so that the additions
+// do not form a single dependency chain, which lets the compiler vectorize the loop.
+template <class Fn> double unrolledSum(absl::Span<const double> values, Fn fn) {
+  double sums[4] = {0, 0, 0, 0};
+  size_t i = 0;
+  for (; i + 4 <= values.size(); i += 4) {
+    sums[0] += fn(values[i]);
+    sums[1] += fn(values[i + 1]);
+    sums[2] += fn(values[i + 2]);
+    sums[3] += fn(values[i + 3]);
+  }
+  for (; i < values.size(); ++i) {
+    sums[0] += fn(values[i]);
+  }
+  return (sums[0] + sums[1]) + (sums[2] + sums[3]);
+}
+
+} // namespace
+
 absl::StatusOr<DetectorSharedPtr> DetectorImplFactory::createForCluster(
     Cluster& cluster, const envoy::config::cluster::v3::Cluster& cluster_config,
     Event::Dispatcher& dispatcher, Runtime::Loader& runtime, EventLoggerSharedPtr event_logger,
@@ -261,7 +282,9 @@ DetectorConfig::DetectorConfig(const envoy::config::cluster::v3::OutlierDetectio
       max_ejection_time_jitter_ms_(static_cast<uint64_t>(PROTOBUF_GET_MS_OR_DEFAULT(
           config, max_ejection_time_jitter, DEFAULT_MAX_EJECTION_TIME_JITTER_MS))),
       successful_active_health_check_uneject_host_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(
-          config, successful_active_health_check_uneject_host, true)) {}
+          config, successful_active_health_check_uneject_host, true)),
+      max_hosts_per_iteration_(static_cast<uint64_t>(
+          PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, max_hosts_per_iteration, 0))) {}
 
 DetectorImpl::DetectorImpl(const Cluster& cluster,
                            const envoy::config::cluster::v3::OutlierDetection& config,
@@ -275,6 +298,10 @@ DetectorImpl::DetectorImpl(const Cluster& cluster,
   // Insert success rate initial numbers for each type of SR detector
   external_origin_sr_num_ = {-1, -1};
   local_origin_sr_num_ = {-1, -1};
+  if (config_.maxHostsPerIteration() > 0) {
+    interval_continuation_ =
+        dispatcher.createSchedulableCallback([this]() -> void { processIntervalHosts(); });
+  }
 }
 
 DetectorImpl::~DetectorImpl() {
@@ -337,6 +364,10 @@ void DetectorImpl::initialize(Cluster& cluster) {
           }
 
           host_monitors_.erase(host);
+          // Hosts which are part of an ongoing interval sweep are skipped for the rest of it.
+          if (!interval_hosts_.empty()) {
+            hosts_removed_during_interval_.insert(host.get());
+          }
         }
       });
 
@@ -612,9 +643,9 @@ void DetectorImpl::onConsecutiveErrorWorker(HostSharedPtr host,
   }
 }
 
-DetectorImpl::EjectionPair DetectorImpl::successRateEjectionThreshold(
-    double success_rate_sum, const std::vector<HostSuccessRatePair>& valid_success_rate_hosts,
-    double success_rate_stdev_factor) {
+DetectorImpl::EjectionPair
+DetectorImpl::successRateEjectionThreshold(absl::Span<const double> success_rates,
+                                           double success_rate_stdev_factor) {
   // This function is using mean and standard deviation as statistical measures for outlier
   // detection. First the mean is calculated by dividing the sum of success rate data over the
   // number of data points. Then variance is calculated by taking the mean of the
@@ -630,18 +661,40 @@ DetectorImpl::EjectionPair DetectorImpl::successRateEjectionThreshold(
   // variance = 400
   // stdev = 20
   // threshold returned = 52
-  double mean = success_rate_sum / valid_success_rate_hosts.size();
-  double variance = 0;
-  std::for_each(valid_success_rate_hosts.begin(), valid_success_rate_hosts.end(),
-                [&variance, mean](HostSuccessRatePair v) {
-                  variance += std::pow(v.success_rate_ - mean, 2);
-                });
-  variance /= valid_success_rate_hosts.size();
-  double stdev = std::sqrt(variance);
+  ASSERT(!success_rates.empty());
+  const double mean =
+      unrolledSum(success_rates, [](double success_rate) { return success_rate; }) /
+      success_rates.size();
+  const auto squared_difference = [mean](double success_rate) {
+    const double difference = success_rate - mean;
+    return difference * difference;
+  };
+  const double variance = unrolledSum(success_rates, squared_difference) / success_rates.size();
+  const double stdev = std::sqrt(variance);
 
   return {mean, (mean - (success_rate_stdev_factor * stdev))};
 }
 
+void DetectorImpl::sampleSuccessRate(uint32_t index,
+                                     DetectorHostMonitor::SuccessRateMonitorType monitor_type) {
+  const absl::optional<std::pair<double, uint64_t>> success_rate_and_volume =
+      interval_hosts_[index]
+          .monitor_->getSRMonitor(monitor_type)
+          .successRateAccumulator()
+          .getSuccessRateAndVolume();
+  if (!success_rate_and_volume) {
+    return;
+  }
+
+  SuccessRateSamples& samples =
+      (monitor_type == DetectorHostMonitor::SuccessRateMonitorType::ExternalOrigin)
+          ? external_origin_samples_
+          : local_origin_samples_;
+  samples.hosts_.push_back(index);
+  samples.success_rates_.push_back(success_rate_and_volume->first);
+  samples.request_volumes_.push_back(success_rate_and_volume->second);
+}
+
 void DetectorImpl::processSuccessRateEjections(
     DetectorHostMonitor::SuccessRateMonitorType monitor_type) {
   uint64_t success_rate_minimum_hosts = runtime_.snapshot().getInteger(
@@ -653,9 +706,13 @@ void DetectorImpl::processSuccessRateEjections(
   uint64_t failure_percentage_request_volume = runtime_.snapshot().getInteger(
       FailurePercentageRequestVolumeRuntime, config_.failurePercentageRequestVolume());
 
-  std::vector<HostSuccessRatePair> valid_success_rate_hosts;
-  std::vector<HostSuccessRatePair> valid_failure_percentage_hosts;
-  double success_rate_sum = 0;
+  const SuccessRateSamples& samples =
+      (monitor_type == DetectorHostMonitor::SuccessRateMonitorType::ExternalOrigin)
+          ? external_origin_samples_
+          : local_origin_samples_;
+  valid_success_rates_.clear();
+  valid_success_rate_samples_.clear();
+  valid_failure_percentage_samples_.clear();
 
   // Reset the Detector's success rate mean and stdev.
   getSRNums(monitor_type) = {-1, -1};
@@ -666,68 +723,58 @@ void DetectorImpl::processSuccessRateEjections(
     return;
   }
 
-  // reserve upper bound of vector size to avoid reallocation.
-  valid_success_rate_hosts.reserve(host_monitors_.size());
-  valid_failure_percentage_hosts.reserve(host_monitors_.size());
-
-  for (const auto& host : host_monitors_) {
-    // Don't do work if the host is already ejected.
-    if (!host.first->healthFlagGet(Host::HealthFlag::FAILED_OUTLIER_CHECK)) {
-      absl::optional<std::pair<double, uint64_t>> host_success_rate_and_volume =
-          host.second->getSRMonitor(monitor_type)
-              .successRateAccumulator()
-              .getSuccessRateAndVolume();
-
-      if (!host_success_rate_and_volume) {
-        continue;
-      }
-      double success_rate = host_success_rate_and_volume.value().first;
-      double request_volume = host_success_rate_and_volume.value().second;
+  for (uint32_t i = 0; i < samples.hosts_.size(); ++i) {
+    const IntervalHost& interval_host = interval_hosts_[samples.hosts_[i]];
+    // Don't do work if the host is already ejected or is gone. The samples were taken while
+    // walking the hosts, so this also covers hosts ejected by a previous pass of this interval.
+    if (interval_host.host_->healthFlagGet(Host::HealthFlag::FAILED_OUTLIER_CHECK) ||
+        removedDuringInterval(*interval_host.host_)) {
+      continue;
+    }
 
-      if (request_volume >=
-          std::min(success_rate_request_volume, failure_percentage_request_volume)) {
-        host.second->successRate(monitor_type, success_rate);
-      }
+    const uint64_t request_volume = samples.request_volumes_[i];
+    if (request_volume >=
+        std::min(success_rate_request_volume, failure_percentage_request_volume)) {
+      interval_host.monitor_->successRate(monitor_type, samples.success_rates_[i]);
+    }
 
-      if (request_volume >= success_rate_request_volume) {
-        valid_success_rate_hosts.emplace_back(HostSuccessRatePair(host.first, success_rate));
-        success_rate_sum += success_rate;
-      }
-      if (request_volume >= failure_percentage_request_volume) {
-        valid_failure_percentage_hosts.emplace_back(HostSuccessRatePair(host.first, success_rate));
-      }
+    if (request_volume >= success_rate_request_volume) {
+      valid_success_rates_.push_back(samples.success_rates_[i]);
+      valid_success_rate_samples_.push_back(i);
+    }
+    if (request_volume >= failure_percentage_request_volume) {
+      valid_failure_percentage_samples_.push_back(i);
     }
   }
 
-  if (!valid_success_rate_hosts.empty() &&
-      valid_success_rate_hosts.size() >= success_rate_minimum_hosts) {
+  if (!valid_success_rates_.empty() && valid_success_rates_.size() >= success_rate_minimum_hosts) {
     const double success_rate_stdev_factor =
         runtime_.snapshot().getInteger(SuccessRateStdevFactorRuntime,
                                        config_.successRateStdevFactor()) /
         1000.0;
-    getSRNums(monitor_type) = successRateEjectionThreshold(
-        success_rate_sum, valid_success_rate_hosts, success_rate_stdev_factor);
+    getSRNums(monitor_type) =
+        successRateEjectionThreshold(valid_success_rates_, success_rate_stdev_factor);
     const double success_rate_ejection_threshold = getSRNums(monitor_type).ejection_threshold_;
-    for (const auto& host_success_rate_pair : valid_success_rate_hosts) {
-      if (host_success_rate_pair.success_rate_ < success_rate_ejection_threshold) {
+    for (size_t i = 0; i < valid_success_rates_.size(); ++i) {
+      if (valid_success_rates_[i] < success_rate_ejection_threshold) {
+        const IntervalHost& interval_host =
+            interval_hosts_[samples.hosts_[valid_success_rate_samples_[i]]];
         stats_.ejections_success_rate_.inc(); // Deprecated.
         const envoy::data::cluster::v3::OutlierEjectionType type =
-            host_monitors_[host_success_rate_pair.host_]
-                ->getSRMonitor(monitor_type)
-                .getEjectionType();
+            interval_host.monitor_->getSRMonitor(monitor_type).getEjectionType();
         updateDetectedEjectionStats(type);
-        ejectHost(host_success_rate_pair.host_, type);
+        ejectHost(interval_host.host_, type);
       }
     }
   }
 
-  if (!valid_failure_percentage_hosts.empty() &&
-      valid_failure_percentage_hosts.size() >= failure_percentage_minimum_hosts) {
+  if (!valid_failure_percentage_samples_.empty() &&
+      valid_failure_percentage_samples_.size() >= failure_percentage_minimum_hosts) {
     const double failure_percentage_threshold = runtime_.snapshot().getInteger(
         FailurePercentageThresholdRuntime, config_.failurePercentageThreshold());
 
-    for (const auto& host_success_rate_pair : valid_failure_percentage_hosts) {
-      if ((100.0 - host_success_rate_pair.success_rate_) >= failure_percentage_threshold) {
+    for (const uint32_t sample : valid_failure_percentage_samples_) {
+      if ((100.0 - samples.success_rates_[sample]) >= failure_percentage_threshold) {
         // We should eject.
 
         // The ejection type returned by the SuccessRateMonitor's getEjectionType() will be a
@@ -737,38 +784,77 @@ void DetectorImpl::processSuccessRateEjections(
                 ? envoy::data::cluster::v3::FAILURE_PERCENTAGE
                 : envoy::data::cluster::v3::FAILURE_PERCENTAGE_LOCAL_ORIGIN;
         updateDetectedEjectionStats(type);
-        ejectHost(host_success_rate_pair.host_, type);
+        ejectHost(interval_hosts_[samples.hosts_[sample]].host_, type);
       }
     }
   }
 }
 
 void DetectorImpl::onIntervalTimer() {
-  MonotonicTime now = time_source_.monotonicTime();
-
-  for (auto host : host_monitors_) {
-    checkHostForUneject(host.first, host.second, now);
+  // Snapshot the hosts, so the sweep has a stable order to resume from if it is split across
+  // several event loop iterations.
+  interval_start_ = time_source_.monotonicTime();
+  interval_hosts_.reserve(host_monitors_.size());
+  for (const auto& [host, monitor] : host_monitors_) {
+    interval_hosts_.push_back({host, monitor});
+  }
+  next_interval_host_ = 0;
+  external_origin_samples_.clear();
+  local_origin_samples_.clear();
+
+  processIntervalHosts();
+}
+
+void DetectorImpl::processIntervalHosts() {
+  const uint64_t max_hosts_per_iteration = config_.maxHostsPerIteration();
+  const size_t end = (max_hosts_per_iteration == 0)
+                         ? interval_hosts_.size()
+                         : std::min<size_t>(interval_hosts_.size(),
+                                            next_interval_host_ + max_hosts_per_iteration);
+
+  for (; next_interval_host_ < end; ++next_interval_host_) {
+    const IntervalHost& interval_host = interval_hosts_[next_interval_host_];
+    if (removedDuringInterval(*interval_host.host_)) {
+      continue;
+    }
+    checkHostForUneject(interval_host.host_, interval_host.monitor_, interval_start_);
 
     // Need to update the writer bucket to keep the data valid.
-    host.second->updateCurrentSuccessRateBucket();
+    interval_host.monitor_->updateCurrentSuccessRateBucket();
     // Refresh host success rate stat for the /clusters endpoint. If there is a new valid value, it
     // will get updated in processSuccessRateEjections().
-    host.second->successRate(DetectorHostMonitor::SuccessRateMonitorType::LocalOrigin, -1);
-    host.second->successRate(DetectorHostMonitor::SuccessRateMonitorType::ExternalOrigin, -1);
+    interval_host.monitor_->successRate(DetectorHostMonitor::SuccessRateMonitorType::LocalOrigin,
+                                        -1);
+    interval_host.monitor_->successRate(
+        DetectorHostMonitor::SuccessRateMonitorType::ExternalOrigin, -1);
+
+    sampleSuccessRate(static_cast<uint32_t>(next_interval_host_),
+                      DetectorHostMonitor::SuccessRateMonitorType::ExternalOrigin);
+    sampleSuccessRate(static_cast<uint32_t>(next_interval_host_),
+                      DetectorHostMonitor::SuccessRateMonitorType::LocalOrigin);
   }
 
+  if (next_interval_host_ < interval_hosts_.size()) {
+    interval_continuation_->scheduleCallbackNextIteration();
+    return;
+  }
+  finishInterval();
+}
+
+void DetectorImpl::finishInterval() {
   processSuccessRateEjections(DetectorHostMonitor::SuccessRateMonitorType::ExternalOrigin);
   processSuccessRateEjections(DetectorHostMonitor::SuccessRateMonitorType::LocalOrigin);
 
   // Decrement time backoff for all hosts which have not been ejected.
-  for (auto host : host_monitors_) {
-    if (!host.first->healthFlagGet(Host::HealthFlag::FAILED_OUTLIER_CHECK)) {
-      auto& monitor = host.second;
+  const std::chrono::milliseconds interval = std::chrono::milliseconds(
+      runtime_.snapshot().getInteger(IntervalMsRuntime, config_.intervalMs()));
+  for (const IntervalHost& interval_host : interval_hosts_) {
+    if (!interval_host.host_->healthFlagGet(Host::HealthFlag::FAILED_OUTLIER_CHECK) &&
+        !removedDuringInterval(*interval_host.host_)) {
+      auto& monitor = interval_host.monitor_;
       // Node is healthy and was not ejected since the last check.
       if (monitor->lastUnejectionTime().has_value() &&
-          ((now - monitor->lastUnejectionTime().value()) >=
-           std::chrono::milliseconds(
-               runtime_.snapshot().getInteger(IntervalMsRuntime, config_.intervalMs())))) {
+          ((interval_start_ - monitor->lastUnejectionTime().value()) >= interval)) {
         if (monitor->ejectTimeBackoff() != 0) {
           monitor->ejectTimeBackoff()--;
         }
@@ -776,6 +862,9 @@ void DetectorImpl::onIntervalTimer() {
     }
   }
 
+  interval_hosts_.clear();
+  hosts_removed_during_interval_.clear();
+  // The timer is only re-armed once the sweep is done, so sweeps never overlap.
   armIntervalTimer();
 }
 
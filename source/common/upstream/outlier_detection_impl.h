@@ -14,6 +14,7 @@
 #include "envoy/config/cluster/v3/cluster.pb.h"
 #include "envoy/config/cluster/v3/outlier_detection.pb.h"
 #include "envoy/data/cluster/v3/outlier_detection_event.pb.h"
+#include "envoy/event/schedulable_cb.h"
 #include "envoy/event/timer.h"
 #include "envoy/http/codes.h"
 #include "envoy/runtime/runtime.h"
@@ -23,7 +24,9 @@
 
 #include "source/common/upstream/upstream_impl.h"
 
+#include "absl/container/flat_hash_set.h"
 #include "absl/container/node_hash_map.h"
+#include "absl/types/span.h"
 
 namespace Envoy {
 namespace Upstream {
@@ -40,16 +43,6 @@ public:
                    EventLoggerSharedPtr event_logger, Random::RandomGenerator& random);
 };
 
-/**
- * Thin struct to facilitate calculations for success rate outlier detection.
- */
-struct HostSuccessRatePair {
-  HostSuccessRatePair(HostSharedPtr host, double success_rate)
-      : host_(host), success_rate_(success_rate) {}
-  HostSharedPtr host_;
-  double success_rate_;
-};
-
 struct SuccessRateAccumulatorBucket {
   std::atomic<uint64_t> success_request_counter_;
   std::atomic<uint64_t> total_request_counter_;
@@ -318,6 +311,7 @@ public:
   bool successfulActiveHealthCheckUnejectHost() const {
     return successful_active_health_check_uneject_host_;
   }
+  uint64_t maxHostsPerIteration() const { return max_hosts_per_iteration_; }
 
 private:
   const uint64_t interval_ms_;
@@ -344,6 +338,7 @@ private:
   const uint64_t max_ejection_time_ms_;
   const uint64_t max_ejection_time_jitter_ms_;
   const bool successful_active_health_check_uneject_host_;
+  const uint64_t max_hosts_per_iteration_;
 
   static constexpr uint64_t DEFAULT_INTERVAL_MS = 10000;
   static constexpr uint64_t DEFAULT_BASE_EJECTION_TIME_MS = 30000;
@@ -403,19 +398,16 @@ public:
    * This function returns pair of double values for success rate outlier detection. The pair
    * contains the average success rate of all valid hosts in the cluster and the ejection threshold.
    * If a host's success rate is under this threshold, the host is an outlier.
-   * @param success_rate_sum is the sum of the data in the success_rate_data vector.
-   * @param valid_success_rate_hosts is the vector containing the individual success rate data
-   *        points.
+   * @param success_rates are the individual success rate data points. They must not be empty.
+   * @param success_rate_stdev_factor is the factor applied to the standard deviation.
    * @return EjectionPair
    */
   struct EjectionPair {
     double success_rate_average_; // average success rate of all valid hosts in the cluster
     double ejection_threshold_;   // ejection threshold for the cluster
   };
-  static EjectionPair
-  successRateEjectionThreshold(double success_rate_sum,
-                               const std::vector<HostSuccessRatePair>& valid_success_rate_hosts,
-                               double success_rate_stdev_factor);
+  static EjectionPair successRateEjectionThreshold(absl::Span<const double> success_rates,
+                                                   double success_rate_stdev_factor);
 
   const absl::node_hash_map<HostSharedPtr, DetectorHostMonitorImpl*>& getHostMonitors() {
     return host_monitors_;
@@ -437,6 +429,13 @@ private:
   void notifyMainThreadConsecutiveError(HostSharedPtr host,
                                         envoy::data::cluster::v3::OutlierEjectionType type);
   void onIntervalTimer();
+  void processIntervalHosts();
+  void finishInterval();
+  bool removedDuringInterval(const Host& host) const {
+    return !hosts_removed_during_interval_.empty() &&
+           hosts_removed_during_interval_.contains(&host);
+  }
+  void sampleSuccessRate(uint32_t index, DetectorHostMonitor::SuccessRateMonitorType monitor_type);
   void runCallbacks(HostSharedPtr host);
   bool enforceEjection(envoy::data::cluster::v3::OutlierEjectionType type);
   void updateEnforcedEjectionStats(envoy::data::cluster::v3::OutlierEjectionType type);
@@ -460,6 +459,28 @@ private:
     Envoy::Stats::Gauge& ejections_active_ref_;
     std::atomic<uint64_t> ejections_active_value_{0};
   };
+
+  // A host visited by the current interval sweep. The host reference keeps the monitor alive
+  // even if the host is removed from the cluster before the sweep completes.
+  struct IntervalHost {
+    HostSharedPtr host_;
+    DetectorHostMonitorImpl* monitor_;
+  };
+
+  // Success rate samples taken during the current interval sweep, stored as parallel arrays so
+  // that the statistics are computed over contiguous memory instead of chasing every host.
+  struct SuccessRateSamples {
+    void clear() {
+      hosts_.clear();
+      success_rates_.clear();
+      request_volumes_.clear();
+    }
+
+    std::vector<uint32_t> hosts_; // Index into interval_hosts_.
+    std::vector<double> success_rates_;
+    std::vector<uint64_t> request_volumes_;
+  };
+
   DetectorConfig config_;
   Event::Dispatcher& dispatcher_;
   Runtime::Loader& runtime_;
@@ -467,12 +488,25 @@ private:
   DetectionStats stats_;
   EjectionsActiveHelper ejections_active_helper_{stats_.ejections_active_};
   Event::TimerPtr interval_timer_;
+  // Only created when the interval sweep is split across event loop iterations.
+  Event::SchedulableCallbackPtr interval_continuation_;
   std::list<ChangeStateCb> callbacks_;
   absl::node_hash_map<HostSharedPtr, DetectorHostMonitorImpl*> host_monitors_;
   EventLoggerSharedPtr event_logger_;
   Common::CallbackHandlePtr member_update_cb_;
   Random::RandomGenerator& random_generator_;
 
+  // State of the interval sweep. It is reused across intervals to avoid reallocations.
+  MonotonicTime interval_start_;
+  std::vector<IntervalHost> interval_hosts_;
+  size_t next_interval_host_{};
+  absl::flat_hash_set<const Host*> hosts_removed_during_interval_;
+  SuccessRateSamples external_origin_samples_;
+  SuccessRateSamples local_origin_samples_;
+  std::vector<double> valid_success_rates_;
+  std::vector<uint32_t> valid_success_rate_samples_;
+  std::vector<uint32_t> valid_failure_percentage_samples_;
+
   // EjectionPair for external and local origin events.
   // When external/local origin events are not split, external_origin_sr_num_ are used for
   // both types of events: external and local. local_origin_sr_num_ is not used.
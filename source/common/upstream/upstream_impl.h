@@ -945,6 +945,7 @@ public:
   }
 
   void createNetworkFilterChain(Network::Connection&) const override;
+  bool hasNetworkFilters() const override { return !filter_factories_.empty(); }
   std::vector<Http::Protocol>
   upstreamHttpProtocol(absl::optional<Http::Protocol> downstream_protocol) const override;
 
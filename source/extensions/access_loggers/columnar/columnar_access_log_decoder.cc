@@ -0,0 +1,63 @@
+/**
+ * Converts a file written by the columnar access log to one JSON object per entry.
+ *
+ * Usage:
+ *
+ * columnar_access_log_decoder <columnar access log path>
+ */
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+#include "source/common/json/json_streamer.h"
+#include "source/extensions/access_loggers/columnar/columnar_format.h"
+
+// NOLINT(namespace-envoy)
+int main(int argc, char** argv) {
+  if (argc != 2) {
+    std::cerr << "Usage: " << argv[0] << " <columnar access log path>" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::ifstream file(argv[1], std::ios::binary);
+  if (!file) {
+    std::cerr << "Unable to open " << argv[1] << std::endl;
+    return EXIT_FAILURE;
+  }
+  std::stringstream contents;
+  contents << file.rdbuf();
+  const std::string data = contents.str();
+
+  absl::string_view input = data;
+  std::string line;
+  while (!input.empty()) {
+    auto block_or_error = Envoy::Extensions::AccessLoggers::Columnar::decodeBlock(input);
+    if (!block_or_error.ok()) {
+      std::cerr << "Offset " << data.size() - input.size() << ": "
+                << block_or_error.status().message() << std::endl;
+      return EXIT_FAILURE;
+    }
+    const auto& block = block_or_error.value();
+    for (uint32_t row = 0; row < block.rows; row++) {
+      line.clear();
+      {
+        Envoy::Json::StringStreamer streamer(line);
+        auto map = streamer.makeRootMap();
+        for (size_t column = 0; column < block.schema.size(); column++) {
+          map->addKey(block.schema[column].name);
+          const auto& value = block.columns[column][row];
+          if (absl::holds_alternative<uint64_t>(value)) {
+            map->addNumber(absl::get<uint64_t>(value));
+          } else if (absl::holds_alternative<std::string>(value)) {
+            map->addString(absl::get<std::string>(value));
+          } else {
+            map->addNull();
+          }
+        }
+      }
+      std::cout << line << "\n";
+    }
+  }
+  return EXIT_SUCCESS;
+}
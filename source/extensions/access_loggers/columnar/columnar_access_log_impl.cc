@@ -0,0 +1,185 @@
+#include "source/extensions/access_loggers/columnar/columnar_access_log_impl.h"
+
+#include "envoy/upstream/upstream.h"
+
+#include "source/common/http/utility.h"
+#include "source/common/stream_info/utility.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace AccessLoggers {
+namespace Columnar {
+namespace {
+
+using ColumnarAccessLogProto = envoy::extensions::access_loggers::columnar::v3::ColumnarAccessLog;
+
+ColumnType columnType(Field field) {
+  switch (field) {
+  case ColumnarAccessLogProto::START_TIME:
+  case ColumnarAccessLogProto::DURATION:
+  case ColumnarAccessLogProto::RESPONSE_CODE:
+  case ColumnarAccessLogProto::BYTES_RECEIVED:
+  case ColumnarAccessLogProto::BYTES_SENT:
+    return ColumnType::UInt64;
+  default:
+    return ColumnType::String;
+  }
+}
+
+void addDuration(BlockEncoder& encoder, absl::optional<std::chrono::nanoseconds> duration) {
+  if (duration.has_value()) {
+    encoder.addUInt64(
+        std::chrono::duration_cast<std::chrono::microseconds>(duration.value()).count());
+  } else {
+    encoder.addNull();
+  }
+}
+
+void addString(BlockEncoder& encoder, absl::string_view value) {
+  if (value.empty()) {
+    encoder.addNull();
+  } else {
+    encoder.addString(value);
+  }
+}
+
+void addField(BlockEncoder& encoder, Field field, const StreamInfo::StreamInfo& stream_info) {
+  switch (field) {
+  case ColumnarAccessLogProto::START_TIME:
+    encoder.addUInt64(std::chrono::duration_cast<std::chrono::microseconds>(
+                          stream_info.startTime().time_since_epoch())
+                          .count());
+    return;
+  case ColumnarAccessLogProto::DURATION:
+    addDuration(encoder, stream_info.requestComplete());
+    return;
+  case ColumnarAccessLogProto::RESPONSE_CODE:
+    if (stream_info.responseCode().has_value()) {
+      encoder.addUInt64(stream_info.responseCode().value());
+    } else {
+      encoder.addNull();
+    }
+    return;
+  case ColumnarAccessLogProto::RESPONSE_CODE_DETAILS:
+    if (stream_info.responseCodeDetails().has_value()) {
+      addString(encoder, stream_info.responseCodeDetails().value());
+    } else {
+      encoder.addNull();
+    }
+    return;
+  case ColumnarAccessLogProto::RESPONSE_FLAGS:
+    addString(encoder, StreamInfo::ResponseFlagUtils::toShortString(stream_info));
+    return;
+  case ColumnarAccessLogProto::BYTES_RECEIVED:
+    encoder.addUInt64(stream_info.bytesReceived());
+    return;
+  case ColumnarAccessLogProto::BYTES_SENT:
+    encoder.addUInt64(stream_info.bytesSent());
+    return;
+  case ColumnarAccessLogProto::PROTOCOL:
+    if (stream_info.protocol().has_value()) {
+      encoder.addString(Http::Utility::getProtocolString(stream_info.protocol().value()));
+    } else {
+      encoder.addNull();
+    }
+    return;
+  case ColumnarAccessLogProto::DOWNSTREAM_REMOTE_ADDRESS: {
+    const auto& address = stream_info.downstreamAddressProvider().remoteAddress();
+    if (address != nullptr) {
+      encoder.addString(address->asStringView());
+    } else {
+      encoder.addNull();
+    }
+    return;
+  }
+  case ColumnarAccessLogProto::UPSTREAM_HOST: {
+    const auto upstream_info = stream_info.upstreamInfo();
+    if (upstream_info.has_value() && upstream_info->upstreamHost() != nullptr) {
+      encoder.addString(upstream_info->upstreamHost()->address()->asStringView());
+    } else {
+      encoder.addNull();
+    }
+    return;
+  }
+  case ColumnarAccessLogProto::UPSTREAM_CLUSTER: {
+    const auto cluster_info = stream_info.upstreamClusterInfo();
+    if (cluster_info.has_value() && cluster_info.value() != nullptr) {
+      addString(encoder, cluster_info.value()->observabilityName());
+    } else {
+      encoder.addNull();
+    }
+    return;
+  }
+  case ColumnarAccessLogProto::ROUTE_NAME:
+    addString(encoder, stream_info.getRouteName());
+    return;
+  case ColumnarAccessLogProto::STREAM_ID: {
+    const auto provider = stream_info.getStreamIdProvider();
+    addString(encoder, provider.has_value() ? provider->toStringView().value_or("") : "");
+    return;
+  }
+  default:
+    PANIC_DUE_TO_CORRUPT_ENUM;
+  }
+}
+
+} // namespace
+
+Schema schemaForFields(const std::vector<Field>& fields) {
+  Schema schema;
+  schema.reserve(fields.size());
+  for (const Field field : fields) {
+    schema.push_back(Column{static_cast<uint32_t>(field), columnType(field),
+                            ColumnarAccessLogProto::Field_Name(field)});
+  }
+  return schema;
+}
+
+ColumnarAccessLog::ThreadLocalBlock::ThreadLocalBlock(ColumnarAccessLogConfigSharedPtr config,
+                                                      Event::Dispatcher& dispatcher)
+    : config_(std::move(config)),
+      encoder_(schemaForFields(config_->fields_), config_->compression_level_),
+      flush_timer_(dispatcher.createTimer([this]() { flush(); })) {}
+
+ColumnarAccessLog::ThreadLocalBlock::~ThreadLocalBlock() { flush(); }
+
+void ColumnarAccessLog::ThreadLocalBlock::log(const StreamInfo::StreamInfo& stream_info) {
+  for (const Field field : config_->fields_) {
+    addField(encoder_, field, stream_info);
+  }
+  if (encoder_.rows() >= config_->max_entries_per_block_) {
+    flush();
+  } else if (encoder_.rows() == 1) {
+    flush_timer_->enableTimer(config_->flush_interval_);
+  }
+}
+
+void ColumnarAccessLog::ThreadLocalBlock::flush() {
+  flush_timer_->disableTimer();
+  if (encoder_.rows() == 0) {
+    return;
+  }
+  output_.clear();
+  encoder_.finishBlock(output_);
+  // Written with a single call, so that blocks of different threads are not interleaved.
+  config_->log_file_->write(output_);
+}
+
+ColumnarAccessLog::ColumnarAccessLog(AccessLog::FilterPtr&& filter,
+                                     ColumnarAccessLogConfigSharedPtr config,
+                                     ThreadLocal::SlotAllocator& tls)
+    : Common::ImplBase(std::move(filter)), tls_slot_(tls.allocateSlot()) {
+  tls_slot_->set([config = std::move(config)](Event::Dispatcher& dispatcher) {
+    return std::make_shared<ThreadLocalBlock>(config, dispatcher);
+  });
+}
+
+void ColumnarAccessLog::emitLog(const Formatter::Context&,
+                                const StreamInfo::StreamInfo& stream_info) {
+  tls_slot_->getTyped<ThreadLocalBlock>().log(stream_info);
+}
+
+} // namespace Columnar
+} // namespace AccessLoggers
+} // namespace Extensions
+} // namespace Envoy
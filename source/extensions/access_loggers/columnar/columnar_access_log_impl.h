@@ -0,0 +1,84 @@
+#pragma once
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "envoy/access_log/access_log.h"
+#include "envoy/event/dispatcher.h"
+#include "envoy/event/timer.h"
+#include "envoy/extensions/access_loggers/columnar/v3/columnar.pb.h"
+#include "envoy/thread_local/thread_local.h"
+
+#include "source/extensions/access_loggers/columnar/columnar_format.h"
+#include "source/extensions/access_loggers/common/access_log_base.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace AccessLoggers {
+namespace Columnar {
+
+using Field = envoy::extensions::access_loggers::columnar::v3::ColumnarAccessLog::Field;
+
+/**
+ * @return Schema the columns of the fields, in the same order.
+ */
+Schema schemaForFields(const std::vector<Field>& fields);
+
+/**
+ * Settings shared by the access log and its per-thread blocks, which can outlive the access log.
+ */
+struct ColumnarAccessLogConfig {
+  std::vector<Field> fields_;
+  uint32_t max_entries_per_block_;
+  std::chrono::milliseconds flush_interval_;
+  uint32_t compression_level_;
+  AccessLog::AccessLogFileSharedPtr log_file_;
+};
+
+using ColumnarAccessLogConfigSharedPtr = std::shared_ptr<const ColumnarAccessLogConfig>;
+
+/**
+ * Access log Instance that writes selected stream info fields to a file in the columnar format.
+ * Every thread encodes its entries into a block of its own, so entries are neither formatted nor
+ * written one by one, and writes a compressed block when it is full or at the flush interval.
+ */
+class ColumnarAccessLog : public Common::ImplBase {
+public:
+  ColumnarAccessLog(AccessLog::FilterPtr&& filter, ColumnarAccessLogConfigSharedPtr config,
+                    ThreadLocal::SlotAllocator& tls);
+
+private:
+  /**
+   * Per-thread block of entries.
+   */
+  class ThreadLocalBlock : public ThreadLocal::ThreadLocalObject {
+  public:
+    ThreadLocalBlock(ColumnarAccessLogConfigSharedPtr config, Event::Dispatcher& dispatcher);
+    // Writes the entries that are still buffered.
+    ~ThreadLocalBlock() override;
+
+    void log(const StreamInfo::StreamInfo& stream_info);
+
+  private:
+    void flush();
+
+    const ColumnarAccessLogConfigSharedPtr config_;
+    BlockEncoder encoder_;
+    const Event::TimerPtr flush_timer_;
+    // Reused across blocks.
+    std::string output_;
+  };
+
+  // Common::ImplBase
+  void emitLog(const Formatter::Context& context,
+               const StreamInfo::StreamInfo& stream_info) override;
+
+  const ThreadLocal::SlotPtr tls_slot_;
+};
+
+} // namespace Columnar
+} // namespace AccessLoggers
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,262 @@
+#include "source/extensions/access_loggers/columnar/columnar_format.h"
+
+#include "source/common/buffer/buffer_impl.h"
+#include "source/common/common/assert.h"
+#include "source/common/common/fmt.h"
+#include "source/common/compression/zstd/compressor/zstd_compressor_impl_base.h"
+
+#include "absl/strings/match.h"
+#include "absl/strings/str_cat.h"
+#include "zstd.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace AccessLoggers {
+namespace Columnar {
+namespace {
+
+void appendVarint(std::string& output, uint64_t value) {
+  while (value >= 0x80) {
+    output.push_back(static_cast<char>(value | 0x80));
+    value >>= 7;
+  }
+  output.push_back(static_cast<char>(value));
+}
+
+bool readVarint(absl::string_view& input, uint64_t& value) {
+  value = 0;
+  for (uint32_t shift = 0; shift < 64 && !input.empty(); shift += 7) {
+    const uint8_t byte = static_cast<uint8_t>(input.front());
+    input.remove_prefix(1);
+    value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+    if ((byte & 0x80) == 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Larger than any block that the encoder writes, and small enough to allocate.
+constexpr uint64_t MaxPayloadSize = 256 * 1024 * 1024;
+
+absl::Status truncatedError(absl::string_view what) {
+  return absl::InvalidArgumentError(absl::StrCat("truncated columnar access log block: ", what));
+}
+
+} // namespace
+
+/**
+ * Compresses each block into a zstd frame of its own, with a checksum so that a corrupted block
+ * is detected. The context is reused across blocks.
+ */
+class BlockEncoder::Compressor
+    : public Envoy::Compression::Zstd::Compressor::ZstdCompressorImplBase {
+public:
+  explicit Compressor(uint32_t compression_level)
+      : ZstdCompressorImplBase(compression_level, /*enable_checksum=*/true,
+                               /*strategy=*/0, /*chunk_size=*/4096) {
+    const size_t result =
+        ZSTD_CCtx_setParameter(cctx_.get(), ZSTD_c_compressionLevel, compression_level_);
+    RELEASE_ASSERT(!ZSTD_isError(result), "");
+  }
+
+private:
+  // ZstdCompressorImplBase
+  void compressPreprocess(Buffer::Instance&, Envoy::Compression::Compressor::State) override {}
+  void compressProcess(const Buffer::Instance&, const Buffer::RawSlice& input_slice,
+                       Buffer::Instance& accumulation_buffer) override {
+    setInput(input_slice);
+    process(accumulation_buffer, ZSTD_e_continue);
+  }
+  void compressPostprocess(Buffer::Instance&) override {}
+};
+
+BlockEncoder::BlockEncoder(Schema schema, uint32_t compression_level)
+    : schema_(std::move(schema)), columns_(schema_.size()),
+      compressor_(std::make_unique<Compressor>(compression_level)) {
+  ASSERT(!schema_.empty());
+  header_.append(BlockMagic.data(), BlockMagic.size());
+  appendVarint(header_, FormatVersion);
+  appendVarint(header_, schema_.size());
+  for (const Column& column : schema_) {
+    appendVarint(header_, column.field);
+    header_.push_back(static_cast<char>(column.type));
+    appendVarint(header_, column.name.size());
+    header_.append(column.name);
+  }
+}
+
+BlockEncoder::~BlockEncoder() = default;
+
+BlockEncoder::ColumnData& BlockEncoder::nextColumn(bool valid) {
+  ColumnData& column = columns_[next_column_];
+  if (rows_ % 8 == 0) {
+    column.validity_.push_back(0);
+  }
+  if (valid) {
+    column.validity_.back() |= 1 << (rows_ % 8);
+  }
+  if (++next_column_ == columns_.size()) {
+    next_column_ = 0;
+    rows_++;
+  }
+  return column;
+}
+
+void BlockEncoder::addUInt64(uint64_t value) {
+  ASSERT(schema_[next_column_].type == ColumnType::UInt64);
+  appendVarint(nextColumn(true).values_, value);
+}
+
+void BlockEncoder::addString(absl::string_view value) {
+  ASSERT(schema_[next_column_].type == ColumnType::String);
+  ColumnData& column = nextColumn(true);
+  appendVarint(column.values_, value.size());
+  column.bytes_.append(value.data(), value.size());
+}
+
+void BlockEncoder::addNull() { nextColumn(false); }
+
+void BlockEncoder::finishBlock(std::string& output) {
+  ASSERT(next_column_ == 0);
+  if (rows_ == 0) {
+    return;
+  }
+
+  payload_.clear();
+  for (ColumnData& column : columns_) {
+    payload_.append(reinterpret_cast<const char*>(column.validity_.data()),
+                    column.validity_.size());
+    payload_.append(column.values_);
+    payload_.append(column.bytes_);
+    column.clear();
+  }
+
+  Buffer::OwnedImpl compressed;
+  compressed.add(payload_);
+  compressor_->compress(compressed, Envoy::Compression::Compressor::State::Finish);
+
+  output.append(header_);
+  appendVarint(output, rows_);
+  appendVarint(output, payload_.size());
+  appendVarint(output, compressed.length());
+  for (const Buffer::RawSlice& slice : compressed.getRawSlices()) {
+    output.append(static_cast<const char*>(slice.mem_), slice.len_);
+  }
+  rows_ = 0;
+}
+
+absl::StatusOr<DecodedBlock> decodeBlock(absl::string_view& input) {
+  if (!absl::StartsWith(input, BlockMagic)) {
+    return absl::InvalidArgumentError("columnar access log block does not start with the magic");
+  }
+  input.remove_prefix(BlockMagic.size());
+
+  uint64_t version;
+  if (!readVarint(input, version)) {
+    return truncatedError("version");
+  }
+  if (version != FormatVersion) {
+    return absl::InvalidArgumentError(
+        fmt::format("unsupported columnar access log format version {}", version));
+  }
+
+  DecodedBlock block;
+  uint64_t column_count;
+  if (!readVarint(input, column_count) || column_count > input.size()) {
+    return truncatedError("schema");
+  }
+  for (uint64_t i = 0; i < column_count; i++) {
+    uint64_t field;
+    uint64_t name_size;
+    if (!readVarint(input, field) || input.empty()) {
+      return truncatedError("schema");
+    }
+    const uint8_t type = static_cast<uint8_t>(input.front());
+    input.remove_prefix(1);
+    if (type > static_cast<uint8_t>(ColumnType::String)) {
+      return absl::InvalidArgumentError(fmt::format("unknown column type {}", type));
+    }
+    if (!readVarint(input, name_size) || name_size > input.size()) {
+      return truncatedError("schema");
+    }
+    block.schema.push_back(Column{static_cast<uint32_t>(field), static_cast<ColumnType>(type),
+                                  std::string(input.substr(0, name_size))});
+    input.remove_prefix(name_size);
+  }
+
+  uint64_t rows;
+  uint64_t payload_size;
+  uint64_t compressed_size;
+  if (!readVarint(input, rows) || !readVarint(input, payload_size) ||
+      !readVarint(input, compressed_size) || compressed_size > input.size()) {
+    return truncatedError("payload");
+  }
+  if (payload_size > MaxPayloadSize) {
+    return absl::InvalidArgumentError("columnar access log block payload is too large");
+  }
+  // Every row takes at least one bit in every column, so this bounds the allocations below.
+  if (rows > payload_size * 8) {
+    return absl::InvalidArgumentError("columnar access log block has more rows than data");
+  }
+  std::string payload(payload_size, '\0');
+  const size_t result =
+      ZSTD_decompress(payload.data(), payload.size(), input.data(), compressed_size);
+  if (ZSTD_isError(result) || result != payload_size) {
+    return absl::InvalidArgumentError("columnar access log block payload cannot be decompressed");
+  }
+  input.remove_prefix(compressed_size);
+
+  block.rows = static_cast<uint32_t>(rows);
+  block.columns.resize(block.schema.size());
+  absl::string_view data = payload;
+  const uint64_t validity_size = (rows + 7) / 8;
+  for (size_t i = 0; i < block.schema.size(); i++) {
+    if (validity_size > data.size()) {
+      return truncatedError("validity");
+    }
+    const absl::string_view validity = data.substr(0, validity_size);
+    data.remove_prefix(validity_size);
+
+    std::vector<DecodedBlock::Value>& values = block.columns[i];
+    values.resize(rows);
+    std::vector<uint64_t> lengths;
+    for (uint64_t row = 0; row < rows; row++) {
+      if ((static_cast<uint8_t>(validity[row / 8]) & (1 << (row % 8))) == 0) {
+        continue;
+      }
+      uint64_t value;
+      if (!readVarint(data, value)) {
+        return truncatedError("values");
+      }
+      if (block.schema[i].type == ColumnType::UInt64) {
+        values[row] = value;
+      } else {
+        lengths.push_back(value);
+      }
+    }
+    if (block.schema[i].type == ColumnType::String) {
+      size_t next = 0;
+      for (uint64_t row = 0; row < rows; row++) {
+        if ((static_cast<uint8_t>(validity[row / 8]) & (1 << (row % 8))) == 0) {
+          continue;
+        }
+        const uint64_t length = lengths[next++];
+        if (length > data.size()) {
+          return truncatedError("strings");
+        }
+        values[row] = std::string(data.substr(0, length));
+        data.remove_prefix(length);
+      }
+    }
+  }
+  if (!data.empty()) {
+    return absl::InvalidArgumentError("columnar access log block has trailing payload data");
+  }
+  return block;
+}
+
+} // namespace Columnar
+} // namespace AccessLoggers
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,129 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/optional.h"
+#include "absl/types/variant.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace AccessLoggers {
+namespace Columnar {
+
+/**
+ * The on-disk format of the columnar access log. A file is a sequence of blocks, each of which
+ * is self-describing:
+ *
+ *   magic "ECAL"
+ *   varint  format version
+ *   varint  column count, followed for each column by
+ *             varint field, uint8 type, varint name length, name
+ *   varint  row count
+ *   varint  uncompressed payload size
+ *   varint  compressed payload size
+ *   bytes   zstd frame with the payload
+ *
+ * The payload holds the columns one after the other. Each column starts with a validity bitmap
+ * of one bit per row, least significant bit first, where a cleared bit is an absent value. It is
+ * followed by one varint per present value for UINT64 columns. STRING columns have one varint
+ * length per present value, followed by the concatenated bytes of all present values.
+ */
+constexpr absl::string_view BlockMagic = "ECAL";
+constexpr uint32_t FormatVersion = 1;
+
+enum class ColumnType : uint8_t {
+  UInt64 = 0,
+  String = 1,
+};
+
+struct Column {
+  // Identifies the value logged in the column, see the Field enum of the configuration.
+  uint32_t field;
+  ColumnType type;
+  std::string name;
+};
+
+using Schema = std::vector<Column>;
+
+/**
+ * Buffers rows of a block column by column, and encodes them into a compressed block.
+ * Each row must have exactly one value added for each column, in column order.
+ */
+class BlockEncoder {
+public:
+  BlockEncoder(Schema schema, uint32_t compression_level);
+  ~BlockEncoder();
+
+  void addUInt64(uint64_t value);
+  void addString(absl::string_view value);
+  void addNull();
+
+  /**
+   * @return uint32_t the number of complete rows in the block.
+   */
+  uint32_t rows() const { return rows_; }
+
+  /**
+   * Appends the encoded block to the output and starts a new block. Does nothing if there are no
+   * rows.
+   */
+  void finishBlock(std::string& output);
+
+  const Schema& schema() const { return schema_; }
+
+private:
+  class Compressor;
+
+  struct ColumnData {
+    void clear() {
+      validity_.clear();
+      values_.clear();
+      bytes_.clear();
+    }
+
+    std::vector<uint8_t> validity_;
+    // Varint values for UINT64 columns, or varint lengths for STRING columns.
+    std::string values_;
+    // Concatenated values of STRING columns.
+    std::string bytes_;
+  };
+
+  ColumnData& nextColumn(bool valid);
+
+  const Schema schema_;
+  std::vector<ColumnData> columns_;
+  // Encoded schema, which is the same for every block.
+  std::string header_;
+  std::unique_ptr<Compressor> compressor_;
+  std::string payload_;
+  uint32_t rows_{};
+  uint32_t next_column_{};
+};
+
+/**
+ * A decoded block. Absent values are absl::monostate.
+ */
+struct DecodedBlock {
+  using Value = absl::variant<absl::monostate, uint64_t, std::string>;
+
+  Schema schema;
+  uint32_t rows{};
+  // Values of each column, indexed by column and then by row.
+  std::vector<std::vector<Value>> columns;
+};
+
+/**
+ * Decodes the block at the start of the input, and removes it from the input.
+ * @return the decoded block, or an error if the input does not start with a valid block.
+ */
+absl::StatusOr<DecodedBlock> decodeBlock(absl::string_view& input);
+
+} // namespace Columnar
+} // namespace AccessLoggers
+} // namespace Extensions
+} // namespace Envoy
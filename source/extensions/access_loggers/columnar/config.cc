@@ -0,0 +1,59 @@
+#include "source/extensions/access_loggers/columnar/config.h"
+
+#include <memory>
+
+#include "envoy/extensions/access_loggers/columnar/v3/columnar.pb.h"
+#include "envoy/extensions/access_loggers/columnar/v3/columnar.pb.validate.h"
+#include "envoy/registry/registry.h"
+
+#include "source/common/protobuf/utility.h"
+#include "source/extensions/access_loggers/columnar/columnar_access_log_impl.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace AccessLoggers {
+namespace Columnar {
+
+AccessLog::InstanceSharedPtr ColumnarAccessLogFactory::createAccessLogInstance(
+    const Protobuf::Message& config, AccessLog::FilterPtr&& filter,
+    Server::Configuration::GenericFactoryContext& context,
+    std::vector<Formatter::CommandParserPtr>&&) {
+  const auto& proto_config = MessageUtil::downcastAndValidate<
+      const envoy::extensions::access_loggers::columnar::v3::ColumnarAccessLog&>(
+      config, context.messageValidationVisitor());
+  auto& server_context = context.serverFactoryContext();
+
+  auto log_config = std::make_shared<ColumnarAccessLogConfig>();
+  for (const int field : proto_config.fields()) {
+    log_config->fields_.push_back(static_cast<Field>(field));
+  }
+  log_config->max_entries_per_block_ =
+      PROTOBUF_GET_WRAPPED_OR_DEFAULT(proto_config, max_entries_per_block, 1024);
+  log_config->flush_interval_ = std::chrono::milliseconds(
+      PROTOBUF_GET_MS_OR_DEFAULT(proto_config, flush_interval, 1000));
+  log_config->compression_level_ =
+      PROTOBUF_GET_WRAPPED_OR_DEFAULT(proto_config, compression_level, 3);
+  log_config->log_file_ = THROW_OR_RETURN_VALUE(
+      server_context.accessLogManager().createAccessLog(
+          Filesystem::FilePathAndType{Filesystem::DestinationType::File, proto_config.path()}),
+      AccessLog::AccessLogFileSharedPtr);
+
+  return std::make_shared<ColumnarAccessLog>(std::move(filter), std::move(log_config),
+                                             server_context.threadLocal());
+}
+
+ProtobufTypes::MessagePtr ColumnarAccessLogFactory::createEmptyConfigProto() {
+  return std::make_unique<envoy::extensions::access_loggers::columnar::v3::ColumnarAccessLog>();
+}
+
+std::string ColumnarAccessLogFactory::name() const { return "envoy.access_loggers.columnar"; }
+
+/**
+ * Static registration for the columnar access log. @see RegisterFactory.
+ */
+REGISTER_FACTORY(ColumnarAccessLogFactory, AccessLog::AccessLogInstanceFactory);
+
+} // namespace Columnar
+} // namespace AccessLoggers
+} // namespace Extensions
+} // namespace Envoy
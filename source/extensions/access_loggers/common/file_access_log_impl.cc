@@ -5,6 +5,12 @@ namespace Extensions {
 namespace AccessLoggers {
 namespace File {
 
+namespace {
+
+constexpr size_t MaxRetainedLineCapacity = 16 * 1024;
+
+} // namespace
+
 FileAccessLog::FileAccessLog(const Filesystem::FilePathAndType& access_log_file_info,
                              AccessLog::FilterPtr&& filter, Formatter::FormatterPtr&& formatter,
                              AccessLog::AccessLogManager& log_manager)
@@ -16,7 +22,16 @@ FileAccessLog::FileAccessLog(const Filesystem::FilePathAndType& access_log_file_
 
 void FileAccessLog::emitLog(const Formatter::Context& context,
                             const StreamInfo::StreamInfo& stream_info) {
-  log_file_->write(formatter_->format(context, stream_info));
+  // write() copies the line, so each thread formats into one buffer that is reused for every line
+  // it logs instead of allocating a new string per line.
+  static thread_local std::string line;
+  line.clear();
+  formatter_->formatTo(context, stream_info, line);
+  log_file_->write(line);
+  if (line.capacity() > MaxRetainedLineCapacity) {
+    // Don't hold on to the memory of an unusually long line.
+    std::string().swap(line);
+  }
 }
 
 } // namespace File
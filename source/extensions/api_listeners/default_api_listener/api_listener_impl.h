@@ -75,6 +75,7 @@ protected:
       IS_ENVOY_BUG("Unexpected call to startUpstreamSecureTransport");
       return false;
     }
+    bool soleFilter() override { return true; }
     Upstream::HostDescriptionConstSharedPtr upstreamHost() override { return nullptr; }
     void upstreamHost(Upstream::HostDescriptionConstSharedPtr) override {
       IS_ENVOY_BUG("Unexpected call to upstreamHost");
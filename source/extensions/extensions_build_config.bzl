@@ -4,6 +4,7 @@ EXTENSIONS = {
     # Access loggers
     #
 
+    "envoy.access_loggers.columnar":                    "//source/extensions/access_loggers/columnar:config",
     "envoy.access_loggers.file":                        "//source/extensions/access_loggers/file:config",
     "envoy.access_loggers.extension_filters.cel":       "//source/extensions/access_loggers/filters/cel:config",
     "envoy.access_loggers.extension_filters.process_ratelimit":       "//source/extensions/access_loggers/filters/process_ratelimit:config",
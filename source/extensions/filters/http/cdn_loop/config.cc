@@ -30,9 +30,10 @@ absl::StatusOr<Http::FilterFactoryCb> CdnLoopFilterFactory::createFilterFactoryF
         fmt::format("Provided cdn_id \"{}\" is not a valid CDN identifier: {}", config.cdn_id(),
                     context.status().message()));
   }
-  return [config](Http::FilterChainFactoryCallbacks& callbacks) -> void {
-    callbacks.addStreamDecoderFilter(
-        std::make_shared<CdnLoopFilter>(config.cdn_id(), config.max_allowed_occurrences()));
+  auto filter =
+      std::make_shared<const CdnLoopFilter>(config.cdn_id(), config.max_allowed_occurrences());
+  return [filter](Http::FilterChainFactoryCallbacks& callbacks) -> void {
+    callbacks.addStatelessStreamDecoderFilter(filter);
   };
 }
 
@@ -25,20 +25,21 @@ constexpr absl::string_view LoopDetectedDetails = "cdn_loop_detected";
 
 } // namespace
 
-Http::FilterHeadersStatus CdnLoopFilter::decodeHeaders(Http::RequestHeaderMap& headers,
-                                                       bool /*end_stream*/) {
+Http::FilterHeadersStatus
+CdnLoopFilter::decodeHeaders(Http::StreamDecoderFilterCallbacks& callbacks,
+                             Http::RequestHeaderMap& headers, bool /*end_stream*/) const {
 
   if (const Http::HeaderEntry* header_entry = headers.getInline(cdn_loop_handle.handle());
       header_entry != nullptr) {
     if (StatusOr<int> count =
             countCdnLoopOccurrences(header_entry->value().getStringView(), cdn_id_);
         !count.ok()) {
-      decoder_callbacks_->sendLocalReply(Http::Code::BadRequest, ParseErrorMessage, nullptr,
-                                         absl::nullopt, ParseErrorDetails);
+      callbacks.sendLocalReply(Http::Code::BadRequest, ParseErrorMessage, nullptr, absl::nullopt,
+                               ParseErrorDetails);
       return Http::FilterHeadersStatus::StopIteration;
     } else if (*count > max_allowed_occurrences_) {
-      decoder_callbacks_->sendLocalReply(Http::Code::BadGateway, LoopDetectedMessage, nullptr,
-                                         absl::nullopt, LoopDetectedDetails);
+      callbacks.sendLocalReply(Http::Code::BadGateway, LoopDetectedMessage, nullptr, absl::nullopt,
+                               LoopDetectedDetails);
       return Http::FilterHeadersStatus::StopIteration;
     }
   }
@@ -5,19 +5,21 @@
 #include "envoy/http/filter.h"
 #include "envoy/http/header_map.h"
 
-#include "source/extensions/filters/http/common/pass_through_filter.h"
-
 namespace Envoy {
 namespace Extensions {
 namespace HttpFilters {
 namespace CdnLoop {
 
-class CdnLoopFilter : public Http::PassThroughDecoderFilter {
+// The filter keeps no per-stream state, so a single instance is shared by all streams.
+class CdnLoopFilter : public Http::StatelessStreamDecoderFilter {
 public:
   CdnLoopFilter(std::string cdn_id, int max_allowed_occurrences)
       : cdn_id_(std::move(cdn_id)), max_allowed_occurrences_(max_allowed_occurrences) {}
-  Http::FilterHeadersStatus decodeHeaders(Http::RequestHeaderMap& headers,
-                                          bool end_stream) override;
+
+  // Http::StatelessStreamDecoderFilter
+  Http::FilterHeadersStatus decodeHeaders(Http::StreamDecoderFilterCallbacks& callbacks,
+                                          Http::RequestHeaderMap& headers,
+                                          bool end_stream) const override;
 
 private:
   const std::string cdn_id_;
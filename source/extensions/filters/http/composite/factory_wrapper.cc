@@ -1,5 +1,6 @@
 #include "source/extensions/filters/http/composite/factory_wrapper.h"
 
+#include "source/common/http/stateless_filter_adapter.h"
 #include "source/extensions/filters/http/composite/filter.h"
 
 namespace Envoy {
@@ -36,6 +37,16 @@ void FactoryCallbacksWrapper::addStreamFilter(Http::StreamFilterSharedPtr filter
   filter_to_inject_ = filter;
 }
 
+void FactoryCallbacksWrapper::addStatelessStreamDecoderFilter(
+    Http::StatelessStreamDecoderFilterSharedPtr filter) {
+  addStreamDecoderFilter(std::make_shared<Http::StatelessStreamDecoderFilterAdapter>(filter));
+}
+
+void FactoryCallbacksWrapper::addStatelessStreamEncoderFilter(
+    Http::StatelessStreamEncoderFilterSharedPtr filter) {
+  addStreamEncoderFilter(std::make_shared<Http::StatelessStreamEncoderFilterAdapter>(filter));
+}
+
 void FactoryCallbacksWrapper::addAccessLogHandler(AccessLog::InstanceSharedPtr access_log) {
   access_loggers_.push_back(std::move(access_log));
 }
@@ -20,6 +20,8 @@ struct FactoryCallbacksWrapper : public Http::FilterChainFactoryCallbacks {
   void addStreamDecoderFilter(Http::StreamDecoderFilterSharedPtr filter) override;
   void addStreamEncoderFilter(Http::StreamEncoderFilterSharedPtr filter) override;
   void addStreamFilter(Http::StreamFilterSharedPtr filter) override;
+  void addStatelessStreamDecoderFilter(Http::StatelessStreamDecoderFilterSharedPtr filter) override;
+  void addStatelessStreamEncoderFilter(Http::StatelessStreamEncoderFilterSharedPtr filter) override;
   void addAccessLogHandler(AccessLog::InstanceSharedPtr) override;
   Event::Dispatcher& dispatcher() override { return dispatcher_; }
 
@@ -8,6 +8,7 @@
 #include "envoy/type/matcher/v3/http_inputs.pb.validate.h"
 
 #include "source/common/config/utility.h"
+#include "source/common/http/stateless_filter_adapter.h"
 #include "source/common/http/utility.h"
 
 #include "absl/status/status.h"
@@ -87,6 +88,17 @@ struct DelegatingFactoryCallbacks : public Envoy::Http::FilterChainFactoryCallba
     auto delegating_filter = std::make_shared<DelegatingStreamFilter>(match_tree_, filter, filter);
     delegated_callbacks_.addStreamFilter(std::move(delegating_filter));
   }
+  void addStatelessStreamDecoderFilter(
+      Envoy::Http::StatelessStreamDecoderFilterSharedPtr filter) override {
+    // The match state is per stream, so the filter is wrapped in a per-stream adapter.
+    addStreamDecoderFilter(
+        std::make_shared<Envoy::Http::StatelessStreamDecoderFilterAdapter>(std::move(filter)));
+  }
+  void addStatelessStreamEncoderFilter(
+      Envoy::Http::StatelessStreamEncoderFilterSharedPtr filter) override {
+    addStreamEncoderFilter(
+        std::make_shared<Envoy::Http::StatelessStreamEncoderFilterAdapter>(std::move(filter)));
+  }
 
   void addAccessLogHandler(AccessLog::InstanceSharedPtr handler) override {
     delegated_callbacks_.addAccessLogHandler(std::move(handler));
@@ -12,6 +12,7 @@
 
 #include "source/common/orca/orca_load_metrics.h"
 #include "source/common/protobuf/utility.h"
+#include "source/common/runtime/runtime_features.h"
 #include "source/extensions/load_balancing_policies/common/load_balancer_impl.h"
 
 #include "absl/status/status.h"
@@ -41,9 +42,8 @@ RoundRobinConfig getRoundRobinConfig(const CommonLbConfig& common_config,
 } // namespace
 
 ClientSideWeightedRoundRobinLbConfig::ClientSideWeightedRoundRobinLbConfig(
-    const ClientSideWeightedRoundRobinLbProto& lb_proto, Event::Dispatcher& main_thread_dispatcher,
-    ThreadLocal::SlotAllocator& tls_slot_allocator)
-    : main_thread_dispatcher_(main_thread_dispatcher), tls_slot_allocator_(tls_slot_allocator) {
+    const ClientSideWeightedRoundRobinLbProto& lb_proto, Event::Dispatcher& main_thread_dispatcher)
+    : main_thread_dispatcher_(main_thread_dispatcher) {
   ENVOY_LOG_MISC(trace, "ClientSideWeightedRoundRobinLbConfig config {}", lb_proto.DebugString());
   metric_names_for_computing_utilization =
       std::vector<std::string>(lb_proto.metric_names_for_computing_utilization().begin(),
@@ -65,21 +65,54 @@ ClientSideWeightedRoundRobinLoadBalancer::WorkerLocalLb::WorkerLocalLb(
     const PrioritySet& priority_set, const PrioritySet* local_priority_set, ClusterLbStats& stats,
     Runtime::Loader& runtime, Random::RandomGenerator& random, const CommonLbConfig& common_config,
     const RoundRobinConfig& round_robin_config, TimeSource& time_source,
-    OptRef<ThreadLocalShim> tls_shim)
+    WeightsVersionSharedPtr weights_version)
     : RoundRobinLoadBalancer(priority_set, local_priority_set, stats, runtime, random,
                              PROTOBUF_PERCENT_TO_ROUNDED_INTEGER_OR_DEFAULT(
                                  common_config, healthy_panic_threshold, 100, 50),
-                             getRoundRobinConfig(common_config, round_robin_config), time_source) {
-  if (tls_shim.has_value()) {
-    apply_weights_cb_handle_ = tls_shim->apply_weights_cb_helper_.add([this]() {
-      // Refresh the EDF scheduler on the hosts in priority set of the
-      // worker-local load balancer on the worker thread.
-      for (const HostSetPtr& host_set : priority_set_.hostSetsPerPriority()) {
-        if (host_set != nullptr) {
-          refresh(host_set->priority());
-        }
-      }
-    });
+                             getRoundRobinConfig(common_config, round_robin_config), time_source),
+      weights_version_(std::move(weights_version)),
+      update_weights_in_place_(Runtime::runtimeFeatureEnabled(
+          "envoy.reloadable_features.client_side_weighted_round_robin_in_place_weights")) {
+  // The schedulers were built from the current weights by the base class constructor.
+  if (weights_version_ != nullptr) {
+    applied_weights_version_ = weights_version_->load(std::memory_order_acquire);
+  }
+}
+
+HostSelectionResponse
+ClientSideWeightedRoundRobinLoadBalancer::WorkerLocalLb::chooseHost(LoadBalancerContext* context) {
+  refreshIfWeightsChanged();
+  return RoundRobinLoadBalancer::chooseHost(context);
+}
+
+HostConstSharedPtr ClientSideWeightedRoundRobinLoadBalancer::WorkerLocalLb::peekAnotherHost(
+    LoadBalancerContext* context) {
+  refreshIfWeightsChanged();
+  return RoundRobinLoadBalancer::peekAnotherHost(context);
+}
+
+void ClientSideWeightedRoundRobinLoadBalancer::WorkerLocalLb::refreshIfWeightsChanged() {
+  if (weights_version_ == nullptr) {
+    return;
+  }
+  const uint64_t weights_version = weights_version_->load(std::memory_order_acquire);
+  if (weights_version == applied_weights_version_) {
+    return;
+  }
+  applied_weights_version_ = weights_version;
+  // Refresh the EDF scheduler on the hosts in priority set of the worker-local load balancer. Any
+  // number of weight updates published since the last pick only cost a single refresh. Updating
+  // the weights in place keeps the weighted schedulers, so a busy worker does not rebuild them on
+  // the request path after every update.
+  for (const HostSetPtr& host_set : priority_set_.hostSetsPerPriority()) {
+    if (host_set == nullptr) {
+      continue;
+    }
+    if (update_weights_in_place_) {
+      refreshWeights(host_set->priority());
+    } else {
+      refresh(host_set->priority());
+    }
   }
 }
 
@@ -104,7 +137,7 @@ void ClientSideWeightedRoundRobinLoadBalancer::updateWeightsOnMainThread() {
     updated = updateWeightsOnHosts(host_set->hosts()) || updated;
   }
   if (updated) {
-    factory_->applyWeightsToAllWorkers();
+    factory_->publishWeights();
   }
 }
 
@@ -273,15 +306,13 @@ ClientSideWeightedRoundRobinLoadBalancer::WorkerLocalLbFactory::createWithCommon
     const CommonLbConfig& common_lb_config, Upstream::LoadBalancerParams params) {
   return std::make_unique<Upstream::ClientSideWeightedRoundRobinLoadBalancer::WorkerLocalLb>(
       params.priority_set, params.local_priority_set, cluster_info_.lbStats(), runtime_, random_,
-      common_lb_config, round_robin_config_, time_source_, tls_->get());
+      common_lb_config, round_robin_config_, time_source_, weights_version_);
 }
 
-void ClientSideWeightedRoundRobinLoadBalancer::WorkerLocalLbFactory::applyWeightsToAllWorkers() {
-  tls_->runOnAllThreads([](OptRef<ThreadLocalShim> tls_shim) -> void {
-    if (tls_shim.has_value()) {
-      tls_shim->apply_weights_cb_helper_.runCallbacks();
-    }
-  });
+void ClientSideWeightedRoundRobinLoadBalancer::WorkerLocalLbFactory::publishWeights() {
+  // The release increment orders the weight updates of the hosts before the new version, so workers
+  // observing the new version rebuild their schedulers from the new weights.
+  weights_version_->fetch_add(1, std::memory_order_release);
 }
 
 ClientSideWeightedRoundRobinLoadBalancer::ClientSideWeightedRoundRobinLoadBalancer(
@@ -295,9 +326,9 @@ ClientSideWeightedRoundRobinLoadBalancer::ClientSideWeightedRoundRobinLoadBalanc
       dynamic_cast<const ClientSideWeightedRoundRobinLbConfig*>(lb_config.ptr());
   ASSERT(typed_lb_config != nullptr);
   report_handler_ = std::make_shared<OrcaLoadReportHandler>(*typed_lb_config, time_source_);
-  factory_ = std::make_shared<WorkerLocalLbFactory>(
-      cluster_info, priority_set, runtime, random, time_source,
-      typed_lb_config->tls_slot_allocator_, typed_lb_config->round_robin_overrides_);
+  factory_ = std::make_shared<WorkerLocalLbFactory>(cluster_info, priority_set, runtime, random,
+                                                    time_source,
+                                                    typed_lb_config->round_robin_overrides_);
 
   initFromConfig(*typed_lb_config);
 
@@ -1,12 +1,13 @@
 #pragma once
 
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
 #include "envoy/extensions/load_balancing_policies/client_side_weighted_round_robin/v3/client_side_weighted_round_robin.pb.h"
 #include "envoy/extensions/load_balancing_policies/round_robin/v3/round_robin.pb.h"
-#include "envoy/thread_local/thread_local.h"
-#include "envoy/thread_local/thread_local_object.h"
 #include "envoy/upstream/upstream.h"
 
-#include "source/common/common/callback_impl.h"
 #include "source/extensions/load_balancing_policies/common/load_balancer_impl.h"
 #include "source/extensions/load_balancing_policies/round_robin/round_robin_lb.h"
 
@@ -27,8 +28,7 @@ using RoundRobinConfig = envoy::extensions::load_balancing_policies::round_robin
 class ClientSideWeightedRoundRobinLbConfig : public Upstream::LoadBalancerConfig {
 public:
   ClientSideWeightedRoundRobinLbConfig(const ClientSideWeightedRoundRobinLbProto& lb_proto,
-                                       Event::Dispatcher& main_thread_dispatcher,
-                                       ThreadLocal::SlotAllocator& tls_slot_allocator);
+                                       Event::Dispatcher& main_thread_dispatcher);
 
   // Parameters for weight calculation from Orca Load report.
   std::vector<std::string> metric_names_for_computing_utilization;
@@ -42,7 +42,6 @@ public:
   RoundRobinConfig round_robin_overrides_;
 
   Event::Dispatcher& main_thread_dispatcher_;
-  ThreadLocal::SlotAllocator& tls_slot_allocator_;
 };
 
 /**
@@ -142,11 +141,11 @@ public:
     TimeSource& time_source_;
   };
 
-  // Thread local shim to store callbacks for weight updates of worker local lb.
-  class ThreadLocalShim : public Envoy::ThreadLocal::ThreadLocalObject {
-  public:
-    Common::CallbackManager<void> apply_weights_cb_helper_;
-  };
+  // Version of the host weights, shared by the main thread and the worker local load balancers.
+  // The main thread bumps it after it updated the weight of any host. Worker local load balancers
+  // update their schedulers lazily, on their first pick after the version changed.
+  using WeightsVersion = std::atomic<uint64_t>;
+  using WeightsVersionSharedPtr = std::shared_ptr<WeightsVersion>;
 
   // This class is used to handle the load balancing on the worker thread.
   class WorkerLocalLb : public RoundRobinLoadBalancer {
@@ -154,11 +153,26 @@ public:
     WorkerLocalLb(const PrioritySet& priority_set, const PrioritySet* local_priority_set,
                   ClusterLbStats& stats, Runtime::Loader& runtime, Random::RandomGenerator& random,
                   const CommonLbConfig& common_config, const RoundRobinConfig& round_robin_config,
-                  TimeSource& time_source, OptRef<ThreadLocalShim> tls_shim);
+                  TimeSource& time_source, WeightsVersionSharedPtr weights_version);
+
+    // Upstream::LoadBalancer
+    HostSelectionResponse chooseHost(LoadBalancerContext* context) override;
+    HostConstSharedPtr peekAnotherHost(LoadBalancerContext* context) override;
 
   private:
     friend class ClientSideWeightedRoundRobinLoadBalancerFriend;
-    Common::CallbackHandlePtr apply_weights_cb_handle_;
+
+    // Brings the schedulers of all priorities up to date if the host weights changed since they
+    // were last updated.
+    void refreshIfWeightsChanged();
+
+    // Null if the load balancer is not driven by a thread aware load balancer.
+    const WeightsVersionSharedPtr weights_version_;
+    // Whether weight updates keep the weighted schedulers instead of rebuilding them, see
+    // EdfLoadBalancerBase::refreshWeights().
+    const bool update_weights_in_place_;
+    // Version of the host weights the schedulers were last built from.
+    uint64_t applied_weights_version_{};
   };
 
   // Factory used to create worker-local load balancer on the worker thread.
@@ -167,13 +181,9 @@ public:
     WorkerLocalLbFactory(const Upstream::ClusterInfo& cluster_info,
                          const Upstream::PrioritySet& priority_set, Runtime::Loader& runtime,
                          Envoy::Random::RandomGenerator& random, TimeSource& time_source,
-                         ThreadLocal::SlotAllocator& tls,
                          const RoundRobinConfig& round_robin_config)
         : cluster_info_(cluster_info), priority_set_(priority_set), runtime_(runtime),
-          random_(random), time_source_(time_source), round_robin_config_(round_robin_config) {
-      tls_ = ThreadLocal::TypedSlot<ThreadLocalShim>::makeUnique(tls);
-      tls_->set([](Envoy::Event::Dispatcher&) { return std::make_shared<ThreadLocalShim>(); });
-    }
+          random_(random), time_source_(time_source), round_robin_config_(round_robin_config) {}
 
     Upstream::LoadBalancerPtr create(Upstream::LoadBalancerParams params) override;
 
@@ -182,9 +192,11 @@ public:
     Upstream::LoadBalancerPtr createWithCommonLbConfig(const CommonLbConfig& common_lb_config,
                                                        Upstream::LoadBalancerParams params);
 
-    void applyWeightsToAllWorkers();
+    // Makes the current host weights visible to all the worker local load balancers, which pick
+    // them up on their next pick. Nothing is posted to the workers.
+    void publishWeights();
 
-    std::unique_ptr<Envoy::ThreadLocal::TypedSlot<ThreadLocalShim>> tls_;
+    const WeightsVersionSharedPtr weights_version_ = std::make_shared<WeightsVersion>(0);
 
     const Upstream::ClusterInfo& cluster_info_;
     const Upstream::PrioritySet& priority_set_;
@@ -38,7 +38,7 @@ public:
              const Protobuf::Message& config) override {
     const auto& lb_config = dynamic_cast<const ClientSideWeightedRoundRobinLbProto&>(config);
     return Upstream::LoadBalancerConfigPtr{new Upstream::ClientSideWeightedRoundRobinLbConfig(
-        lb_config, context.mainThreadDispatcher(), context.threadLocal())};
+        lb_config, context.mainThreadDispatcher())};
   }
 };
 
@@ -931,7 +931,10 @@ EdfLoadBalancerBase::EdfLoadBalancerBase(
   // consistent with what other LB implementations do (e.g. thread aware).
   // The downside of a full recompute is that time complexity is O(n * log n),
   // so we will need to do better at delta tracking to scale (see
-  // https://github.com/envoyproxy/envoy/issues/2874).
+  // https://github.com/envoyproxy/envoy/issues/2874). Note that the hosts added and removed by an
+  // update are not enough to update the schedulers in place: the healthy, degraded and per
+  // locality host sources also change when the health of existing hosts changes, which is not
+  // reported as a delta.
   priority_update_cb_ = priority_set.addPriorityUpdateCb(
       [this](uint32_t priority, const HostVector&, const HostVector&) { refresh(priority); });
   member_update_cb_ =
@@ -977,64 +980,89 @@ void EdfLoadBalancerBase::refresh(uint32_t priority) {
   if (priority >= priority_set_.hostSetsPerPriority().size()) {
     return;
   }
-  const auto add_hosts_source = [this](HostsSource source, const HostVector& hosts) {
-    // Nuke existing scheduler if it exists.
-    auto& scheduler = scheduler_[source] = Scheduler{};
-    refreshHostSource(source);
-    if (isSlowStartEnabled()) {
-      recalculateHostsInSlowStart(hosts);
-    }
+  // Populate EdfSchedulers for each valid HostsSource value for the host set at this priority.
+  forEachHostsSource(priority, [this](const HostsSource& source, const HostVector& hosts) {
+    rebuildScheduler(source, hosts);
+  });
+}
 
-    // Check if the original host weights are equal and no hosts are in slow start mode, in that
-    // case EDF creation is skipped. When all original weights are equal and no hosts are in slow
-    // start mode we can rely on unweighted host pick to do optimal round robin and least-loaded
-    // host selection with lower memory and CPU overhead.
-    if (hostWeightsAreEqual(hosts) && noHostsAreInSlowStart()) {
-      // Skip edf creation.
+void EdfLoadBalancerBase::refreshWeights(uint32_t priority) {
+  // Ensure that priority is within hostSetsPerPriority.
+  if (priority >= priority_set_.hostSetsPerPriority().size()) {
+    return;
+  }
+  forEachHostsSource(priority, [this](const HostsSource& source, const HostVector& hosts) {
+    // A weighted scheduler is kept, as it applies the new weight of a host when the host is next
+    // picked. A host source which is picked unweighted needs a scheduler once its weights differ.
+    const auto scheduler_it = scheduler_.find(source);
+    if (scheduler_it != scheduler_.end() && scheduler_it->second.edf_ != nullptr) {
       return;
     }
-
-    // If there are no hosts or a single one, there is no need for an EDF scheduler
-    // (thus lowering memory and CPU overhead), as the (possibly) single host
-    // will be the one always selected by the scheduler.
-    if (hosts.size() <= 1) {
-      return;
+    if (scheduler_it == scheduler_.end() || !hostWeightsAreEqual(hosts) ||
+        !noHostsAreInSlowStart()) {
+      rebuildScheduler(source, hosts);
     }
+  });
+}
 
-    // Populate the scheduler with the host list with a randomized starting point.
-    // TODO(mattklein123): We must build the EDF schedule even if all of the hosts are currently
-    // weighted 1. This is because currently we don't refresh host sets if only weights change.
-    // We should probably change this to refresh at all times. See the comment in
-    // BaseDynamicClusterImpl::updateDynamicHostList about this.
-    scheduler.edf_ = std::make_unique<EdfScheduler<Host>>(EdfScheduler<Host>::createWithPicks(
-        hosts,
-        // We use a fixed weight here. While the weight may change without
-        // notification, this will only be stale until this host is next picked,
-        // at which point it is reinserted into the EdfScheduler with its new
-        // weight in chooseHost().
-        [this](const Host& host) { return hostWeight(host); }, seed_));
-  };
-  // Populate EdfSchedulers for each valid HostsSource value for the host set at this priority.
+void EdfLoadBalancerBase::forEachHostsSource(
+    uint32_t priority,
+    const std::function<void(const HostsSource&, const HostVector&)>& callback) const {
   const auto& host_set = priority_set_.hostSetsPerPriority()[priority];
-  add_hosts_source(HostsSource(priority, HostsSource::SourceType::AllHosts), host_set->hosts());
-  add_hosts_source(HostsSource(priority, HostsSource::SourceType::HealthyHosts),
-                   host_set->healthyHosts());
-  add_hosts_source(HostsSource(priority, HostsSource::SourceType::DegradedHosts),
-                   host_set->degradedHosts());
+  callback(HostsSource(priority, HostsSource::SourceType::AllHosts), host_set->hosts());
+  callback(HostsSource(priority, HostsSource::SourceType::HealthyHosts), host_set->healthyHosts());
+  callback(HostsSource(priority, HostsSource::SourceType::DegradedHosts),
+           host_set->degradedHosts());
   for (uint32_t locality_index = 0;
        locality_index < host_set->healthyHostsPerLocality().get().size(); ++locality_index) {
-    add_hosts_source(
-        HostsSource(priority, HostsSource::SourceType::LocalityHealthyHosts, locality_index),
-        host_set->healthyHostsPerLocality().get()[locality_index]);
+    callback(HostsSource(priority, HostsSource::SourceType::LocalityHealthyHosts, locality_index),
+             host_set->healthyHostsPerLocality().get()[locality_index]);
   }
   for (uint32_t locality_index = 0;
        locality_index < host_set->degradedHostsPerLocality().get().size(); ++locality_index) {
-    add_hosts_source(
-        HostsSource(priority, HostsSource::SourceType::LocalityDegradedHosts, locality_index),
-        host_set->degradedHostsPerLocality().get()[locality_index]);
+    callback(HostsSource(priority, HostsSource::SourceType::LocalityDegradedHosts, locality_index),
+             host_set->degradedHostsPerLocality().get()[locality_index]);
   }
 }
 
+void EdfLoadBalancerBase::rebuildScheduler(const HostsSource& source, const HostVector& hosts) {
+  // Nuke existing scheduler if it exists.
+  auto& scheduler = scheduler_[source] = Scheduler{};
+  refreshHostSource(source);
+  if (isSlowStartEnabled()) {
+    recalculateHostsInSlowStart(hosts);
+  }
+
+  // Check if the original host weights are equal and no hosts are in slow start mode, in that
+  // case EDF creation is skipped. When all original weights are equal and no hosts are in slow
+  // start mode we can rely on unweighted host pick to do optimal round robin and least-loaded
+  // host selection with lower memory and CPU overhead.
+  if (hostWeightsAreEqual(hosts) && noHostsAreInSlowStart()) {
+    // Skip edf creation.
+    return;
+  }
+
+  // If there are no hosts or a single one, there is no need for an EDF scheduler
+  // (thus lowering memory and CPU overhead), as the (possibly) single host
+  // will be the one always selected by the scheduler.
+  if (hosts.size() <= 1) {
+    return;
+  }
+
+  // Populate the scheduler with the host list with a randomized starting point.
+  // TODO(mattklein123): We must build the EDF schedule even if all of the hosts are currently
+  // weighted 1. This is because currently we don't refresh host sets if only weights change.
+  // We should probably change this to refresh at all times. See the comment in
+  // BaseDynamicClusterImpl::updateDynamicHostList about this.
+  scheduler.edf_ = std::make_unique<EdfScheduler<Host>>(EdfScheduler<Host>::createWithPicks(
+      hosts,
+      // We use a fixed weight here. While the weight may change without
+      // notification, this will only be stale until this host is next picked,
+      // at which point it is reinserted into the EdfScheduler with its new
+      // weight in chooseHost().
+      [this](const Host& host) { return hostWeight(host); }, seed_));
+}
+
 bool EdfLoadBalancerBase::isSlowStartEnabled() const {
   return slow_start_window_ > std::chrono::milliseconds(0);
 }
@@ -3,6 +3,7 @@
 #include <bitset>
 #include <cmath>
 #include <cstdint>
+#include <functional>
 #include <memory>
 #include <queue>
 #include <set>
@@ -530,6 +531,12 @@ protected:
 
   virtual void refresh(uint32_t priority);
 
+  // Updates the schedulers of the priority after the weights of its hosts changed, but not its
+  // hosts. Unlike refresh(), this keeps the weighted schedulers, which apply the new weight of a
+  // host when the host is next picked, and only builds a scheduler for the host sources which are
+  // picked unweighted if their weights are no longer equal.
+  void refreshWeights(uint32_t priority);
+
   bool isSlowStartEnabled() const;
   bool noHostsAreInSlowStart() const;
 
@@ -546,6 +553,10 @@ protected:
 
 private:
   friend class EdfLoadBalancerBasePeer;
+  void forEachHostsSource(
+      uint32_t priority,
+      const std::function<void(const HostsSource&, const HostVector&)>& callback) const;
+  void rebuildScheduler(const HostsSource& source, const HostVector& hosts);
   virtual void refreshHostSource(const HostsSource& source) PURE;
   virtual double hostWeight(const Host& host) const PURE;
   virtual HostConstSharedPtr unweightedHostPeek(const HostVector& hosts_to_use,
@@ -37,7 +37,7 @@ public:
   public:
     virtual ~HashingLoadBalancer() = default;
     virtual HostSelectionResponse chooseHost(uint64_t hash, uint32_t attempt) const PURE;
-    const absl::string_view hashKey(HostConstSharedPtr host, bool use_hostname) const {
+    static absl::string_view hashKey(const HostConstSharedPtr& host, bool use_hostname) {
       const Protobuf::Value& val = Config::Metadata::metadataValue(
           host->metadata().get(), Config::MetadataFilters::get().ENVOY_LB,
           Config::MetadataEnvoyLbKeys::get().HASH_KEY);
@@ -173,8 +173,13 @@ private:
     std::shared_ptr<DegradedLoad> degraded_per_priority_load_ ABSL_GUARDED_BY(mutex_);
   };
 
+  /**
+   * Creates the hashing load balancer of a priority. Called on the main thread on every refresh,
+   * for every priority, so implementations may reuse state kept from the previous build of the
+   * same priority.
+   */
   virtual HashingLoadBalancerSharedPtr
-  createLoadBalancer(const NormalizedHostWeightVector& normalized_host_weights,
+  createLoadBalancer(uint32_t priority, const NormalizedHostWeightVector& normalized_host_weights,
                      double min_normalized_weight, double max_normalized_weight) PURE;
   void refresh();
 
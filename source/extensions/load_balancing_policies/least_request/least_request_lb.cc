@@ -3,6 +3,41 @@
 namespace Envoy {
 namespace Upstream {
 
+namespace {
+
+void collectActiveRequestGauges(const HostVector& hosts,
+                                std::vector<const Stats::PrimitiveGauge*>& gauges) {
+  gauges.clear();
+  gauges.reserve(hosts.size());
+  for (const auto& host : hosts) {
+    gauges.push_back(&host->stats().rq_active_);
+  }
+}
+
+} // namespace
+
+void LeastRequestLoadBalancer::refreshHostSource(const HostsSource& source) {
+  const HostVector& hosts = hostSourceToHosts(source);
+  ActiveRequests& active_requests = active_requests_[source];
+  active_requests.hosts_ = &hosts;
+  collectActiveRequestGauges(hosts, active_requests.gauges_);
+}
+
+const LeastRequestLoadBalancer::ActiveRequests&
+LeastRequestLoadBalancer::activeRequests(const HostVector& hosts_to_use,
+                                         const HostsSource& source) {
+  ActiveRequests& active_requests = active_requests_[source];
+  // The gauges are collected when the host source is refreshed. Collect them again if the hosts to
+  // use do not match, which keeps the picks correct should a host source ever be used before it is
+  // refreshed.
+  if (active_requests.hosts_ != &hosts_to_use ||
+      active_requests.gauges_.size() != hosts_to_use.size()) {
+    active_requests.hosts_ = &hosts_to_use;
+    collectActiveRequestGauges(hosts_to_use, active_requests.gauges_);
+  }
+  return active_requests;
+}
+
 double LeastRequestLoadBalancer::hostWeight(const Host& host) const {
   // This method is called to calculate the dynamic weight as following when all load balancing
   // weights are not equal:
@@ -55,15 +90,16 @@ HostConstSharedPtr LeastRequestLoadBalancer::unweightedHostPeek(const HostVector
 }
 
 HostConstSharedPtr LeastRequestLoadBalancer::unweightedHostPick(const HostVector& hosts_to_use,
-                                                                const HostsSource&) {
+                                                                const HostsSource& source) {
   HostSharedPtr candidate_host = nullptr;
+  const ActiveRequests& active_requests = activeRequests(hosts_to_use, source);
 
   switch (selection_method_) {
   case envoy::extensions::load_balancing_policies::least_request::v3::LeastRequest::FULL_SCAN:
-    candidate_host = unweightedHostPickFullScan(hosts_to_use);
+    candidate_host = unweightedHostPickFullScan(hosts_to_use, active_requests);
     break;
   case envoy::extensions::load_balancing_policies::least_request::v3::LeastRequest::N_CHOICES:
-    candidate_host = unweightedHostPickNChoices(hosts_to_use);
+    candidate_host = unweightedHostPickNChoices(hosts_to_use, active_requests);
     break;
   default:
     IS_ENVOY_BUG("unknown selection method specified for least request load balancer");
@@ -72,30 +108,28 @@ HostConstSharedPtr LeastRequestLoadBalancer::unweightedHostPick(const HostVector
   return candidate_host;
 }
 
-HostSharedPtr LeastRequestLoadBalancer::unweightedHostPickFullScan(const HostVector& hosts_to_use) {
-  HostSharedPtr candidate_host = nullptr;
-
-  size_t num_hosts_known_tied_for_least = 0;
-
-  const size_t num_hosts = hosts_to_use.size();
-
-  for (size_t i = 0; i < num_hosts; ++i) {
-    const HostSharedPtr& sampled_host = hosts_to_use[i];
+HostSharedPtr
+LeastRequestLoadBalancer::unweightedHostPickFullScan(const HostVector& hosts_to_use,
+                                                     const ActiveRequests& active_requests) {
+  const auto& gauges = active_requests.gauges_;
+  const size_t num_hosts = gauges.size();
+  if (num_hosts == 0) {
+    return nullptr;
+  }
 
-    if (candidate_host == nullptr) {
-      // Make a first choice to start the comparisons.
-      num_hosts_known_tied_for_least = 1;
-      candidate_host = sampled_host;
-      continue;
-    }
+  // Make a first choice to start the comparisons.
+  size_t candidate_index = 0;
+  uint64_t candidate_active_rq = gauges[0]->value();
+  size_t num_hosts_known_tied_for_least = 1;
 
-    const auto candidate_active_rq = candidate_host->stats().rq_active_.value();
-    const auto sampled_active_rq = sampled_host->stats().rq_active_.value();
+  for (size_t i = 1; i < num_hosts; ++i) {
+    const uint64_t sampled_active_rq = gauges[i]->value();
 
     if (sampled_active_rq < candidate_active_rq) {
       // Reset the count of known tied hosts.
       num_hosts_known_tied_for_least = 1;
-      candidate_host = sampled_host;
+      candidate_index = i;
+      candidate_active_rq = sampled_active_rq;
     } else if (sampled_active_rq == candidate_active_rq) {
       ++num_hosts_known_tied_for_least;
 
@@ -108,36 +142,37 @@ HostSharedPtr LeastRequestLoadBalancer::unweightedHostPickFullScan(const HostVec
       // candidate_host returned by this function.
       const size_t random_tied_host_index = random_.random() % num_hosts_known_tied_for_least;
       if (random_tied_host_index == 0) {
-        candidate_host = sampled_host;
+        candidate_index = i;
       }
     }
   }
 
-  return candidate_host;
+  return hosts_to_use[candidate_index];
 }
 
-HostSharedPtr LeastRequestLoadBalancer::unweightedHostPickNChoices(const HostVector& hosts_to_use) {
-  HostSharedPtr candidate_host = nullptr;
+HostSharedPtr
+LeastRequestLoadBalancer::unweightedHostPickNChoices(const HostVector& hosts_to_use,
+                                                     const ActiveRequests& active_requests) {
+  const auto& gauges = active_requests.gauges_;
+  if (choice_count_ == 0) {
+    return nullptr;
+  }
 
-  for (uint32_t choice_idx = 0; choice_idx < choice_count_; ++choice_idx) {
-    const int rand_idx = random_.random() % hosts_to_use.size();
-    const HostSharedPtr& sampled_host = hosts_to_use[rand_idx];
+  // Make a first choice to start the comparisons.
+  size_t candidate_index = random_.random() % gauges.size();
+  uint64_t candidate_active_rq = gauges[candidate_index]->value();
 
-    if (candidate_host == nullptr) {
-      // Make a first choice to start the comparisons.
-      candidate_host = sampled_host;
-      continue;
-    }
-
-    const auto candidate_active_rq = candidate_host->stats().rq_active_.value();
-    const auto sampled_active_rq = sampled_host->stats().rq_active_.value();
+  for (uint32_t choice_idx = 1; choice_idx < choice_count_; ++choice_idx) {
+    const size_t rand_idx = random_.random() % gauges.size();
+    const uint64_t sampled_active_rq = gauges[rand_idx]->value();
 
     if (sampled_active_rq < candidate_active_rq) {
-      candidate_host = sampled_host;
+      candidate_index = rand_idx;
+      candidate_active_rq = sampled_active_rq;
     }
   }
 
-  return candidate_host;
+  return hosts_to_use[candidate_index];
 }
 
 } // namespace Upstream
@@ -1,7 +1,13 @@
 #pragma once
 
+#include <vector>
+
+#include "envoy/stats/primitive_stats.h"
+
 #include "source/extensions/load_balancing_policies/common/load_balancer_impl.h"
 
+#include "absl/container/flat_hash_map.h"
+
 namespace Envoy {
 namespace Upstream {
 
@@ -61,17 +67,33 @@ protected:
   }
 
 private:
-  void refreshHostSource(const HostsSource&) override {}
+  // Active request gauges of the hosts of a HostsSource, in the same order as the hosts. Comparing
+  // sampled hosts reads the gauges from this array instead of going through the shared pointer and
+  // the stats of every host.
+  struct ActiveRequests {
+    // The host vector the gauges were collected from.
+    const HostVector* hosts_{};
+    std::vector<const Stats::PrimitiveGauge*> gauges_;
+  };
+
+  void refreshHostSource(const HostsSource& source) override;
   double hostWeight(const Host& host) const override;
   HostConstSharedPtr unweightedHostPeek(const HostVector& hosts_to_use,
                                         const HostsSource& source) override;
   HostConstSharedPtr unweightedHostPick(const HostVector& hosts_to_use,
                                         const HostsSource& source) override;
-  HostSharedPtr unweightedHostPickFullScan(const HostVector& hosts_to_use);
-  HostSharedPtr unweightedHostPickNChoices(const HostVector& hosts_to_use);
+  HostSharedPtr unweightedHostPickFullScan(const HostVector& hosts_to_use,
+                                           const ActiveRequests& active_requests);
+  HostSharedPtr unweightedHostPickNChoices(const HostVector& hosts_to_use,
+                                           const ActiveRequests& active_requests);
+  const ActiveRequests& activeRequests(const HostVector& hosts_to_use, const HostsSource& source);
 
   const uint32_t choice_count_;
 
+  // Per worker arrays of the active request gauges of the hosts of every HostsSource, rebuilt in
+  // refreshHostSource() whenever the hosts of the source change.
+  absl::flat_hash_map<HostsSource, ActiveRequests, HostsSourceHash> active_requests_;
+
   // The exponent used to calculate host weights can be configured via runtime. We cache it for
   // performance reasons and refresh it in `LeastRequestLoadBalancer::refresh(uint32_t priority)`
   // whenever a `HostSet` is updated.
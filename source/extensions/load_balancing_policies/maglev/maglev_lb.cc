@@ -80,12 +80,41 @@ TypedMaglevLbConfig::TypedMaglevLbConfig(const MaglevLbProto& lb_config,
       lb_config_(lb_config) {}
 
 ThreadAwareLoadBalancerBase::HashingLoadBalancerSharedPtr
-MaglevLoadBalancer::createLoadBalancer(const NormalizedHostWeightVector& normalized_host_weights,
+MaglevLoadBalancer::createLoadBalancer(uint32_t priority,
+                                       const NormalizedHostWeightVector& normalized_host_weights,
                                        double /* min_normalized_weight */,
                                        double max_normalized_weight) {
-  HashingLoadBalancerSharedPtr maglev_lb =
-      MaglevFactory::createMaglevTable(normalized_host_weights, max_normalized_weight, table_size_,
-                                       use_hostname_for_hashing_, stats_);
+  if (priority >= table_builds_.size()) {
+    table_builds_.resize(priority + 1);
+  }
+  TableBuild& build = table_builds_[priority];
+
+  std::vector<std::string> hash_keys;
+  hash_keys.reserve(normalized_host_weights.size());
+  for (const auto& host_weight : normalized_host_weights) {
+    hash_keys.emplace_back(
+        HashingLoadBalancer::hashKey(host_weight.first, use_hostname_for_hashing_));
+  }
+
+  // Refreshes happen for changes of any priority and for host changes which leave the hosts used
+  // by the table unchanged, e.g. when unhealthy hosts are added or removed.
+  if (build.table_ != nullptr && build.max_normalized_weight_ == max_normalized_weight &&
+      build.normalized_host_weights_ == normalized_host_weights && build.hash_keys_ == hash_keys) {
+    ENVOY_LOG(debug, "maglev: table input of priority {} is unchanged, reusing table", priority);
+    if (!normalized_host_weights.empty()) {
+      stats_.min_entries_per_host_.set(build.min_entries_per_host_);
+      stats_.max_entries_per_host_.set(build.max_entries_per_host_);
+    }
+  } else {
+    build.table_ = MaglevFactory::createMaglevTable(normalized_host_weights, max_normalized_weight,
+                                                    table_size_, use_hostname_for_hashing_, stats_);
+    build.normalized_host_weights_ = normalized_host_weights;
+    build.hash_keys_ = std::move(hash_keys);
+    build.max_normalized_weight_ = max_normalized_weight;
+    build.min_entries_per_host_ = stats_.min_entries_per_host_.value();
+    build.max_entries_per_host_ = stats_.max_entries_per_host_.value();
+  }
+  HashingLoadBalancerSharedPtr maglev_lb = build.table_;
 
   if (hash_balance_factor_ == 0) {
     return maglev_lb;
@@ -167,14 +196,13 @@ void OriginalMaglevTable::constructImplementationInternals(
         continue;
       }
       entry.target_weight_ += max_normalized_weight;
-      uint64_t c = permutation(entry);
+      uint64_t c = entry.permutation_;
       while (table_[c] != nullptr) {
-        entry.next_++;
-        c = permutation(entry);
+        c = nextPermutation(entry);
       }
 
       table_[c] = entry.host_;
-      entry.next_++;
+      nextPermutation(entry);
       entry.count_++;
       table_index++;
     }
@@ -219,17 +247,16 @@ void CompactMaglevTable::constructImplementationInternals(
       entry.target_weight_ += max_normalized_weight;
       // As we're using the compact implementation, our table size is limited to
       // 32-bit, hence static_cast here should be safe.
-      uint32_t c = static_cast<uint32_t>(permutation(entry));
+      uint32_t c = static_cast<uint32_t>(entry.permutation_);
       while (occupied[c]) {
-        entry.next_++;
-        c = static_cast<uint32_t>(permutation(entry));
+        c = static_cast<uint32_t>(nextPermutation(entry));
       }
 
       // Record the index of the given host.
       table_.set(c, i);
       occupied[c] = true;
 
-      entry.next_++;
+      nextPermutation(entry);
       entry.count_++;
       table_index++;
     }
@@ -292,10 +319,6 @@ HostSelectionResponse CompactMaglevTable::chooseHost(uint64_t hash, uint32_t att
   return {host_table_[index]};
 }
 
-uint64_t MaglevTable::permutation(const TableBuildEntry& entry) {
-  return (entry.offset_ + (entry.skip_ * entry.next_)) % table_size_;
-}
-
 MaglevLoadBalancer::MaglevLoadBalancer(const PrioritySet& priority_set, ClusterLbStats& stats,
                                        Stats::Scope& scope, Runtime::Loader& runtime,
                                        Random::RandomGenerator& random,
@@ -75,18 +75,30 @@ public:
 protected:
   struct TableBuildEntry {
     TableBuildEntry(const HostConstSharedPtr& host, uint64_t offset, uint64_t skip, double weight)
-        : host_(host), offset_(offset), skip_(skip), weight_(weight) {}
+        : host_(host), offset_(offset), skip_(skip), weight_(weight), permutation_(offset) {}
 
     HostConstSharedPtr host_;
     const uint64_t offset_;
     const uint64_t skip_;
     const double weight_;
     double target_weight_{};
-    uint64_t next_{};
+    // Current slot of the permutation, i.e. (offset_ + skip_ * next) % table_size_.
+    uint64_t permutation_;
     uint64_t count_{};
   };
 
-  uint64_t permutation(const TableBuildEntry& entry);
+  /**
+   * Advances the entry to the next slot of its permutation and returns it. Since both the offset
+   * and the skip are smaller than the table size, this only needs a conditional subtraction
+   * instead of a division for every probe.
+   */
+  uint64_t nextPermutation(TableBuildEntry& entry) const {
+    entry.permutation_ += entry.skip_;
+    if (entry.permutation_ >= table_size_) {
+      entry.permutation_ -= table_size_;
+    }
+    return entry.permutation_;
+  }
 
   /**
    * Template method for constructing the Maglev table.
@@ -178,9 +190,20 @@ public:
   static MaglevLoadBalancerStats generateStats(Stats::Scope& scope);
 
 private:
+  // Input, result and stats of the last table build of a priority. Any change of the input moves
+  // slots of all hosts, so the table is either reused as a whole or rebuilt from scratch.
+  struct TableBuild {
+    NormalizedHostWeightVector normalized_host_weights_;
+    std::vector<std::string> hash_keys_;
+    double max_normalized_weight_{};
+    HashingLoadBalancerSharedPtr table_;
+    uint64_t min_entries_per_host_{};
+    uint64_t max_entries_per_host_{};
+  };
+
   // ThreadAwareLoadBalancerBase
   HashingLoadBalancerSharedPtr
-  createLoadBalancer(const NormalizedHostWeightVector& normalized_host_weights,
+  createLoadBalancer(uint32_t priority, const NormalizedHostWeightVector& normalized_host_weights,
                      double /* min_normalized_weight */, double max_normalized_weight) override;
 
   Stats::ScopeSharedPtr scope_;
@@ -188,6 +211,7 @@ private:
   const uint64_t table_size_;
   const bool use_hostname_for_hashing_;
   const uint32_t hash_balance_factor_;
+  std::vector<TableBuild> table_builds_;
 };
 
 } // namespace Upstream
@@ -9,6 +9,7 @@
 
 #include "source/common/common/assert.h"
 
+#include "absl/container/flat_hash_set.h"
 #include "absl/container/inlined_vector.h"
 #include "absl/strings/string_view.h"
 
@@ -71,6 +72,26 @@ RingHashLoadBalancer::RingHashLoadBalancer(const PrioritySet& priority_set, Clus
   }
 }
 
+ThreadAwareLoadBalancerBase::HashingLoadBalancerSharedPtr
+RingHashLoadBalancer::createLoadBalancer(uint32_t priority,
+                                         const NormalizedHostWeightVector& normalized_host_weights,
+                                         double min_normalized_weight,
+                                         double /* max_normalized_weight */) {
+  if (priority >= rings_.size()) {
+    rings_.resize(priority + 1);
+  }
+  auto ring = std::make_shared<Ring>(normalized_host_weights, min_normalized_weight,
+                                     min_ring_size_, max_ring_size_, hash_function_,
+                                     use_hostname_for_hashing_, stats_, rings_[priority].get());
+  rings_[priority] = ring;
+  if (hash_balance_factor_ == 0) {
+    return ring;
+  }
+
+  return std::make_shared<BoundedLoadHashingLoadBalancer>(
+      ring, std::move(normalized_host_weights), hash_balance_factor_);
+}
+
 RingHashLoadBalancerStats RingHashLoadBalancer::generateStats(Stats::Scope& scope) {
   return {ALL_RING_HASH_LOAD_BALANCER_STATS(POOL_GAUGE(scope))};
 }
@@ -125,10 +146,49 @@ HostSelectionResponse RingHashLoadBalancer::Ring::chooseHost(uint64_t h, uint32_
 }
 
 using HashFunction = envoy::config::cluster::v3::Cluster::RingHashLbConfig::HashFunction;
+
+namespace {
+
+// Hashes "<key>_<i>" for every i in [begin, end) of a host.
+class HostHasher : private Logger::Loggable<Logger::Id::upstream> {
+public:
+  HostHasher(absl::string_view key, HashFunction hash_function)
+      : hash_function_(hash_function), prefix_size_(key.size() + 1) {
+    hash_key_buffer_.assign(key.begin(), key.end());
+    hash_key_buffer_.emplace_back('_');
+  }
+
+  template <class Callback> void hash(uint64_t begin, uint64_t end, Callback callback) {
+    for (uint64_t i = begin; i < end; ++i) {
+      const std::string i_str = absl::StrCat("", i);
+      hash_key_buffer_.insert(hash_key_buffer_.end(), i_str.begin(), i_str.end());
+
+      absl::string_view hash_key(static_cast<char*>(hash_key_buffer_.data()),
+                                 hash_key_buffer_.size());
+
+      const uint64_t hash = (hash_function_ == HashFunction::RingHash_HashFunction_MURMUR_HASH_2)
+                                ? MurmurHash::murmurHash2(hash_key, MurmurHash::STD_HASH_SEED)
+                                : HashUtil::xxHash64(hash_key);
+
+      ENVOY_LOG(trace, "ring hash: hash_key={} hash={}", hash_key, hash);
+      callback(hash);
+      hash_key_buffer_.resize(prefix_size_);
+    }
+  }
+
+private:
+  const HashFunction hash_function_;
+  const size_t prefix_size_;
+  absl::InlinedVector<char, 196> hash_key_buffer_;
+};
+
+} // namespace
+
 RingHashLoadBalancer::Ring::Ring(const NormalizedHostWeightVector& normalized_host_weights,
                                  double min_normalized_weight, uint64_t min_ring_size,
                                  uint64_t max_ring_size, HashFunction hash_function,
-                                 bool use_hostname_for_hashing, RingHashLoadBalancerStats& stats)
+                                 bool use_hostname_for_hashing, RingHashLoadBalancerStats& stats,
+                                 const Ring* previous)
     : stats_(stats) {
   ENVOY_LOG(trace, "ring hash: building ring");
 
@@ -148,7 +208,6 @@ RingHashLoadBalancer::Ring::Ring(const NormalizedHostWeightVector& normalized_ho
 
   // Reserve memory for the entire ring up front.
   const uint64_t ring_size = std::ceil(scale);
-  ring_.reserve(ring_size);
 
   // Populate the hash ring by walking through the (host, weight) pairs in
   // normalized_host_weights, and generating (scale * weight) hashes for each host. Since these
@@ -167,8 +226,14 @@ RingHashLoadBalancer::Ring::Ring(const NormalizedHostWeightVector& normalized_ho
   // For stats reporting, keep track of the minimum and maximum actual number of hashes per host.
   // Users should hopefully pay attention to these numbers and alert if min_hashes_per_host is too
   // low, since that implies an inaccurate request distribution.
-
-  absl::InlinedVector<char, 196> hash_key_buffer;
+  //
+  // The i-th hash of a host only depends on its hash key, so the entries a host had on the
+  // previous ring are still valid as long as its key did not change. Only the hashes a host
+  // gained are computed here, and the ones it lost are removed from the previous entries below.
+  std::vector<RingEntry> new_entries;
+  new_entries.reserve(previous == nullptr ? ring_size : 0);
+  absl::flat_hash_set<std::pair<uint64_t, const Host*>> removed_entries;
+  host_hashes_.reserve(normalized_host_weights.size());
   double current_hashes = 0.0;
   double target_hashes = 0.0;
   uint64_t min_hashes_per_host = ring_size;
@@ -178,38 +243,57 @@ RingHashLoadBalancer::Ring::Ring(const NormalizedHostWeightVector& normalized_ho
     const absl::string_view key_to_hash = hashKey(host, use_hostname_for_hashing);
     ASSERT(!key_to_hash.empty());
 
-    hash_key_buffer.assign(key_to_hash.begin(), key_to_hash.end());
-    hash_key_buffer.emplace_back('_');
-    auto offset_start = hash_key_buffer.end();
-
     // As noted above: maintain current_hashes and target_hashes as running sums across the entire
-    // host set. `i` is needed only to construct the hash key, and tally min/max hashes per host.
+    // host set.
     target_hashes += scale * entry.second;
-    uint64_t i = 0;
+    uint64_t count = 0;
     while (current_hashes < target_hashes) {
-      const std::string i_str = absl::StrCat("", i);
-      hash_key_buffer.insert(offset_start, i_str.begin(), i_str.end());
-
-      absl::string_view hash_key(static_cast<char*>(hash_key_buffer.data()),
-                                 hash_key_buffer.size());
-
-      const uint64_t hash = (hash_function == HashFunction::RingHash_HashFunction_MURMUR_HASH_2)
-                                ? MurmurHash::murmurHash2(hash_key, MurmurHash::STD_HASH_SEED)
-                                : HashUtil::xxHash64(hash_key);
-
-      ENVOY_LOG(trace, "ring hash: hash_key={} hash={}", hash_key, hash);
-      ring_.push_back({hash, host});
-      ++i;
+      ++count;
       ++current_hashes;
-      hash_key_buffer.erase(offset_start, hash_key_buffer.end());
     }
-    min_hashes_per_host = std::min(i, min_hashes_per_host);
-    max_hashes_per_host = std::max(i, max_hashes_per_host);
+    min_hashes_per_host = std::min(count, min_hashes_per_host);
+    max_hashes_per_host = std::max(count, max_hashes_per_host);
+
+    uint64_t reused = 0;
+    HostHasher hasher(key_to_hash, hash_function);
+    if (previous != nullptr) {
+      const auto it = previous->host_hashes_.find(host.get());
+      if (it != previous->host_hashes_.end() && it->second.key_ == key_to_hash) {
+        reused = std::min(count, it->second.count_);
+        hasher.hash(count, it->second.count_, [&](uint64_t hash) {
+          removed_entries.emplace(hash, host.get());
+        });
+      }
+    }
+    hasher.hash(reused, count, [&](uint64_t hash) { new_entries.push_back({hash, host}); });
+    host_hashes_[host.get()] = {std::string(key_to_hash), count};
   }
 
-  std::sort(ring_.begin(), ring_.end(), [](const RingEntry& lhs, const RingEntry& rhs) -> bool {
+  const auto compare = [](const RingEntry& lhs, const RingEntry& rhs) -> bool {
     return lhs.hash_ < rhs.hash_;
-  });
+  };
+  std::sort(new_entries.begin(), new_entries.end(), compare);
+  if (previous == nullptr) {
+    ring_ = std::move(new_entries);
+  } else {
+    absl::flat_hash_set<const Host*> removed_hosts;
+    for (const auto& [host, host_hashes] : previous->host_hashes_) {
+      const auto it = host_hashes_.find(host);
+      if (it == host_hashes_.end() || it->second.key_ != host_hashes.key_) {
+        removed_hosts.insert(host);
+      }
+    }
+
+    ring_.reserve(ring_size);
+    for (const RingEntry& entry : previous->ring_) {
+      if (!removed_hosts.contains(entry.host_.get()) &&
+          !removed_entries.contains(std::make_pair(entry.hash_, entry.host_.get()))) {
+        ring_.push_back(entry);
+      }
+    }
+    const auto middle = ring_.insert(ring_.end(), new_entries.begin(), new_entries.end());
+    std::inplace_merge(ring_.begin(), middle, ring_.end(), compare);
+  }
   if (ENVOY_LOG_CHECK_LEVEL(trace)) {
     for (const auto& entry : ring_) {
       const absl::string_view key_to_hash = hashKey(entry.host_, use_hostname_for_hashing);
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <string>
 #include <vector>
 
 #include "envoy/config/cluster/v3/cluster.pb.h"
@@ -13,6 +14,8 @@
 #include "source/common/common/logger.h"
 #include "source/extensions/load_balancing_policies/common/thread_aware_lb_impl.h"
 
+#include "absl/container/flat_hash_map.h"
+
 namespace Envoy {
 namespace Upstream {
 
@@ -76,15 +79,30 @@ private:
     HostConstSharedPtr host_;
   };
 
+  // Hash key and number of ring entries of a host.
+  struct HostHashes {
+    std::string key_;
+    uint64_t count_{};
+  };
+
   struct Ring : public HashingLoadBalancer {
+    /**
+     * Builds the ring. If the ring previously built for the same priority is given, the entries
+     * of hosts which are still present with the same hash key are taken over from it and only
+     * the entries of new or reweighted hosts are hashed. The result is the same as when building
+     * from scratch.
+     */
     Ring(const NormalizedHostWeightVector& normalized_host_weights, double min_normalized_weight,
          uint64_t min_ring_size, uint64_t max_ring_size, HashFunction hash_function,
-         bool use_hostname_for_hashing, RingHashLoadBalancerStats& stats);
+         bool use_hostname_for_hashing, RingHashLoadBalancerStats& stats,
+         const Ring* previous = nullptr);
 
     // ThreadAwareLoadBalancerBase::HashingLoadBalancer
     HostSelectionResponse chooseHost(uint64_t hash, uint32_t attempt) const override;
 
     std::vector<RingEntry> ring_;
+    // Only used on the main thread to build the next ring of the same priority.
+    absl::flat_hash_map<const Host*, HostHashes> host_hashes_;
 
     RingHashLoadBalancerStats& stats_;
   };
@@ -92,18 +110,8 @@ private:
 
   // ThreadAwareLoadBalancerBase
   HashingLoadBalancerSharedPtr
-  createLoadBalancer(const NormalizedHostWeightVector& normalized_host_weights,
-                     double min_normalized_weight, double /* max_normalized_weight */) override {
-    HashingLoadBalancerSharedPtr ring_hash_lb =
-        std::make_shared<Ring>(normalized_host_weights, min_normalized_weight, min_ring_size_,
-                               max_ring_size_, hash_function_, use_hostname_for_hashing_, stats_);
-    if (hash_balance_factor_ == 0) {
-      return ring_hash_lb;
-    }
-
-    return std::make_shared<BoundedLoadHashingLoadBalancer>(
-        ring_hash_lb, std::move(normalized_host_weights), hash_balance_factor_);
-  }
+  createLoadBalancer(uint32_t priority, const NormalizedHostWeightVector& normalized_host_weights,
+                     double min_normalized_weight, double /* max_normalized_weight */) override;
 
   static RingHashLoadBalancerStats generateStats(Stats::Scope& scope);
 
@@ -117,6 +125,8 @@ private:
   const HashFunction hash_function_;
   const bool use_hostname_for_hashing_;
   const uint32_t hash_balance_factor_;
+  // Ring last built for each priority.
+  std::vector<std::shared_ptr<Ring>> rings_;
 };
 
 } // namespace Upstream
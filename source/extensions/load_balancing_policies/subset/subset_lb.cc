@@ -11,6 +11,7 @@
 #include "source/common/config/metadata.h"
 #include "source/common/config/well_known_names.h"
 #include "source/common/protobuf/utility.h"
+#include "source/common/runtime/runtime_features.h"
 
 #include "absl/container/node_hash_set.h"
 
@@ -61,6 +62,8 @@ SubsetLoadBalancer::SubsetLoadBalancer(const SubsetLoadBalancerConfig& lb_config
       locality_weight_aware_(lb_config_.subsetInfo().localityWeightAware()),
       scale_locality_weight_(lb_config_.subsetInfo().scaleLocalityWeight()),
       list_as_any_(lb_config_.subsetInfo().listAsAny()),
+      lazy_subsets_(
+          Runtime::runtimeFeatureEnabled("envoy.reloadable_features.subset_lb_lazy_subsets")),
       allow_redundant_keys_(lb_config_.subsetInfo().allowRedundantKeys()) {
   ASSERT(lb_config_.subsetInfo().isEnabled());
 
@@ -120,16 +123,16 @@ void SubsetLoadBalancer::refreshSubsets(uint32_t priority) {
 void SubsetLoadBalancer::initSubsetAnyOnce() {
   if (!subset_any_) {
     subset_any_ = std::make_shared<LbSubsetEntry>();
-    subset_any_->lb_subset_ =
-        std::make_unique<PriorityLbSubset>(*this, locality_weight_aware_, scale_locality_weight_);
+    subset_any_->lb_subset_ = std::make_unique<PriorityLbSubset>(*this, locality_weight_aware_,
+                                                                 scale_locality_weight_, false);
   }
 }
 
 void SubsetLoadBalancer::initSubsetDefaultOnce() {
   if (!subset_default_) {
     subset_default_ = std::make_shared<LbSubsetEntry>();
-    subset_default_->lb_subset_ =
-        std::make_unique<PriorityLbSubset>(*this, locality_weight_aware_, scale_locality_weight_);
+    subset_default_->lb_subset_ = std::make_unique<PriorityLbSubset>(
+        *this, locality_weight_aware_, scale_locality_weight_, false);
   }
 }
 
@@ -378,6 +381,7 @@ HostConstSharedPtr SubsetLoadBalancer::tryChooseHostFromContext(LoadBalancerCont
 
   host_chosen = true;
   stats_.lb_subsets_selected_.inc();
+  entry->lb_subset_->materialize();
   return Upstream::LoadBalancer::onlyAllowSynchronousHostSelection(
       entry->lb_subset_->chooseHost(context));
 }
@@ -423,12 +427,11 @@ SubsetLoadBalancer::LbSubsetEntryPtr SubsetLoadBalancer::findSubset(
 
 void SubsetLoadBalancer::updateFallbackSubset(uint32_t priority, const HostVector& all_hosts) {
   auto update_func = [priority, &all_hosts](LbSubsetPtr& subset, const HostPredicate& predicate) {
-    for (const auto& host : all_hosts) {
-      if (predicate(*host)) {
-        subset->pushHost(priority, host);
+    for (uint32_t i = 0; i < all_hosts.size(); ++i) {
+      if (predicate(*all_hosts[i])) {
+        subset->pushHost(priority, i, all_hosts[i]);
       }
     }
-    subset->finalize(priority);
   };
 
   if (subset_any_ != nullptr) {
@@ -460,8 +463,8 @@ void SubsetLoadBalancer::initLbSubsetEntryOnce(LbSubsetEntryPtr& entry, bool sin
     entry->lb_subset_ = std::make_unique<SingleHostLbSubset>();
     entry->single_host_subset_ = true;
   } else {
-    entry->lb_subset_ =
-        std::make_unique<PriorityLbSubset>(*this, locality_weight_aware_, scale_locality_weight_);
+    entry->lb_subset_ = std::make_unique<PriorityLbSubset>(*this, locality_weight_aware_,
+                                                           scale_locality_weight_, lazy_subsets_);
     entry->single_host_subset_ = false;
   }
 
@@ -476,7 +479,8 @@ void SubsetLoadBalancer::processSubsets(uint32_t priority, const HostVector& all
   absl::flat_hash_set<const LbSubsetEntry*> single_host_entries;
   uint64_t collision_count_of_single_host_entries{};
 
-  for (const auto& host : all_hosts) {
+  for (uint32_t i = 0; i < all_hosts.size(); ++i) {
+    const HostSharedPtr& host = all_hosts[i];
     for (const auto& subset_selector : subset_selectors_) {
       const auto& keys = subset_selector->selectorKeys();
       // For each host, for each subset key, attempt to extract the metadata corresponding to the
@@ -495,7 +499,7 @@ void SubsetLoadBalancer::processSubsets(uint32_t priority, const HostVector& all
           single_host_entries.emplace(entry.get());
         }
 
-        entry->lb_subset_->pushHost(priority, host);
+        entry->lb_subset_->pushHost(priority, i, host);
       }
     }
   }
@@ -511,13 +515,32 @@ void SubsetLoadBalancer::processSubsets(uint32_t priority, const HostVector& all
         scope_, {name_storage.statName()}, Stats::Gauge::ImportMode::Accumulate);
   }
   single_duplicate_stat_->set(collision_count_of_single_host_entries);
+}
 
-  // Finalize updates after all the hosts are evaluated.
-  forEachSubset(subsets_, [priority](LbSubsetEntryPtr entry) {
-    if (entry->initialized()) {
-      entry->lb_subset_->finalize(priority);
+// Finalizes the updates of all the subsets after the hosts of the priority were pushed to them by
+// updateFallbackSubset and processSubsets.
+void SubsetLoadBalancer::finalizeSubsets(uint32_t priority, const HostVector& all_hosts) {
+  std::vector<LbSubset*> lb_subsets;
+  const auto collect = [&lb_subsets](const LbSubsetEntryPtr& entry) {
+    if (entry != nullptr && entry->initialized()) {
+      lb_subsets.push_back(entry->lb_subset_.get());
     }
-  });
+  };
+  collect(subset_any_);
+  collect(subset_default_);
+  forEachSubset(subsets_, collect);
+
+  // Fill the host sets of all the subsets with a single pass over the original host set.
+  const HostIndex index(all_hosts);
+  HostPartitioner partitioner(index);
+  for (LbSubset* lb_subset : lb_subsets) {
+    lb_subset->addToPartitioner(priority, partitioner);
+  }
+  partitioner.partition(*original_priority_set_.hostSetsPerPriority()[priority]);
+
+  for (LbSubset* lb_subset : lb_subsets) {
+    lb_subset->finalize(priority, index);
+  }
 }
 
 // Given the latest all hosts, update all subsets for this priority level, creating new subsets as
@@ -525,6 +548,7 @@ void SubsetLoadBalancer::processSubsets(uint32_t priority, const HostVector& all
 void SubsetLoadBalancer::update(uint32_t priority, const HostVector& all_hosts) {
   updateFallbackSubset(priority, all_hosts);
   processSubsets(priority, all_hosts);
+  finalizeSubsets(priority, all_hosts);
 }
 
 bool SubsetLoadBalancer::hostMatches(const SubsetMetadata& kvs, const Host& host) {
@@ -725,67 +749,152 @@ SubsetLoadBalancer::PrioritySubsetImpl::PrioritySubsetImpl(const SubsetLoadBalan
   triggerCallbacks();
 }
 
-// Given all hosts that that belong in this subset, hosts_added and hosts_removed, update the
-// underlying HostSet. The hosts_added Hosts and hosts_removed Hosts have been filtered to match
-// hosts that belong in this subset.
-void SubsetLoadBalancer::HostSubsetImpl::update(const HostHashSet& matching_hosts,
-                                                const HostVector& hosts_added,
-                                                const HostVector& hosts_removed) {
-  auto cached_predicate = [&matching_hosts](const auto& host) {
-    return matching_hosts.count(&host) == 1;
-  };
+SubsetLoadBalancer::HostIndex::HostIndex(const HostVector& hosts) : hosts_(hosts) {
+  positions_.reserve(hosts.size());
+  for (uint32_t i = 0; i < hosts.size(); ++i) {
+    positions_.emplace(hosts[i].get(), i);
+  }
+}
 
-  // TODO(snowp): If we had a unhealthyHosts() function we could avoid potentially traversing
-  // the list of hosts twice.
-  auto hosts = std::make_shared<HostVector>();
-  hosts->reserve(original_host_set_.hosts().size());
-  for (const auto& host : original_host_set_.hosts()) {
-    if (cached_predicate(*host)) {
-      hosts->emplace_back(host);
-    }
+absl::optional<uint32_t> SubsetLoadBalancer::HostIndex::find(const Host& host) const {
+  const auto it = positions_.find(&host);
+  if (it == positions_.end()) {
+    return absl::nullopt;
   }
+  return it->second;
+}
 
-  auto healthy_hosts = std::make_shared<HealthyHostVector>();
-  healthy_hosts->get().reserve(original_host_set_.healthyHosts().size());
-  for (const auto& host : original_host_set_.healthyHosts()) {
-    if (cached_predicate(*host)) {
-      healthy_hosts->get().emplace_back(host);
-    }
+void SubsetLoadBalancer::HostBitmap::set(uint32_t position) {
+  const uint32_t word = position / 64;
+  if (words_.empty()) {
+    first_word_ = word;
+  } else if (word < first_word_) {
+    words_.insert(words_.begin(), first_word_ - word, 0);
+    first_word_ = word;
   }
+  if (word - first_word_ >= words_.size()) {
+    words_.resize(word - first_word_ + 1);
+  }
+  words_[word - first_word_] |= uint64_t{1} << (position % 64);
+}
 
-  auto degraded_hosts = std::make_shared<DegradedHostVector>();
-  degraded_hosts->get().reserve(original_host_set_.degradedHosts().size());
-  for (const auto& host : original_host_set_.degradedHosts()) {
-    if (cached_predicate(*host)) {
-      degraded_hosts->get().emplace_back(host);
-    }
+bool SubsetLoadBalancer::HostBitmap::test(uint32_t position) const {
+  const uint32_t word = position / 64;
+  if (word < first_word_ || word - first_word_ >= words_.size()) {
+    return false;
   }
+  return (words_[word - first_word_] >> (position % 64)) & 1;
+}
 
-  auto excluded_hosts = std::make_shared<ExcludedHostVector>();
-  excluded_hosts->get().reserve(original_host_set_.excludedHosts().size());
-  for (const auto& host : original_host_set_.excludedHosts()) {
-    if (cached_predicate(*host)) {
-      excluded_hosts->get().emplace_back(host);
+void SubsetLoadBalancer::HostPartitioner::add(const HostBitmap& hosts,
+                                              HostSubsetImpl::Partition& partition) {
+  if (partitions_by_position_.empty()) {
+    partitions_by_position_.resize(index_.size());
+  }
+  hosts.forEach([this, &partition](uint32_t position) {
+    partitions_by_position_[position].push_back(&partition);
+  });
+  partitions_.push_back(&partition);
+}
+
+void SubsetLoadBalancer::HostPartitioner::partition(const HostSet& original_host_set) {
+  if (partitions_.empty()) {
+    return;
+  }
+
+  using Partition = HostSubsetImpl::Partition;
+
+  // Appends every host of the list to the partitions it belongs to. The order of the hosts in the
+  // original list is preserved in every partition.
+  const auto distribute = [this](const HostVector& hosts, auto&& target) {
+    for (const auto& host : hosts) {
+      const absl::optional<uint32_t> position = index_.find(*host);
+      if (!position.has_value()) {
+        continue;
+      }
+      for (Partition* partition : partitions_by_position_[*position]) {
+        target(*partition).push_back(host);
+      }
+    }
+  };
+  const auto distribute_per_locality = [this, &distribute](const HostsPerLocality& original,
+                                                           auto&& target) {
+    const auto& localities = original.get();
+    for (Partition* partition : partitions_) {
+      target(*partition).resize(localities.size());
+    }
+    for (size_t i = 0; i < localities.size(); ++i) {
+      distribute(localities[i], [&target, i](Partition& partition) -> HostVector& {
+        return target(partition)[i];
+      });
     }
+  };
+
+  distribute(original_host_set.hosts(), [](Partition& p) -> HostVector& { return p.hosts_; });
+  distribute(original_host_set.healthyHosts().get(),
+             [](Partition& p) -> HostVector& { return p.healthy_hosts_; });
+  distribute(original_host_set.degradedHosts().get(),
+             [](Partition& p) -> HostVector& { return p.degraded_hosts_; });
+  distribute(original_host_set.excludedHosts().get(),
+             [](Partition& p) -> HostVector& { return p.excluded_hosts_; });
+
+  // With a single locality the hosts per locality are built from the hosts of the subset.
+  if (original_host_set.hostsPerLocality().get().size() != 1) {
+    distribute_per_locality(original_host_set.hostsPerLocality(),
+                            [](Partition& p) -> std::vector<HostVector>& {
+                              return p.hosts_per_locality_;
+                            });
   }
+  distribute_per_locality(original_host_set.healthyHostsPerLocality(),
+                          [](Partition& p) -> std::vector<HostVector>& {
+                            return p.healthy_hosts_per_locality_;
+                          });
+  distribute_per_locality(original_host_set.degradedHostsPerLocality(),
+                          [](Partition& p) -> std::vector<HostVector>& {
+                            return p.degraded_hosts_per_locality_;
+                          });
+  distribute_per_locality(original_host_set.excludedHostsPerLocality(),
+                          [](Partition& p) -> std::vector<HostVector>& {
+                            return p.excluded_hosts_per_locality_;
+                          });
+}
 
-  // If we only have one locality we can avoid the first call to filter() by
-  // just creating a new HostsPerLocality from the list of all hosts.
+// Given the hosts of the original host set that belong in this subset, hosts_added and
+// hosts_removed, update the underlying HostSet. The hosts_added Hosts and hosts_removed Hosts have
+// been filtered to match hosts that belong in this subset.
+void SubsetLoadBalancer::HostSubsetImpl::update(Partition&& partition,
+                                                const HostVector& hosts_added,
+                                                const HostVector& hosts_removed) {
+  auto hosts = std::make_shared<HostVector>(std::move(partition.hosts_));
+  auto healthy_hosts = std::make_shared<HealthyHostVector>();
+  healthy_hosts->get() = std::move(partition.healthy_hosts_);
+  auto degraded_hosts = std::make_shared<DegradedHostVector>();
+  degraded_hosts->get() = std::move(partition.degraded_hosts_);
+  auto excluded_hosts = std::make_shared<ExcludedHostVector>();
+  excluded_hosts->get() = std::move(partition.excluded_hosts_);
+
+  // If we only have one locality we can avoid distributing the hosts per locality by just creating
+  // a new HostsPerLocality from the list of all hosts.
   HostsPerLocalityConstSharedPtr hosts_per_locality;
 
   if (original_host_set_.hostsPerLocality().get().size() == 1) {
     hosts_per_locality = std::make_shared<HostsPerLocalityImpl>(
         *hosts, original_host_set_.hostsPerLocality().hasLocalLocality());
   } else {
-    hosts_per_locality = original_host_set_.hostsPerLocality().filter({cached_predicate})[0];
+    hosts_per_locality = std::make_shared<HostsPerLocalityImpl>(
+        std::move(partition.hosts_per_locality_),
+        original_host_set_.hostsPerLocality().hasLocalLocality());
   }
 
-  auto healthy_hosts_per_locality =
-      original_host_set_.healthyHostsPerLocality().filter({cached_predicate})[0];
-  auto degraded_hosts_per_locality =
-      original_host_set_.degradedHostsPerLocality().filter({cached_predicate})[0];
-  auto excluded_hosts_per_locality =
-      original_host_set_.excludedHostsPerLocality().filter({cached_predicate})[0];
+  auto healthy_hosts_per_locality = std::make_shared<HostsPerLocalityImpl>(
+      std::move(partition.healthy_hosts_per_locality_),
+      original_host_set_.healthyHostsPerLocality().hasLocalLocality());
+  auto degraded_hosts_per_locality = std::make_shared<HostsPerLocalityImpl>(
+      std::move(partition.degraded_hosts_per_locality_),
+      original_host_set_.degradedHostsPerLocality().hasLocalLocality());
+  auto excluded_hosts_per_locality = std::make_shared<HostsPerLocalityImpl>(
+      std::move(partition.excluded_hosts_per_locality_),
+      original_host_set_.excludedHostsPerLocality().hasLocalLocality());
 
   HostSetImpl::updateHosts(
       HostSetImpl::updateHostsParams(
@@ -846,11 +955,11 @@ HostSetImplPtr SubsetLoadBalancer::PrioritySubsetImpl::createHostSet(
 }
 
 void SubsetLoadBalancer::PrioritySubsetImpl::update(uint32_t priority,
-                                                    const HostHashSet& matching_hosts,
+                                                    HostSubsetImpl::Partition&& partition,
                                                     const HostVector& hosts_added,
                                                     const HostVector& hosts_removed) {
   const auto& host_subset = getOrCreateHostSet(priority);
-  updateSubset(priority, matching_hosts, hosts_added, hosts_removed);
+  updateSubset(priority, std::move(partition), hosts_added, hosts_removed);
 
   if (host_subset.hosts().empty() != empty_) {
     empty_ = true;
@@ -867,31 +976,87 @@ void SubsetLoadBalancer::PrioritySubsetImpl::update(uint32_t priority,
   }
 }
 
-void SubsetLoadBalancer::PriorityLbSubset::finalize(uint32_t priority) {
-  while (host_sets_.size() <= priority) {
-    host_sets_.push_back({HostHashSet(), HostHashSet()});
+SubsetLoadBalancer::PriorityLbSubset::PriorityLbSubset(const SubsetLoadBalancer& subset_lb,
+                                                       bool locality_weight_aware,
+                                                       bool scale_locality_weight, bool lazy)
+    : subset_lb_(subset_lb), locality_weight_aware_(locality_weight_aware),
+      scale_locality_weight_(scale_locality_weight) {
+  if (!lazy) {
+    materialize();
+  }
+}
+
+void SubsetLoadBalancer::PriorityLbSubset::finalize(uint32_t priority, const HostIndex& index) {
+  if (subset_ == nullptr) {
+    // Keep the hosts until the subset is materialized. The positions stay valid until the next
+    // update of the priority, which replaces them.
+    if (pending_hosts_.size() <= priority) {
+      pending_hosts_.resize(priority + 1);
+    }
+    pending_hosts_[priority].swap(hosts_);
+    hosts_.clear();
+    return;
   }
-  auto& [old_hosts, new_hosts] = host_sets_[priority];
 
   HostVector added;
   HostVector removed;
 
-  for (const auto& host : old_hosts) {
-    if (new_hosts.count(host) == 0) {
-      removed.emplace_back(host);
+  // The hosts of the subset before the update that are still in it.
+  HostBitmap kept;
+  const auto& host_sets = subset_->hostSetsPerPriority();
+  if (priority < host_sets.size()) {
+    for (const auto& host : host_sets[priority]->hosts()) {
+      const absl::optional<uint32_t> position = index.find(*host);
+      if (position.has_value() && hosts_.test(*position)) {
+        kept.set(*position);
+      } else {
+        removed.emplace_back(host);
+      }
     }
   }
 
-  for (const auto& host : new_hosts) {
-    if (old_hosts.count(host) == 0) {
-      added.emplace_back(host);
+  hosts_.forEach([&](uint32_t position) {
+    if (!kept.test(position)) {
+      added.emplace_back(index.host(position));
     }
-  }
+  });
 
-  subset_.update(priority, new_hosts, added, removed);
+  subset_->update(priority, std::move(partition_), added, removed);
+  partition_ = {};
+  hosts_.clear();
+}
+
+void SubsetLoadBalancer::PriorityLbSubset::materialize() {
+  if (subset_ != nullptr) {
+    return;
+  }
+  subset_ = std::make_unique<PrioritySubsetImpl>(subset_lb_, locality_weight_aware_,
+                                                 scale_locality_weight_);
+
+  // Fill the host sets with the hosts kept by the updates since the subset was created. The hosts
+  // of the original host sets did not change since then.
+  const auto& host_sets = subset_lb_.original_priority_set_.hostSetsPerPriority();
+  for (uint32_t priority = 0; priority < pending_hosts_.size(); ++priority) {
+    if (pending_hosts_[priority].empty()) {
+      continue;
+    }
+    const HostSet& host_set = *host_sets[priority];
+    const HostIndex index(host_set.hosts());
+    HostPartitioner partitioner(index);
+    hosts_.swap(pending_hosts_[priority]);
+    partitioner.add(hosts_, partition_);
+    partitioner.partition(host_set);
+    finalize(priority, index);
+  }
+  pending_hosts_.clear();
+}
 
-  old_hosts.swap(new_hosts);
-  new_hosts.clear();
+bool SubsetLoadBalancer::PriorityLbSubset::active() const {
+  if (subset_ != nullptr) {
+    return !subset_->empty();
+  }
+  return std::any_of(pending_hosts_.begin(), pending_hosts_.end(),
+                     [](const HostBitmap& hosts) { return !hosts.empty(); });
 }
 
 SubsetLoadBalancer::LoadBalancerContextWrapper::LoadBalancerContextWrapper(
@@ -24,7 +24,10 @@
 #include "source/common/upstream/upstream_impl.h"
 #include "source/extensions/load_balancing_policies/subset/subset_lb_config.h"
 
+#include "absl/container/flat_hash_map.h"
+#include "absl/container/inlined_vector.h"
 #include "absl/container/node_hash_map.h"
+#include "absl/numeric/bits.h"
 #include "absl/types/optional.h"
 
 namespace Envoy {
@@ -85,7 +88,21 @@ private:
           original_host_set_(original_host_set), locality_weight_aware_(locality_weight_aware),
           scale_locality_weight_(scale_locality_weight) {}
 
-    void update(const HostHashSet& matching_hosts, const HostVector& hosts_added,
+    // Hosts of the subset in each of the lists of the original host set, in the same order as in
+    // the original lists. The per locality lists are left empty when the original host set has a
+    // single locality.
+    struct Partition {
+      HostVector hosts_;
+      HostVector healthy_hosts_;
+      HostVector degraded_hosts_;
+      HostVector excluded_hosts_;
+      std::vector<HostVector> hosts_per_locality_;
+      std::vector<HostVector> healthy_hosts_per_locality_;
+      std::vector<HostVector> degraded_hosts_per_locality_;
+      std::vector<HostVector> excluded_hosts_per_locality_;
+    };
+
+    void update(Partition&& partition, const HostVector& hosts_added,
                 const HostVector& hosts_removed);
     LocalityWeightsConstSharedPtr
     determineLocalityWeights(const HostsPerLocality& hosts_per_locality) const;
@@ -102,8 +119,8 @@ private:
     PrioritySubsetImpl(const SubsetLoadBalancer& subset_lb, bool locality_weight_aware,
                        bool scale_locality_weight);
 
-    void update(uint32_t priority, const HostHashSet& matching_hosts, const HostVector& hosts_added,
-                const HostVector& hosts_removed);
+    void update(uint32_t priority, HostSubsetImpl::Partition&& partition,
+                const HostVector& hosts_added, const HostVector& hosts_removed);
 
     bool empty() const { return empty_; }
 
@@ -113,10 +130,10 @@ private:
       }
     }
 
-    void updateSubset(uint32_t priority, const HostHashSet& matching_hosts,
+    void updateSubset(uint32_t priority, HostSubsetImpl::Partition&& partition,
                       const HostVector& hosts_added, const HostVector& hosts_removed) {
       reinterpret_cast<HostSubsetImpl*>(host_sets_[priority].get())
-          ->update(matching_hosts, hosts_added, hosts_removed);
+          ->update(std::move(partition), hosts_added, hosts_removed);
       runUpdateCallbacks(hosts_added, hosts_removed);
     }
 
@@ -220,52 +237,133 @@ private:
     SubsetSelectorFallbackParams fallback_params_;
   };
 
+  // Positions of the hosts of a priority of the original host set, in the order of its hosts.
+  class HostIndex {
+  public:
+    explicit HostIndex(const HostVector& hosts);
+
+    absl::optional<uint32_t> find(const Host& host) const;
+    const HostSharedPtr& host(uint32_t position) const { return hosts_[position]; }
+    uint32_t size() const { return hosts_.size(); }
+
+  private:
+    const HostVector& hosts_;
+    absl::flat_hash_map<const Host*, uint32_t> positions_;
+  };
+
+  // Set of positions in a HostIndex, one bit per position. Only the words between the lowest and
+  // the highest position set are stored, so that subsets of neighbouring hosts stay small.
+  class HostBitmap {
+  public:
+    void set(uint32_t position);
+    bool test(uint32_t position) const;
+    bool empty() const { return words_.empty(); }
+    // Keeps the storage for the next update.
+    void clear() {
+      words_.clear();
+      first_word_ = 0;
+    }
+    void swap(HostBitmap& other) {
+      words_.swap(other.words_);
+      std::swap(first_word_, other.first_word_);
+    }
+    // Invokes cb with every position set, in increasing order.
+    template <class Callback> void forEach(Callback cb) const {
+      for (size_t i = 0; i < words_.size(); ++i) {
+        for (uint64_t word = words_[i]; word != 0; word &= word - 1) {
+          cb(static_cast<uint32_t>((first_word_ + i) * 64 + absl::countr_zero(word)));
+        }
+      }
+    }
+
+  private:
+    std::vector<uint64_t> words_;
+    uint32_t first_word_{};
+  };
+
+  // Index from the hosts of a priority to the partitions of the subsets they belong to. Used to
+  // fill all the subsets of a priority with a single pass over the lists of the original host set,
+  // instead of filtering every list of the original host set once per subset.
+  class HostPartitioner {
+  public:
+    explicit HostPartitioner(const HostIndex& index) : index_(index) {}
+
+    // Registers the hosts that belong to the subset owning the partition.
+    void add(const HostBitmap& hosts, HostSubsetImpl::Partition& partition);
+    // Distributes the hosts of the original host set to the partitions they were registered to.
+    void partition(const HostSet& original_host_set);
+
+  private:
+    const HostIndex& index_;
+    std::vector<absl::InlinedVector<HostSubsetImpl::Partition*, 4>> partitions_by_position_;
+    std::vector<HostSubsetImpl::Partition*> partitions_;
+  };
+
   class LbSubset {
   public:
     virtual ~LbSubset() = default;
     virtual HostSelectionResponse chooseHost(LoadBalancerContext* context) const PURE;
-    virtual void pushHost(uint32_t priority, HostSharedPtr host) PURE;
-    virtual void finalize(uint32_t priority) PURE;
+    // Adds the host at the given position in the hosts of the priority to the subset.
+    virtual void pushHost(uint32_t priority, uint32_t position, HostSharedPtr host) PURE;
+    // Called after pushHost and before finalize. Registers the hosts pushed for the priority.
+    virtual void addToPartitioner(uint32_t priority, HostPartitioner& partitioner) PURE;
+    virtual void finalize(uint32_t priority, const HostIndex& index) PURE;
+    // Called before chooseHost on subsets found by their metadata.
+    virtual void materialize() PURE;
     virtual bool active() const PURE;
   };
   using LbSubsetPtr = std::unique_ptr<LbSubset>;
 
   class PriorityLbSubset : public LbSubset {
   public:
+    // A lazy subset only creates its host sets and load balancer on the first call to
+    // materialize. Until then, it only keeps the positions of its hosts in every priority.
     PriorityLbSubset(const SubsetLoadBalancer& subset_lb, bool locality_weight_aware,
-                     bool scale_locality_weight)
-        : subset_(subset_lb, locality_weight_aware, scale_locality_weight) {}
+                     bool scale_locality_weight, bool lazy);
 
     // Subset
     HostSelectionResponse chooseHost(LoadBalancerContext* context) const override {
-      return subset_.lb_->chooseHost(context);
+      ASSERT(subset_ != nullptr);
+      return subset_->lb_->chooseHost(context);
     }
-    void pushHost(uint32_t priority, HostSharedPtr host) override {
-      while (host_sets_.size() <= priority) {
-        host_sets_.push_back({HostHashSet(), HostHashSet()});
+    void pushHost(uint32_t, uint32_t position, HostSharedPtr) override { hosts_.set(position); }
+    void addToPartitioner(uint32_t, HostPartitioner& partitioner) override {
+      if (subset_ != nullptr) {
+        partitioner.add(hosts_, partition_);
       }
-      host_sets_[priority].second.emplace(std::move(host));
     }
     // Called after pushHost. Update subset by the hosts that pushed in the pushHost. If no any host
     // is pushed then subset_ will be set to empty.
-    void finalize(uint32_t priority) override;
+    void finalize(uint32_t priority, const HostIndex& index) override;
+    void materialize() override;
 
-    bool active() const override { return !subset_.empty(); }
+    bool active() const override;
 
-    std::vector<std::pair<HostHashSet, HostHashSet>> host_sets_;
-    PrioritySubsetImpl subset_;
+  private:
+    const SubsetLoadBalancer& subset_lb_;
+    const bool locality_weight_aware_;
+    const bool scale_locality_weight_;
+    // Hosts pushed for the priority being updated.
+    HostBitmap hosts_;
+    // Hosts of every priority, until the subset is materialized.
+    std::vector<HostBitmap> pending_hosts_;
+    // Filled by the HostPartitioner between pushHost and finalize.
+    HostSubsetImpl::Partition partition_;
+    std::unique_ptr<PrioritySubsetImpl> subset_;
   };
 
   class SingleHostLbSubset : public LbSubset {
     // Subset
     HostSelectionResponse chooseHost(LoadBalancerContext*) const override { return subset_; }
     // This is called at most once for every update for single host subset.
-    void pushHost(uint32_t priority, HostSharedPtr host) override {
+    void pushHost(uint32_t priority, uint32_t, HostSharedPtr host) override {
       new_hosts_[priority] = std::move(host);
     }
+    // Single host subsets do not own a host set.
+    void addToPartitioner(uint32_t, HostPartitioner&) override {}
     // Called after pushHost. Update subset by the host that pushed in the pushHost. If no any host
     // is pushed then subset_ will be set to nullptr.
-    void finalize(uint32_t priority) override {
+    void finalize(uint32_t priority, const HostIndex&) override {
       if (auto iter = new_hosts_.find(priority); iter == new_hosts_.end()) {
         // No any host for current subset and priority. Try remove record in the hosts_.
         hosts_.erase(priority);
@@ -282,6 +380,7 @@ private:
 
       subset_ = hosts_.begin()->second;
     }
+    void materialize() override {}
     bool active() const override { return subset_ != nullptr; }
 
     // We will update subsets for every priority separately and these simple map can help us
@@ -320,6 +419,7 @@ private:
 
   void updateFallbackSubset(uint32_t priority, const HostVector& all_hosts);
   void processSubsets(uint32_t priority, const HostVector& all_hosts);
+  void finalizeSubsets(uint32_t priority, const HostVector& all_hosts);
 
   HostConstSharedPtr tryChooseHostFromContext(LoadBalancerContext* context, bool& host_chosen);
 
@@ -381,6 +481,7 @@ private:
   const bool locality_weight_aware_ : 1;
   const bool scale_locality_weight_ : 1;
   const bool list_as_any_ : 1;
+  const bool lazy_subsets_ : 1;
   const bool allow_redundant_keys_{};
 };
 
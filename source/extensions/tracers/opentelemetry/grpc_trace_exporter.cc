@@ -11,7 +11,7 @@ namespace OpenTelemetry {
 
 OpenTelemetryGrpcTraceExporter::OpenTelemetryGrpcTraceExporter(
     const Grpc::RawAsyncClientSharedPtr& client)
-    : client_(client),
+    : raw_client_(client), client_(client),
       service_method_(*Protobuf::DescriptorPool::generated_pool()->FindMethodByName(
           "opentelemetry.proto.collector.trace.v1.TraceService.Export")) {}
 
@@ -46,6 +46,15 @@ bool OpenTelemetryGrpcTraceExporter::log(const ExportTraceServiceRequest& reques
   return true;
 }
 
+bool OpenTelemetryGrpcTraceExporter::logSerialized(Buffer::InstancePtr&& request,
+                                                   uint64_t span_count) {
+  raw_client_->sendRaw(service_method_.service()->full_name(), service_method_.name(),
+                       std::move(request), *this, Tracing::NullSpan::instance(),
+                       Http::AsyncClient::RequestOptions());
+  OpenTelemetryTraceExporter::logExportedSpans(span_count);
+  return true;
+}
+
 } // namespace OpenTelemetry
 } // namespace Tracers
 } // namespace Extensions
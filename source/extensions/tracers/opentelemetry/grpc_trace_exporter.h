@@ -26,7 +26,10 @@ public:
                  Tracing::Span&) override;
 
   bool log(const ExportTraceServiceRequest& request) override;
+  bool logSerialized(Buffer::InstancePtr&& request, uint64_t span_count) override;
 
+  // Serialized requests bypass the typed client.
+  Grpc::RawAsyncClientSharedPtr raw_client_;
   Grpc::AsyncClient<ExportTraceServiceRequest, ExportTraceServiceResponse> client_;
   const Protobuf::MethodDescriptor& service_method_;
 };
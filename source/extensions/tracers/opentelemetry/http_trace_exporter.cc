@@ -5,6 +5,7 @@
 #include <string>
 #include <vector>
 
+#include "source/common/buffer/buffer_impl.h"
 #include "source/common/common/enum_to_int.h"
 #include "source/common/common/logger.h"
 #include "source/common/protobuf/protobuf.h"
@@ -36,6 +37,19 @@ bool OpenTelemetryHttpTraceExporter::log(const ExportTraceServiceRequest& reques
     return false;
   }
 
+  const bool sent = send(std::make_unique<Buffer::OwnedImpl>(request_body));
+  OpenTelemetryTraceExporter::logExportedSpans(request);
+  return sent;
+}
+
+bool OpenTelemetryHttpTraceExporter::logSerialized(Buffer::InstancePtr&& request,
+                                                   uint64_t span_count) {
+  const bool sent = send(std::move(request));
+  OpenTelemetryTraceExporter::logExportedSpans(span_count);
+  return sent;
+}
+
+bool OpenTelemetryHttpTraceExporter::send(Buffer::InstancePtr&& request_body) {
   const auto thread_local_cluster =
       cluster_manager_.getThreadLocalCluster(http_service_.http_uri().cluster());
   if (thread_local_cluster == nullptr) {
@@ -59,7 +73,7 @@ bool OpenTelemetryHttpTraceExporter::log(const ExportTraceServiceRequest& reques
   for (const auto& header_pair : parsed_headers_to_add_) {
     message->headers().setReference(header_pair.first, header_pair.second);
   }
-  message->body().add(request_body);
+  message->body().move(*request_body);
 
   const auto options =
       Http::AsyncClient::RequestOptions()
@@ -70,8 +84,6 @@ bool OpenTelemetryHttpTraceExporter::log(const ExportTraceServiceRequest& reques
   Http::AsyncClient::Request* in_flight_request =
       thread_local_cluster->httpAsyncClient().send(std::move(message), *this, options);
 
-  OpenTelemetryTraceExporter::logExportedSpans(request);
-
   if (in_flight_request == nullptr) {
     return false;
   }
@@ -28,6 +28,7 @@ public:
                                  const envoy::config::core::v3::HttpService& http_service);
 
   bool log(const ExportTraceServiceRequest& request) override;
+  bool logSerialized(Buffer::InstancePtr&& request, uint64_t span_count) override;
 
   // Http::AsyncClient::Callbacks.
   void onSuccess(const Http::AsyncClient::Request&, Http::ResponseMessagePtr&&) override;
@@ -35,6 +36,8 @@ public:
   void onBeforeFinalizeUpstreamSpan(Tracing::Span&, const Http::ResponseHeaderMap*) override {}
 
 private:
+  bool send(Buffer::InstancePtr&& request_body);
+
   Upstream::ClusterManager& cluster_manager_;
   envoy::config::core::v3::HttpService http_service_;
   // Track active HTTP requests to be able to cancel them on destruction.
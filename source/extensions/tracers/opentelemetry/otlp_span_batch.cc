@@ -0,0 +1,107 @@
+#include "source/extensions/tracers/opentelemetry/otlp_span_batch.h"
+
+#include <memory>
+
+#include "source/common/protobuf/protobuf.h"
+#include "source/common/version/version.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace Tracers {
+namespace OpenTelemetry {
+
+namespace {
+
+// Tags of the length-delimited fields used below, i.e. (field_number << 3) | 2.
+constexpr uint8_t FieldOneTag = 0x0a;
+constexpr uint8_t FieldTwoTag = 0x12;
+constexpr uint8_t FieldThreeTag = 0x1a;
+
+uint64_t lengthDelimitedSize(uint64_t length) {
+  return 1 + Protobuf::io::CodedOutputStream::VarintSize64(length) + length;
+}
+
+void appendFieldHeader(std::string& out, uint8_t tag, uint64_t length) {
+  uint8_t header[1 + 10];
+  header[0] = tag;
+  const uint8_t* end = Protobuf::io::CodedOutputStream::WriteVarint64ToArray(length, header + 1);
+  out.append(reinterpret_cast<const char*>(header), end - header);
+}
+
+} // namespace
+
+OtlpSpanBatch::OtlpSpanBatch(const Resource& resource) : schema_url_(resource.schema_url_) {
+  ::opentelemetry::proto::resource::v1::Resource resource_proto;
+  for (const auto& [key, value] : resource.attributes_) {
+    auto* attribute = resource_proto.add_attributes();
+    attribute->set_key(key);
+    attribute->mutable_value()->set_string_value(value);
+  }
+  resource_ = resource_proto.SerializeAsString();
+
+  ::opentelemetry::proto::common::v1::InstrumentationScope scope;
+  scope.set_name("envoy");
+  scope.set_version(Envoy::VersionInfo::version());
+  scope_ = scope.SerializeAsString();
+}
+
+uint64_t OtlpSpanBatch::encodedSize(const ::opentelemetry::proto::trace::v1::Span& span) {
+  return lengthDelimitedSize(span.ByteSizeLong());
+}
+
+void OtlpSpanBatch::add(const ::opentelemetry::proto::trace::v1::Span& span) {
+  // Same approach as Grpc::Common::serializeToGrpcFrame(): reserve a single slice for the field
+  // header and the span, then serialize in place.
+  const uint32_t size = span.ByteSizeLong();
+  const uint64_t alloc_size = lengthDelimitedSize(size);
+  auto reservation = spans_.reserveSingleSlice(alloc_size);
+  ASSERT(reservation.slice().len_ >= alloc_size);
+  uint8_t* current = reinterpret_cast<uint8_t*>(reservation.slice().mem_);
+  *current++ = FieldTwoTag; // ScopeSpans.spans
+  current = Protobuf::io::CodedOutputStream::WriteVarint32ToArray(size, current);
+  Protobuf::io::ArrayOutputStream stream(current, size, -1);
+  Protobuf::io::CodedOutputStream codec_stream(&stream);
+  span.SerializeWithCachedSizes(&codec_stream);
+  reservation.commit(alloc_size);
+  span_count_++;
+}
+
+Buffer::InstancePtr OtlpSpanBatch::release() {
+  // ExportTraceServiceRequest{resource_spans: [ResourceSpans{resource, scope_spans: [ScopeSpans{
+  // scope, spans}], schema_url}]}. Only the headers and the constant parts are written here, the
+  // spans are moved over as they are.
+  const uint64_t scope_spans_size = lengthDelimitedSize(scope_.size()) + spans_.length();
+  uint64_t resource_spans_size = lengthDelimitedSize(scope_spans_size);
+  if (!resource_.empty()) {
+    resource_spans_size += lengthDelimitedSize(resource_.size());
+  }
+  if (!schema_url_.empty()) {
+    resource_spans_size += lengthDelimitedSize(schema_url_.size());
+  }
+
+  std::string prefix;
+  appendFieldHeader(prefix, FieldOneTag, resource_spans_size); // resource_spans
+  if (!resource_.empty()) {
+    appendFieldHeader(prefix, FieldOneTag, resource_.size()); // ResourceSpans.resource
+    prefix.append(resource_);
+  }
+  appendFieldHeader(prefix, FieldTwoTag, scope_spans_size); // ResourceSpans.scope_spans
+  appendFieldHeader(prefix, FieldOneTag, scope_.size());    // ScopeSpans.scope
+  prefix.append(scope_);
+
+  auto request = std::make_unique<Buffer::OwnedImpl>(prefix);
+  request->move(spans_);
+  if (!schema_url_.empty()) {
+    std::string suffix;
+    appendFieldHeader(suffix, FieldThreeTag, schema_url_.size()); // ResourceSpans.schema_url
+    suffix.append(schema_url_);
+    request->add(suffix);
+  }
+  span_count_ = 0;
+  return request;
+}
+
+} // namespace OpenTelemetry
+} // namespace Tracers
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include "envoy/buffer/buffer.h"
+
+#include "source/common/buffer/buffer_impl.h"
+#include "source/extensions/tracers/opentelemetry/resource_detectors/resource_detector.h"
+
+#include "opentelemetry/proto/trace/v1/trace.pb.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace Tracers {
+namespace OpenTelemetry {
+
+/**
+ * Batch of finished spans kept in the OTLP wire format. Every span is serialized once when it is
+ * added, and the batch is turned into a serialized ExportTraceServiceRequest by prepending the
+ * resource and the instrumentation scope, so no intermediate request proto is ever built and the
+ * spans are never copied.
+ */
+class OtlpSpanBatch {
+public:
+  explicit OtlpSpanBatch(const Resource& resource);
+
+  /**
+   * @return the number of bytes the span will take in the batch.
+   */
+  static uint64_t encodedSize(const ::opentelemetry::proto::trace::v1::Span& span);
+
+  /**
+   * Serializes a span at the end of the batch.
+   */
+  void add(const ::opentelemetry::proto::trace::v1::Span& span);
+
+  /**
+   * Moves the batch out as a serialized ExportTraceServiceRequest, leaving the batch empty.
+   */
+  Buffer::InstancePtr release();
+
+  bool empty() const { return span_count_ == 0; }
+  uint64_t spanCount() const { return span_count_; }
+  uint64_t byteSize() const { return spans_.length(); }
+
+private:
+  // Serialized opentelemetry.proto.resource.v1.Resource.
+  std::string resource_;
+  // Serialized opentelemetry.proto.common.v1.InstrumentationScope.
+  std::string scope_;
+  const std::string schema_url_;
+  // Concatenation of the ScopeSpans.spans fields of all added spans.
+  Buffer::OwnedImpl spans_;
+  uint64_t span_count_{};
+};
+
+} // namespace OpenTelemetry
+} // namespace Tracers
+} // namespace Extensions
+} // namespace Envoy
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "envoy/buffer/buffer.h"
+
 #include "source/common/common/logger.h"
 
 #include "opentelemetry/proto/collector/trace/v1/trace_service.pb.h"
@@ -30,6 +32,16 @@ public:
    */
   virtual bool log(const ExportTraceServiceRequest& request) = 0;
 
+  /**
+   * @brief Exports an already serialized trace request to the configured OTLP service.
+   *
+   * @param request The serialized ExportTraceServiceRequest.
+   * @param span_count The number of spans in the request.
+   * @return true When the request was sent.
+   * @return false When sending the request failed.
+   */
+  virtual bool logSerialized(Buffer::InstancePtr&& request, uint64_t span_count) = 0;
+
   /**
    * @brief Logs as debug the number of exported spans.
    *
@@ -43,6 +55,15 @@ public:
       }
     }
   }
+
+  /**
+   * @brief Logs as debug the number of exported spans.
+   *
+   * @param span_count The number of spans in the serialized request.
+   */
+  void logExportedSpans(uint64_t span_count) {
+    ENVOY_LOG(debug, "Number of exported spans: {}", span_count);
+  }
 };
 
 using OpenTelemetryTraceExporterPtr = std::unique_ptr<OpenTelemetryTraceExporter>;
@@ -9,10 +9,8 @@
 #include "source/common/common/hex.h"
 #include "source/common/tracing/common_values.h"
 #include "source/common/tracing/trace_context_impl.h"
-#include "source/common/version/version.h"
 #include "source/extensions/tracers/opentelemetry/otlp_utils.h"
 
-#include "opentelemetry/proto/collector/trace/v1/trace_service.pb.h"
 #include "opentelemetry/proto/trace/v1/trace.pb.h"
 
 namespace Envoy {
@@ -22,8 +20,6 @@ namespace OpenTelemetry {
 
 constexpr absl::string_view kDefaultVersion = "00";
 
-using opentelemetry::proto::collector::trace::v1::ExportTraceServiceRequest;
-
 namespace {
 
 const Tracing::TraceContextHandler& traceParentHeader() {
@@ -187,10 +183,10 @@ Tracer::Tracer(OpenTelemetryTraceExporterPtr exporter, Envoy::TimeSource& time_s
                Random::RandomGenerator& random, Runtime::Loader& runtime,
                Event::Dispatcher& dispatcher, OpenTelemetryTracerStats tracing_stats,
                const ResourceConstSharedPtr resource, SamplerSharedPtr sampler,
-               uint64_t max_cache_size)
-    : exporter_(std::move(exporter)), time_source_(time_source), random_(random), runtime_(runtime),
-      tracing_stats_(tracing_stats), resource_(resource), sampler_(sampler),
-      max_cache_size_(max_cache_size) {
+               uint64_t max_cache_size, uint64_t max_batch_bytes)
+    : exporter_(std::move(exporter)), time_source_(time_source), random_(random),
+      span_batch_(*resource), runtime_(runtime), tracing_stats_(tracing_stats), sampler_(sampler),
+      max_cache_size_(max_cache_size), max_batch_bytes_(max_batch_bytes) {
   flush_timer_ = dispatcher.createTimer([this]() -> void {
     tracing_stats_.timer_flushed_.inc();
     flushSpans();
@@ -206,62 +202,51 @@ void Tracer::enableTimer() {
 }
 
 void Tracer::flushSpans() {
-  if (span_buffer_.empty()) {
+  if (span_batch_.empty()) {
     return;
   }
 
-  ExportTraceServiceRequest request;
-  // A request consists of ResourceSpans.
-  ::opentelemetry::proto::trace::v1::ResourceSpans* resource_span = request.add_resource_spans();
-  resource_span->set_schema_url(resource_->schema_url_);
-
-  // add resource attributes
-  for (auto const& att : resource_->attributes_) {
-    opentelemetry::proto::common::v1::KeyValue key_value =
-        opentelemetry::proto::common::v1::KeyValue();
-    opentelemetry::proto::common::v1::AnyValue value_proto =
-        opentelemetry::proto::common::v1::AnyValue();
-    value_proto.set_string_value(std::string{att.second});
-    key_value.set_key(std::string{att.first});
-    *key_value.mutable_value() = value_proto;
-    (*resource_span->mutable_resource()->add_attributes()) = key_value;
-  }
-
-  ::opentelemetry::proto::trace::v1::ScopeSpans* scope_span = resource_span->add_scope_spans();
-
-  // set the instrumentation scope name and version
-  *scope_span->mutable_scope()->mutable_name() = "envoy";
-  *scope_span->mutable_scope()->mutable_version() = Envoy::VersionInfo::version();
-
-  for (const auto& pending_span : span_buffer_) {
-    (*scope_span->add_spans()) = pending_span;
-  }
+  const uint64_t span_count = span_batch_.spanCount();
+  Buffer::InstancePtr request = span_batch_.release();
   if (exporter_) {
-    tracing_stats_.spans_sent_.add(span_buffer_.size());
-    if (!exporter_->log(request)) {
+    tracing_stats_.spans_sent_.add(span_count);
+    if (!exporter_->logSerialized(std::move(request), span_count)) {
       // TODO: should there be any sort of retry or reporting here?
       ENVOY_LOG(trace, "Unsuccessful log request to OpenTelemetry trace collector.");
+      tracing_stats_.export_failed_.inc();
     }
   } else {
     ENVOY_LOG(info, "Skipping log request to OpenTelemetry: no exporter configured");
   }
-  span_buffer_.clear();
 }
 
 void Tracer::sendSpan(::opentelemetry::proto::trace::v1::Span& span) {
-  if (span_buffer_.size() >= max_cache_size_) {
+  if (span_batch_.spanCount() >= max_cache_size_) {
     ENVOY_LOG_EVERY_POW_2(
         warn,
         "Span buffer size exceeded maximum limit. Discarding span. Current size: {}, Max size: {}",
-        span_buffer_.size(), max_cache_size_);
+        span_batch_.spanCount(), max_cache_size_);
     tracing_stats_.spans_dropped_.inc();
     flushSpans();
     return;
   }
-  span_buffer_.push_back(span);
+  if (max_batch_bytes_ != 0) {
+    const uint64_t span_size = OtlpSpanBatch::encodedSize(span);
+    if (span_size > max_batch_bytes_) {
+      ENVOY_LOG_EVERY_POW_2(warn, "Span of {} bytes exceeds the maximum batch size of {} bytes",
+                            span_size, max_batch_bytes_);
+      tracing_stats_.spans_dropped_.inc();
+      tracing_stats_.spans_dropped_too_large_.inc();
+      return;
+    }
+    if (span_batch_.byteSize() + span_size > max_batch_bytes_) {
+      flushSpans();
+    }
+  }
+  span_batch_.add(span);
   const uint64_t min_flush_spans =
       runtime_.snapshot().getInteger("tracing.opentelemetry.min_flush_spans", 5U);
-  if (span_buffer_.size() >= min_flush_spans) {
+  if (span_batch_.spanCount() >= min_flush_spans) {
     flushSpans();
   }
 }
@@ -12,6 +12,7 @@
 #include "source/common/common/logger.h"
 #include "source/extensions/tracers/common/factory_base.h"
 #include "source/extensions/tracers/opentelemetry/grpc_trace_exporter.h"
+#include "source/extensions/tracers/opentelemetry/otlp_span_batch.h"
 #include "source/extensions/tracers/opentelemetry/resource_detectors/resource_detector.h"
 #include "source/extensions/tracers/opentelemetry/samplers/sampler.h"
 #include "source/extensions/tracers/opentelemetry/span_context.h"
@@ -26,7 +27,9 @@ namespace OpenTelemetry {
 #define OPENTELEMETRY_TRACER_STATS(COUNTER)                                                        \
   COUNTER(spans_sent)                                                                              \
   COUNTER(timer_flushed)                                                                           \
-  COUNTER(spans_dropped)
+  COUNTER(spans_dropped)                                                                           \
+  COUNTER(spans_dropped_too_large)                                                                 \
+  COUNTER(export_failed)
 
 struct OpenTelemetryTracerStats {
   OPENTELEMETRY_TRACER_STATS(GENERATE_COUNTER_STRUCT)
@@ -40,7 +43,7 @@ public:
   Tracer(OpenTelemetryTraceExporterPtr exporter, Envoy::TimeSource& time_source,
          Random::RandomGenerator& random, Runtime::Loader& runtime, Event::Dispatcher& dispatcher,
          OpenTelemetryTracerStats tracing_stats, const ResourceConstSharedPtr resource,
-         SamplerSharedPtr sampler, uint64_t max_cache_size);
+         SamplerSharedPtr sampler, uint64_t max_cache_size, uint64_t max_batch_bytes = 0);
 
   void sendSpan(::opentelemetry::proto::trace::v1::Span& span);
 
@@ -69,13 +72,15 @@ private:
   OpenTelemetryTraceExporterPtr exporter_;
   Envoy::TimeSource& time_source_;
   Random::RandomGenerator& random_;
-  std::vector<::opentelemetry::proto::trace::v1::Span> span_buffer_;
+  // Finished spans, already serialized in the OTLP wire format.
+  OtlpSpanBatch span_batch_;
   Runtime::Loader& runtime_;
   Event::TimerPtr flush_timer_;
   OpenTelemetryTracerStats tracing_stats_;
-  const ResourceConstSharedPtr resource_;
   SamplerSharedPtr sampler_;
   uint64_t max_cache_size_;
+  // Upper bound of the serialized spans of one export request, 0 if unbounded.
+  uint64_t max_batch_bytes_;
 };
 
 /**
@@ -108,6 +113,11 @@ public:
    */
   bool useLocalDecision() const override { return use_local_decision_; }
 
+  /**
+   * @return whether the span will be exported when finished.
+   */
+  bool isRecording() const override { return sampled_; }
+
   /**
    * @return whether or not the sampled attribute is set
    */
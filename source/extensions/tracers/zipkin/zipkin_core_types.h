@@ -560,6 +560,7 @@ public:
   void log(SystemTime timestamp, const std::string& event) override;
   void setSampled(bool val) override { sampled_ = val; }
   bool useLocalDecision() const override { return use_local_decision_; }
+  bool isRecording() const override { return sampled_; }
   void setOperation(absl::string_view operation) override { setName(std::string(operation)); }
   void injectContext(Tracing::TraceContext& trace_context,
                      const Tracing::UpstreamContext&) override;
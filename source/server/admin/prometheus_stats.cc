@@ -1,11 +1,13 @@
 #include "source/server/admin/prometheus_stats.h"
 
 #include <cmath>
+#include <iterator>
+#include <numeric>
 
-#include "source/common/common/empty_string.h"
 #include "source/common/common/macros.h"
 #include "source/common/common/regex.h"
 #include "source/common/stats/histogram_impl.h"
+#include "source/common/stats/symbol_table.h"
 #include "source/common/upstream/host_utility.h"
 
 #include "absl/strings/str_cat.h"
@@ -46,17 +48,6 @@ std::string sanitizeValue(const absl::string_view value) {
                                     });
 }
 
-/*
- * Comparator for Stats::Metric that does not require a string representation
- * to make the comparison, for memory efficiency.
- */
-struct MetricLessThan {
-  bool operator()(const Stats::Metric* a, const Stats::Metric* b) const {
-    ASSERT(&a->constSymbolTable() == &b->constSymbolTable());
-    return a->constSymbolTable().lessThan(a->statName(), b->statName());
-  }
-};
-
 struct PrimitiveMetricSnapshotLessThan {
   bool operator()(const Stats::PrimitiveMetricMetadata* a,
                   const Stats::PrimitiveMetricMetadata* b) {
@@ -70,151 +61,6 @@ std::string generateNumericOutput(uint64_t value, const Stats::TagVector& tags,
   return fmt::format("{0}{{{1}}} {2}\n", prefixed_tag_extracted_name, formatted_tags, value);
 }
 
-/*
- * Return the prometheus output for a numeric Stat (Counter or Gauge).
- */
-template <class StatType>
-std::string generateStatNumericOutput(const StatType& metric,
-                                      const std::string& prefixed_tag_extracted_name) {
-  return generateNumericOutput(metric.value(), metric.tags(), prefixed_tag_extracted_name);
-}
-
-/*
- * Returns the prometheus output for a TextReadout in gauge format.
- * It is a workaround of a limitation of prometheus which stores only numeric metrics.
- * The output is a gauge named the same as a given text-readout. The value of returned gauge is
- * always equal to 0. Returned gauge contains all tags of a given text-readout and one additional
- * tag {"text_value":"textReadout.value"}.
- */
-std::string generateTextReadoutOutput(const Stats::TextReadout& text_readout,
-                                      const std::string& prefixed_tag_extracted_name) {
-  auto tags = text_readout.tags();
-  tags.push_back(Stats::Tag{"text_value", text_readout.value()});
-  const std::string formattedTags = PrometheusStatsFormatter::formattedTags(tags);
-  return fmt::format("{0}{{{1}}} 0\n", prefixed_tag_extracted_name, formattedTags);
-}
-
-/*
- * Returns the prometheus output for a histogram. The output is a multi-line string (with embedded
- * newlines) that contains all the individual bucket counts and sum/count for a single histogram
- * (metric_name plus all tags).
- */
-std::string generateHistogramOutput(const Stats::ParentHistogram& histogram,
-                                    const std::string& prefixed_tag_extracted_name) {
-  const std::string tags = PrometheusStatsFormatter::formattedTags(histogram.tags());
-  const std::string hist_tags = histogram.tags().empty() ? EMPTY_STRING : (tags + ",");
-
-  const Stats::HistogramStatistics& stats = histogram.cumulativeStatistics();
-  Stats::ConstSupportedBuckets& supported_buckets = stats.supportedBuckets();
-  const std::vector<uint64_t>& computed_buckets = stats.computedBuckets();
-  std::string output;
-  for (size_t i = 0; i < supported_buckets.size(); ++i) {
-    double bucket = supported_buckets[i];
-    uint64_t value = computed_buckets[i];
-    // We want to print the bucket in a fixed point (non-scientific) format. The fmt library
-    // doesn't have a specific modifier to format as a fixed-point value only so we use the
-    // 'g' operator which prints the number in general fixed point format or scientific format
-    // with precision 50 to round the number up to 32 significant digits in fixed point format
-    // which should cover pretty much all cases
-    output.append(fmt::format("{0}_bucket{{{1}le=\"{2:.32g}\"}} {3}\n", prefixed_tag_extracted_name,
-                              hist_tags, bucket, value));
-  }
-
-  output.append(fmt::format("{0}_bucket{{{1}le=\"+Inf\"}} {2}\n", prefixed_tag_extracted_name,
-                            hist_tags, stats.sampleCount()));
-  output.append(fmt::format("{0}_sum{{{1}}} {2:.32g}\n", prefixed_tag_extracted_name, tags,
-                            stats.sampleSum()));
-  output.append(fmt::format("{0}_count{{{1}}} {2}\n", prefixed_tag_extracted_name, tags,
-                            stats.sampleCount()));
-
-  return output;
-};
-
-/**
- * Processes a stat type (counter, gauge, histogram) by generating all output lines, sorting
- * them by tag-extracted metric name, and then outputting them in the correct sorted order into
- * response.
- *
- * @param response The buffer to put the output into.
- * @param used_only Whether to only output stats that are used.
- * @param regex A filter on which stats to output.
- * @param metrics The metrics to output stats for. This must contain all stats of the given type
- *        to be included in the same output.
- * @param generate_output A function which returns the output text for this metric.
- * @param type The name of the prometheus metric type for used in TYPE annotations.
- */
-template <class StatType>
-uint64_t outputStatType(
-    Buffer::Instance& response, const StatsParams& params,
-    const std::vector<Stats::RefcountPtr<StatType>>& metrics,
-    const std::function<std::string(
-        const StatType& metric, const std::string& prefixed_tag_extracted_name)>& generate_output,
-    absl::string_view type, const Stats::CustomStatNamespaces& custom_namespaces) {
-
-  /*
-   * From
-   * https:*github.com/prometheus/docs/blob/master/content/docs/instrumenting/exposition_formats.md#grouping-and-sorting:
-   *
-   * All lines for a given metric must be provided as one single group, with the optional HELP and
-   * TYPE lines first (in no particular order). Beyond that, reproducible sorting in repeated
-   * expositions is preferred but not required, i.e. do not sort if the computational cost is
-   * prohibitive.
-   */
-
-  // This is an unsorted collection of dumb-pointers (no need to increment then decrement every
-  // refcount; ownership is held throughout by `metrics`). It is unsorted for efficiency, but will
-  // be sorted before producing the final output to satisfy the "preferred" ordering from the
-  // prometheus spec: metrics will be sorted by their tags' textual representation, which will be
-  // consistent across calls.
-  using StatTypeUnsortedCollection = std::vector<const StatType*>;
-
-  // Return early to avoid crashing when getting the symbol table from the first metric.
-  if (metrics.empty()) {
-    return 0;
-  }
-
-  // There should only be one symbol table for all of the stats in the admin
-  // interface. If this assumption changes, the name comparisons in this function
-  // will have to change to compare to convert all StatNames to strings before
-  // comparison.
-  const Stats::SymbolTable& global_symbol_table = metrics.front()->constSymbolTable();
-
-  // Sorted collection of metrics sorted by their tagExtractedName, to satisfy the requirements
-  // of the exposition format.
-  std::map<Stats::StatName, StatTypeUnsortedCollection, Stats::StatNameLessThan> groups(
-      global_symbol_table);
-
-  for (const auto& metric : metrics) {
-    ASSERT(&global_symbol_table == &metric->constSymbolTable());
-    if (!params.shouldShowMetric(*metric)) {
-      continue;
-    }
-    groups[metric->tagExtractedStatName()].push_back(metric.get());
-  }
-
-  auto result = groups.size();
-  for (auto& group : groups) {
-    const absl::optional<std::string> prefixed_tag_extracted_name =
-        PrometheusStatsFormatter::metricName(global_symbol_table.toString(group.first),
-                                             custom_namespaces);
-    if (!prefixed_tag_extracted_name.has_value()) {
-      --result;
-      continue;
-    }
-    response.add(fmt::format("# TYPE {0} {1}\n", prefixed_tag_extracted_name.value(), type));
-
-    // Sort before producing the final output to satisfy the "preferred" ordering from the
-    // prometheus spec: metrics will be sorted by their tags' textual representation, which will
-    // be consistent across calls.
-    std::sort(group.second.begin(), group.second.end(), MetricLessThan());
-
-    for (const auto& metric : group.second) {
-      response.add(generate_output(*metric, prefixed_tag_extracted_name.value()));
-    }
-  }
-  return result;
-}
-
 template <class StatType>
 uint64_t outputPrimitiveStatType(Buffer::Instance& response, const StatsParams& params,
                                  const std::vector<StatType>& metrics, absl::string_view type,
@@ -276,34 +122,60 @@ uint64_t outputPrimitiveStatType(Buffer::Instance& response, const StatsParams&
   return result;
 }
 
-/*
- * Returns the prometheus output for a summary. The output is a multi-line string (with embedded
- * newlines) that contains all the individual quantile values and sum/count for a single histogram
- * (metric_name plus all tags).
- */
-std::string generateSummaryOutput(const Stats::ParentHistogram& histogram,
-                                  const std::string& prefixed_tag_extracted_name) {
-  const std::string tags = PrometheusStatsFormatter::formattedTags(histogram.tags());
-  const std::string hist_tags = histogram.tags().empty() ? EMPTY_STRING : (tags + ",");
-
-  const Stats::HistogramStatistics& stats = histogram.intervalStatistics();
-  Stats::ConstSupportedBuckets& supported_quantiles = stats.supportedQuantiles();
-  const std::vector<double>& computed_quantiles = stats.computedQuantiles();
-  std::string output;
-  for (size_t i = 0; i < supported_quantiles.size(); ++i) {
-    double quantile = supported_quantiles[i];
-    double value = computed_quantiles[i];
-    output.append(fmt::format("{0}{{{1}quantile=\"{2}\"}} {3:.32g}\n", prefixed_tag_extracted_name,
-                              hist_tags, quantile, value));
+uint64_t outputHostMetrics(Buffer::Instance& response, const StatsParams& params,
+                           const Upstream::ClusterManager& cluster_manager,
+                           const Stats::CustomStatNamespaces& custom_namespaces) {
+  // Note: This assumes that there is no overlap in stat name between per-endpoint stats and all
+  // other stats. If this is not true, then the counters/gauges for per-endpoint need to be combined
+  // with the above counter/gauge calls so that stats can be properly grouped.
+  std::vector<Stats::PrimitiveCounterSnapshot> host_counters;
+  std::vector<Stats::PrimitiveGaugeSnapshot> host_gauges;
+  Upstream::HostUtility::forEachHostMetric(
+      cluster_manager,
+      [&](Stats::PrimitiveCounterSnapshot&& metric) {
+        host_counters.emplace_back(std::move(metric));
+      },
+      [&](Stats::PrimitiveGaugeSnapshot&& metric) { host_gauges.emplace_back(std::move(metric)); });
+
+  uint64_t metric_name_count =
+      outputPrimitiveStatType(response, params, host_counters, "counter", custom_namespaces);
+  metric_name_count +=
+      outputPrimitiveStatType(response, params, host_gauges, "gauge", custom_namespaces);
+  return metric_name_count;
+}
+
+template <class StatType>
+void renderMetrics(PrometheusStatsRenderer& renderer, PrometheusStatsRenderer::Type type,
+                   const std::vector<Stats::RefcountPtr<StatType>>& metrics,
+                   Buffer::Instance& response) {
+  renderer.reset(type);
+  for (const auto& metric : metrics) {
+    renderer.add(*metric);
   }
+  renderer.finalizeGroups();
+  while (renderer.renderNextGroup(response)) {
+  }
+}
 
-  output.append(fmt::format("{0}_sum{{{1}}} {2:.32g}\n", prefixed_tag_extracted_name, tags,
-                            stats.sampleSum()));
-  output.append(fmt::format("{0}_count{{{1}}} {2}\n", prefixed_tag_extracted_name, tags,
-                            stats.sampleCount()));
+absl::string_view typeName(PrometheusStatsRenderer::Type type) {
+  switch (type) {
+  case PrometheusStatsRenderer::Type::Counter:
+    return "counter";
+  case PrometheusStatsRenderer::Type::Gauge:
+  // TextReadout stats are returned in gauge format, so "gauge" type is set intentionally.
+  case PrometheusStatsRenderer::Type::TextReadout:
+    return "gauge";
+  case PrometheusStatsRenderer::Type::Histogram:
+    return "histogram";
+  case PrometheusStatsRenderer::Type::Summary:
+    return "summary";
+  }
+  PANIC_DUE_TO_CORRUPT_ENUM;
+}
 
-  return output;
-};
+// Output is moved to the response buffer in blocks of about this size while rendering large
+// groups.
+constexpr size_t OutputFlushSize = 64 * 1024;
 
 } // namespace
 
@@ -365,30 +237,19 @@ uint64_t PrometheusStatsFormatter::statsAsPrometheus(
     const std::vector<Stats::TextReadoutSharedPtr>& text_readouts,
     const Upstream::ClusterManager& cluster_manager, Buffer::Instance& response,
     const StatsParams& params, const Stats::CustomStatNamespaces& custom_namespaces) {
-
-  uint64_t metric_name_count = 0;
-  metric_name_count += outputStatType<Stats::Counter>(response, params, counters,
-                                                      generateStatNumericOutput<Stats::Counter>,
-                                                      "counter", custom_namespaces);
-
-  metric_name_count += outputStatType<Stats::Gauge>(response, params, gauges,
-                                                    generateStatNumericOutput<Stats::Gauge>,
-                                                    "gauge", custom_namespaces);
-
-  // TextReadout stats are returned in gauge format, so "gauge" type is set intentionally.
-  metric_name_count += outputStatType<Stats::TextReadout>(
-      response, params, text_readouts, generateTextReadoutOutput, "gauge", custom_namespaces);
+  PrometheusStatsRenderer renderer(params, custom_namespaces);
+  renderMetrics(renderer, PrometheusStatsRenderer::Type::Counter, counters, response);
+  renderMetrics(renderer, PrometheusStatsRenderer::Type::Gauge, gauges, response);
+  renderMetrics(renderer, PrometheusStatsRenderer::Type::TextReadout, text_readouts, response);
 
   // validation of bucket modes is handled separately
   switch (params.histogram_buckets_mode_) {
   case Utility::HistogramBucketsMode::Summary:
-    metric_name_count += outputStatType<Stats::ParentHistogram>(
-        response, params, histograms, generateSummaryOutput, "summary", custom_namespaces);
+    renderMetrics(renderer, PrometheusStatsRenderer::Type::Summary, histograms, response);
     break;
   case Utility::HistogramBucketsMode::Unset:
   case Utility::HistogramBucketsMode::Cumulative:
-    metric_name_count += outputStatType<Stats::ParentHistogram>(
-        response, params, histograms, generateHistogramOutput, "histogram", custom_namespaces);
+    renderMetrics(renderer, PrometheusStatsRenderer::Type::Histogram, histograms, response);
     break;
   // "Detailed" and "Disjoint" don't make sense for prometheus histogram semantics
   case Utility::HistogramBucketsMode::Detailed:
@@ -397,25 +258,291 @@ uint64_t PrometheusStatsFormatter::statsAsPrometheus(
     break;
   }
 
-  // Note: This assumes that there is no overlap in stat name between per-endpoint stats and all
-  // other stats. If this is not true, then the counters/gauges for per-endpoint need to be combined
-  // with the above counter/gauge calls so that stats can be properly grouped.
-  std::vector<Stats::PrimitiveCounterSnapshot> host_counters;
-  std::vector<Stats::PrimitiveGaugeSnapshot> host_gauges;
-  Upstream::HostUtility::forEachHostMetric(
-      cluster_manager,
-      [&](Stats::PrimitiveCounterSnapshot&& metric) {
-        host_counters.emplace_back(std::move(metric));
-      },
-      [&](Stats::PrimitiveGaugeSnapshot&& metric) { host_gauges.emplace_back(std::move(metric)); });
+  return renderer.metricNameCount() +
+         outputHostMetrics(response, params, cluster_manager, custom_namespaces);
+}
 
-  metric_name_count +=
-      outputPrimitiveStatType(response, params, host_counters, "counter", custom_namespaces);
+PrometheusStatsRenderer::PrometheusStatsRenderer(
+    const StatsParams& params, const Stats::CustomStatNamespaces& custom_namespaces)
+    : params_(params), custom_namespaces_(custom_namespaces) {}
+
+void PrometheusStatsRenderer::reset(Type type) {
+  type_ = type;
+  metrics_.clear();
+  // Label blocks are keyed by symbol encodings, which are only stable while the metrics that hold
+  // them are referenced, so the cache does not outlive the collected metrics.
+  label_blocks_.clear();
+  group_ends_.clear();
+  next_group_ = 0;
+}
 
-  metric_name_count +=
-      outputPrimitiveStatType(response, params, host_gauges, "gauge", custom_namespaces);
+void PrometheusStatsRenderer::add(Stats::Metric& metric) {
+  if (params_.shouldShowMetric(metric)) {
+    metrics_.emplace_back(&metric);
+  }
+}
 
-  return metric_name_count;
+void PrometheusStatsRenderer::finalizeGroups() {
+  /*
+   * From
+   * https:*github.com/prometheus/docs/blob/master/content/docs/instrumenting/exposition_formats.md#grouping-and-sorting:
+   *
+   * All lines for a given metric must be provided as one single group, with the optional HELP and
+   * TYPE lines first (in no particular order). Beyond that, reproducible sorting in repeated
+   * expositions is preferred but not required, i.e. do not sort if the computational cost is
+   * prohibitive.
+   */
+  if (metrics_.empty()) {
+    return;
+  }
+
+  // There should only be one symbol table for all of the stats in the admin
+  // interface. If this assumption changes, the name comparisons in this function
+  // will have to change to compare to convert all StatNames to strings before
+  // comparison.
+  const Stats::SymbolTable& symbol_table = metrics_.front()->constSymbolTable();
+
+  // Sort by full name first. The grouping below is stable, so within a group the metrics are
+  // ordered by name, which is consistent across calls.
+  symbol_table.sortByStatNames<Stats::RefcountPtr<Stats::Metric>>(
+      metrics_.begin(), metrics_.end(),
+      [](const Stats::RefcountPtr<Stats::Metric>& metric) { return metric->statName(); });
+
+  // Find the distinct tag-extracted names without converting them to strings.
+  absl::flat_hash_map<Stats::StatName, uint32_t> group_index;
+  std::vector<Stats::StatName> group_names;
+  std::vector<uint32_t> metric_groups;
+  metric_groups.reserve(metrics_.size());
+  for (const auto& metric : metrics_) {
+    ASSERT(&symbol_table == &metric->constSymbolTable());
+    const auto [iter, inserted] =
+        group_index.try_emplace(metric->tagExtractedStatName(), group_names.size());
+    if (inserted) {
+      group_names.push_back(iter->first);
+    }
+    metric_groups.push_back(iter->second);
+  }
+
+  // Order the groups by tag-extracted name. Names which are encoded differently but are equal as
+  // strings are merged into one group.
+  std::vector<uint32_t> order(group_names.size());
+  std::iota(order.begin(), order.end(), 0);
+  symbol_table.sortByStatNames<uint32_t>(
+      order.begin(), order.end(), [&group_names](uint32_t group) { return group_names[group]; });
+  std::vector<uint32_t> rank(group_names.size());
+  uint32_t num_ranks = 0;
+  for (size_t i = 0; i < order.size(); ++i) {
+    if (i > 0 && symbol_table.lessThan(group_names[order[i - 1]], group_names[order[i]])) {
+      ++num_ranks;
+    }
+    rank[order[i]] = num_ranks;
+  }
+  ++num_ranks;
+
+  // Stable counting sort of the metrics by group.
+  std::vector<uint32_t> offsets(num_ranks, 0);
+  for (const uint32_t group : metric_groups) {
+    ++offsets[rank[group]];
+  }
+  uint32_t offset = 0;
+  for (uint32_t& next : offsets) {
+    const uint32_t count = next;
+    next = offset;
+    offset += count;
+  }
+  std::vector<Stats::RefcountPtr<Stats::Metric>> sorted(metrics_.size());
+  for (size_t i = 0; i < metrics_.size(); ++i) {
+    sorted[offsets[rank[metric_groups[i]]]++] = std::move(metrics_[i]);
+  }
+  metrics_ = std::move(sorted);
+  // Each offset now points at the end of its group.
+  group_ends_ = std::move(offsets);
+}
+
+bool PrometheusStatsRenderer::renderNextGroup(Buffer::Instance& response) {
+  if (next_group_ == group_ends_.size()) {
+    return false;
+  }
+  const uint32_t begin = next_group_ == 0 ? 0 : group_ends_[next_group_ - 1];
+  const uint32_t end = group_ends_[next_group_++];
+
+  const Stats::Metric& first = *metrics_[begin];
+  const absl::optional<std::string> name = PrometheusStatsFormatter::metricName(
+      first.constSymbolTable().toString(first.tagExtractedStatName()), custom_namespaces_);
+  if (name.has_value()) {
+    ++metric_name_count_;
+    output_.clear();
+    fmt::format_to(std::back_inserter(output_), "# TYPE {0} {1}\n", name.value(), typeName(type_));
+    for (uint32_t i = begin; i < end; ++i) {
+      renderMetric(*metrics_[i], name.value());
+      if (output_.size() >= OutputFlushSize) {
+        response.add(output_);
+        output_.clear();
+      }
+    }
+    response.add(output_);
+  }
+
+  // Release the rendered metrics, so that stats deleted in the meantime can be freed.
+  for (uint32_t i = begin; i < end; ++i) {
+    metrics_[i].reset();
+  }
+  return true;
+}
+
+absl::string_view PrometheusStatsRenderer::labels(const Stats::Metric& metric) {
+  // The tag names and values are length-prefixed so that the key is unambiguous.
+  label_key_.clear();
+  const auto append = [this](Stats::StatName stat_name) {
+    const uint64_t size = stat_name.dataSize();
+    label_key_.append(reinterpret_cast<const char*>(&size), sizeof(size));
+    if (size > 0) {
+      label_key_.append(reinterpret_cast<const char*>(stat_name.data()), size);
+    }
+  };
+  metric.iterateTagStatNames([&append](Stats::StatName name, Stats::StatName value) -> bool {
+    append(name);
+    append(value);
+    return true;
+  });
+
+  auto iter = label_blocks_.find(label_key_);
+  if (iter == label_blocks_.end()) {
+    iter = label_blocks_.emplace(label_key_, PrometheusStatsFormatter::formattedTags(metric.tags()))
+               .first;
+  }
+  // The view is only valid until the next insertion.
+  return iter->second;
+}
+
+void PrometheusStatsRenderer::renderMetric(const Stats::Metric& metric, absl::string_view name) {
+  const absl::string_view tags = labels(metric);
+  const absl::string_view separator = tags.empty() ? "" : ",";
+  auto out = std::back_inserter(output_);
+
+  switch (type_) {
+  case Type::Counter:
+    fmt::format_to(out, "{0}{{{1}}} {2}\n", name, tags,
+                   static_cast<const Stats::Counter&>(metric).value());
+    return;
+  case Type::Gauge:
+    fmt::format_to(out, "{0}{{{1}}} {2}\n", name, tags,
+                   static_cast<const Stats::Gauge&>(metric).value());
+    return;
+  case Type::TextReadout:
+    // Prometheus only stores numeric metrics, so a text readout is rendered as a gauge with a
+    // value of 0, with the text in an additional "text_value" tag. Metric is a virtual base of
+    // TextReadout, hence the dynamic_cast.
+    fmt::format_to(out, "{0}{{{1}{2}text_value=\"{3}\"}} 0\n", name, tags, separator,
+                   sanitizeValue(dynamic_cast<const Stats::TextReadout&>(metric).value()));
+    return;
+  case Type::Histogram: {
+    const Stats::HistogramStatistics& stats =
+        static_cast<const Stats::ParentHistogram&>(metric).cumulativeStatistics();
+    Stats::ConstSupportedBuckets& supported_buckets = stats.supportedBuckets();
+    const std::vector<uint64_t>& computed_buckets = stats.computedBuckets();
+    for (size_t i = 0; i < supported_buckets.size(); ++i) {
+      // We want to print the bucket in a fixed point (non-scientific) format. The fmt library
+      // doesn't have a specific modifier to format as a fixed-point value only so we use the
+      // 'g' operator which prints the number in general fixed point format or scientific format
+      // with precision 50 to round the number up to 32 significant digits in fixed point format
+      // which should cover pretty much all cases
+      fmt::format_to(out, "{0}_bucket{{{1}{2}le=\"{3:.32g}\"}} {4}\n", name, tags, separator,
+                     supported_buckets[i], computed_buckets[i]);
+    }
+    fmt::format_to(out, "{0}_bucket{{{1}{2}le=\"+Inf\"}} {3}\n", name, tags, separator,
+                   stats.sampleCount());
+    fmt::format_to(out, "{0}_sum{{{1}}} {2:.32g}\n", name, tags, stats.sampleSum());
+    fmt::format_to(out, "{0}_count{{{1}}} {2}\n", name, tags, stats.sampleCount());
+    return;
+  }
+  case Type::Summary: {
+    const Stats::HistogramStatistics& stats =
+        static_cast<const Stats::ParentHistogram&>(metric).intervalStatistics();
+    Stats::ConstSupportedBuckets& supported_quantiles = stats.supportedQuantiles();
+    const std::vector<double>& computed_quantiles = stats.computedQuantiles();
+    for (size_t i = 0; i < supported_quantiles.size(); ++i) {
+      fmt::format_to(out, "{0}{{{1}{2}quantile=\"{3}\"}} {4:.32g}\n", name, tags, separator,
+                     supported_quantiles[i], computed_quantiles[i]);
+    }
+    fmt::format_to(out, "{0}_sum{{{1}}} {2:.32g}\n", name, tags, stats.sampleSum());
+    fmt::format_to(out, "{0}_count{{{1}}} {2}\n", name, tags, stats.sampleCount());
+    return;
+  }
+  }
+}
+
+PrometheusStatsRequest::PrometheusStatsRequest(Stats::Store& stats, const StatsParams& params,
+                                               const Upstream::ClusterManager& cluster_manager,
+                                               const Stats::CustomStatNamespaces& custom_namespaces)
+    : params_(params), stats_(stats), cluster_manager_(cluster_manager),
+      custom_namespaces_(custom_namespaces), renderer_(params_, custom_namespaces_) {}
+
+Http::Code PrometheusStatsRequest::start(Http::ResponseHeaderMap&) {
+  startPhase();
+  return Http::Code::OK;
+}
+
+bool PrometheusStatsRequest::nextChunk(Buffer::Instance& response) {
+  // nextChunk's contract is to add up to chunk_size_ additional bytes. The
+  // caller is not required to drain the bytes after each call to nextChunk.
+  const uint64_t starting_response_length = response.length();
+  while (response.length() - starting_response_length < chunk_size_) {
+    if (renderer_.renderNextGroup(response)) {
+      continue;
+    }
+    switch (phase_) {
+    case Phase::Counters:
+      phase_ = Phase::Gauges;
+      break;
+    case Phase::Gauges:
+      phase_ = Phase::TextReadouts;
+      break;
+    case Phase::TextReadouts:
+      phase_ = Phase::Histograms;
+      break;
+    case Phase::Histograms:
+    case Phase::Done:
+      // Per-host metrics are not held by reference count, so they are rendered in one batch, as
+      // in StatsRequest::renderPerHostMetrics.
+      phase_ = Phase::Done;
+      outputHostMetrics(response, params_, cluster_manager_, custom_namespaces_);
+      return false;
+    }
+    startPhase();
+  }
+  return true;
+}
+
+void PrometheusStatsRequest::startPhase() {
+  switch (phase_) {
+  case Phase::Counters:
+    renderer_.reset(PrometheusStatsRenderer::Type::Counter);
+    stats_.forEachCounter(nullptr, [this](Stats::Counter& counter) { renderer_.add(counter); });
+    break;
+  case Phase::Gauges:
+    renderer_.reset(PrometheusStatsRenderer::Type::Gauge);
+    stats_.forEachGauge(nullptr, [this](Stats::Gauge& gauge) { renderer_.add(gauge); });
+    break;
+  case Phase::TextReadouts:
+    renderer_.reset(PrometheusStatsRenderer::Type::TextReadout);
+    if (params_.prometheus_text_readouts_) {
+      stats_.forEachTextReadout(
+          nullptr, [this](Stats::TextReadout& text_readout) { renderer_.add(text_readout); });
+    }
+    break;
+  case Phase::Histograms:
+    // Unsupported bucket modes are rejected by PrometheusStatsFormatter::validateParams().
+    renderer_.reset(params_.histogram_buckets_mode_ == Utility::HistogramBucketsMode::Summary
+                        ? PrometheusStatsRenderer::Type::Summary
+                        : PrometheusStatsRenderer::Type::Histogram);
+    stats_.forEachHistogram(
+        nullptr, [this](Stats::ParentHistogram& histogram) { renderer_.add(histogram); });
+    break;
+  case Phase::Done:
+    break;
+  }
+  renderer_.finalizeGroups();
 }
 
 } // namespace Server
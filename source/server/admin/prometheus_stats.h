@@ -4,12 +4,16 @@
 #include <string>
 
 #include "envoy/buffer/buffer.h"
+#include "envoy/server/admin.h"
 #include "envoy/stats/custom_stat_namespaces.h"
 #include "envoy/stats/histogram.h"
 #include "envoy/stats/stats.h"
+#include "envoy/stats/store.h"
 
 #include "source/server/admin/stats_params.h"
 
+#include "absl/container/flat_hash_map.h"
+
 namespace Envoy {
 namespace Server {
 /**
@@ -53,5 +57,98 @@ public:
              const Stats::CustomStatNamespaces& custom_namespace_factory);
 };
 
+/**
+ * Renders metrics of one type in the Prometheus exposition format, grouped by tag-extracted name.
+ * Metrics are held by reference count rather than rendered up front, so that groups can be
+ * emitted incrementally. Label blocks are escaped once per distinct tag set and reused for every
+ * metric that carries the same tags.
+ */
+class PrometheusStatsRenderer {
+public:
+  enum class Type { Counter, Gauge, TextReadout, Histogram, Summary };
+
+  PrometheusStatsRenderer(const StatsParams& params,
+                          const Stats::CustomStatNamespaces& custom_namespaces);
+
+  /**
+   * Drops all collected metrics and prepares for collecting metrics of the given type.
+   */
+  void reset(Type type);
+
+  /**
+   * Collects a metric of the type passed to reset(), if it passes the filters in the params.
+   */
+  void add(Stats::Metric& metric);
+
+  /**
+   * Groups the collected metrics by tag-extracted name, in the order required by the exposition
+   * format. Must be called after the last add() and before renderNextGroup().
+   */
+  void finalizeGroups();
+
+  /**
+   * Renders the TYPE line and all metrics of the next group.
+   * @return false if no groups were left to render.
+   */
+  bool renderNextGroup(Buffer::Instance& response);
+
+  /**
+   * @return the number of distinct metric names rendered so far.
+   */
+  uint64_t metricNameCount() const { return metric_name_count_; }
+
+private:
+  absl::string_view labels(const Stats::Metric& metric);
+  void renderMetric(const Stats::Metric& metric, absl::string_view name);
+
+  const StatsParams& params_;
+  const Stats::CustomStatNamespaces& custom_namespaces_;
+  Type type_{Type::Counter};
+  std::vector<Stats::RefcountPtr<Stats::Metric>> metrics_;
+  // End offsets in metrics_ of the groups, in rendering order.
+  std::vector<uint32_t> group_ends_;
+  size_t next_group_{0};
+  // Escaped label blocks, keyed by the encoded tag names and values.
+  absl::flat_hash_map<std::string, std::string> label_blocks_;
+  std::string label_key_;
+  std::string output_;
+  uint64_t metric_name_count_{0};
+};
+
+/**
+ * Streams the Prometheus exposition of a stats store to an admin client. Only the metrics of the
+ * type currently being rendered are held, and output is emitted in chunks of about chunk-size
+ * bytes, rather than building the whole response in memory.
+ */
+class PrometheusStatsRequest : public Admin::Request {
+public:
+  static constexpr uint64_t DefaultChunkSize = 2 * 1000 * 1000;
+
+  PrometheusStatsRequest(Stats::Store& stats, const StatsParams& params,
+                         const Upstream::ClusterManager& cluster_manager,
+                         const Stats::CustomStatNamespaces& custom_namespaces);
+
+  // Admin::Request
+  Http::Code start(Http::ResponseHeaderMap& response_headers) override;
+  bool nextChunk(Buffer::Instance& response) override;
+
+  // Sets the chunk size.
+  void setChunkSize(uint64_t chunk_size) { chunk_size_ = chunk_size; }
+
+private:
+  enum class Phase { Counters, Gauges, TextReadouts, Histograms, Done };
+
+  // Collects the metrics of the current phase into renderer_.
+  void startPhase();
+
+  const StatsParams params_;
+  Stats::Store& stats_;
+  const Upstream::ClusterManager& cluster_manager_;
+  const Stats::CustomStatNamespaces& custom_namespaces_;
+  PrometheusStatsRenderer renderer_;
+  Phase phase_{Phase::Counters};
+  uint64_t chunk_size_{DefaultChunkSize};
+};
+
 } // namespace Server
 } // namespace Envoy
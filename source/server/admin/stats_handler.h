@@ -33,27 +33,6 @@ public:
                                               Buffer::Instance& response, AdminStream&);
   Http::Code handlerStatsRecentLookupsEnable(Http::ResponseHeaderMap& response_headers,
                                              Buffer::Instance& response, AdminStream&);
-  Http::Code handlerPrometheusStats(Http::ResponseHeaderMap& response_headers,
-                                    Buffer::Instance& response, AdminStream&);
-
-  /**
-   * Parses and executes a prometheus stats request.
-   *
-   * @param path_and_query the URL path and query
-   * @param response buffer into which to write response
-   * @return http response code
-   */
-  Http::Code prometheusStats(absl::string_view path_and_query, Buffer::Instance& response);
-
-  /**
-   * Checks the server_ to see if a flush is needed, and then renders the
-   * prometheus stats request.
-   *
-   * @params params the already-parsed parameters.
-   * @param response buffer into which to write response
-   */
-  Http::Code prometheusFlushAndRender(const StatsParams& params, Buffer::Instance& response);
-
   /**
    * Renders the stats as prometheus. This is broken out as a separately
    * callable API to facilitate the benchmark
@@ -87,15 +66,20 @@ public:
    */
   Admin::UrlHandler statsHandler(bool active_mode);
 
+  /**
+   * @return a URL handler for /stats/prometheus, which streams the exposition
+   *         in chunks.
+   */
+  Admin::UrlHandler prometheusStatsHandler();
+
   static Admin::RequestPtr makeRequest(Stats::Store& stats, const StatsParams& params,
                                        const Upstream::ClusterManager& cm,
                                        StatsRequest::UrlHandlerFn url_handler_fn = nullptr);
   Admin::RequestPtr makeRequest(AdminStream&);
 
 private:
-  static Http::Code prometheusStats(absl::string_view path_and_query, Buffer::Instance& response,
-                                    Stats::Store& stats,
-                                    Stats::CustomStatNamespaces& custom_namespaces);
+  Admin::RequestPtr makePrometheusRequest(AdminStream& admin_stream);
+  Admin::RequestPtr makePrometheusRequest(const StatsParams& params);
 };
 
 } // namespace Server
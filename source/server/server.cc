@@ -285,6 +285,10 @@ void InstanceBase::updateServerStats() {
       enumToInt(Utility::serverState(initManager().state(), healthCheckFailed())));
   server_stats_->stats_recent_lookups_.set(
       stats_store_.symbolTable().getRecentLookups([](absl::string_view, uint64_t) {}));
+  server_stats_->stats_symbol_table_contentions_.set(
+      stats_store_.symbolTable().lockContentions());
+  server_stats_->stats_symbol_table_exclusive_locks_.set(
+      stats_store_.symbolTable().exclusiveLockAcquisitions());
 }
 
 void InstanceBase::flushStatsInternal() {
@@ -550,6 +554,7 @@ absl::Status InstanceBase::initializeOrThrow(Network::Address::InstanceConstShar
       bootstrap_.stats_config(), stats_store_.symbolTable(), server_contexts_));
   stats_store_.setHistogramSettings(
       std::make_unique<Stats::HistogramSettingsImpl>(bootstrap_.stats_config(), server_contexts_));
+  stats_store_.setPerWorkerCounters(bootstrap_.stats_config().per_worker_counters());
 
   const std::string server_stats_prefix = "server.";
   const std::string server_compilation_settings_stats_prefix = "server.compilation_settings";
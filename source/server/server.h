@@ -89,6 +89,8 @@ struct ServerCompilationSettingsStats {
   GAUGE(parent_connections, Accumulate)                                                            \
   GAUGE(state, NeverImport)                                                                        \
   GAUGE(stats_recent_lookups, NeverImport)                                                         \
+  GAUGE(stats_symbol_table_contentions, NeverImport)                                               \
+  GAUGE(stats_symbol_table_exclusive_locks, NeverImport)                                           \
   GAUGE(total_connections, Accumulate)                                                             \
   GAUGE(uptime, Accumulate)                                                                        \
   GAUGE(version, NeverImport)                                                                      \
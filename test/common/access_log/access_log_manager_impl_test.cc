@@ -8,9 +8,11 @@
 #include "test/mocks/api/mocks.h"
 #include "test/mocks/event/mocks.h"
 #include "test/mocks/filesystem/mocks.h"
+#include "test/test_common/test_runtime.h"
 #include "test/test_common/test_time.h"
 #include "test/test_common/utility.h"
 
+#include "absl/synchronization/notification.h"
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 
@@ -527,6 +529,177 @@ TEST_F(AccessLogManagerImplTest, ReopenAllFiles) {
       .WillOnce(Return(ByMove(Filesystem::resultSuccess<bool>(true))));
 }
 
+TEST(AccessLogRingTest, WrapsAround) {
+  AccessLogRing ring(8);
+  EXPECT_TRUE(ring.push("abcdef"));
+  EXPECT_FALSE(ring.push("ghi"));
+
+  absl::InlinedVector<absl::string_view, 16> slices;
+  ring.release(ring.peek(slices));
+  ASSERT_EQ(1U, slices.size());
+  EXPECT_EQ("abcdef", slices[0]);
+  EXPECT_EQ(0U, ring.size());
+
+  // The data now spans the end and the start of the buffer.
+  EXPECT_TRUE(ring.push("ghijk"));
+  EXPECT_EQ(5U, ring.size());
+  slices.clear();
+  const uint64_t position = ring.peek(slices);
+  ASSERT_EQ(2U, slices.size());
+  EXPECT_EQ("gh", slices[0]);
+  EXPECT_EQ("ijk", slices[1]);
+  ring.release(position);
+  EXPECT_EQ(0U, ring.size());
+}
+
+TEST_F(AccessLogManagerImplTest, SharedFlushThreadWritesAllData) {
+  TestScopedRuntime scoped_runtime;
+  scoped_runtime.mergeValues(
+      {{"envoy.reloadable_features.shared_access_log_flush_thread", "true"}});
+
+  EXPECT_CALL(*file_, open_(_)).WillOnce(Return(ByMove(Filesystem::resultSuccess<bool>(true))));
+  AccessLogFileSharedPtr log_file =
+      access_log_manager_
+          .createAccessLog(Filesystem::FilePathAndType{Filesystem::DestinationType::File, "foo"})
+          .value();
+
+  // The flush thread may flush between the writes, so only the concatenated data is checked.
+  absl::Mutex mutex;
+  std::string written;
+  EXPECT_CALL(*file_, write_(_))
+      .WillRepeatedly(Invoke([&](absl::string_view data) -> Api::IoCallSizeResult {
+        absl::MutexLock lock(&mutex);
+        absl::StrAppend(&written, data);
+        return Filesystem::resultSuccess<ssize_t>(static_cast<ssize_t>(data.length()));
+      }));
+
+  log_file->write("test");
+  log_file->write("test2");
+  log_file->flush();
+  {
+    absl::MutexLock lock(&mutex);
+    EXPECT_EQ("testtest2", written);
+  }
+  EXPECT_EQ(2UL, store_.counter("filesystem.write_buffered").value());
+  EXPECT_EQ(0UL, store_.counter("filesystem.write_overflowed").value());
+  EXPECT_EQ(0, store_.gauge("filesystem.write_total_buffered", Stats::Gauge::ImportMode::Accumulate)
+                   .value());
+
+  EXPECT_CALL(*file_, close_()).WillOnce(Return(ByMove(Filesystem::resultSuccess<bool>(true))));
+}
+
+TEST_F(AccessLogManagerImplTest, SharedFlushThreadOverflowsAndDrops) {
+  AccessLogFileStats stats{ACCESS_LOG_FILE_STATS(POOL_COUNTER_PREFIX(store_, "shared."),
+                                                 POOL_GAUGE_PREFIX(store_, "shared."))};
+  auto flush_thread = std::make_shared<AccessLogFlushThread>(
+      thread_factory_, std::chrono::milliseconds(3600 * 1000), stats);
+
+  auto* file = new NiceMock<Filesystem::MockFile>;
+  EXPECT_CALL(*file, open_(_)).WillOnce(Return(ByMove(Filesystem::resultSuccess<bool>(true))));
+  ASSERT_TRUE(file->open({}).return_value_);
+
+  // Blocks the first flush until the test has filled the overflow buffer.
+  absl::Notification flushing;
+  absl::Notification unblock;
+  std::string written;
+  EXPECT_CALL(*file, write_(_))
+      .WillRepeatedly(Invoke([&](absl::string_view data) -> Api::IoCallSizeResult {
+        if (!flushing.HasBeenNotified()) {
+          flushing.Notify();
+          unblock.WaitForNotification();
+        }
+        absl::StrAppend(&written, data);
+        return Filesystem::resultSuccess<ssize_t>(static_cast<ssize_t>(data.length()));
+      }));
+  EXPECT_CALL(*file, close_()).WillOnce(Return(ByMove(Filesystem::resultSuccess<bool>(true))));
+
+  {
+    SharedAccessLogFileImpl log_file(Filesystem::FilePtr{file}, lock_, stats, flush_thread,
+                                     /*ring_size=*/4, /*max_overflow_size=*/8);
+
+    // Larger than the ring, so it goes to the overflow buffer and wakes the flush thread.
+    log_file.write("abcde");
+    flushing.WaitForNotification();
+
+    log_file.write("12345678");
+    // Fits neither the ring nor what is left of the overflow buffer.
+    log_file.write("vwxyz");
+    EXPECT_EQ(2UL, stats.write_overflowed_.value());
+    EXPECT_EQ(1UL, stats.write_dropped_.value());
+    unblock.Notify();
+  }
+
+  EXPECT_EQ("abcde12345678", written);
+  EXPECT_EQ(2UL, stats.write_buffered_.value());
+  EXPECT_EQ(0, stats.write_total_buffered_.value());
+}
+
+// Data a thread writes after overflowing is written after the overflowed data, even if it fits
+// the ring of the thread.
+TEST_F(AccessLogManagerImplTest, SharedFlushThreadKeepsOrderAfterOverflow) {
+  AccessLogFileStats stats{ACCESS_LOG_FILE_STATS(POOL_COUNTER_PREFIX(store_, "shared."),
+                                                 POOL_GAUGE_PREFIX(store_, "shared."))};
+  auto flush_thread = std::make_shared<AccessLogFlushThread>(
+      thread_factory_, std::chrono::milliseconds(3600 * 1000), stats);
+
+  auto* file = new NiceMock<Filesystem::MockFile>;
+  EXPECT_CALL(*file, open_(_)).WillOnce(Return(ByMove(Filesystem::resultSuccess<bool>(true))));
+  ASSERT_TRUE(file->open({}).return_value_);
+
+  absl::Mutex mutex;
+  std::string written;
+  EXPECT_CALL(*file, write_(_))
+      .WillRepeatedly(Invoke([&](absl::string_view data) -> Api::IoCallSizeResult {
+        absl::MutexLock lock(&mutex);
+        absl::StrAppend(&written, data);
+        return Filesystem::resultSuccess<ssize_t>(static_cast<ssize_t>(data.length()));
+      }));
+  EXPECT_CALL(*file, close_()).WillOnce(Return(ByMove(Filesystem::resultSuccess<bool>(true))));
+
+  {
+    SharedAccessLogFileImpl log_file(Filesystem::FilePtr{file}, lock_, stats, flush_thread,
+                                     /*ring_size=*/4, /*max_overflow_size=*/64);
+    log_file.write("ab");
+    // Larger than what is left of the ring.
+    log_file.write("cde");
+    log_file.write("f");
+  }
+
+  absl::MutexLock lock(&mutex);
+  EXPECT_EQ("abcdef", written);
+  EXPECT_EQ(0UL, stats.write_dropped_.value());
+}
+
+// Threads that exit release their ring, so more threads than MAX_RINGS can write one after the
+// other without overflowing.
+TEST_F(AccessLogManagerImplTest, SharedFlushThreadReusesRingsOfExitedThreads) {
+  AccessLogFileStats stats{ACCESS_LOG_FILE_STATS(POOL_COUNTER_PREFIX(store_, "shared."),
+                                                 POOL_GAUGE_PREFIX(store_, "shared."))};
+  auto flush_thread = std::make_shared<AccessLogFlushThread>(
+      thread_factory_, std::chrono::milliseconds(3600 * 1000), stats);
+
+  auto* file = new NiceMock<Filesystem::MockFile>;
+  EXPECT_CALL(*file, open_(_)).WillOnce(Return(ByMove(Filesystem::resultSuccess<bool>(true))));
+  ASSERT_TRUE(file->open({}).return_value_);
+  ON_CALL(*file, write_(_))
+      .WillByDefault(Invoke([](absl::string_view data) -> Api::IoCallSizeResult {
+        return Filesystem::resultSuccess<ssize_t>(static_cast<ssize_t>(data.length()));
+      }));
+  EXPECT_CALL(*file, close_()).WillOnce(Return(ByMove(Filesystem::resultSuccess<bool>(true))));
+
+  {
+    SharedAccessLogFileImpl log_file(Filesystem::FilePtr{file}, lock_, stats, flush_thread);
+    for (uint32_t i = 0; i < 2 * SharedAccessLogFileImpl::MAX_RINGS; ++i) {
+      Thread::ThreadPtr thread =
+          thread_factory_.createThread([&log_file]() -> void { log_file.write("test"); });
+      thread->join();
+    }
+  }
+
+  EXPECT_EQ(2 * SharedAccessLogFileImpl::MAX_RINGS, stats.write_buffered_.value());
+  EXPECT_EQ(0UL, stats.write_overflowed_.value());
+}
+
 } // namespace
 } // namespace AccessLog
 } // namespace Envoy
@@ -2,6 +2,7 @@
 #include "envoy/http/stream_reset_handler.h"
 
 #include "source/common/buffer/buffer_impl.h"
+#include "source/common/buffer/slice_pool.h"
 #include "source/common/buffer/watermark_buffer.h"
 #include "source/common/common/assert.h"
 
@@ -320,6 +321,35 @@ BENCHMARK(bufferReserveCommit)
     ->Arg(64 * 1024)
     ->Arg(128 * 1024);
 
+// Test a proxy-like cycle: read into a downstream buffer, move it to an upstream buffer and drain
+// the upstream buffer as it is written. Arg 0 is the read size, arg 1 enables the slice pool.
+static void bufferReadMoveDrain(benchmark::State& state) {
+  const uint64_t size = state.range(0);
+  Buffer::SlicePool pool;
+  Buffer::SlicePool::ScopedActivation activation(state.range(1) != 0 ? &pool : nullptr);
+  Buffer::OwnedImpl downstream;
+  Buffer::OwnedImpl upstream;
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    Buffer::Reservation reservation = downstream.reserveForReadWithLengthForTest(size);
+    reservation.commit(reservation.length());
+    upstream.move(downstream);
+    while (upstream.length() != 0) {
+      upstream.drain(std::min<uint64_t>(upstream.length(), Buffer::Slice::default_slice_size_));
+    }
+  }
+  benchmark::DoNotOptimize(upstream.length());
+}
+BENCHMARK(bufferReadMoveDrain)
+    ->Args({4 * 1024, 0})
+    ->Args({4 * 1024, 1})
+    ->Args({16 * 1024, 0})
+    ->Args({16 * 1024, 1})
+    ->Args({64 * 1024, 0})
+    ->Args({64 * 1024, 1})
+    ->Args({128 * 1024, 0})
+    ->Args({128 * 1024, 1});
+
 // Test the reserve+commit cycle, for the common case where the reserved space is
 // only partially used (and therefore the commit size is smaller than the reservation size).
 static void bufferReserveCommitPartial(benchmark::State& state) {
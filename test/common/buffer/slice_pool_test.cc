@@ -0,0 +1,128 @@
+#include <memory>
+#include <string>
+
+#include "source/common/buffer/buffer_impl.h"
+#include "source/common/buffer/slice_pool.h"
+#include "source/common/stats/isolated_store_impl.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Buffer {
+namespace {
+
+class SlicePoolTest : public testing::Test {
+protected:
+  SlicePoolTest()
+      : stats_(SlicePoolStats{ALL_SLICE_POOL_STATS(POOL_COUNTER_PREFIX(scope_, "slice_pool."),
+                                                   POOL_GAUGE_PREFIX(scope_, "slice_pool."))}) {
+    pool_.setStats(&stats_);
+  }
+
+  Stats::IsolatedStoreImpl store_;
+  Stats::Scope& scope_{*store_.rootScope()};
+  SlicePoolStats stats_;
+  SlicePool pool_{4 * Slice::default_slice_size_, 2 * Slice::default_slice_size_};
+};
+
+TEST_F(SlicePoolTest, ReusesReleasedStorage) {
+  SlicePool::StoragePtr storage = pool_.allocate(Slice::default_slice_size_);
+  const uint8_t* memory = storage.get();
+  EXPECT_EQ(1, stats_.misses_.value());
+
+  pool_.release(std::move(storage), Slice::default_slice_size_);
+  EXPECT_EQ(Slice::default_slice_size_, pool_.bytesCached());
+  EXPECT_EQ(Slice::default_slice_size_, stats_.bytes_cached_.value());
+
+  storage = pool_.allocate(Slice::default_slice_size_);
+  EXPECT_EQ(memory, storage.get());
+  EXPECT_EQ(1, stats_.hits_.value());
+  EXPECT_EQ(0, pool_.bytesCached());
+  EXPECT_EQ(0, stats_.bytes_cached_.value());
+}
+
+TEST_F(SlicePoolTest, SizesArePooledSeparately) {
+  pool_.release(pool_.allocate(SlicePool::PageSize), SlicePool::PageSize);
+  SlicePool::StoragePtr storage = pool_.allocate(2 * SlicePool::PageSize);
+  EXPECT_EQ(2, stats_.misses_.value());
+  EXPECT_EQ(0, stats_.hits_.value());
+  EXPECT_EQ(SlicePool::PageSize, pool_.bytesCached());
+}
+
+TEST_F(SlicePoolTest, LargeStorageIsNotPooled) {
+  const uint64_t size = 2 * SlicePool::MaxPooledSize;
+  pool_.release(pool_.allocate(size), size);
+  EXPECT_EQ(0, pool_.bytesCached());
+  EXPECT_EQ(0, stats_.hits_.value());
+  EXPECT_EQ(0, stats_.misses_.value());
+}
+
+TEST_F(SlicePoolTest, TrimsToLowWatermark) {
+  for (uint32_t i = 0; i < 4; ++i) {
+    pool_.release(std::make_unique<uint8_t[]>(Slice::default_slice_size_),
+                  Slice::default_slice_size_);
+  }
+  EXPECT_EQ(4 * Slice::default_slice_size_, pool_.bytesCached());
+
+  // Going above the high watermark trims down to the low watermark first.
+  pool_.release(std::make_unique<uint8_t[]>(Slice::default_slice_size_),
+                Slice::default_slice_size_);
+  EXPECT_EQ(3 * Slice::default_slice_size_, pool_.bytesCached());
+  EXPECT_EQ(3 * Slice::default_slice_size_, stats_.bytes_cached_.value());
+
+  pool_.trim(0);
+  EXPECT_EQ(0, pool_.bytesCached());
+}
+
+TEST_F(SlicePoolTest, TrimReleasesLargestSizesFirst) {
+  pool_.release(std::make_unique<uint8_t[]>(SlicePool::PageSize), SlicePool::PageSize);
+  pool_.release(std::make_unique<uint8_t[]>(Slice::default_slice_size_),
+                Slice::default_slice_size_);
+  pool_.trim(SlicePool::PageSize);
+  EXPECT_EQ(SlicePool::PageSize, pool_.bytesCached());
+  pool_.allocate(SlicePool::PageSize);
+  EXPECT_EQ(1, stats_.hits_.value());
+}
+
+TEST_F(SlicePoolTest, BuffersUseCurrentPool) {
+  EXPECT_EQ(nullptr, SlicePool::current());
+  {
+    SlicePool::ScopedActivation activation(&pool_);
+    EXPECT_EQ(&pool_, SlicePool::current());
+
+    OwnedImpl buffer;
+    buffer.add(std::string(Slice::default_slice_size_, 'a'));
+    EXPECT_EQ(1, stats_.misses_.value());
+    buffer.drain(buffer.length());
+    EXPECT_EQ(Slice::default_slice_size_, pool_.bytesCached());
+
+    // A reservation reuses the drained slice.
+    {
+      auto reservation = buffer.reserveSingleSlice(Slice::default_slice_size_);
+      reservation.commit(100);
+    }
+    EXPECT_EQ(1, stats_.hits_.value());
+    buffer.drain(buffer.length());
+
+    {
+      SlicePool::ScopedActivation no_pool(nullptr);
+      EXPECT_EQ(nullptr, SlicePool::current());
+      OwnedImpl other;
+      other.add(std::string(Slice::default_slice_size_, 'b'));
+    }
+    EXPECT_EQ(&pool_, SlicePool::current());
+    EXPECT_EQ(1, stats_.hits_.value());
+  }
+  EXPECT_EQ(nullptr, SlicePool::current());
+
+  // Outside of the activation, slices do not use the pool.
+  const uint64_t bytes_cached = pool_.bytesCached();
+  OwnedImpl buffer;
+  buffer.add(std::string(Slice::default_slice_size_, 'c'));
+  buffer.drain(buffer.length());
+  EXPECT_EQ(bytes_cached, pool_.bytesCached());
+}
+
+} // namespace
+} // namespace Buffer
+} // namespace Envoy
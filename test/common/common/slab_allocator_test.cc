@@ -0,0 +1,128 @@
+#include <list>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "source/common/common/slab_allocator.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace {
+
+TEST(SlabArenaTest, GrowsSlabsAndReusesSlots) {
+  SlabArena arena(2, 4);
+  std::vector<void*> slots;
+  for (uint32_t i = 0; i < 2; ++i) {
+    slots.push_back(arena.allocate(24));
+  }
+  EXPECT_EQ(1, arena.slabs());
+  // Slots of the same slab are contiguous.
+  EXPECT_EQ(static_cast<char*>(slots[0]) + 32, slots[1]);
+
+  // The second slab has twice the slots, and the third one is capped.
+  for (uint32_t i = 0; i < 4; ++i) {
+    slots.push_back(arena.allocate(24));
+  }
+  EXPECT_EQ(2, arena.slabs());
+  slots.push_back(arena.allocate(24));
+  EXPECT_EQ(3, arena.slabs());
+
+  // Released slots are handed out again, most recently released first.
+  arena.deallocate(slots[1]);
+  arena.deallocate(slots[4]);
+  EXPECT_EQ(slots[4], arena.allocate(24));
+  EXPECT_EQ(slots[1], arena.allocate(24));
+  EXPECT_EQ(3, arena.slabs());
+}
+
+TEST(SlabArenaTest, StartsOverOnceEmpty) {
+  SlabArena arena(1, 4);
+  std::vector<void*> slots;
+  for (uint32_t i = 0; i < 3; ++i) {
+    slots.push_back(arena.allocate(24));
+  }
+  EXPECT_EQ(2, arena.slabs());
+  for (void* slot : slots) {
+    arena.deallocate(slot);
+  }
+
+  // Once all slots are released the existing slabs are handed out in order again.
+  EXPECT_EQ(slots[0], arena.allocate(24));
+  EXPECT_EQ(slots[1], arena.allocate(24));
+  EXPECT_EQ(slots[2], arena.allocate(24));
+  EXPECT_EQ(2, arena.slabs());
+}
+
+TEST(SlabArenaTest, ReserveSizesFirstSlab) {
+  SlabArena arena(1, 8);
+  arena.reserve(5);
+  std::vector<void*> slots;
+  for (uint32_t i = 0; i < 5; ++i) {
+    slots.push_back(arena.allocate(24));
+  }
+  EXPECT_EQ(1, arena.slabs());
+  EXPECT_EQ(static_cast<char*>(slots[0]) + 4 * 32, slots[4]);
+
+  // Reserving has no effect once a slab was allocated.
+  arena.reserve(100);
+  arena.allocate(24);
+  EXPECT_EQ(2, arena.slabs());
+}
+
+TEST(SlabAllocatorTest, List) {
+  SlabArena arena;
+  std::list<std::string, SlabAllocator<std::string>> list{SlabAllocator<std::string>(arena)};
+  for (uint32_t i = 0; i < 100; ++i) {
+    list.push_back(std::string(i, 'a'));
+  }
+  const std::string* first = &list.front();
+  list.remove_if([](const std::string& value) { return value.size() % 2 == 1; });
+  EXPECT_EQ(50, list.size());
+  // Nodes do not move.
+  EXPECT_EQ(first, &list.front());
+
+  const size_t slabs = arena.slabs();
+  for (uint32_t i = 0; i < 50; ++i) {
+    list.push_front(std::string(i, 'b'));
+  }
+  EXPECT_EQ(slabs, arena.slabs());
+  EXPECT_EQ(100, list.size());
+}
+
+TEST(SlabAllocatorTest, Set) {
+  SlabArena arena;
+  std::set<int, std::less<int>, SlabAllocator<int>> set{SlabAllocator<int>(arena)};
+  for (int i = 0; i < 100; ++i) {
+    set.insert(99 - i);
+  }
+  int expected = 0;
+  for (const int value : set) {
+    EXPECT_EQ(expected++, value);
+  }
+}
+
+TEST(SlabAllocatorTest, ArraysUseHeap) {
+  SlabArena arena;
+  SlabAllocator<int> allocator(arena);
+  int* values = allocator.allocate(16);
+  allocator.deallocate(values, 16);
+  EXPECT_EQ(0, arena.slabs());
+
+  SlabAllocator<char> other(allocator);
+  EXPECT_TRUE(other == allocator);
+  SlabArena other_arena;
+  EXPECT_TRUE(SlabAllocator<int>(other_arena) != allocator);
+}
+
+TEST(SlabAllocatorTest, DefaultConstructedUsesHeap) {
+  std::list<int, SlabAllocator<int>> list;
+  for (int i = 0; i < 10; ++i) {
+    list.push_back(i);
+  }
+  EXPECT_EQ(10, list.size());
+  EXPECT_TRUE(SlabAllocator<int>() == list.get_allocator());
+}
+
+} // namespace
+} // namespace Envoy
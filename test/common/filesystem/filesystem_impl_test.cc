@@ -373,6 +373,24 @@ TEST_F(FileSystemImplTest, PwriteWritesTheSpecifiedRange) {
   EXPECT_EQ(contents, "01BOOPS789");
 }
 
+TEST_F(FileSystemImplTest, WritevWritesAllBuffersInOrder) {
+  const std::string file_path = TestEnvironment::writeStringToFileForTest("test_envoy", "012");
+  {
+    FilePathAndType file_info{Filesystem::DestinationType::File, file_path};
+    FilePtr file = file_system_.createFile(file_info);
+    const Api::IoCallBoolResult open_result =
+        file->open(FlagSet{(1 << Filesystem::File::Operation::Write) |
+                           (1 << Filesystem::File::Operation::Append)});
+    EXPECT_TRUE(open_result.return_value_) << open_result.err_->getErrorDetails();
+    const std::vector<absl::string_view> buffers{"abc", "", "defg"};
+    const Api::IoCallSizeResult write_result = file->writev(buffers);
+    EXPECT_EQ(write_result.return_value_, 7) << write_result.err_->getErrorDetails();
+    EXPECT_THAT(write_result.err_, ::testing::IsNull());
+  }
+  auto contents = TestEnvironment::readFileToStringForTest(file_path);
+  EXPECT_EQ(contents, "012abcdefg");
+}
+
 TEST_F(FileSystemImplTest, StatOnDirectoryReturnsDirectoryType) {
   const std::string new_dir_path = TestEnvironment::temporaryPath("envoy_test_dir");
   TestEnvironment::createPath(new_dir_path);
@@ -29,6 +29,37 @@ std::unique_ptr<Envoy::Formatter::JsonFormatterImpl> makeJsonFormatter() {
   return std::make_unique<Envoy::Formatter::JsonFormatterImpl>(struct_format, false);
 }
 
+// Common text access log format, close to the default format.
+constexpr absl::string_view TextLogFormat =
+    "[%START_TIME%] \"%REQ(:METHOD)% %REQ(X-ENVOY-ORIGINAL-PATH?:PATH)% %PROTOCOL%\" "
+    "%RESPONSE_CODE% %RESPONSE_FLAGS% %BYTES_RECEIVED% %BYTES_SENT% %DURATION% "
+    "%RESP(X-ENVOY-UPSTREAM-SERVICE-TIME)% \"%REQ(X-FORWARDED-FOR)%\" \"%REQ(USER-AGENT)%\" "
+    "\"%REQ(X-REQUEST-ID)%\" \"%REQ(:AUTHORITY)%\" \"%UPSTREAM_HOST%\"\n";
+
+// The same fields as a JSON access log format.
+std::unique_ptr<Envoy::Formatter::JsonFormatterImpl> makeCommonJsonFormatter() {
+  Protobuf::Struct struct_format;
+  const std::string format_yaml = R"EOF(
+    start_time: '%START_TIME%'
+    method: '%REQ(:METHOD)%'
+    path: '%REQ(X-ENVOY-ORIGINAL-PATH?:PATH)%'
+    protocol: '%PROTOCOL%'
+    response_code: '%RESPONSE_CODE%'
+    response_flags: '%RESPONSE_FLAGS%'
+    bytes_received: '%BYTES_RECEIVED%'
+    bytes_sent: '%BYTES_SENT%'
+    duration: '%DURATION%'
+    upstream_service_time: '%RESP(X-ENVOY-UPSTREAM-SERVICE-TIME)%'
+    x_forwarded_for: '%REQ(X-FORWARDED-FOR)%'
+    user_agent: '%REQ(USER-AGENT)%'
+    request_id: '%REQ(X-REQUEST-ID)%'
+    authority: '%REQ(:AUTHORITY)%'
+    upstream_host: '%UPSTREAM_HOST%'
+  )EOF";
+  TestUtility::loadFromYaml(format_yaml, struct_format);
+  return std::make_unique<Envoy::Formatter::JsonFormatterImpl>(struct_format, false);
+}
+
 std::unique_ptr<Envoy::TestStreamInfo> makeStreamInfo(TimeSource& time_source) {
   auto stream_info = std::make_unique<Envoy::TestStreamInfo>(time_source);
   stream_info->downstream_connection_info_provider_->setRemoteAddress(
@@ -125,6 +156,53 @@ static void BM_JsonAccessLogFormatter(benchmark::State& state) {
 }
 BENCHMARK(BM_JsonAccessLogFormatter);
 
+// Formats lines of a common format with request and response headers, either into a new string
+// per line or by appending to a reused output buffer.
+static void formatCommonLines(benchmark::State& state, const Formatter::Formatter& formatter) {
+  testing::NiceMock<MockTimeSystem> time_system;
+  std::unique_ptr<Envoy::TestStreamInfo> stream_info = makeStreamInfo(time_system);
+  stream_info->setResponseCode(200);
+  const Http::TestRequestHeaderMapImpl request_headers{
+      {":method", "GET"},
+      {":path", "/api/v1/resources/42?expand=true"},
+      {":authority", "api.example.com"},
+      {"x-forwarded-for", "203.0.113.1"},
+      {"user-agent", "Mozilla/5.0 (X11; Linux x86_64) AppleWebKit/537.36 (KHTML, like Gecko)"},
+      {"x-request-id", "4b6f3a1e-2c8d-4e5f-9a7b-1c2d3e4f5a6b"}};
+  const Http::TestResponseHeaderMapImpl response_headers{
+      {":status", "200"}, {"x-envoy-upstream-service-time", "12"}};
+  const Formatter::Context context(&request_headers, &response_headers);
+  const bool reuse_output = state.range(0) != 0;
+
+  std::string output;
+  size_t output_bytes = 0;
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    if (reuse_output) {
+      output.clear();
+      formatter.formatTo(context, *stream_info, output);
+      output_bytes += output.size();
+    } else {
+      output_bytes += formatter.format(context, *stream_info).size();
+    }
+  }
+  benchmark::DoNotOptimize(output_bytes);
+}
+
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void BM_CommonTextAccessLogFormatter(benchmark::State& state) {
+  std::unique_ptr<Envoy::Formatter::FormatterImpl> formatter =
+      *Envoy::Formatter::FormatterImpl::create(TextLogFormat, false);
+  formatCommonLines(state, *formatter);
+}
+BENCHMARK(BM_CommonTextAccessLogFormatter)->Arg(0)->Arg(1)->ArgName("reuse_output");
+
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void BM_CommonJsonAccessLogFormatter(benchmark::State& state) {
+  std::unique_ptr<Envoy::Formatter::JsonFormatterImpl> formatter = makeCommonJsonFormatter();
+  formatCommonLines(state, *formatter);
+}
+BENCHMARK(BM_CommonJsonAccessLogFormatter)->Arg(0)->Arg(1)->ArgName("reuse_output");
+
 // NOLINTNEXTLINE(readability-identifier-naming)
 static void BM_FormatterCommandParsing(benchmark::State& state) {
   const std::string token = "Listener:namespace:key";
@@ -4160,6 +4160,55 @@ TEST(SubstitutionFormatterTest, JsonFormatterMultiTokenTest) {
   }
 }
 
+// Test that formatTo() appends the same line as format() to an existing output buffer.
+TEST(SubstitutionFormatterTest, FormatToAppendsToOutput) {
+  NiceMock<StreamInfo::MockStreamInfo> stream_info;
+  absl::optional<Http::Protocol> protocol = Http::Protocol::Http11;
+  EXPECT_CALL(stream_info, protocol()).WillRepeatedly(Return(protocol));
+  EXPECT_CALL(stream_info, bytesSent()).WillRepeatedly(Return(42));
+  Http::TestRequestHeaderMapImpl request_header{{"some_request_header", "SOME \"REQUEST\""}};
+  Context formatter_context;
+  formatter_context.setRequestHeaders(request_header);
+
+  std::unique_ptr<FormatterImpl> text_formatter = *FormatterImpl::create(
+      "%PROTOCOL% %REQ(some_request_header)% %REQ(missing)% %BYTES_SENT% 1");
+  Protobuf::Struct key_mapping;
+  TestUtility::loadFromYaml(R"EOF(
+    protocol: '%PROTOCOL%'
+    header: '%REQ(some_request_header)%'
+    missing: '%REQ(missing)%'
+    bytes_sent: '%BYTES_SENT%'
+    number: 1
+    multi_token: '%PROTOCOL% %REQ(some_request_header)% %REQ(missing)% %BYTES_SENT%'
+  )EOF",
+                            key_mapping);
+  JsonFormatterImpl json_formatter(key_mapping, false);
+
+  EXPECT_EQ("HTTP/1.1 SOME \"REQUEST\" - 42 1",
+            text_formatter->format(formatter_context, stream_info));
+  for (const Formatter* formatter :
+       std::vector<const Formatter*>{text_formatter.get(), &json_formatter}) {
+    const std::string line = formatter->format(formatter_context, stream_info);
+    std::string output = "prefix";
+    // The output is reused for several lines.
+    for (int i = 0; i < 3; ++i) {
+      output.resize(6);
+      formatter->formatTo(formatter_context, stream_info, output);
+      EXPECT_EQ("prefix" + line, output);
+    }
+  }
+  const Protobuf::Struct expected = TestUtility::jsonToStruct(R"EOF({
+    "protocol": "HTTP/1.1",
+    "header": "SOME \"REQUEST\"",
+    "missing": null,
+    "bytes_sent": 42,
+    "number": 1,
+    "multi_token": "HTTP/1.1 SOME \"REQUEST\" - 42"
+  })EOF");
+  EXPECT_TRUE(TestUtility::protoEqual(
+      TestUtility::jsonToStruct(json_formatter.format(formatter_context, stream_info)), expected));
+}
+
 TEST(SubstitutionFormatterTest, JsonFormatterTest) {
   NiceMock<StreamInfo::MockStreamInfo> stream_info;
   Http::TestRequestHeaderMapImpl request_header{{"key_1", "value_1"},
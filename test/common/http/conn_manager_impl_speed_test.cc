@@ -0,0 +1,157 @@
+// Note: this should be run with --compilation_mode=opt, and would benefit from a
+// quiescent system with disabled cstate power management.
+
+#include <memory>
+
+#include "source/common/common/macros.h"
+#include "source/common/memory/stats.h"
+#include "source/common/runtime/runtime_features.h"
+#include "source/extensions/filters/http/common/pass_through_filter.h"
+
+#include "test/common/http/conn_manager_impl_test_base.h"
+
+#include "absl/flags/reflection.h"
+#include "benchmark/benchmark.h"
+
+using testing::_;
+using testing::Invoke;
+
+namespace Envoy {
+namespace Http {
+namespace {
+
+// Responds to every request with a header only response.
+class RespondingFilter : public PassThroughFilter {
+public:
+  FilterHeadersStatus decodeHeaders(RequestHeaderMap&, bool) override {
+    ResponseHeaderMapPtr headers = ResponseHeaderMapImpl::create();
+    headers->setStatus(200);
+    decoder_callbacks_->encodeHeaders(std::move(headers), true, "benchmark");
+    return FilterHeadersStatus::StopIteration;
+  }
+};
+
+const LowerCaseString& addedHeader() { CONSTRUCT_ON_FIRST_USE(LowerCaseString, "x-added"); }
+
+// Adds a request header, like the header mutation filters. A filter is created for every stream.
+class AddHeaderFilter : public PassThroughDecoderFilter {
+public:
+  FilterHeadersStatus decodeHeaders(RequestHeaderMap& headers, bool) override {
+    headers.addReference(addedHeader(), "true");
+    return FilterHeadersStatus::Continue;
+  }
+};
+
+// The same filter without per-stream state, shared by all streams.
+class StatelessAddHeaderFilter : public StatelessStreamDecoderFilter {
+public:
+  FilterHeadersStatus decodeHeaders(StreamDecoderFilterCallbacks&, RequestHeaderMap& headers,
+                                    bool) const override {
+    headers.addReference(addedHeader(), "true");
+    return FilterHeadersStatus::Continue;
+  }
+};
+
+// Runs header only requests through a connection manager with a chain of filters, which are
+// created for every stream like the filters of a real filter chain.
+class ConnManagerSpeedTest : public HttpConnectionManagerImplMixin {
+public:
+  // Uses pass through filters.
+  explicit ConnManagerSpeedTest(int filters) {
+    setupFilters(filters, [](FilterChainFactoryCallbacks& callbacks) {
+      callbacks.addStreamFilter(std::make_shared<PassThroughFilter>());
+    });
+  }
+
+  // Uses filters that add a request header, either created for every stream or shared.
+  ConnManagerSpeedTest(int filters, bool stateless) {
+    if (stateless) {
+      auto filter = std::make_shared<const StatelessAddHeaderFilter>();
+      setupFilters(filters, [filter](FilterChainFactoryCallbacks& callbacks) {
+        callbacks.addStatelessStreamDecoderFilter(filter);
+      });
+    } else {
+      setupFilters(filters, [](FilterChainFactoryCallbacks& callbacks) {
+        callbacks.addStreamDecoderFilter(std::make_shared<AddHeaderFilter>());
+      });
+    }
+  }
+
+  // Sets up a chain of the given number of filters, the last of which responds to the request.
+  void setupFilters(int filters, FilterFactoryCb filter_factory) {
+    setup(SetupOpts().setTracing(false));
+    ON_CALL(filter_factory_, createFilterChain(_))
+        .WillByDefault(Invoke([filters, filter_factory](FilterChainManager& manager) -> bool {
+          for (int i = 0; i < filters - 1; ++i) {
+            manager.applyFilterFactoryCb({}, filter_factory);
+          }
+          FilterFactoryCb responder = [](FilterChainFactoryCallbacks& callbacks) {
+            callbacks.addStreamFilter(std::make_shared<RespondingFilter>());
+          };
+          manager.applyFilterFactoryCb({}, responder);
+          return true;
+        }));
+    ON_CALL(*codec_, dispatch(_)).WillByDefault(Invoke([this](Buffer::Instance&) -> Status {
+      RequestDecoder& decoder = conn_manager_->newStream(response_encoder_);
+      decoder.decodeHeaders(
+          RequestHeaderMapPtr{new TestRequestHeaderMapImpl{
+              {":authority", "host"}, {":path", "/"}, {":method", "GET"}}},
+          true);
+      return okStatus();
+    }));
+  }
+
+  // Runs one request. Returns the number of bytes allocated for the stream that are still in use
+  // once it has completed and is waiting for deferred deletion.
+  int64_t request() {
+    const int64_t allocated = Memory::Stats::totalCurrentlyAllocated();
+    Buffer::OwnedImpl data("request");
+    conn_manager_->onData(data, false);
+    const int64_t stream_bytes = Memory::Stats::totalCurrentlyAllocated() - allocated;
+    filter_callbacks_.connection_.dispatcher_.to_delete_.clear();
+    response_encoder_.stream_.callbacks_.clear();
+    return stream_bytes;
+  }
+};
+
+} // namespace
+
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void BM_HeaderOnlyRequest(benchmark::State& state) {
+  absl::FlagSaver flag_saver;
+  Runtime::maybeSetRuntimeGuard("envoy.reloadable_features.http_stream_arena",
+                                state.range(1) != 0);
+  ConnManagerSpeedTest test(state.range(0));
+  int64_t stream_bytes = 0;
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    stream_bytes += test.request();
+  }
+  // Only meaningful with a memory allocator that reports the allocated bytes, e.g. tcmalloc.
+  state.counters["stream_bytes"] =
+      benchmark::Counter(stream_bytes, benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_HeaderOnlyRequest)->ArgsProduct({{1, 5, 10}, {0, 1}})->ArgNames({"filters", "arena"});
+
+// Compares filters created for every stream with the same filters shared by all streams.
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void BM_HeaderMutationFilters(benchmark::State& state) {
+  absl::FlagSaver flag_saver;
+  Runtime::maybeSetRuntimeGuard("envoy.reloadable_features.http_stream_arena",
+                                state.range(2) != 0);
+  ConnManagerSpeedTest test(state.range(0), state.range(1) != 0);
+  int64_t stream_bytes = 0;
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    stream_bytes += test.request();
+  }
+  // Only meaningful with a memory allocator that reports the allocated bytes, e.g. tcmalloc.
+  state.counters["stream_bytes"] =
+      benchmark::Counter(stream_bytes, benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_HeaderMutationFilters)
+    ->ArgsProduct({{5, 10, 20}, {0, 1}, {0, 1}})
+    ->ArgNames({"filters", "stateless", "arena"});
+
+} // namespace Http
+} // namespace Envoy
@@ -524,6 +524,29 @@ TEST_F(HttpConnectionManagerImplTest, MaxRequests) {
   conn_manager_->onEvent(Network::ConnectionEvent::RemoteClose);
 }
 
+// Reaching max_requests_per_connection on HTTP/1.1 stops the codec from creating streams for
+// pipelined requests.
+TEST_F(HttpConnectionManagerImplTest, MaxRequestsHttp11StopsPipelinedRequests) {
+  max_requests_per_connection_ = 2;
+  setup();
+
+  EXPECT_CALL(*codec_, dispatch(_)).WillRepeatedly(Invoke([&](Buffer::Instance&) -> Http::Status {
+    conn_manager_->newStream(response_encoder_);
+    return Http::okStatus();
+  }));
+
+  EXPECT_CALL(*codec_, closeAfterActiveStreams()).Times(0);
+  Buffer::OwnedImpl fake_input("hello");
+  conn_manager_->onData(fake_input, false);
+
+  EXPECT_CALL(*codec_, closeAfterActiveStreams());
+  EXPECT_CALL(*codec_, shutdownNotice()).Times(0);
+  conn_manager_->onData(fake_input, false);
+  EXPECT_EQ(1U, stats_.named_.downstream_cx_max_requests_reached_.value());
+
+  conn_manager_->onEvent(Network::ConnectionEvent::RemoteClose);
+}
+
 // max_requests_per_connection is met first then the drain timer fires. Drain timer should be
 // ignored.
 TEST_F(HttpConnectionManagerImplTest, DrainConnectionUponCompletionVsOnDrainTimeoutHttp11) {
@@ -139,6 +139,97 @@ TEST_F(FilterManagerTest, RequestHeadersOrResponseHeadersAccess) {
   filter_manager_->destroyFilters();
 }
 
+// Verifies that filters share the arena of the stream, which outlives the filters.
+TEST_F(FilterManagerTest, StreamArena) {
+  TestScopedRuntime scoped_runtime;
+  scoped_runtime.mergeValues({{"envoy.reloadable_features.http_stream_arena", "true"}});
+  initialize();
+
+  auto decoder_filter = std::make_shared<NiceMock<MockStreamDecoderFilter>>();
+  auto encoder_filter = std::make_shared<NiceMock<MockStreamEncoderFilter>>();
+  EXPECT_CALL(filter_factory_, createFilterChain(_))
+      .WillOnce(Invoke([&](FilterChainManager& manager) -> bool {
+        auto decoder_factory = createDecoderFilterFactoryCb(decoder_filter);
+        manager.applyFilterFactoryCb({}, decoder_factory);
+        auto encoder_factory = createEncoderFilterFactoryCb(encoder_filter);
+        manager.applyFilterFactoryCb({}, encoder_factory);
+        return true;
+      }));
+  filter_manager_->createDownstreamFilterChain();
+
+  struct Counted {
+    explicit Counted(int& destroyed) : destroyed_(destroyed) {}
+    ~Counted() { ++destroyed_; }
+
+    int& destroyed_;
+  };
+  int destroyed = 0;
+  EXPECT_EQ(&decoder_filter->callbacks_->streamArena(),
+            &encoder_filter->callbacks_->streamArena());
+  decoder_filter->callbacks_->streamArena().create<Counted>(destroyed);
+
+  filter_manager_->destroyFilters();
+  EXPECT_EQ(0, destroyed);
+  filter_manager_.reset();
+  EXPECT_EQ(1, destroyed);
+}
+
+// A stateless filter that records the callbacks of every stream it is called for.
+class RecordingStatelessFilter : public StatelessStreamDecoderFilter {
+public:
+  FilterHeadersStatus decodeHeaders(StreamDecoderFilterCallbacks& callbacks, RequestHeaderMap&,
+                                    bool) const override {
+    callbacks_.push_back(&callbacks);
+    return FilterHeadersStatus::Continue;
+  }
+
+  mutable std::vector<StreamDecoderFilterCallbacks*> callbacks_;
+};
+
+// Verifies that a single stateless filter serves several streams, with the callbacks of each
+// stream.
+TEST_F(FilterManagerTest, StatelessFilterSharedAcrossStreams) {
+  for (const bool use_stream_arena : {false, true}) {
+    TestScopedRuntime scoped_runtime;
+    scoped_runtime.mergeValues(
+        {{"envoy.reloadable_features.http_stream_arena", use_stream_arena ? "true" : "false"}});
+    auto stateless_filter = std::make_shared<RecordingStatelessFilter>();
+    FilterFactoryCb stateless_factory = [stateless_filter](FilterChainFactoryCallbacks& callbacks) {
+      callbacks.addStatelessStreamDecoderFilter(stateless_filter);
+    };
+    RequestHeaderMapPtr headers{
+        new TestRequestHeaderMapImpl{{":authority", "host"}, {":path", "/"}, {":method", "GET"}}};
+    ON_CALL(filter_manager_callbacks_, requestHeaders())
+        .WillByDefault(Return(makeOptRef(*headers)));
+
+    for (size_t i = 0; i < 2; ++i) {
+      initialize();
+      auto decoder_filter = std::make_shared<NiceMock<MockStreamDecoderFilter>>();
+      EXPECT_CALL(filter_factory_, createFilterChain(_))
+          .WillOnce(Invoke([&](FilterChainManager& manager) -> bool {
+            manager.applyFilterFactoryCb({"stateless"}, stateless_factory);
+            auto decoder_factory = createDecoderFilterFactoryCb(decoder_filter);
+            manager.applyFilterFactoryCb({"decoder"}, decoder_factory);
+            return true;
+          }));
+      filter_manager_->createDownstreamFilterChain();
+      filter_manager_->requestHeadersInitialized();
+
+      // Iteration continues with the next filter.
+      EXPECT_CALL(*decoder_filter, decodeHeaders(_, true))
+          .WillOnce(Return(FilterHeadersStatus::StopIteration));
+      filter_manager_->decodeHeaders(*headers, true);
+      ASSERT_EQ(i + 1, stateless_filter->callbacks_.size());
+      EXPECT_EQ("stateless", stateless_filter->callbacks_.back()->filterConfigName());
+
+      filter_manager_->destroyFilters();
+      filter_manager_.reset();
+    }
+    // Streams only keep the filter alive while they exist.
+    EXPECT_EQ(2, stateless_filter.use_count());
+  }
+}
+
 // Verifies that the local reply persists the gRPC classification even if the request headers are
 // modified.
 TEST_F(FilterManagerTest, SendLocalReplyDuringDecodingGrpcClassiciation) {
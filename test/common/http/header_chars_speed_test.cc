@@ -0,0 +1,132 @@
+// Note: this should be run with --compilation_mode=opt, and would benefit from a
+// quiescent system with disabled cstate power management.
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "source/common/common/macros.h"
+#include "source/common/http/header_chars.h"
+
+#include "benchmark/benchmark.h"
+
+namespace Envoy {
+namespace Http {
+namespace {
+
+using HeaderSet = std::vector<std::pair<std::string, std::string>>;
+
+// Request headers as sent by a browser over HTTP/1.1, with the original case of the names.
+const HeaderSet& browserHeaders() {
+  CONSTRUCT_ON_FIRST_USE(
+      HeaderSet,
+      {{"Host", "www.example.com"},
+       {"Connection", "keep-alive"},
+       {"Cache-Control", "max-age=0"},
+       {"sec-ch-ua",
+        "\"Chromium\";v=\"124\", \"Google Chrome\";v=\"124\", \"Not-A.Brand\";v=\"99\""},
+       {"sec-ch-ua-mobile", "?0"},
+       {"sec-ch-ua-platform", "\"Linux\""},
+       {"Upgrade-Insecure-Requests", "1"},
+       {"User-Agent", "Mozilla/5.0 (X11; Linux x86_64) AppleWebKit/537.36 (KHTML, like Gecko) "
+                      "Chrome/124.0.0.0 Safari/537.36"},
+       {"Accept", "text/html,application/xhtml+xml,application/xml;q=0.9,image/avif,image/webp,"
+                  "image/apng,*/*;q=0.8,application/signed-exchange;v=b3;q=0.7"},
+       {"Sec-Fetch-Site", "same-origin"},
+       {"Sec-Fetch-Mode", "navigate"},
+       {"Sec-Fetch-User", "?1"},
+       {"Sec-Fetch-Dest", "document"},
+       {"Referer", "https://www.example.com/products/category/electronics?page=2&sort=price"},
+       {"Accept-Encoding", "gzip, deflate, br, zstd"},
+       {"Accept-Language", "en-US,en;q=0.9,de;q=0.8"},
+       {"Cookie", "session_id=3f2a9c1e7b4d4e6f8a0b1c2d3e4f5a6b; theme=dark; "
+                  "_ga=GA1.1.1234567890.1700000000; consent=analytics%3Dtrue%26ads%3Dfalse"},
+       {"If-None-Match", "W/\"5f3c-18f2a7b9c40\""},
+       {"If-Modified-Since", "Tue, 14 May 2024 08:12:31 GMT"},
+       {"X-Requested-With", "XMLHttpRequest"}});
+}
+
+// Request headers of a unary gRPC call, without the ':' prefix of the pseudo headers.
+const HeaderSet& grpcHeaders() {
+  CONSTRUCT_ON_FIRST_USE(HeaderSet,
+                         {{"method", "POST"},
+                          {"scheme", "http"},
+                          {"path", "/envoy.service.discovery.v3.AggregatedDiscoveryService/"
+                                   "StreamAggregatedResources"},
+                          {"authority", "xds.example.internal:18000"},
+                          {"content-type", "application/grpc"},
+                          {"te", "trailers"},
+                          {"grpc-accept-encoding", "identity,deflate,gzip"},
+                          {"grpc-timeout", "4999877u"},
+                          {"user-agent", "grpc-c++/1.62.0 grpc-c/39.0.0 (linux; chttp2)"},
+                          {"x-request-id", "6c1f3d0e-8b2a-4f7e-9c5d-1a2b3c4d5e6f"},
+                          {"traceparent",
+                           "00-0af7651916cd43dd8448eb211c80319c-b7ad6b7169203331-01"},
+                          {"x-envoy-expected-rq-timeout-ms", "5000"}});
+}
+
+const HeaderSet& headerSet(int64_t index) {
+  return index == 0 ? browserHeaders() : grpcHeaders();
+}
+
+} // namespace
+
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void BM_ValidateNames(benchmark::State& state) {
+  const HeaderSet& headers = headerSet(state.range(0));
+  const bool scalar = state.range(1) != 0;
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    for (const auto& header : headers) {
+      benchmark::DoNotOptimize(scalar ? HeaderChars::isValidNameScalar(header.first)
+                                      : HeaderChars::isValidName(header.first));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * headers.size());
+}
+BENCHMARK(BM_ValidateNames)->ArgsProduct({{0, 1}, {0, 1}})->ArgNames({"grpc", "scalar"});
+
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void BM_ValidateValues(benchmark::State& state) {
+  const HeaderSet& headers = headerSet(state.range(0));
+  const bool scalar = state.range(1) != 0;
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    for (const auto& header : headers) {
+      benchmark::DoNotOptimize(scalar ? HeaderChars::isValidValueScalar(header.second)
+                                      : HeaderChars::isValidValue(header.second));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * headers.size());
+}
+BENCHMARK(BM_ValidateValues)->ArgsProduct({{0, 1}, {0, 1}})->ArgNames({"grpc", "scalar"});
+
+// Lower cases the names in the same way as the HTTP/1 codec does for every received header.
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void BM_LowerNames(benchmark::State& state) {
+  const HeaderSet& headers = headerSet(state.range(0));
+  const bool scalar = state.range(1) != 0;
+  std::vector<std::string> names;
+  for (const auto& header : headers) {
+    names.push_back(header.first);
+  }
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    for (size_t i = 0; i < names.size(); ++i) {
+      std::string& name = names[i];
+      // Restore the original case, so every iteration converts the same names.
+      name.assign(headers[i].first);
+      if (scalar) {
+        HeaderChars::toLowerScalar(name.data(), name.size());
+      } else {
+        HeaderChars::toLower(name.data(), name.size());
+      }
+      benchmark::DoNotOptimize(name.data());
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * headers.size());
+}
+BENCHMARK(BM_LowerNames)->ArgsProduct({{0, 1}, {0, 1}})->ArgNames({"grpc", "scalar"});
+
+} // namespace Http
+} // namespace Envoy
@@ -0,0 +1,66 @@
+#include <string>
+
+#include "source/common/http/header_chars.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Http {
+namespace {
+
+TEST(HeaderCharsTest, Name) {
+  EXPECT_TRUE(HeaderChars::isValidName(""));
+  EXPECT_TRUE(HeaderChars::isValidName("content-type"));
+  EXPECT_TRUE(HeaderChars::isValidName("X-Custom_Header!#$%&'*+.^`|~0123456789"));
+  EXPECT_FALSE(HeaderChars::isValidName("content type"));
+  EXPECT_FALSE(HeaderChars::isValidName("content:type"));
+  EXPECT_FALSE(HeaderChars::isValidName("x-a-header-name-that-is-long-enough-for-all-blocks\x80"));
+}
+
+TEST(HeaderCharsTest, Value) {
+  EXPECT_TRUE(HeaderChars::isValidValue(""));
+  EXPECT_TRUE(HeaderChars::isValidValue("text/html, application/xhtml+xml;q=0.9\t*/*;q=0.8"));
+  EXPECT_TRUE(HeaderChars::isValidValue("obs-text \x80\xff"));
+  EXPECT_FALSE(HeaderChars::isValidValue("a value that is long enough for all blocks\x7f"));
+  EXPECT_FALSE(HeaderChars::isValidValue(absl::string_view("nul\0", 4)));
+  EXPECT_FALSE(HeaderChars::isValidValue("line\r\nbreak"));
+}
+
+TEST(HeaderCharsTest, ToLower) {
+  std::string value = "Content-Type: Text/HTML @[`{ \xc0\xda";
+  HeaderChars::toLower(value.data(), value.size());
+  EXPECT_EQ("content-type: text/html @[`{ \xc0\xda", value);
+}
+
+// The vectorized versions process blocks of 8, 16 or 32 bytes, with an overlapping block at the
+// end of the string. Place every byte value at every position of strings of every length up to
+// several blocks, and compare the results with the scalar versions.
+TEST(HeaderCharsTest, MatchesScalar) {
+  constexpr absl::string_view filler = "aZ-9x";
+  for (size_t size = 1; size <= 100; ++size) {
+    std::string base(size, 'a');
+    for (size_t i = 0; i < size; ++i) {
+      base[i] = filler[i % filler.size()];
+    }
+    for (size_t position = 0; position < size; ++position) {
+      for (int byte = 0; byte < 256; ++byte) {
+        std::string value = base;
+        value[position] = static_cast<char>(byte);
+        ASSERT_EQ(HeaderChars::isValidNameScalar(value), HeaderChars::isValidName(value))
+            << "size " << size << " position " << position << " byte " << byte;
+        ASSERT_EQ(HeaderChars::isValidValueScalar(value), HeaderChars::isValidValue(value))
+            << "size " << size << " position " << position << " byte " << byte;
+
+        std::string expected = value;
+        HeaderChars::toLowerScalar(expected.data(), expected.size());
+        HeaderChars::toLower(value.data(), value.size());
+        ASSERT_EQ(expected, value) << "size " << size << " position " << position << " byte "
+                                   << byte;
+      }
+    }
+  }
+}
+
+} // namespace
+} // namespace Http
+} // namespace Envoy
@@ -1,8 +1,10 @@
 #include "source/common/http/header_map_impl.h"
 #include "source/common/http/headers.h"
+#include "source/common/runtime/runtime_features.h"
 
 #include "test/test_common/utility.h"
 
+#include "absl/flags/reflection.h"
 #include "benchmark/benchmark.h"
 
 namespace Envoy {
@@ -21,6 +23,9 @@ static void addDummyHeaders(HeaderMap& headers, size_t num_headers,
 
 /** Measure the construction/destruction speed of RequestHeaderMapImpl.*/
 static void headerMapImplCreate(benchmark::State& state) {
+  absl::FlagSaver flag_saver;
+  Runtime::maybeSetRuntimeGuard("envoy.reloadable_features.http_stream_arena",
+                                state.range(0) != 0);
   // Make sure first time construction is not counted.
   Http::ResponseHeaderMapImpl::create();
   for (auto _ : state) { // NOLINT
@@ -28,7 +33,7 @@ static void headerMapImplCreate(benchmark::State& state) {
     benchmark::DoNotOptimize(headers->size());
   }
 }
-BENCHMARK(headerMapImplCreate);
+BENCHMARK(headerMapImplCreate)->Arg(0)->Arg(1)->ArgName("slabs");
 
 /**
  * Measure the speed of setting/overwriting a header value. The numeric Arg passed
@@ -200,6 +205,9 @@ static void headerMapImplPopulate(benchmark::State& state) {
       {LowerCaseString("set-cookie"), "_cookie1=12345678; path = /; secure"},
       {LowerCaseString("set-cookie"), "_cookie2=12345678; path = /; secure"},
   };
+  absl::FlagSaver flag_saver;
+  Runtime::maybeSetRuntimeGuard("envoy.reloadable_features.http_stream_arena",
+                                state.range(0) != 0);
   for (auto _ : state) { // NOLINT
     auto headers = Http::ResponseHeaderMapImpl::create();
     for (const auto& key_value : headers_to_add) {
@@ -208,7 +216,25 @@ static void headerMapImplPopulate(benchmark::State& state) {
     benchmark::DoNotOptimize(headers->size());
   }
 }
-BENCHMARK(headerMapImplPopulate);
+BENCHMARK(headerMapImplPopulate)->Arg(0)->Arg(1)->ArgName("slabs");
+
+/**
+ * Measure the speed of copying a HeaderMapImpl, as done e.g. for retries and request mirroring.
+ */
+static void headerMapImplCopy(benchmark::State& state) {
+  absl::FlagSaver flag_saver;
+  Runtime::maybeSetRuntimeGuard("envoy.reloadable_features.http_stream_arena",
+                                state.range(1) != 0);
+  auto headers = Http::RequestHeaderMapImpl::create();
+  addDummyHeaders(*headers, state.range(0));
+  for (auto _ : state) { // NOLINT
+    auto copy = createHeaderMap<RequestHeaderMapImpl>(*headers);
+    benchmark::DoNotOptimize(copy->size());
+  }
+}
+BENCHMARK(headerMapImplCopy)
+    ->ArgsProduct({{0, 1, 5, 10, 50}, {0, 1}})
+    ->ArgNames({"headers", "slabs"});
 
 /**
  * Measure the speed of encoding headers as part of upgraded requests (HTTP/1 to HTTP/2)
@@ -64,6 +64,14 @@ TEST(HeaderStringTest, All) {
     EXPECT_TRUE(to_move.empty()); // NOLINT(bugprone-use-after-move)
     EXPECT_EQ("HELLO", string.getStringView());
   }
+
+  // Inline lower case conversion.
+  {
+    HeaderString string;
+    string.setCopy("X-Forwarded-For-Some-Very-Long-Header-Name_01");
+    string.inlineToLower();
+    EXPECT_EQ("x-forwarded-for-some-very-long-header-name_01", string.getStringView());
+  }
 }
 
 Http::RegisterCustomInlineHeader<Http::CustomInlineHeaderRegistry::Type::RequestHeaders>
@@ -134,6 +142,37 @@ TEST(HeaderMapImplTest, InlineInsert) {
   EXPECT_EQ("hello", headers.get(Headers::get().Host)[0]->value().getStringView());
 }
 
+// With envoy.reloadable_features.http_stream_arena the entries live in slabs of the map. Entries
+// must not move while other entries are added, removed and reused.
+TEST(HeaderMapImplTest, SlabAllocatedEntries) {
+  TestScopedRuntime scoped_runtime;
+  scoped_runtime.mergeValues({{"envoy.reloadable_features.http_stream_arena", "true"}});
+
+  TestRequestHeaderMapImpl headers;
+  headers.setHost("host");
+  const HeaderEntry* host = headers.Host();
+  for (int i = 0; i < 100; ++i) {
+    headers.addCopy(LowerCaseString(absl::StrCat("x-header-", i)), absl::StrCat(i));
+  }
+  headers.removePrefix(LowerCaseString("x-header-1"));
+  for (int i = 0; i < 10; ++i) {
+    headers.addCopy(LowerCaseString(absl::StrCat("x-other-", i)), "value");
+  }
+  EXPECT_EQ(host, headers.Host());
+  EXPECT_EQ("host", headers.getHostValue());
+  EXPECT_EQ(100, headers.size());
+  EXPECT_EQ("99", headers.get(LowerCaseString("x-header-99"))[0]->value().getStringView());
+
+  auto copy = createHeaderMap<RequestHeaderMapImpl>(headers);
+  EXPECT_EQ(100, copy->size());
+  EXPECT_EQ("99", copy->get(LowerCaseString("x-header-99"))[0]->value().getStringView());
+  headers.clear();
+  EXPECT_TRUE(headers.empty());
+  headers.setHost("other");
+  EXPECT_EQ("other", headers.getHostValue());
+  EXPECT_EQ("host", copy->getHostValue());
+}
+
 TEST(HeaderMapImplTest, InlineAppend) {
   {
     TestRequestHeaderMapImpl headers;
@@ -3595,6 +3595,276 @@ TEST_F(Http1ServerConnectionImplTest, PipedRequestWithMutipleEvent) {
   connection_.dispatcher_.clearDeferredDeleteList();
 }
 
+// With pipelining enabled, pipelined requests are dispatched without waiting for the earlier
+// responses, and the responses are written in request order.
+TEST_F(Http1ServerConnectionImplTest, PipelinedRequestsDispatchedConcurrently) {
+  codec_settings_.max_pipelined_requests_ = 3;
+  initialize();
+
+  NiceMock<MockRequestDecoder> decoder;
+  std::vector<Http::ResponseEncoder*> response_encoders;
+  EXPECT_CALL(callbacks_, newStream(_, _))
+      .Times(3)
+      .WillRepeatedly(Invoke([&](ResponseEncoder& encoder, bool) -> RequestDecoder& {
+        response_encoders.push_back(&encoder);
+        return decoder;
+      }));
+  EXPECT_CALL(decoder, decodeHeaders_(_, true)).Times(3);
+  EXPECT_CALL(connection_, readDisable(true)).Times(0);
+
+  Buffer::OwnedImpl buffer("GET /a HTTP/1.1\r\nhost: a.com\r\n\r\n"
+                           "GET /b HTTP/1.1\r\nhost: a.com\r\n\r\n"
+                           "GET /c HTTP/1.1\r\nhost: a.com\r\n\r\n");
+  auto status = codec_->dispatch(buffer);
+  EXPECT_TRUE(status.ok());
+  EXPECT_EQ(0, buffer.length());
+  ASSERT_EQ(3, response_encoders.size());
+  EXPECT_EQ(2, store_.counter("http1.pipelined_requests").value());
+  EXPECT_EQ(2, store_.gauge("http1.pipelined_responses_held", Stats::Gauge::ImportMode::Accumulate)
+                   .value());
+
+  std::string output;
+  ON_CALL(connection_, write(_, _)).WillByDefault(AddBufferToString(&output));
+
+  // The responses to the second and third request are held until the first one is written.
+  TestResponseHeaderMapImpl headers{{":status", "200"}};
+  response_encoders[2]->encodeHeaders(headers, true);
+  TestResponseHeaderMapImpl not_found{{":status", "404"}};
+  response_encoders[1]->encodeHeaders(not_found, false);
+  EXPECT_EQ("", output);
+  EXPECT_EQ(1, store_.counter("http1.pipelined_responses_buffered").value());
+
+  response_encoders[0]->encodeHeaders(headers, true);
+  EXPECT_EQ("HTTP/1.1 200 OK\r\ncontent-length: 0\r\n\r\n"
+            "HTTP/1.1 404 Not Found\r\ntransfer-encoding: chunked\r\n\r\n",
+            output);
+  EXPECT_EQ(1, store_.gauge("http1.pipelined_responses_held", Stats::Gauge::ImportMode::Accumulate)
+                   .value());
+
+  Buffer::OwnedImpl data("body");
+  response_encoders[1]->encodeData(data, true);
+  EXPECT_EQ("HTTP/1.1 200 OK\r\ncontent-length: 0\r\n\r\n"
+            "HTTP/1.1 404 Not Found\r\ntransfer-encoding: chunked\r\n\r\n"
+            "4\r\nbody\r\n0\r\n\r\n"
+            "HTTP/1.1 200 OK\r\ncontent-length: 0\r\n\r\n",
+            output);
+  EXPECT_EQ(0, store_.gauge("http1.pipelined_responses_held", Stats::Gauge::ImportMode::Accumulate)
+                   .value());
+  connection_.dispatcher_.clearDeferredDeleteList();
+}
+
+// Reading is disabled once the pipeline is full, and re-enabled when the head of the pipeline
+// completes.
+TEST_F(Http1ServerConnectionImplTest, PipelinedRequestsReadDisabledWhenFull) {
+  codec_settings_.max_pipelined_requests_ = 2;
+  initialize();
+
+  NiceMock<MockRequestDecoder> decoder;
+  std::vector<Http::ResponseEncoder*> response_encoders;
+  ON_CALL(callbacks_, newStream(_, _))
+      .WillByDefault(Invoke([&](ResponseEncoder& encoder, bool) -> RequestDecoder& {
+        response_encoders.push_back(&encoder);
+        return decoder;
+      }));
+
+  EXPECT_CALL(connection_, readDisable(true));
+  Buffer::OwnedImpl buffer("GET /a HTTP/1.1\r\nhost: a.com\r\n\r\n"
+                           "GET /b HTTP/1.1\r\nhost: a.com\r\n\r\n"
+                           "GET /c HTTP/1.1\r\nhost: a.com\r\n\r\n");
+  auto status = codec_->dispatch(buffer);
+  EXPECT_TRUE(status.ok());
+  ASSERT_EQ(2, response_encoders.size());
+  // The third request is not consumed.
+  EXPECT_NE(0, buffer.length());
+
+  std::string output;
+  ON_CALL(connection_, write(_, _)).WillByDefault(AddBufferToString(&output));
+  TestResponseHeaderMapImpl headers{{":status", "200"}};
+  response_encoders[0]->encodeHeaders(headers, true);
+
+  EXPECT_CALL(connection_, readDisable(false));
+  connection_.dispatcher_.clearDeferredDeleteList();
+
+  status = codec_->dispatch(buffer);
+  EXPECT_TRUE(status.ok());
+  EXPECT_EQ(0, buffer.length());
+  EXPECT_EQ(3, response_encoders.size());
+
+  response_encoders[2]->encodeHeaders(headers, true);
+  response_encoders[1]->encodeHeaders(headers, true);
+  EXPECT_EQ("HTTP/1.1 200 OK\r\ncontent-length: 0\r\n\r\n"
+            "HTTP/1.1 200 OK\r\ncontent-length: 0\r\n\r\n"
+            "HTTP/1.1 200 OK\r\ncontent-length: 0\r\n\r\n",
+            output);
+  connection_.dispatcher_.clearDeferredDeleteList();
+}
+
+// The held responses of a connection share its buffer limit, so the watermark callbacks run once
+// their total output exceeds it even if each response is below it.
+TEST_F(Http1ServerConnectionImplTest, PipelinedResponsesShareBufferLimit) {
+  codec_settings_.max_pipelined_requests_ = 3;
+  ON_CALL(connection_, bufferLimit()).WillByDefault(Return(80));
+  initialize();
+
+  NiceMock<MockRequestDecoder> decoder;
+  std::vector<Http::ResponseEncoder*> response_encoders;
+  ON_CALL(callbacks_, newStream(_, _))
+      .WillByDefault(Invoke([&](ResponseEncoder& encoder, bool) -> RequestDecoder& {
+        response_encoders.push_back(&encoder);
+        return decoder;
+      }));
+
+  Buffer::OwnedImpl buffer("GET /a HTTP/1.1\r\nhost: a.com\r\n\r\n"
+                           "GET /b HTTP/1.1\r\nhost: a.com\r\n\r\n"
+                           "GET /c HTTP/1.1\r\nhost: a.com\r\n\r\n");
+  auto status = codec_->dispatch(buffer);
+  EXPECT_TRUE(status.ok());
+  ASSERT_EQ(3, response_encoders.size());
+
+  Http::MockStreamCallbacks second_callbacks;
+  Http::MockStreamCallbacks third_callbacks;
+  response_encoders[1]->getStream().addCallbacks(second_callbacks);
+  response_encoders[2]->getStream().addCallbacks(third_callbacks);
+
+  std::string output;
+  ON_CALL(connection_, write(_, _)).WillByDefault(AddBufferToString(&output));
+
+  // Each held response is 47 bytes, below the limit of 80 bytes, but both together exceed it.
+  TestResponseHeaderMapImpl headers{{":status", "200"}};
+  EXPECT_CALL(second_callbacks, onAboveWriteBufferHighWatermark()).Times(0);
+  response_encoders[1]->encodeHeaders(headers, false);
+  EXPECT_CALL(second_callbacks, onAboveWriteBufferHighWatermark());
+  EXPECT_CALL(third_callbacks, onAboveWriteBufferHighWatermark());
+  response_encoders[2]->encodeHeaders(headers, false);
+  EXPECT_EQ("", output);
+
+  // Writing the output of the second response releases it from the shared limit. The output still
+  // held is above half of the limit, so the third response stays above the high watermark.
+  EXPECT_CALL(second_callbacks, onBelowWriteBufferLowWatermark());
+  EXPECT_CALL(third_callbacks, onBelowWriteBufferLowWatermark()).Times(0);
+  response_encoders[0]->encodeHeaders(headers, true);
+  EXPECT_NE("", output);
+
+  EXPECT_CALL(third_callbacks, onBelowWriteBufferLowWatermark());
+  Buffer::OwnedImpl data("body");
+  response_encoders[1]->encodeData(data, true);
+  response_encoders[2]->encodeData(data, true);
+  connection_.dispatcher_.clearDeferredDeleteList();
+}
+
+// Resetting any of the pipelined streams resets all of them.
+TEST_F(Http1ServerConnectionImplTest, PipelinedRequestsReset) {
+  codec_settings_.max_pipelined_requests_ = 2;
+  initialize();
+
+  NiceMock<MockRequestDecoder> decoder;
+  std::vector<Http::ResponseEncoder*> response_encoders;
+  ON_CALL(callbacks_, newStream(_, _))
+      .WillByDefault(Invoke([&](ResponseEncoder& encoder, bool) -> RequestDecoder& {
+        response_encoders.push_back(&encoder);
+        return decoder;
+      }));
+
+  Buffer::OwnedImpl buffer("GET /a HTTP/1.1\r\nhost: a.com\r\n\r\n"
+                           "GET /b HTTP/1.1\r\nhost: a.com\r\n\r\n");
+  auto status = codec_->dispatch(buffer);
+  EXPECT_TRUE(status.ok());
+  ASSERT_EQ(2, response_encoders.size());
+
+  Http::MockStreamCallbacks first_callbacks;
+  Http::MockStreamCallbacks second_callbacks;
+  response_encoders[0]->getStream().addCallbacks(first_callbacks);
+  response_encoders[1]->getStream().addCallbacks(second_callbacks);
+  EXPECT_CALL(first_callbacks, onResetStream(StreamResetReason::LocalReset, _));
+  EXPECT_CALL(second_callbacks, onResetStream(StreamResetReason::LocalReset, _));
+  response_encoders[1]->getStream().resetStream(StreamResetReason::LocalReset);
+  EXPECT_EQ(0, store_.gauge("http1.pipelined_responses_held", Stats::Gauge::ImportMode::Accumulate)
+                   .value());
+  connection_.dispatcher_.clearDeferredDeleteList();
+}
+
+// No requests are parsed behind a request that closes the connection.
+TEST_F(Http1ServerConnectionImplTest, PipelinedRequestsStopAfterConnectionClose) {
+  codec_settings_.max_pipelined_requests_ = 3;
+  initialize();
+
+  NiceMock<MockRequestDecoder> decoder;
+  EXPECT_CALL(callbacks_, newStream(_, _)).Times(2).WillRepeatedly(ReturnRef(decoder));
+
+  Buffer::OwnedImpl buffer("GET /a HTTP/1.1\r\nhost: a.com\r\n\r\n"
+                           "GET /b HTTP/1.1\r\nhost: a.com\r\nconnection: close\r\n\r\n"
+                           "GET /c HTTP/1.1\r\nhost: a.com\r\n\r\n");
+  EXPECT_CALL(connection_, readDisable(true)).Times(2);
+  auto status = codec_->dispatch(buffer);
+  EXPECT_TRUE(status.ok());
+  EXPECT_EQ("GET /c HTTP/1.1\r\nhost: a.com\r\n\r\n", buffer.toString());
+
+  // Further data is not parsed either.
+  status = codec_->dispatch(buffer);
+  EXPECT_TRUE(status.ok());
+  EXPECT_NE(0, buffer.length());
+}
+
+// Likewise for an HTTP/1.0 request without keep-alive.
+TEST_F(Http1ServerConnectionImplTest, PipelinedRequestsStopAfterHttp10) {
+  codec_settings_.accept_http_10_ = true;
+  codec_settings_.max_pipelined_requests_ = 3;
+  initialize();
+
+  NiceMock<MockRequestDecoder> decoder;
+  EXPECT_CALL(callbacks_, newStream(_, _)).Times(2).WillRepeatedly(ReturnRef(decoder));
+
+  Buffer::OwnedImpl buffer("GET /a HTTP/1.0\r\nhost: a.com\r\nconnection: keep-alive\r\n\r\n"
+                           "GET /b HTTP/1.0\r\nhost: a.com\r\n\r\n"
+                           "GET /c HTTP/1.0\r\nhost: a.com\r\n\r\n");
+  auto status = codec_->dispatch(buffer);
+  EXPECT_TRUE(status.ok());
+  EXPECT_EQ("GET /c HTTP/1.0\r\nhost: a.com\r\n\r\n", buffer.toString());
+}
+
+// No requests are parsed behind the request being parsed when the connection starts closing.
+TEST_F(Http1ServerConnectionImplTest, PipelinedRequestsStopAfterCloseAfterActiveStreams) {
+  codec_settings_.max_pipelined_requests_ = 3;
+  initialize();
+
+  NiceMock<MockRequestDecoder> decoder;
+  uint32_t streams = 0;
+  EXPECT_CALL(callbacks_, newStream(_, _))
+      .Times(2)
+      .WillRepeatedly(Invoke([&](ResponseEncoder&, bool) -> RequestDecoder& {
+        // Mimic the connection manager reaching max_requests_per_connection.
+        if (++streams == 2) {
+          codec_->closeAfterActiveStreams();
+        }
+        return decoder;
+      }));
+
+  Buffer::OwnedImpl buffer("GET /a HTTP/1.1\r\nhost: a.com\r\n\r\n"
+                           "GET /b HTTP/1.1\r\nhost: a.com\r\n\r\n"
+                           "GET /c HTTP/1.1\r\nhost: a.com\r\n\r\n");
+  auto status = codec_->dispatch(buffer);
+  EXPECT_TRUE(status.ok());
+  EXPECT_EQ("GET /c HTTP/1.1\r\nhost: a.com\r\n\r\n", buffer.toString());
+}
+
+// Upgrades cannot be pipelined behind other requests.
+TEST_F(Http1ServerConnectionImplTest, PipelinedUpgradeRejected) {
+  codec_settings_.max_pipelined_requests_ = 2;
+  initialize();
+
+  NiceMock<MockRequestDecoder> decoder;
+  EXPECT_CALL(callbacks_, newStream(_, _)).Times(2).WillRepeatedly(ReturnRef(decoder));
+  EXPECT_CALL(decoder, sendLocalReply(Http::Code::BadRequest, "Bad Request", _, _,
+                                      "http1.pipelined_upgrade"));
+
+  Buffer::OwnedImpl buffer(
+      "GET /a HTTP/1.1\r\nhost: a.com\r\n\r\n"
+      "GET /b HTTP/1.1\r\nhost: a.com\r\nconnection: upgrade\r\nupgrade: foo\r\n\r\n");
+  auto status = codec_->dispatch(buffer);
+  EXPECT_TRUE(isCodecProtocolError(status));
+  EXPECT_EQ(status.message(), "http/1.1 protocol error: pipelined upgrade request");
+}
+
 TEST_F(Http1ServerConnectionImplTest, Utf8Path) {
   initialize();
 
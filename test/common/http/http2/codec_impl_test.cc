@@ -626,6 +626,127 @@ TEST_P(Http2CodecImplTest, SimpleRequestResponse) {
   }
 }
 
+// Frames of the response are held back until the flush callback runs, and are then written to the
+// connection at once.
+TEST_P(Http2CodecImplTest, WriteCoalescing) {
+  server_http2_options_.mutable_write_coalescing();
+  auto* flush_callback =
+      new NiceMock<Event::MockSchedulableCallback>(&server_connection_.dispatcher_);
+  initialize();
+
+  TestRequestHeaderMapImpl request_headers;
+  HttpTestUtility::addDefaultHeaders(request_headers);
+  EXPECT_CALL(request_decoder_, decodeHeaders_(_, false));
+  EXPECT_TRUE(request_encoder_->encodeHeaders(request_headers, false).ok());
+  driveToCompletion();
+  EXPECT_FALSE(flush_callback->enabled_);
+
+  TestResponseHeaderMapImpl response_headers{{":status", "200"}};
+  response_encoder_->encodeHeaders(response_headers, false);
+  Buffer::OwnedImpl response_body(std::string(1024, 'b'));
+  response_encoder_->encodeData(response_body, false);
+  EXPECT_TRUE(flush_callback->enabled_);
+  EXPECT_EQ(0, client_wrapper_->buffer_.length());
+
+  EXPECT_CALL(response_decoder_, decodeHeaders_(_, false));
+  EXPECT_CALL(response_decoder_, decodeData(_, false));
+  flush_callback->invokeCallback();
+  EXPECT_NE(0, client_wrapper_->buffer_.length());
+  driveToCompletion();
+  // The SETTINGS frames sent before the stream was opened were written right away.
+  EXPECT_LE(2, server_stats_store_.histogramValues("http2.frames_per_write", false).back());
+
+  // Once the last stream is closed frames are written right away.
+  EXPECT_CALL(request_decoder_, decodeData(_, true));
+  Buffer::OwnedImpl request_body;
+  request_encoder_->encodeData(request_body, true);
+  driveToCompletion();
+  EXPECT_CALL(response_decoder_, decodeData(_, true));
+  response_encoder_->encodeData(response_body, true);
+  EXPECT_FALSE(flush_callback->enabled_);
+  driveToCompletion();
+  EXPECT_TRUE(client_wrapper_->status_.ok());
+  EXPECT_TRUE(server_wrapper_->status_.ok());
+}
+
+// With a max_delay the coalesced frames are written when the flush timer fires, without any other
+// flush.
+TEST_P(Http2CodecImplTest, WriteCoalescingMaxDelay) {
+  server_http2_options_.mutable_write_coalescing()->mutable_max_delay()->set_nanos(5000000);
+  auto* flush_timer = new NiceMock<Event::MockTimer>(&server_connection_.dispatcher_);
+  initialize();
+
+  TestRequestHeaderMapImpl request_headers;
+  HttpTestUtility::addDefaultHeaders(request_headers);
+  EXPECT_CALL(request_decoder_, decodeHeaders_(_, false));
+  EXPECT_TRUE(request_encoder_->encodeHeaders(request_headers, false).ok());
+  driveToCompletion();
+  EXPECT_FALSE(flush_timer->enabled_);
+
+  // The timer is armed by the first held frame and not re-armed by later ones.
+  EXPECT_CALL(*flush_timer, enableTimer(std::chrono::milliseconds(5), _));
+  TestResponseHeaderMapImpl response_headers{{":status", "200"}};
+  response_encoder_->encodeHeaders(response_headers, false);
+  Buffer::OwnedImpl response_body(std::string(1024, 'b'));
+  response_encoder_->encodeData(response_body, false);
+  EXPECT_TRUE(flush_timer->enabled_);
+  EXPECT_EQ(0, client_wrapper_->buffer_.length());
+
+  EXPECT_CALL(response_decoder_, decodeHeaders_(_, false));
+  EXPECT_CALL(response_decoder_, decodeData(_, false));
+  flush_timer->invokeCallback();
+  EXPECT_NE(0, client_wrapper_->buffer_.length());
+  driveToCompletion();
+  EXPECT_LE(2, server_stats_store_.histogramValues("http2.frames_per_write", false).back());
+  testing::Mock::VerifyAndClearExpectations(flush_timer);
+
+  EXPECT_CALL(request_decoder_, decodeData(_, true));
+  Buffer::OwnedImpl request_body;
+  request_encoder_->encodeData(request_body, true);
+  driveToCompletion();
+  EXPECT_CALL(response_decoder_, decodeData(_, true));
+  response_encoder_->encodeData(response_body, true);
+  driveToCompletion();
+  EXPECT_TRUE(client_wrapper_->status_.ok());
+  EXPECT_TRUE(server_wrapper_->status_.ok());
+}
+
+// Once max_bytes are held the coalesced frames are written right away, and the pending flush timer
+// is cancelled.
+TEST_P(Http2CodecImplTest, WriteCoalescingMaxBytes) {
+  auto* write_coalescing = server_http2_options_.mutable_write_coalescing();
+  write_coalescing->mutable_max_bytes()->set_value(1024);
+  write_coalescing->mutable_max_delay()->set_seconds(1);
+  auto* flush_timer = new NiceMock<Event::MockTimer>(&server_connection_.dispatcher_);
+  initialize();
+
+  TestRequestHeaderMapImpl request_headers;
+  HttpTestUtility::addDefaultHeaders(request_headers);
+  EXPECT_CALL(request_decoder_, decodeHeaders_(_, false));
+  EXPECT_TRUE(request_encoder_->encodeHeaders(request_headers, false).ok());
+  driveToCompletion();
+
+  TestResponseHeaderMapImpl response_headers{{":status", "200"}};
+  response_encoder_->encodeHeaders(response_headers, false);
+  EXPECT_TRUE(flush_timer->enabled_);
+  EXPECT_EQ(0, client_wrapper_->buffer_.length());
+
+  // The body brings the held frames to max_bytes, so they are written without waiting for the
+  // timer.
+  EXPECT_CALL(*flush_timer, disableTimer());
+  Buffer::OwnedImpl response_body(std::string(1024, 'b'));
+  response_encoder_->encodeData(response_body, false);
+  EXPECT_FALSE(flush_timer->enabled_);
+  EXPECT_LE(1024, client_wrapper_->buffer_.length());
+  testing::Mock::VerifyAndClearExpectations(flush_timer);
+
+  EXPECT_CALL(response_decoder_, decodeHeaders_(_, false));
+  EXPECT_CALL(response_decoder_, decodeData(_, false));
+  driveToCompletion();
+  EXPECT_TRUE(client_wrapper_->status_.ok());
+  EXPECT_TRUE(server_wrapper_->status_.ok());
+}
+
 TEST_P(Http2CodecImplTest, ClientUnexpectedHeaders) {
   initialize();
 
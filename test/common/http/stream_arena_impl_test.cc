@@ -0,0 +1,83 @@
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "source/common/http/stream_arena_impl.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Http {
+namespace {
+
+TEST(StreamArenaImplTest, NoBlockUntilFirstUse) {
+  StreamArenaImpl arena;
+  EXPECT_EQ(0, arena.blocks());
+}
+
+TEST(StreamArenaImplTest, AllocatesAlignedMemoryFromGrowingBlocks) {
+  StreamArenaImpl arena(64, 128);
+  char* first = static_cast<char*>(arena.allocate(3, 1));
+  // Aligned after the first allocation within the same block.
+  void* second = arena.allocate(8, 8);
+  EXPECT_EQ(first + 8, second);
+  EXPECT_EQ(0, reinterpret_cast<uintptr_t>(second) % 8);
+  EXPECT_EQ(1, arena.blocks());
+
+  arena.allocate(32, 8);
+  EXPECT_EQ(1, arena.blocks());
+  // Does not fit into the remainder of the first block.
+  arena.allocate(24, 8);
+  EXPECT_EQ(2, arena.blocks());
+}
+
+TEST(StreamArenaImplTest, LargeAllocationsGetTheirOwnBlock) {
+  StreamArenaImpl arena(64, 128);
+  char* first = static_cast<char*>(arena.allocate(8, 8));
+  arena.allocate(100, 8);
+  EXPECT_EQ(2, arena.blocks());
+  // The current block is still used afterwards.
+  EXPECT_EQ(first + 8, arena.allocate(8, 8));
+  EXPECT_EQ(2, arena.blocks());
+}
+
+TEST(StreamArenaImplTest, DestroysObjectsInReverseOrder) {
+  std::vector<int> destroyed;
+  struct Tracked {
+    Tracked(std::vector<int>& destroyed, int id) : destroyed_(destroyed), id_(id) {}
+    ~Tracked() { destroyed_.push_back(id_); }
+
+    std::vector<int>& destroyed_;
+    const int id_;
+  };
+  {
+    StreamArenaImpl arena;
+    arena.create<Tracked>(destroyed, 1);
+    std::string& value = arena.create<std::string>(100, 'a');
+    arena.create<Tracked>(destroyed, 2);
+    EXPECT_EQ(std::string(100, 'a'), value);
+    EXPECT_TRUE(destroyed.empty());
+  }
+  EXPECT_EQ(std::vector<int>({2, 1}), destroyed);
+}
+
+TEST(StreamArenaImplTest, StreamArenaPtr) {
+  int destroyed = 0;
+  struct Counted {
+    explicit Counted(int& destroyed) : destroyed_(destroyed) {}
+    ~Counted() { ++destroyed_; }
+
+    int& destroyed_;
+  };
+  StreamArenaImpl arena;
+  {
+    StreamArenaPtr<Counted> in_arena = makeStreamArenaPtr<Counted>(&arena, destroyed);
+    StreamArenaPtr<Counted> on_heap = makeStreamArenaPtr<Counted>(nullptr, destroyed);
+    EXPECT_EQ(1, arena.blocks());
+  }
+  EXPECT_EQ(2, destroyed);
+}
+
+} // namespace
+} // namespace Http
+} // namespace Envoy
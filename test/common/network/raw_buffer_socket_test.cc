@@ -19,5 +19,11 @@ TEST(RawBufferSocketFactory, RawBufferSocketFactory) {
   EXPECT_GT(keys.size(), 0);
 }
 
+TEST(RawBufferSocket, IsRawBuffer) {
+  RawBufferSocket socket;
+  EXPECT_TRUE(socket.isRawBuffer());
+  EXPECT_EQ(nullptr, socket.ssl());
+}
+
 } // namespace Network
 } // namespace Envoy
@@ -311,6 +311,53 @@ static void bmRouteTableSizeWithPrefixMatcherTree(benchmark::State& state) {
   }
 }
 
+/**
+ * Measure the cost of selecting a virtual host by wildcard domain as the number of domains grows.
+ * Every virtual host has a "*.tenant-<n>.example.com" suffix wildcard, and a final "*.example.com"
+ * virtual host catches unknown tenants. Requests target the last tenant and an unknown tenant.
+ */
+static void bmWildcardVirtualHostLookup(benchmark::State& state) {
+  Api::ApiPtr api = Api::createApiForTest();
+  NiceMock<Server::Configuration::MockServerFactoryContext> factory_context;
+  NiceMock<Envoy::StreamInfo::MockStreamInfo> stream_info;
+  ON_CALL(factory_context, api()).WillByDefault(ReturnRef(*api));
+
+  RouteConfiguration route_config;
+  for (int i = 0; i < state.range(0); ++i) {
+    VirtualHost* v_host = route_config.add_virtual_hosts();
+    v_host->set_name(absl::StrCat("tenant-", i));
+    v_host->add_domains(absl::StrCat("*.tenant-", i, ".example.com"));
+    Route* route = v_host->add_routes();
+    route->mutable_match()->set_prefix("/");
+    route->mutable_direct_response()->set_status(200);
+  }
+  VirtualHost* catch_all = route_config.add_virtual_hosts();
+  catch_all->set_name("catch_all");
+  catch_all->add_domains("*.example.com");
+  Route* route = catch_all->add_routes();
+  route->mutable_match()->set_prefix("/");
+  route->mutable_direct_response()->set_status(404);
+
+  std::shared_ptr<ConfigImpl> config = *ConfigImpl::create(
+      route_config, factory_context, ProtobufMessage::getNullValidationVisitor(), true);
+
+  const Http::TestRequestHeaderMapImpl known_tenant{
+      {":authority", absl::StrCat("api.tenant-", state.range(0) - 1, ".example.com")},
+      {":method", "GET"},
+      {":path", "/"},
+      {"x-forwarded-proto", "http"}};
+  const Http::TestRequestHeaderMapImpl unknown_tenant{
+      {":authority", "api.tenant-unknown.example.com"},
+      {":method", "GET"},
+      {":path", "/"},
+      {"x-forwarded-proto", "http"}};
+
+  for (auto _ : state) { // NOLINT
+    benchmark::DoNotOptimize(config->route(known_tenant, stream_info, 0));
+    benchmark::DoNotOptimize(config->route(unknown_tenant, stream_info, 0));
+  }
+}
+
 BENCHMARK(bmRouteTableSizeWithPathPrefixMatch)->RangeMultiplier(2)->Ranges({{1, 2 << 13}});
 BENCHMARK(bmRouteTableSizeWithExactPathMatch)->RangeMultiplier(2)->Ranges({{1, 2 << 13}});
 BENCHMARK(bmRouteTableSizeWithRegexMatch)->RangeMultiplier(2)->Ranges({{1, 2 << 13}});
@@ -318,6 +365,8 @@ BENCHMARK(bmRouteTableSizeWithRegexMatch)->RangeMultiplier(2)->Ranges({{1, 2 <<
 BENCHMARK(bmRouteTableSizeWithExactMatcherTree)->RangeMultiplier(2)->Ranges({{1, 2 << 13}});
 BENCHMARK(bmRouteTableSizeWithPrefixMatcherTree)->RangeMultiplier(2)->Ranges({{1, 2 << 13}});
 
+BENCHMARK(bmWildcardVirtualHostLookup)->RangeMultiplier(8)->Ranges({{1, 1 << 15}});
+
 } // namespace
 } // namespace Router
 } // namespace Envoy
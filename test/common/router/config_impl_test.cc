@@ -11998,6 +11998,262 @@ virtual_hosts:
   EXPECT_NE(nullptr, dynamic_cast<const SslRedirectRoute*>(accepted_route.get()));
 }
 
+class CompiledRouteTableTest : public testing::Test,
+                               public ConfigImplTestBase,
+                               public TestScopedRuntime {
+public:
+  CompiledRouteTableTest() {
+    mergeValues({{"envoy.reloadable_features.compiled_route_table", "true"}});
+  }
+};
+
+TEST_F(CompiledRouteTableTest, FirstMatchSemantics) {
+  const std::string yaml = R"EOF(
+virtual_hosts:
+  - name: bar
+    domains: ["*"]
+    routes:
+      - match: { prefix: "/foo", headers: [{ name: x-tenant, string_match: { exact: a } }] }
+        route: { cluster: foo_tenant_a }
+      - match: { safe_regex: { regex: "/foo/[0-9]+" } }
+        route: { cluster: foo_regex }
+      - match: { path: "/foo/bar" }
+        route: { cluster: foo_bar_exact }
+      - match: { path_separated_prefix: "/foo/bar" }
+        route: { cluster: foo_bar_separated }
+      - match: { prefix: "/FOO", case_sensitive: false }
+        route: { cluster: foo_insensitive }
+      - match: { prefix: "/foo/bar/baz" }
+        route: { cluster: unreachable }
+      - match: { prefix: "/" }
+        route: { cluster: default }
+)EOF";
+
+  factory_context_.cluster_manager_.initializeClusters(
+      {"foo_tenant_a", "foo_regex", "foo_bar_exact", "foo_bar_separated", "foo_insensitive",
+       "unreachable", "default"},
+      {});
+  TestConfigImpl config(parseRouteConfigurationFromYaml(yaml), factory_context_, true,
+                        creation_status_);
+
+  auto tenant_headers = genHeaders("bat.com", "/foo/bar", "GET");
+  tenant_headers.addCopy("x-tenant", "a");
+  EXPECT_EQ("foo_tenant_a", config.route(tenant_headers, 0)->routeEntry()->clusterName());
+  EXPECT_EQ("foo_regex",
+            config.route(genHeaders("bat.com", "/foo/123", "GET"), 0)->routeEntry()->clusterName());
+  EXPECT_EQ(
+      "foo_bar_exact",
+      config.route(genHeaders("bat.com", "/foo/bar?a=b", "GET"), 0)->routeEntry()->clusterName());
+  EXPECT_EQ("foo_bar_separated", config.route(genHeaders("bat.com", "/foo/bar/baz", "GET"), 0)
+                                     ->routeEntry()
+                                     ->clusterName());
+  EXPECT_EQ(
+      "foo_insensitive",
+      config.route(genHeaders("bat.com", "/foo/barbaz", "GET"), 0)->routeEntry()->clusterName());
+  EXPECT_EQ("foo_insensitive",
+            config.route(genHeaders("bat.com", "/Foo", "GET"), 0)->routeEntry()->clusterName());
+  EXPECT_EQ("default",
+            config.route(genHeaders("bat.com", "/fo", "GET"), 0)->routeEntry()->clusterName());
+}
+
+TEST_F(CompiledRouteTableTest, IgnorePathParameters) {
+  const std::string yaml = R"EOF(
+ignore_path_parameters_in_path_matching: true
+virtual_hosts:
+  - name: bar
+    domains: ["*"]
+    routes:
+      - match: { path: "/foo" }
+        route: { cluster: foo }
+      - match: { prefix: "/" }
+        route: { cluster: default }
+)EOF";
+
+  factory_context_.cluster_manager_.initializeClusters({"foo", "default"}, {});
+  TestConfigImpl config(parseRouteConfigurationFromYaml(yaml), factory_context_, true,
+                        creation_status_);
+
+  EXPECT_EQ("foo", config.route(genHeaders("bat.com", "/foo;jsessionid=1?a=b", "GET"), 0)
+                       ->routeEntry()
+                       ->clusterName());
+  EXPECT_EQ("default",
+            config.route(genHeaders("bat.com", "/foo/;a", "GET"), 0)->routeEntry()->clusterName());
+}
+
+TEST_F(CompiledRouteTableTest, PathlessConnectRoutes) {
+  const std::string yaml = R"EOF(
+virtual_hosts:
+  - name: connect
+    domains: ["*"]
+    routes:
+      - match: { prefix: "/" }
+        route: { cluster: default }
+      - match: { connect_matcher: {} }
+        route: { cluster: connect }
+)EOF";
+
+  factory_context_.cluster_manager_.initializeClusters({"connect", "default"}, {});
+  TestConfigImpl config(parseRouteConfigurationFromYaml(yaml), factory_context_, true,
+                        creation_status_);
+
+  EXPECT_EQ("connect", config.route(genPathlessHeaders("bat.com", "CONNECT"), 0)
+                           ->routeEntry()
+                           ->clusterName());
+}
+
+// The evaluation status passed to route callbacks is relative to the full route list, the same
+// as for a linear scan.
+TEST_F(CompiledRouteTableTest, RouteCallbackEvalStatus) {
+  const std::string yaml = R"EOF(
+virtual_hosts:
+  - name: bar
+    domains: ["*"]
+    routes:
+      - match: { prefix: "/foo/bar" }
+        route: { cluster: foo_bar }
+      - match: { prefix: "/other" }
+        route: { cluster: other }
+      - match: { prefix: "/foo" }
+        route: { cluster: foo }
+      - match: { prefix: "/another" }
+        route: { cluster: another }
+)EOF";
+
+  factory_context_.cluster_manager_.initializeClusters({"foo_bar", "other", "foo", "another"},
+                                                       {});
+  TestConfigImpl config(parseRouteConfigurationFromYaml(yaml), factory_context_, true,
+                        creation_status_);
+  std::vector<std::string> clusters{"foo", "foo_bar"};
+
+  RouteConstSharedPtr accepted_route = config.route(
+      [&clusters](RouteConstSharedPtr route,
+                  RouteEvalStatus route_eval_status) -> RouteMatchStatus {
+        EXPECT_FALSE(clusters.empty());
+        EXPECT_EQ(clusters.back(), route->routeEntry()->clusterName());
+        clusters.pop_back();
+        EXPECT_EQ(route_eval_status, RouteEvalStatus::HasMoreRoutes);
+        return RouteMatchStatus::Continue;
+      },
+      genHeaders("bat.com", "/foo/bar/baz", "GET"));
+  EXPECT_TRUE(clusters.empty());
+  EXPECT_EQ(nullptr, accepted_route);
+}
+
+class ReuseVirtualHostsTest : public testing::Test,
+                              public ConfigImplTestBase,
+                              public TestScopedRuntime {
+public:
+  ReuseVirtualHostsTest() {
+    mergeValues({{"envoy.reloadable_features.rds_reuse_unchanged_virtual_hosts", "true"}});
+    factory_context_.cluster_manager_.initializeClusters({"foo", "bar", "baz"}, {});
+  }
+
+  std::shared_ptr<ConfigImpl> createConfig(const std::string& yaml,
+                                           const ConfigImpl* previous_config = nullptr) {
+    return ConfigImpl::create(parseRouteConfigurationFromYaml(yaml), factory_context_,
+                              ProtobufMessage::getNullValidationVisitor(), false, previous_config)
+        .value();
+  }
+
+  RouteConstSharedPtr route(const ConfigImpl& config, const std::string& host) {
+    return config.route(genHeaders(host, "/", "GET"), stream_info_, 0);
+  }
+
+  const std::string yaml_ = R"EOF(
+virtual_hosts:
+  - name: foo
+    domains: ["foo"]
+    routes:
+      - match: { prefix: "/" }
+        route: { cluster: foo }
+  - name: bar
+    domains: ["bar"]
+    routes:
+      - match: { prefix: "/" }
+        route: { cluster: bar }
+)EOF";
+  NiceMock<Envoy::StreamInfo::MockStreamInfo> stream_info_;
+};
+
+TEST_F(ReuseVirtualHostsTest, ReuseUnchangedVirtualHosts) {
+  auto first = createConfig(yaml_);
+  EXPECT_EQ(2, first->rebuiltVirtualHosts());
+  EXPECT_EQ(0, first->reusedVirtualHosts());
+
+  auto second = createConfig(yaml_ + R"EOF(
+  - name: baz
+    domains: ["baz"]
+    routes:
+      - match: { prefix: "/" }
+        route: { cluster: baz }
+)EOF",
+                             first.get());
+  EXPECT_EQ(1, second->rebuiltVirtualHosts());
+  EXPECT_EQ(2, second->reusedVirtualHosts());
+  EXPECT_EQ(route(*first, "foo"), route(*second, "foo"));
+  EXPECT_EQ(route(*first, "bar"), route(*second, "bar"));
+  EXPECT_EQ("baz", route(*second, "baz")->routeEntry()->clusterName());
+
+  // Virtual hosts reused from the previous config keep working after it is released.
+  const RouteConstSharedPtr foo_route = route(*first, "foo");
+  first.reset();
+  auto third = createConfig(R"EOF(
+virtual_hosts:
+  - name: foo
+    domains: ["foo"]
+    routes:
+      - match: { prefix: "/" }
+        route: { cluster: foo }
+  - name: bar
+    domains: ["bar"]
+    routes:
+      - match: { prefix: "/" }
+        route: { cluster: baz }
+)EOF",
+                            second.get());
+  EXPECT_EQ(1, third->rebuiltVirtualHosts());
+  EXPECT_EQ(1, third->reusedVirtualHosts());
+  EXPECT_EQ(foo_route, route(*third, "foo"));
+  EXPECT_EQ("baz", route(*third, "bar")->routeEntry()->clusterName());
+  EXPECT_EQ(nullptr, route(*third, "baz"));
+}
+
+// Virtual hosts capture the global configuration, so a change outside of the virtual hosts
+// rebuilds all of them.
+TEST_F(ReuseVirtualHostsTest, RebuildOnGlobalChange) {
+  auto first = createConfig(yaml_);
+  auto second = createConfig("response_headers_to_add: [{ header: { key: x-foo, value: bar } }]\n" +
+                                 yaml_,
+                             first.get());
+  EXPECT_EQ(2, second->rebuiltVirtualHosts());
+  EXPECT_EQ(0, second->reusedVirtualHosts());
+  EXPECT_NE(route(*first, "foo"), route(*second, "foo"));
+
+  // Identical global configuration again.
+  auto third = createConfig("response_headers_to_add: [{ header: { key: x-foo, value: bar } }]\n" +
+                                yaml_,
+                            second.get());
+  EXPECT_EQ(0, third->rebuiltVirtualHosts());
+  EXPECT_EQ(2, third->reusedVirtualHosts());
+}
+
+TEST_F(ReuseVirtualHostsTest, DisabledWhenValidatingClusters) {
+  auto first = createConfig(yaml_);
+  auto second = ConfigImpl::create(parseRouteConfigurationFromYaml(yaml_), factory_context_,
+                                   ProtobufMessage::getNullValidationVisitor(), true, first.get())
+                    .value();
+  EXPECT_EQ(2, second->rebuiltVirtualHosts());
+  EXPECT_EQ(0, second->reusedVirtualHosts());
+}
+
+TEST_F(ReuseVirtualHostsTest, DisabledByRuntime) {
+  mergeValues({{"envoy.reloadable_features.rds_reuse_unchanged_virtual_hosts", "false"}});
+  auto first = createConfig(yaml_);
+  auto second = createConfig(yaml_, first.get());
+  EXPECT_EQ(2, second->rebuiltVirtualHosts());
+  EXPECT_EQ(0, second->reusedVirtualHosts());
+}
+
 class CommonConfigImplTest : public testing::Test, public ConfigImplTestBase {};
 
 TEST_F(CommonConfigImplTest, TestCommonConfig) {
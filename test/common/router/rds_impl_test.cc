@@ -335,6 +335,69 @@ TEST_F(RdsImplTest, Basic) {
   EXPECT_TRUE(scope_.findGaugeByString("foo.rds.foo_route_config.config_reload_time_ms"));
 }
 
+// Verify that unchanged virtual hosts are shared between successive RDS updates when
+// envoy.reloadable_features.rds_reuse_unchanged_virtual_hosts is enabled.
+TEST_F(RdsImplTest, ReuseUnchangedVirtualHosts) {
+  TestScopedRuntime scoped_runtime;
+  scoped_runtime.mergeValues(
+      {{"envoy.reloadable_features.rds_reuse_unchanged_virtual_hosts", "true"}});
+  setup();
+
+  const std::string response_yaml = R"EOF(
+version_info: "{}"
+resources:
+- "@type": type.googleapis.com/envoy.config.route.v3.RouteConfiguration
+  name: foo_route_config
+  virtual_hosts:
+  - name: foo
+    domains: ["foo"]
+    routes:
+    - match: {{ prefix: "/" }}
+      route: {{ cluster: foo }}
+  - name: bar
+    domains: ["bar"]
+    routes:
+    - match: {{ prefix: "/" }}
+      route: {{ cluster: {} }}
+  {}
+)EOF";
+  const auto update = [this, &response_yaml](const std::string& version,
+                                             const std::string& bar_cluster,
+                                             const std::string& extra) {
+    auto response = TestUtility::parseYaml<envoy::service::discovery::v3::DiscoveryResponse>(
+        fmt::format(response_yaml, version, bar_cluster, extra));
+    const auto decoded_resources =
+        TestUtility::decodeResources<envoy::config::route::v3::RouteConfiguration>(response);
+    EXPECT_TRUE(
+        rds_callbacks_->onConfigUpdate(decoded_resources.refvec_, response.version_info()).ok());
+  };
+  const auto counter = [this](const std::string& name) {
+    return scope_.counter("foo.rds.foo_route_config." + name).value();
+  };
+
+  EXPECT_CALL(init_watcher_, ready());
+  update("1", "bar", "");
+  EXPECT_EQ(2UL, counter("vhost_rebuilt"));
+  EXPECT_EQ(0UL, counter("vhost_reused"));
+
+  // Only the bar virtual host changed.
+  const RouteConstSharedPtr foo_route =
+      route(Http::TestRequestHeaderMapImpl{{":authority", "foo"}, {":path", "/"}});
+  update("2", "baz", "");
+  EXPECT_EQ(3UL, counter("vhost_rebuilt"));
+  EXPECT_EQ(1UL, counter("vhost_reused"));
+  EXPECT_EQ("baz", route(Http::TestRequestHeaderMapImpl{{":authority", "bar"}, {":path", "/"}})
+                       ->routeEntry()
+                       ->clusterName());
+  EXPECT_EQ(foo_route,
+            route(Http::TestRequestHeaderMapImpl{{":authority", "foo"}, {":path", "/"}}));
+
+  // A change outside of the virtual hosts rebuilds every virtual host.
+  update("3", "baz", "response_headers_to_remove: [x-foo]");
+  EXPECT_EQ(5UL, counter("vhost_rebuilt"));
+  EXPECT_EQ(1UL, counter("vhost_reused"));
+}
+
 // validate there will be exception throw when unknown factory found for per virtualhost typed
 // config.
 TEST_F(RdsImplTest, UnknownFacotryForPerVirtualHostTypedConfig) {
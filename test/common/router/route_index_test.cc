@@ -0,0 +1,89 @@
+#include "source/common/router/route_index.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+using testing::ElementsAre;
+using testing::IsEmpty;
+
+namespace Envoy {
+namespace Router {
+namespace {
+
+RouteIndex::Candidates findCandidates(const RouteIndex& index, absl::string_view path) {
+  RouteIndex::Candidates candidates;
+  index.findCandidates(path, candidates);
+  return candidates;
+}
+
+TEST(RouteIndexTest, Empty) {
+  RouteIndex index;
+  EXPECT_EQ(0, index.size());
+  EXPECT_THAT(findCandidates(index, "/foo"), IsEmpty());
+}
+
+TEST(RouteIndexTest, PrefixAndExact) {
+  RouteIndex index;
+  index.addRoute(0, PathMatchType::Prefix, "/foo/bar", true);
+  index.addRoute(1, PathMatchType::Exact, "/foo", true);
+  index.addRoute(2, PathMatchType::Prefix, "/foo", true);
+  index.addRoute(3, PathMatchType::Prefix, "/foo", true);
+  index.addRoute(4, PathMatchType::Exact, "/foo/bar", true);
+  index.addRoute(5, PathMatchType::Prefix, "/", true);
+  index.addRoute(6, PathMatchType::Prefix, "", true);
+  EXPECT_EQ(7, index.size());
+  EXPECT_EQ(0, index.unindexedRoutes());
+
+  EXPECT_THAT(findCandidates(index, "/foo"), ElementsAre(1, 2, 3, 5, 6));
+  EXPECT_THAT(findCandidates(index, "/foo/bar"), ElementsAre(0, 2, 3, 4, 5, 6));
+  EXPECT_THAT(findCandidates(index, "/foo/ba"), ElementsAre(2, 3, 5, 6));
+  EXPECT_THAT(findCandidates(index, "/bar"), ElementsAre(5, 6));
+  EXPECT_THAT(findCandidates(index, "bar"), ElementsAre(6));
+}
+
+TEST(RouteIndexTest, PathSeparatedPrefix) {
+  RouteIndex index;
+  index.addRoute(0, PathMatchType::PathSeparatedPrefix, "/api", true);
+  index.addRoute(1, PathMatchType::Prefix, "/api", true);
+
+  // The path segment boundary is left to the route itself.
+  EXPECT_THAT(findCandidates(index, "/api"), ElementsAre(0, 1));
+  EXPECT_THAT(findCandidates(index, "/apiv2"), ElementsAre(0, 1));
+  EXPECT_THAT(findCandidates(index, "/ap"), IsEmpty());
+}
+
+TEST(RouteIndexTest, CaseInsensitive) {
+  RouteIndex index;
+  index.addRoute(0, PathMatchType::Prefix, "/Foo", false);
+  index.addRoute(1, PathMatchType::Exact, "/FOO/bar", false);
+  index.addRoute(2, PathMatchType::Prefix, "/Foo", true);
+
+  EXPECT_THAT(findCandidates(index, "/foo/BAR"), ElementsAre(0, 1));
+  EXPECT_THAT(findCandidates(index, "/Foo/bar"), ElementsAre(0, 1, 2));
+}
+
+TEST(RouteIndexTest, UnindexedRoutesAlwaysCandidates) {
+  RouteIndex index;
+  index.addRoute(0, PathMatchType::Regex, "/foo/.*", true);
+  index.addRoute(1, PathMatchType::Prefix, "/foo", true);
+  index.addRoute(2, PathMatchType::None, "", true);
+  index.addRoute(3, PathMatchType::Template, "/foo/{bar}", true);
+  index.addRoute(4, PathMatchType::Prefix, "/bar", true);
+  EXPECT_EQ(3, index.unindexedRoutes());
+
+  EXPECT_THAT(findCandidates(index, "/foo/x"), ElementsAre(0, 1, 2, 3));
+  EXPECT_THAT(findCandidates(index, "/baz"), ElementsAre(0, 2, 3));
+}
+
+TEST(RouteIndexTest, AppendsToCandidates) {
+  RouteIndex index;
+  index.addRoute(0, PathMatchType::Prefix, "/", true);
+
+  RouteIndex::Candidates candidates{42};
+  index.findCandidates("/foo", candidates);
+  EXPECT_THAT(candidates, ElementsAre(42, 0));
+}
+
+} // namespace
+} // namespace Router
+} // namespace Envoy
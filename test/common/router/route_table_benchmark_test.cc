@@ -0,0 +1,102 @@
+#include "envoy/config/route/v3/route.pb.h"
+#include "envoy/config/route/v3/route_components.pb.h"
+
+#include "source/common/http/header_map_impl.h"
+#include "source/common/router/config_impl.h"
+#include "source/common/runtime/runtime_features.h"
+
+#include "test/mocks/server/mocks.h"
+#include "test/mocks/stream_info/mocks.h"
+#include "test/test_common/utility.h"
+
+#include "absl/flags/reflection.h"
+#include "benchmark/benchmark.h"
+
+using testing::NiceMock;
+using testing::ReturnRef;
+
+namespace Envoy {
+namespace Router {
+namespace {
+
+constexpr int RouteCount = 10000;
+
+/**
+ * Builds a virtual host with RouteCount routes resembling a large API gateway: a mix of exact
+ * paths, path separated prefixes and prefixes, one in every ten guarded by a header predicate, and
+ * a trailing catch-all.
+ */
+envoy::config::route::v3::RouteConfiguration genRouteConfig() {
+  envoy::config::route::v3::RouteConfiguration proto_config;
+  auto* virtual_host = proto_config.add_virtual_hosts();
+  virtual_host->set_name("default");
+  virtual_host->add_domains("*");
+
+  for (int i = 0; i < RouteCount; ++i) {
+    auto* route = virtual_host->add_routes();
+    auto* match = route->mutable_match();
+    switch (i % 3) {
+    case 0:
+      match->set_path(absl::StrCat("/api/v1/service_", i, "/method"));
+      break;
+    case 1:
+      match->set_path_separated_prefix(absl::StrCat("/api/v1/service_", i));
+      break;
+    default:
+      match->set_prefix(absl::StrCat("/api/v1/service_", i, "/"));
+      break;
+    }
+    if (i % 10 == 0) {
+      auto* header = match->add_headers();
+      header->set_name("x-tenant");
+      header->mutable_string_match()->set_exact(absl::StrCat("tenant_", i));
+    }
+    route->mutable_route()->set_cluster(absl::StrCat("service_", i));
+  }
+
+  auto* route = virtual_host->add_routes();
+  route->mutable_match()->set_prefix("/");
+  route->mutable_route()->set_cluster("default");
+  return proto_config;
+}
+
+/**
+ * Measure the time it takes to select a route from a virtual host with RouteCount routes, with
+ * and without the compiled route table. The benchmark argument selects the route the request
+ * resolves to, expressed as a fraction (in percent) of the route table; 100 falls through to the
+ * catch-all route.
+ */
+void bmLargeRouteTable(benchmark::State& state, bool compiled) {
+  absl::FlagSaver flag_saver;
+  Runtime::maybeSetRuntimeGuard("envoy.reloadable_features.compiled_route_table", compiled);
+
+  Api::ApiPtr api(Api::createApiForTest());
+  NiceMock<Server::Configuration::MockServerFactoryContext> factory_context;
+  ON_CALL(factory_context, api()).WillByDefault(ReturnRef(*api));
+  std::shared_ptr<ConfigImpl> config = *ConfigImpl::create(
+      genRouteConfig(), factory_context, ProtobufMessage::getNullValidationVisitor(), false);
+
+  const NiceMock<Envoy::StreamInfo::MockStreamInfo> stream_info;
+  const int target = std::min<int>(state.range(0) * RouteCount / 100, RouteCount);
+  Http::TestRequestHeaderMapImpl req_headers{
+      {":authority", "www.example.com"},
+      {":path", absl::StrCat("/api/v1/service_", target, "/method?query=1")},
+      {":method", "GET"},
+      {":scheme", "http"},
+      {"x-tenant", "none"}};
+
+  for (auto _ : state) { // NOLINT
+    auto& result = config->route(req_headers, stream_info, 0)->routeEntry()->clusterName();
+    benchmark::DoNotOptimize(result);
+  }
+}
+
+void bmLargeRouteTableLinear(benchmark::State& state) { bmLargeRouteTable(state, false); }
+void bmLargeRouteTableCompiled(benchmark::State& state) { bmLargeRouteTable(state, true); }
+
+BENCHMARK(bmLargeRouteTableLinear)->Arg(0)->Arg(50)->Arg(100);
+BENCHMARK(bmLargeRouteTableCompiled)->Arg(0)->Arg(50)->Arg(100);
+
+} // namespace
+} // namespace Router
+} // namespace Envoy
@@ -0,0 +1,102 @@
+#include <memory>
+#include <string>
+
+#include "source/common/router/wildcard_domain_trie.h"
+
+#include "absl/strings/str_cat.h"
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Router {
+namespace {
+
+using Trie = WildcardDomainTrie<std::shared_ptr<std::string>>;
+
+std::shared_ptr<std::string> value(absl::string_view v) {
+  return std::make_shared<std::string>(v);
+}
+
+std::string find(const Trie& trie, absl::string_view host) {
+  const auto* result = trie.find(host);
+  return result == nullptr ? "" : **result;
+}
+
+TEST(WildcardDomainTrieTest, Empty) {
+  Trie trie(Trie::Direction::Backward);
+  EXPECT_TRUE(trie.empty());
+  EXPECT_EQ(nullptr, trie.find("foo.com"));
+  EXPECT_EQ(nullptr, trie.find(""));
+}
+
+TEST(WildcardDomainTrieTest, SuffixLongestMatch) {
+  Trie trie(Trie::Direction::Backward);
+  EXPECT_TRUE(trie.add(".baz.com", value("*.baz.com")));
+  EXPECT_TRUE(trie.add("-bar.baz.com", value("*-bar.baz.com")));
+  EXPECT_TRUE(trie.add(".com", value("*.com")));
+  EXPECT_TRUE(trie.add("z.com", value("*z.com")));
+  EXPECT_FALSE(trie.empty());
+
+  EXPECT_EQ("*-bar.baz.com", find(trie, "foo-bar.baz.com"));
+  EXPECT_EQ("*.baz.com", find(trie, "foo.bar.baz.com"));
+  EXPECT_EQ("*.baz.com", find(trie, "a.baz.com"));
+  EXPECT_EQ("*z.com", find(trie, "baz.com"));
+  EXPECT_EQ("*.com", find(trie, "foo.com"));
+  EXPECT_EQ("", find(trie, "foo.net"));
+}
+
+TEST(WildcardDomainTrieTest, WildcardMustMatchOneCharacter) {
+  Trie trie(Trie::Direction::Backward);
+  EXPECT_TRUE(trie.add(".foo.com", value("*.foo.com")));
+  EXPECT_TRUE(trie.add(".com", value("*.com")));
+
+  // "*.foo.com" must not match ".foo.com", the next longest match is used instead.
+  EXPECT_EQ("*.com", find(trie, ".foo.com"));
+  EXPECT_EQ("", find(trie, ".com"));
+  EXPECT_EQ("*.foo.com", find(trie, "a.foo.com"));
+}
+
+TEST(WildcardDomainTrieTest, Prefix) {
+  Trie trie(Trie::Direction::Forward);
+  EXPECT_TRUE(trie.add("foo.", value("foo.*")));
+  EXPECT_TRUE(trie.add("foo.bar-", value("foo.bar-*")));
+  EXPECT_TRUE(trie.add("f", value("f*")));
+
+  EXPECT_EQ("foo.bar-*", find(trie, "foo.bar-baz"));
+  EXPECT_EQ("foo.*", find(trie, "foo.bar"));
+  EXPECT_EQ("f*", find(trie, "foo"));
+  EXPECT_EQ("f*", find(trie, "foo."));
+  EXPECT_EQ("", find(trie, "f"));
+  EXPECT_EQ("", find(trie, "bar.foo"));
+}
+
+TEST(WildcardDomainTrieTest, Duplicates) {
+  Trie trie(Trie::Direction::Backward);
+  EXPECT_TRUE(trie.add(".foo.com", value("first")));
+  EXPECT_FALSE(trie.add(".foo.com", value("second")));
+  EXPECT_EQ("first", find(trie, "a.foo.com"));
+
+  // Inserting a key which splits an existing edge still detects duplicates afterwards.
+  EXPECT_TRUE(trie.add("o.com", value("*o.com")));
+  EXPECT_FALSE(trie.add("o.com", value("again")));
+  EXPECT_FALSE(trie.add(".foo.com", value("again")));
+  EXPECT_EQ("first", find(trie, "a.foo.com"));
+  EXPECT_EQ("*o.com", find(trie, "bo.com"));
+}
+
+TEST(WildcardDomainTrieTest, ManyDomains) {
+  Trie trie(Trie::Direction::Backward);
+  for (int i = 0; i < 1000; ++i) {
+    EXPECT_TRUE(trie.add(absl::StrCat(".tenant-", i, ".example.com"), value(absl::StrCat(i))));
+  }
+  EXPECT_TRUE(trie.add(".example.com", value("example")));
+
+  for (int i = 0; i < 1000; ++i) {
+    EXPECT_EQ(absl::StrCat(i), find(trie, absl::StrCat("api.tenant-", i, ".example.com")));
+  }
+  EXPECT_EQ("example", find(trie, "api.tenant-1000.example.com"));
+  EXPECT_EQ("example", find(trie, "tenant-1.example.com"));
+}
+
+} // namespace
+} // namespace Router
+} // namespace Envoy
@@ -137,6 +137,112 @@ TEST_F(AllocatorImplTest, RefCountDecAllocRaceSynchronized) {
   EXPECT_FALSE(alloc_.isMutexLockedForTest());
 }
 
+// Counters created before any thread registered a counter slab keep using a single atomic.
+TEST_F(AllocatorImplTest, CounterSlabsNotRegistered) {
+  CounterSharedPtr counter = alloc_.makeCounter(makeStat("counter.name"), StatName(), {});
+  alloc_.registerCounterSlab();
+  counter->add(5);
+  EXPECT_EQ(5, counter->value());
+  EXPECT_EQ(5, counter->latch());
+}
+
+TEST_F(AllocatorImplTest, CounterSlabs) {
+  alloc_.registerCounterSlab();
+  // Registering again on the same thread has no effect.
+  alloc_.registerCounterSlab();
+  CounterSharedPtr counter = alloc_.makeCounter(makeStat("counter.name"), StatName(), {});
+  EXPECT_FALSE(counter->used());
+  counter->inc();
+  counter->add(4);
+  EXPECT_TRUE(counter->used());
+  // Increments in the slabs are only visible once they are folded.
+  EXPECT_EQ(0, counter->value());
+  alloc_.foldCounterSlabs();
+  EXPECT_EQ(5, counter->value());
+  EXPECT_EQ(5, counter->latch());
+  EXPECT_EQ(0, counter->latch());
+
+  // The pending increment survives a reset, as for counters without slabs.
+  counter->add(3);
+  alloc_.foldCounterSlabs();
+  counter->reset();
+  EXPECT_EQ(0, counter->value());
+  counter->inc();
+  EXPECT_EQ(0, counter->value());
+  alloc_.foldCounterSlabs();
+  EXPECT_EQ(1, counter->value());
+  EXPECT_EQ(4, counter->latch());
+  EXPECT_EQ(1, counter->value());
+}
+
+// Increments from threads with and without slabs are summed.
+TEST_F(AllocatorImplTest, CounterSlabsMultipleThreads) {
+  alloc_.registerCounterSlab();
+  CounterSharedPtr counter = alloc_.makeCounter(makeStat("counter.name"), StatName(), {});
+  Thread::ThreadFactory& thread_factory = Thread::threadFactoryForTest();
+
+  const uint32_t num_threads = 8;
+  const uint32_t iters = 10000;
+  std::vector<Thread::ThreadPtr> threads;
+  absl::Notification go;
+  for (uint32_t i = 0; i < num_threads; ++i) {
+    const bool register_slab = i % 2 == 0;
+    threads.push_back(thread_factory.createThread([&, register_slab]() {
+      if (register_slab) {
+        alloc_.registerCounterSlab();
+      }
+      go.WaitForNotification();
+      for (uint32_t i = 0; i < iters; ++i) {
+        counter->inc();
+      }
+    }));
+  }
+  go.Notify();
+  uint64_t latched = 0;
+  for (uint32_t i = 0; i < num_threads; ++i) {
+    alloc_.foldCounterSlabs();
+    latched += counter->latch();
+    threads[i]->join();
+  }
+  alloc_.foldCounterSlabs();
+  latched += counter->latch();
+  EXPECT_EQ(num_threads * iters, counter->value());
+  EXPECT_EQ(num_threads * iters, latched);
+
+  // Counters created after the threads exited see zeroed cells in their slabs.
+  CounterSharedPtr counter2 = alloc_.makeCounter(makeStat("counter.name2"), StatName(), {});
+  EXPECT_EQ(0, counter2->value());
+}
+
+// Cells of freed counters are reused by new counters, starting from zero.
+TEST_F(AllocatorImplTest, CounterSlabsReuseCells) {
+  alloc_.registerCounterSlab();
+  StatName counter_name = makeStat("counter.name");
+  CounterSharedPtr counter = alloc_.makeCounter(counter_name, StatName(), {});
+  counter->add(7);
+  alloc_.foldCounterSlabs();
+  counter.reset();
+
+  for (uint32_t i = 0; i < 2 * CounterSlabs::CellsPerChunk; ++i) {
+    counter = alloc_.makeCounter(counter_name, StatName(), {});
+    EXPECT_EQ(0, counter->value());
+    counter->add(i + 1);
+    alloc_.foldCounterSlabs();
+    EXPECT_EQ(i + 1, counter->value());
+    counter.reset();
+  }
+
+  std::vector<CounterSharedPtr> counters;
+  for (uint32_t i = 0; i < 2 * CounterSlabs::CellsPerChunk; ++i) {
+    counters.push_back(alloc_.makeCounter(makeStat(absl::StrCat("counter.", i)), StatName(), {}));
+    counters.back()->add(i);
+  }
+  alloc_.foldCounterSlabs();
+  for (uint32_t i = 0; i < counters.size(); ++i) {
+    EXPECT_EQ(i, counters[i]->value());
+  }
+}
+
 TEST_F(AllocatorImplTest, HiddenGauge) {
   GaugeSharedPtr hidden_gauge =
       alloc_.makeGauge(makeStat("hidden"), StatName(), {}, Gauge::ImportMode::HiddenAccumulate);
@@ -17,8 +17,10 @@ StatName ThreadLocalStoreNoMocksMixin::makeStatName(absl::string_view name) {
   return pool_.add(name);
 }
 
-ThreadLocalRealThreadsMixin::ThreadLocalRealThreadsMixin(uint32_t num_threads)
+ThreadLocalRealThreadsMixin::ThreadLocalRealThreadsMixin(uint32_t num_threads,
+                                                         bool per_worker_counters)
     : RealThreadsTestHelper(num_threads) {
+  store_->setPerWorkerCounters(per_worker_counters);
   runOnMainBlocking([this]() { store_->initializeThreading(*main_dispatcher_, *tls_); });
 }
 
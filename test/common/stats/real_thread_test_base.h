@@ -34,7 +34,7 @@ protected:
   static constexpr uint32_t NumIters = 35;
 
 public:
-  ThreadLocalRealThreadsMixin(uint32_t num_threads);
+  ThreadLocalRealThreadsMixin(uint32_t num_threads, bool per_worker_counters = false);
 
   ~ThreadLocalRealThreadsMixin();
 
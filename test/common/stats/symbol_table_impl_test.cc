@@ -232,7 +232,7 @@ TEST_F(StatNameTest, TestSuccessfulDecode) {
 class StatNameDeathTest : public StatNameTest {
 public:
   void decodeSymbolVec(const SymbolVec& symbol_vec) {
-    Thread::LockGuard lock(table_.lock_);
+    absl::ReaderMutexLock lock(table_.lock_);
     for (Symbol symbol : symbol_vec) {
       table_.fromSymbol(symbol);
     }
@@ -532,23 +532,9 @@ TEST_F(StatNameTest, RacingSymbolCreation) {
   access.setReady();
   accesses.Wait();
 
-  // In a perfect world, we could use reader-locks in the SymbolTable
-  // implementation, and there should be zero additional contentions
-  // after latching 'create_contentions' above. And we can definitely
-  // have this world, but this slows down BM_CreateRace in
-  // symbol_table_speed_test.cc, even on a 72-core machine.
-  //
-  // Thus it is better to avoid symbol-table contention by refactoring
-  // all stat-creation code to symbolize all stat string elements at
-  // construction, as composition does not require a lock.
-  //
-  // See this commit
-  // https://github.com/envoyproxy/envoy/pull/5321/commits/ef712d0f5a11ff49831c1935e8a2ef8a0a935bc9
-  // for a working reader-lock implementation, which would pass this EXPECT:
-  //     EXPECT_EQ(create_contentions, mutex_tracer.numContentions());
-  //
-  // Note also that we cannot guarantee there *will* be contentions
-  // as a machine or OS is free to run all threads serially.
+  // Note that we cannot guarantee there *will* be contentions as a machine
+  // or OS is free to run all threads serially. See
+  // MutexContentionOnExistingSymbols for the accesses of existing symbols.
 
   wait.setReady();
   for (auto& thread : threads) {
@@ -594,29 +580,20 @@ TEST_F(StatNameTest, MutexContentionOnExistingSymbols) {
 
   int64_t create_contentions = mutex_tracer.numContentions();
   ENVOY_LOG_MISC(info, "Number of contentions: {}", create_contentions);
+  const uint64_t exclusive_acquisitions = table_.exclusiveLockAcquisitions();
+  const uint64_t table_contentions = table_.lockContentions();
 
   // But when we access the already-existing symbols, we guarantee that no
-  // further mutex contentions occur.
+  // further symbol table contentions occur, as existing symbols are looked
+  // up with the table lock held in shared mode.
   access.setReady();
   accesses.Wait();
 
-  // In a perfect world, we could use reader-locks in the SymbolTable
-  // implementation, and there should be zero additional contentions
-  // after latching 'create_contentions' above. And we can definitely
-  // have this world, but this slows down BM_CreateRace in
-  // symbol_table_speed_test.cc, even on a 72-core machine.
-  //
-  // Thus it is better to avoid symbol-table contention by refactoring
-  // all stat-creation code to symbolize all stat string elements at
-  // construction, as composition does not require a lock.
-  //
-  // See this commit
-  // https://github.com/envoyproxy/envoy/pull/5321/commits/ef712d0f5a11ff49831c1935e8a2ef8a0a935bc9
-  // for a working reader-lock implementation, which would pass this EXPECT:
-  //     EXPECT_EQ(create_contentions, mutex_tracer.numContentions());
-  //
-  // Note also that we cannot guarantee there *will* be contentions
-  // as a machine or OS is free to run all threads serially.
+  // The global mutex tracer also counts contentions on the mutexes used to
+  // coordinate the threads above, so the symbol table's own counters are
+  // checked instead.
+  EXPECT_EQ(exclusive_acquisitions, table_.exclusiveLockAcquisitions());
+  EXPECT_EQ(table_contentions, table_.lockContentions());
 
   wait.setReady();
   for (auto& thread : threads) {
@@ -624,6 +601,36 @@ TEST_F(StatNameTest, MutexContentionOnExistingSymbols) {
   }
 }
 
+// Only creating a symbol and dropping the last reference to it take the table
+// lock exclusively.
+TEST_F(StatNameTest, ExclusiveLockAcquisitions) {
+  const uint64_t initial = table_.exclusiveLockAcquisitions();
+
+  StatNameStorage first("a.b", table_);
+  EXPECT_EQ(initial + 1, table_.exclusiveLockAcquisitions());
+
+  // Existing symbols.
+  StatNameStorage second("a.b", table_);
+  StatNameStorage copy(first.statName(), table_);
+  EXPECT_EQ("a.b", table_.toString(copy.statName()));
+  EXPECT_EQ(initial + 1, table_.exclusiveLockAcquisitions());
+
+  // Only "c" is new.
+  StatNameStorage third("a.c", table_);
+  EXPECT_EQ(initial + 2, table_.exclusiveLockAcquisitions());
+
+  // Symbols which are still referenced are not removed.
+  second.free(table_);
+  copy.free(table_);
+  third.free(table_);
+  EXPECT_EQ(initial + 3, table_.exclusiveLockAcquisitions());
+  EXPECT_EQ(2, table_.numSymbols());
+
+  first.free(table_);
+  EXPECT_EQ(initial + 4, table_.exclusiveLockAcquisitions());
+  EXPECT_EQ(0, table_.numSymbols());
+}
+
 TEST_F(StatNameTest, SharedStatNameStorageSetInsertAndFind) {
   StatNameStorageSet set;
   const int iters = 10;
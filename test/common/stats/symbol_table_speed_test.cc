@@ -13,6 +13,7 @@
 #include "test/common/stats/make_elements_helper.h"
 #include "test/test_common/utility.h"
 
+#include "absl/strings/str_cat.h"
 #include "absl/synchronization/blocking_counter.h"
 #include "benchmark/benchmark.h"
 
@@ -213,3 +214,80 @@ static void bmSetStrings(benchmark::State& state) {
   }
 }
 BENCHMARK(bmSetStrings);
+
+// Symbol table and names shared by the threads of the multi-threaded
+// benchmarks below. They are set up and torn down by thread 0 outside of the
+// benchmark loop, which all threads enter and leave together.
+static Envoy::Stats::SymbolTable* shared_table;
+static Envoy::Stats::StatNamePool* shared_pool;
+static std::vector<Envoy::Stats::StatName>* shared_names;
+static std::vector<std::string>* shared_strings;
+
+static void setUpSharedTable(benchmark::State& state) {
+  if (state.thread_index() == 0) {
+    shared_table = new Envoy::Stats::SymbolTable;
+    shared_pool = new Envoy::Stats::StatNamePool(*shared_table);
+    shared_names = new std::vector<Envoy::Stats::StatName>(prepareNames(*shared_pool, 1000));
+    shared_strings = new std::vector<std::string>;
+    for (Envoy::Stats::StatName stat_name : *shared_names) {
+      shared_strings->push_back(shared_table->toString(stat_name));
+    }
+  }
+}
+
+static void tearDownSharedTable(benchmark::State& state) {
+  if (state.thread_index() == 0) {
+    delete shared_strings;
+    delete shared_names;
+    shared_pool->clear();
+    delete shared_pool;
+    delete shared_table;
+  }
+}
+
+// Encodes and frees names whose symbols are all in the table already, which is
+// the common case for stats created on workers, e.g. per-command stats.
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void bmEncodeExistingMultiThreaded(benchmark::State& state) {
+  setUpSharedTable(state);
+  size_t index = state.thread_index();
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    const std::string& name = (*shared_strings)[index++ % shared_strings->size()];
+    Envoy::Stats::StatNameStorage storage(name, *shared_table);
+    storage.free(*shared_table);
+  }
+  tearDownSharedTable(state);
+}
+BENCHMARK(bmEncodeExistingMultiThreaded)->Threads(1)->Threads(8)->Threads(64);
+
+// Encodes and frees names with a token which is not in the table, so that
+// symbols are created and removed on every iteration.
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void bmEncodeNewMultiThreaded(benchmark::State& state) {
+  setUpSharedTable(state);
+  size_t index = 0;
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    const std::string& name = (*shared_strings)[index % shared_strings->size()];
+    Envoy::Stats::StatNameStorage storage(
+        absl::StrCat(name, ".thread", state.thread_index(), "_", index++ % 16), *shared_table);
+    storage.free(*shared_table);
+  }
+  tearDownSharedTable(state);
+}
+BENCHMARK(bmEncodeNewMultiThreaded)->Threads(1)->Threads(8)->Threads(64);
+
+// Decodes names to strings, e.g. when stats are flushed or rendered by admin.
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void bmDecodeMultiThreaded(benchmark::State& state) {
+  setUpSharedTable(state);
+  size_t index = state.thread_index();
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    benchmark::DoNotOptimize(
+        shared_table->toString((*shared_names)[index++ % shared_names->size()]));
+  }
+  tearDownSharedTable(state);
+}
+BENCHMARK(bmDecodeMultiThreaded)->Threads(1)->Threads(8)->Threads(64);
@@ -140,3 +140,61 @@ BENCHMARK(BM_StatsWithTlsAndRejectionsWithoutDot);
 
 // TODO(jmarantz): add multi-threaded variant of this test, that aggressively
 // looks up stats in multiple threads to try to trigger contention issues.
+
+namespace Envoy {
+
+// State shared by the threads of the counter increment benchmarks. It is created and destroyed
+// by thread 0 outside of the benchmark loop, which the other threads only enter once the setup is
+// complete.
+class CounterIncPerf {
+public:
+  explicit CounterIncPerf(bool per_worker_counters)
+      : alloc_(symbol_table_), name_("cluster.backend.upstream_rq_total", symbol_table_) {
+    if (per_worker_counters) {
+      alloc_.registerCounterSlab();
+    }
+    counter_ = alloc_.makeCounter(name_.statName(), Stats::StatName(), {});
+  }
+
+  Stats::SymbolTableImpl symbol_table_;
+  Stats::AllocatorImpl alloc_;
+  Stats::StatNameManagedStorage name_;
+  Stats::CounterSharedPtr counter_;
+};
+
+CounterIncPerf* counter_inc_perf = nullptr;
+
+} // namespace Envoy
+
+// Increments a single hot counter from all benchmark threads, either with the counter shared by
+// all threads or with a per-thread counter slab.
+static void counterInc(benchmark::State& state, bool per_worker_counters) {
+  if (state.thread_index() == 0) {
+    Envoy::counter_inc_perf = new Envoy::CounterIncPerf(per_worker_counters);
+  }
+
+  bool registered = !per_worker_counters;
+  for (auto _ : state) { // NOLINT
+    if (!registered) {
+      Envoy::counter_inc_perf->alloc_.registerCounterSlab();
+      registered = true;
+    }
+    Envoy::Stats::Counter& counter = *Envoy::counter_inc_perf->counter_;
+    for (uint32_t i = 0; i < 1000; ++i) {
+      counter.inc();
+    }
+  }
+
+  if (state.thread_index() == 0) {
+    delete Envoy::counter_inc_perf;
+    Envoy::counter_inc_perf = nullptr;
+  }
+}
+
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void BM_CounterIncShared(benchmark::State& state) { counterInc(state, false); }
+BENCHMARK(BM_CounterIncShared)->Threads(1)->Threads(8)->Threads(64);
+
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void BM_CounterIncPerWorker(benchmark::State& state) { counterInc(state, true); }
+BENCHMARK(BM_CounterIncPerWorker)->Threads(1)->Threads(8)->Threads(64);
@@ -2183,6 +2183,50 @@ TEST_F(ClusterShutdownCleanupStarvationTest, TwelveThreadsWithoutBlockade) {
   store_->sync().signal(ThreadLocalStoreImpl::MainDispatcherCleanupSync);
 }
 
+class PerWorkerCountersTest : public ThreadLocalRealThreadsMixin, public testing::Test {
+protected:
+  static constexpr uint32_t NumThreads = 4;
+  static constexpr uint32_t NumIncrements = 1000;
+
+  PerWorkerCountersTest() : ThreadLocalRealThreadsMixin(NumThreads, true) {}
+
+  void mergeHistograms() {
+    BlockingBarrier blocking_barrier(1);
+    runOnMainBlocking([this, &blocking_barrier]() {
+      store_->mergeHistograms(blocking_barrier.decrementCountFn());
+    });
+  }
+};
+
+// Increments made on workers, on main and on a thread unknown to the store are all visible to
+// readers after the next merge, whether or not the incrementing thread has a counter slab.
+TEST_F(PerWorkerCountersTest, IncrementOnAllThreads) {
+  const StatName name = makeStatName("per_worker_counter");
+  Counter* counter = nullptr;
+  runOnMainBlocking([this, name, &counter]() {
+    counter = &scope_.counterFromStatName(name);
+    counter->inc();
+  });
+  runOnAllWorkersBlocking([counter]() {
+    for (uint32_t i = 0; i < NumIncrements; ++i) {
+      counter->inc();
+    }
+  });
+  counter->add(10);
+  // Only the increment on the thread without a slab is visible before the merge.
+  EXPECT_EQ(10, counter->value());
+
+  mergeHistograms();
+  const uint64_t expected = 1 + NumThreads * NumIncrements + 10;
+  runOnMainBlocking([counter, expected]() {
+    EXPECT_EQ(expected, counter->value());
+    EXPECT_EQ(expected, counter->latch());
+    EXPECT_EQ(0, counter->latch());
+    EXPECT_TRUE(counter->used());
+  });
+  EXPECT_EQ(expected, TestUtility::findCounter(*store_, "per_worker_counter")->value());
+}
+
 class HistogramThreadTest : public ThreadLocalRealThreadsMixin, public testing::Test {
 protected:
   static constexpr uint32_t NumThreads = 10;
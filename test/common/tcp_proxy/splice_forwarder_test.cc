@@ -0,0 +1,232 @@
+#include <sys/socket.h>
+
+#include <cerrno>
+#include <functional>
+#include <string>
+
+#include "source/common/api/os_sys_calls_impl.h"
+#include "source/common/tcp_proxy/splice_forwarder.h"
+
+#include "test/test_common/utility.h"
+
+#include "absl/types/optional.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace TcpProxy {
+namespace {
+
+using Direction = SpliceForwarder::Direction;
+
+class SpliceForwarderTest : public testing::Test, public SpliceForwarder::Callbacks {
+protected:
+  SpliceForwarderTest()
+      : api_(Api::createApiForTest()), dispatcher_(api_->allocateDispatcher("test_thread")),
+        os_sys_calls_(Api::OsSysCallsSingleton::get()) {}
+
+  void SetUp() override {
+    // Index 0 of each pair is the peer, index 1 the socket of the proxied connection.
+    ASSERT_EQ(0, os_sys_calls_.socketpair(AF_UNIX, SOCK_STREAM, 0, downstream_).return_value_);
+    ASSERT_EQ(0, os_sys_calls_.socketpair(AF_UNIX, SOCK_STREAM, 0, upstream_).return_value_);
+    for (os_fd_t fd : {downstream_[0], downstream_[1], upstream_[0], upstream_[1]}) {
+      ASSERT_EQ(0, os_sys_calls_.setsocketblocking(fd, false).return_value_);
+    }
+  }
+
+  void TearDown() override {
+    forwarder_.reset();
+    for (os_fd_t fd : {downstream_[0], downstream_[1], upstream_[0], upstream_[1]}) {
+      if (SOCKET_VALID(fd)) {
+        os_sys_calls_.close(fd);
+      }
+    }
+  }
+
+  void createForwarder(uint32_t pipe_size = 0) {
+    forwarder_ =
+        SpliceForwarder::create(*dispatcher_, downstream_[1], upstream_[1], pipe_size, *this);
+  }
+
+  void runUntil(const std::function<bool()>& condition) {
+    while (!condition()) {
+      dispatcher_->run(Event::Dispatcher::RunType::NonBlock);
+    }
+  }
+
+  uint64_t write(os_fd_t fd, const std::string& data) {
+    const Api::SysCallSizeResult result = os_sys_calls_.write(fd, data.data(), data.size());
+    return result.return_value_ > 0 ? result.return_value_ : 0;
+  }
+
+  std::string read(os_fd_t fd) {
+    std::string data;
+    char buffer[16384];
+    for (;;) {
+      const Api::SysCallSizeResult result = os_sys_calls_.recv(fd, buffer, sizeof(buffer), 0);
+      if (result.return_value_ <= 0) {
+        return data;
+      }
+      data.append(buffer, result.return_value_);
+    }
+  }
+
+  static size_t index(Direction direction) { return direction == Direction::Upstream ? 0 : 1; }
+
+  // SpliceForwarder::Callbacks
+  void onSpliceBytes(Direction direction, uint64_t bytes_read, uint64_t bytes_written) override {
+    bytes_read_[index(direction)] += bytes_read;
+    bytes_written_[index(direction)] += bytes_written;
+  }
+  void onSpliceFlowControl(Direction direction, bool paused) override {
+    (paused ? pauses_ : resumes_)[index(direction)]++;
+  }
+  void onSpliceEndStream(Direction direction) override {
+    end_stream_[index(direction)] = true;
+    if (stop_on_end_stream_) {
+      forwarder_->stop();
+    }
+  }
+  void onSpliceError(Direction direction, int error) override {
+    error_direction_ = direction;
+    error_ = error;
+  }
+
+  Api::ApiPtr api_;
+  Event::DispatcherPtr dispatcher_;
+  Api::OsSysCalls& os_sys_calls_;
+  os_fd_t downstream_[2];
+  os_fd_t upstream_[2];
+  SpliceForwarderPtr forwarder_;
+
+  uint64_t bytes_read_[2]{};
+  uint64_t bytes_written_[2]{};
+  uint32_t pauses_[2]{};
+  uint32_t resumes_[2]{};
+  bool end_stream_[2]{};
+  bool stop_on_end_stream_{false};
+  absl::optional<Direction> error_direction_;
+  int error_{0};
+};
+
+#if defined(__linux__)
+
+TEST_F(SpliceForwarderTest, ForwardsBothDirections) {
+  createForwarder();
+  ASSERT_NE(nullptr, forwarder_);
+
+  // Bytes written before the forwarder runs for the first time are forwarded too.
+  EXPECT_EQ(5, write(downstream_[0], "hello"));
+  std::string received;
+  runUntil([&]() {
+    received += read(upstream_[0]);
+    return received.size() == 5;
+  });
+  EXPECT_EQ("hello", received);
+  EXPECT_EQ(5, bytes_read_[0]);
+  EXPECT_EQ(5, bytes_written_[0]);
+  EXPECT_TRUE(forwarder_->forwarded());
+
+  EXPECT_EQ(6, write(upstream_[0], "world!"));
+  received.clear();
+  runUntil([&]() {
+    received += read(downstream_[0]);
+    return received.size() == 6;
+  });
+  EXPECT_EQ("world!", received);
+  EXPECT_EQ(6, bytes_read_[1]);
+  EXPECT_EQ(6, bytes_written_[1]);
+  EXPECT_EQ(0, forwarder_->bufferedBytes(Direction::Upstream));
+  EXPECT_EQ(0, forwarder_->bufferedBytes(Direction::Downstream));
+  EXPECT_FALSE(end_stream_[0]);
+  EXPECT_FALSE(end_stream_[1]);
+}
+
+TEST_F(SpliceForwarderTest, EndStream) {
+  createForwarder();
+  ASSERT_NE(nullptr, forwarder_);
+
+  EXPECT_EQ(3, write(downstream_[0], "bye"));
+  ASSERT_EQ(0, os_sys_calls_.shutdown(downstream_[0], SHUT_WR).return_value_);
+  runUntil([&]() { return end_stream_[0]; });
+  EXPECT_EQ("bye", read(upstream_[0]));
+  EXPECT_FALSE(end_stream_[1]);
+
+  ASSERT_EQ(0, os_sys_calls_.shutdown(upstream_[0], SHUT_WR).return_value_);
+  runUntil([&]() { return end_stream_[1]; });
+  EXPECT_EQ(0, bytes_read_[1]);
+}
+
+TEST_F(SpliceForwarderTest, FlowControl) {
+  createForwarder(4096);
+  ASSERT_NE(nullptr, forwarder_);
+
+  // Nothing reads from the upstream peer, so the socket buffers and the pipe fill up until the
+  // downstream peer cannot write anymore.
+  const std::string chunk(16384, 'a');
+  uint64_t sent = 0;
+  runUntil([&]() {
+    const uint64_t written = write(downstream_[0], chunk);
+    sent += written;
+    return written == 0 && pauses_[0] == 1;
+  });
+  EXPECT_EQ(0, resumes_[0]);
+  EXPECT_LT(0, forwarder_->bufferedBytes(Direction::Upstream));
+  EXPECT_LT(bytes_written_[0], sent);
+
+  uint64_t received = 0;
+  runUntil([&]() {
+    received += read(upstream_[0]).size();
+    return received == sent;
+  });
+  EXPECT_EQ(1, resumes_[0]);
+  EXPECT_EQ(sent, bytes_read_[0]);
+  EXPECT_EQ(sent, bytes_written_[0]);
+  EXPECT_EQ(0, pauses_[1]);
+}
+
+TEST_F(SpliceForwarderTest, DestinationClosed) {
+  createForwarder();
+  ASSERT_NE(nullptr, forwarder_);
+
+  os_sys_calls_.close(upstream_[0]);
+  upstream_[0] = INVALID_SOCKET;
+  EXPECT_EQ(5, write(downstream_[0], "hello"));
+  runUntil([&]() { return error_ != 0; });
+  EXPECT_EQ(Direction::Upstream, error_direction_);
+  EXPECT_EQ(EPIPE, error_);
+  EXPECT_EQ(5, bytes_read_[0]);
+  EXPECT_EQ(0, bytes_written_[0]);
+
+  // The forwarder stopped, so further bytes stay in the socket.
+  EXPECT_EQ(5, write(downstream_[0], "again"));
+  dispatcher_->run(Event::Dispatcher::RunType::NonBlock);
+  EXPECT_EQ(5, bytes_read_[0]);
+  EXPECT_EQ("again", read(downstream_[1]));
+}
+
+TEST_F(SpliceForwarderTest, StopFromCallback) {
+  createForwarder();
+  ASSERT_NE(nullptr, forwarder_);
+  stop_on_end_stream_ = true;
+
+  // Both directions end in the same event, but no callback follows a stop.
+  ASSERT_EQ(0, os_sys_calls_.shutdown(downstream_[0], SHUT_WR).return_value_);
+  ASSERT_EQ(0, os_sys_calls_.shutdown(upstream_[0], SHUT_WR).return_value_);
+  runUntil([&]() { return end_stream_[0] || end_stream_[1]; });
+  dispatcher_->run(Event::Dispatcher::RunType::NonBlock);
+  EXPECT_NE(end_stream_[0], end_stream_[1]);
+}
+
+#else
+
+TEST_F(SpliceForwarderTest, NotSupported) {
+  createForwarder();
+  EXPECT_EQ(nullptr, forwarder_);
+}
+
+#endif
+
+} // namespace
+} // namespace TcpProxy
+} // namespace Envoy
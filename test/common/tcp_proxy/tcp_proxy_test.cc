@@ -266,6 +266,39 @@ TEST_P(TcpProxyTest, HalfCloseProxy) {
   upstream_callbacks_->onEvent(Network::ConnectionEvent::RemoteClose);
 }
 
+// Splicing is not started when other network filters would see the downstream data.
+TEST_P(TcpProxyTest, SpliceFallbackWithOtherDownstreamFilters) {
+  envoy::extensions::filters::network::tcp_proxy::v3::TcpProxy config = defaultConfig();
+  config.set_use_splice(true);
+  setup(1, config);
+
+  EXPECT_CALL(filter_callbacks_, soleFilter()).WillOnce(Return(false));
+  raiseEventUpstreamConnected(0);
+  EXPECT_EQ(0U, config_->stats().downstream_cx_splice_total_.value());
+  EXPECT_EQ(1U, config_->stats().downstream_cx_splice_fallback_.value());
+
+  Buffer::OwnedImpl buffer("hello");
+  EXPECT_CALL(*upstream_connections_.at(0), write(BufferEqual(&buffer), false));
+  filter_->onData(buffer, false);
+}
+
+// Splicing is not started when the upstream cluster has network filters.
+TEST_P(TcpProxyTest, SpliceFallbackWithUpstreamNetworkFilters) {
+  envoy::extensions::filters::network::tcp_proxy::v3::TcpProxy config = defaultConfig();
+  config.set_use_splice(true);
+  setup(1, config);
+
+  EXPECT_CALL(filter_callbacks_, soleFilter()).WillOnce(Return(true));
+  EXPECT_CALL(upstream_hosts_.at(0)->cluster_, hasNetworkFilters()).WillOnce(Return(true));
+  raiseEventUpstreamConnected(0);
+  EXPECT_EQ(0U, config_->stats().downstream_cx_splice_total_.value());
+  EXPECT_EQ(1U, config_->stats().downstream_cx_splice_fallback_.value());
+
+  Buffer::OwnedImpl response("world");
+  EXPECT_CALL(filter_callbacks_.connection_, write(BufferEqual(&response), false));
+  upstream_callbacks_->onUpstreamData(response, false);
+}
+
 // Test with an explicitly configured upstream.
 TEST_P(TcpProxyTest, ExplicitFactory) {
   // Explicitly configure an HTTP upstream, to test factory creation.
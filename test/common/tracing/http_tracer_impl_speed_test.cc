@@ -0,0 +1,107 @@
+#include "envoy/type/tracing/v3/custom_tag.pb.h"
+
+#include "source/common/http/header_map_impl.h"
+#include "source/common/tracing/custom_tag_impl.h"
+#include "source/common/tracing/http_tracer_impl.h"
+
+#include "test/mocks/stream_info/mocks.h"
+#include "test/test_common/utility.h"
+
+#include "benchmark/benchmark.h"
+
+namespace Envoy {
+namespace Tracing {
+namespace {
+
+// Span which copies every tag like a real driver would, and reports nothing unless sampled.
+class TestSpan : public Span {
+public:
+  explicit TestSpan(bool sampled) : sampled_(sampled) {}
+
+  void setOperation(absl::string_view) override {}
+  void setTag(absl::string_view name, absl::string_view value) override {
+    tags_.emplace_back(std::string(name), std::string(value));
+  }
+  void log(SystemTime, const std::string&) override {}
+  void finishSpan() override {
+    benchmark::DoNotOptimize(tags_.size());
+    tags_.clear();
+  }
+  void injectContext(TraceContext&, const UpstreamContext&) override {}
+  SpanPtr spawnChild(const Config&, const std::string&, SystemTime) override { return nullptr; }
+  void setSampled(bool sampled) override { sampled_ = sampled; }
+  bool useLocalDecision() const override { return false; }
+  bool isRecording() const override { return sampled_; }
+  std::string getBaggage(absl::string_view) override { return EMPTY_STRING; }
+  void setBaggage(absl::string_view, absl::string_view) override {}
+  std::string getTraceId() const override { return EMPTY_STRING; }
+  std::string getSpanId() const override { return EMPTY_STRING; }
+
+private:
+  bool sampled_;
+  std::vector<std::pair<std::string, std::string>> tags_;
+};
+
+// Config which applies a handful of custom tags, as the HTTP connection manager does.
+class TestConfig : public Config {
+public:
+  TestConfig(const StreamInfo::StreamInfo& stream_info,
+             const Http::RequestHeaderMap& request_headers)
+      : stream_info_(stream_info), request_headers_(request_headers) {
+    for (const std::string& yaml : {
+             "{ tag: literal, literal: { value: some_value } }",
+             "{ tag: tenant, request_header: { name: x-tenant, default_value: none } }",
+             "{ tag: agent, request_header: { name: user-agent } }",
+         }) {
+      envoy::type::tracing::v3::CustomTag custom_tag;
+      TestUtility::loadFromYaml(yaml, custom_tag);
+      custom_tags_.push_back(CustomTagUtility::createCustomTag(custom_tag));
+    }
+  }
+
+  OperationName operationName() const override { return OperationName::Ingress; }
+  bool spawnUpstreamSpan() const override { return false; }
+  void modifySpan(Span& span, bool) const override {
+    const HttpTraceContext trace_context(request_headers_);
+    const CustomTagContext ctx{trace_context, stream_info_, {&request_headers_}};
+    for (const auto& custom_tag : custom_tags_) {
+      custom_tag->applySpan(span, ctx);
+    }
+  }
+  bool verbose() const override { return false; }
+  uint32_t maxPathTagLength() const override { return 256; }
+
+private:
+  const StreamInfo::StreamInfo& stream_info_;
+  const Http::RequestHeaderMap& request_headers_;
+  std::vector<CustomTagConstSharedPtr> custom_tags_;
+};
+
+// Measures the per request cost of finalizing the downstream span. The argument selects whether
+// the span is sampled (1) or will be dropped by the driver (0).
+// NOLINTNEXTLINE(readability-identifier-naming)
+void BM_FinalizeDownstreamSpan(benchmark::State& state) {
+  testing::NiceMock<StreamInfo::MockStreamInfo> stream_info;
+  stream_info.protocol_ = Http::Protocol::Http2;
+  auto request_headers = Http::RequestHeaderMapImpl::create();
+  request_headers->setMethod("GET");
+  request_headers->setPath("/some/request/path?with=query");
+  request_headers->setHost("example.com");
+  request_headers->setScheme("https");
+  request_headers->setUserAgent("benchmark");
+  request_headers->setRequestId("c6b9a2d8-4c39-4d35-9d3f-ad3a3e0c9d49");
+  auto response_headers = Http::ResponseHeaderMapImpl::create();
+  response_headers->setStatus(200);
+  TestConfig config(stream_info, *request_headers);
+  TestSpan span(state.range(0) != 0);
+
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    HttpTracerUtility::finalizeDownstreamSpan(span, request_headers.get(), response_headers.get(),
+                                              nullptr, stream_info, config);
+  }
+}
+BENCHMARK(BM_FinalizeDownstreamSpan)->Arg(0)->Arg(1);
+
+} // namespace
+} // namespace Tracing
+} // namespace Envoy
@@ -728,6 +728,23 @@ TEST_F(HttpConnManFinalizerImplTest, CustomTagOverwritesCommonTag) {
                                             config);
 }
 
+TEST_F(HttpConnManFinalizerImplTest, NotRecordingSpanSkipsTags) {
+  Http::TestRequestHeaderMapImpl request_headers{
+      {"x-request-id", "id"}, {":path", "/test"}, {":method", "GET"}, {":scheme", "https"}};
+  Http::TestResponseHeaderMapImpl response_headers{{":status", "200"}};
+
+  ON_CALL(span, isRecording()).WillByDefault(Return(false));
+  EXPECT_CALL(span, setTag(_, _)).Times(0);
+  EXPECT_CALL(span, log(_, _)).Times(0);
+  EXPECT_CALL(config, modifySpan(_, _)).Times(0);
+  EXPECT_CALL(span, finishSpan());
+  HttpTracerUtility::finalizeDownstreamSpan(span, &request_headers, &response_headers, nullptr,
+                                            stream_info, config);
+
+  EXPECT_CALL(span, finishSpan());
+  HttpTracerUtility::finalizeUpstreamSpan(span, stream_info, config);
+}
+
 TEST(HttpTraceContextTest, HttpTraceContextTest) {
   {
     Http::TestRequestHeaderMapImpl request_headers;
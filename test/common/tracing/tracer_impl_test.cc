@@ -423,6 +423,22 @@ TEST_F(TracerImplTest, BasicFunctionalityNodeSet) {
   tracer_->startSpan(config_, trace_context_, stream_info_, {Reason::Sampling, true});
 }
 
+TEST_F(TracerImplTest, NotRecordingSpanSkipsNodeTags) {
+  EXPECT_CALL(config_, operationName()).Times(2);
+
+  NiceMock<MockSpan>* span = new NiceMock<MockSpan>();
+  ON_CALL(*span, isRecording()).WillByDefault(Return(false));
+  ON_CALL(*span, useLocalDecision()).WillByDefault(Return(false));
+  EXPECT_CALL(*driver_, startSpan_(_, _, _, _, _)).WillOnce(Return(span));
+  EXPECT_CALL(*span, setTag(_, _)).Times(0);
+
+  SpanPtr active_span =
+      tracer_->startSpan(config_, trace_context_, stream_info_, {Reason::Sampling, false});
+
+  EXPECT_CALL(*span, finishSpan());
+  TracerUtility::finalizeSpan(*active_span, stream_info_, config_, false);
+}
+
 TEST_F(TracerImplTest, ChildGrpcUpstreamSpanTest) {
   EXPECT_CALL(local_info_, nodeName());
   EXPECT_CALL(config_, operationName()).Times(2).WillRepeatedly(Return(OperationName::Egress));
@@ -0,0 +1,181 @@
+#include <algorithm>
+#include <functional>
+#include <list>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "envoy/config/bootstrap/v3/bootstrap.pb.h"
+#include "envoy/thread_local/thread_local.h"
+
+#include "source/common/common/fmt.h"
+#include "source/common/config/null_grpc_mux_impl.h"
+#include "source/common/upstream/upstream_impl.h"
+
+#include "test/benchmark/main.h"
+#include "test/common/upstream/test_cluster_manager.h"
+#include "test/common/upstream/utility.h"
+#include "test/mocks/network/mocks.h"
+#include "test/test_common/registry.h"
+
+#include "benchmark/benchmark.h"
+
+namespace Envoy {
+namespace Upstream {
+namespace {
+
+using testing::_;
+using testing::Invoke;
+using testing::Return;
+using testing::ReturnRef;
+
+// Thread local slot which keeps separate data for the main thread and for each simulated worker,
+// so that every worker applies updates to its own thread local cluster manager, host sets and load
+// balancers. The data is owned by the caller, which releases it after the cluster manager.
+class PerWorkerSlot : public ThreadLocal::Slot {
+public:
+  PerWorkerSlot(Event::Dispatcher& dispatcher,
+                std::vector<ThreadLocal::ThreadLocalObjectSharedPtr>& data)
+      : dispatcher_(dispatcher), data_(data) {}
+
+  // ThreadLocal::Slot
+  bool currentThreadRegistered() override { return true; }
+  ThreadLocal::ThreadLocalObjectSharedPtr get() override { return data_[0]; }
+  void set(InitializeCb cb) override {
+    for (ThreadLocal::ThreadLocalObjectSharedPtr& data : data_) {
+      data = cb(dispatcher_);
+    }
+  }
+  void runOnAllThreads(const UpdateCb& cb) override {
+    for (ThreadLocal::ThreadLocalObjectSharedPtr& data : data_) {
+      // Copy the callback the same way posting it to the worker dispatchers does.
+      UpdateCb posted = cb;
+      posted(data);
+    }
+  }
+  void runOnAllThreads(const UpdateCb& cb, const std::function<void()>& main_callback) override {
+    runOnAllThreads(cb);
+    main_callback();
+  }
+  bool isShutdown() const override { return false; }
+
+private:
+  Event::Dispatcher& dispatcher_;
+  std::vector<ThreadLocal::ThreadLocalObjectSharedPtr>& data_;
+};
+
+// Single static cluster owned by a cluster manager. Every thread local slot holds data for the
+// main thread and num_workers simulated workers, and posted updates run once for each of them.
+class ClusterUpdateTester {
+public:
+  ClusterUpdateTester(uint64_t num_hosts, uint64_t num_workers)
+      : registered_dns_factory_(dns_resolver_factory_) {
+    ON_CALL(factory_.server_context_.xds_manager_, adsMux())
+        .WillByDefault(Return(std::make_shared<Config::NullGrpcMuxImpl>()));
+    ON_CALL(factory_.tls_, allocateSlot())
+        .WillByDefault(Invoke([this, num_workers]() -> ThreadLocal::SlotPtr {
+          slot_data_.emplace_back(num_workers + 1);
+          return std::make_unique<PerWorkerSlot>(factory_.tls_.dispatcher_, slot_data_.back());
+        }));
+
+    envoy::config::bootstrap::v3::Bootstrap bootstrap;
+    auto* cluster = bootstrap.mutable_static_resources()->add_clusters();
+    cluster->set_name("cluster_1");
+    cluster->set_type(envoy::config::cluster::v3::Cluster::STATIC);
+    cluster->mutable_connect_timeout()->set_seconds(1);
+    cluster->mutable_load_assignment()->set_cluster_name("cluster_1");
+    auto* endpoints = cluster->mutable_load_assignment()->add_endpoints();
+    for (uint64_t i = 0; i < num_hosts; i++) {
+      auto* socket_address = endpoints->add_lb_endpoints()
+                                 ->mutable_endpoint()
+                                 ->mutable_address()
+                                 ->mutable_socket_address();
+      socket_address->set_address(hostAddress(i));
+      socket_address->set_port_value(80);
+    }
+    next_host_ = num_hosts;
+
+    cluster_manager_ = TestClusterManagerImpl::createTestClusterManager(bootstrap, factory_,
+                                                                        factory_.server_context_);
+    ON_CALL(factory_.server_context_, clusterManager()).WillByDefault(ReturnRef(*cluster_manager_));
+    THROW_IF_NOT_OK(cluster_manager_->initialize(bootstrap));
+  }
+
+  ~ClusterUpdateTester() {
+    cluster_manager_->shutdown();
+    cluster_manager_.reset();
+    // Release the thread local data in the reverse order of the slot allocation, as the thread
+    // local instance does on shutdown.
+    while (!slot_data_.empty()) {
+      slot_data_.pop_back();
+    }
+  }
+
+  // Prepares an update which replaces churn_percent of the hosts of the cluster with new ones.
+  void prepareChurn(uint64_t churn_percent) {
+    Cluster& cluster = cluster_manager_->activeClusters().at("cluster_1").get();
+    const HostVector& hosts = cluster.prioritySet().hostSetsPerPriority()[0]->hosts();
+    const size_t num_changed = std::max<size_t>(1, hosts.size() * churn_percent / 100);
+
+    hosts_removed_.assign(hosts.begin(), hosts.begin() + num_changed);
+    hosts_added_.clear();
+    for (size_t i = 0; i < num_changed; i++) {
+      hosts_added_.push_back(
+          makeTestHost(cluster.info(), fmt::format("tcp://{}:80", hostAddress(next_host_++))));
+    }
+    auto new_hosts = std::make_shared<HostVector>(hosts.begin() + num_changed, hosts.end());
+    new_hosts->insert(new_hosts->end(), hosts_added_.begin(), hosts_added_.end());
+    update_hosts_params_ = HostSetImpl::partitionHosts(new_hosts, HostsPerLocalityImpl::empty());
+  }
+
+  // Applies the prepared update, which is propagated to all workers.
+  void applyChurn() {
+    Cluster& cluster = cluster_manager_->activeClusters().at("cluster_1").get();
+    cluster.prioritySet().updateHosts(0, std::move(update_hosts_params_), nullptr, hosts_added_,
+                                      hosts_removed_, absl::nullopt, absl::nullopt);
+  }
+
+private:
+  static std::string hostAddress(uint64_t i) {
+    return fmt::format("10.{}.{}.{}", (i >> 16) & 0xff, (i >> 8) & 0xff, i & 0xff);
+  }
+
+  testing::NiceMock<TestClusterManagerFactory> factory_;
+  testing::NiceMock<Network::MockDnsResolverFactory> dns_resolver_factory_;
+  Registry::InjectFactory<Network::DnsResolverFactory> registered_dns_factory_;
+  std::list<std::vector<ThreadLocal::ThreadLocalObjectSharedPtr>> slot_data_;
+  std::unique_ptr<TestClusterManagerImpl> cluster_manager_;
+  uint64_t next_host_{};
+  HostVector hosts_added_;
+  HostVector hosts_removed_;
+  PrioritySet::UpdateHostsParams update_hosts_params_;
+};
+
+// Measures the cost of propagating a membership update which replaces 1% of the hosts of a
+// cluster. The arguments are the number of hosts and the number of workers.
+// NOLINTNEXTLINE(readability-identifier-naming)
+void BM_ClusterMembershipUpdate(benchmark::State& state) {
+  if (benchmark::skipExpensiveBenchmarks() && state.range(0) > 1000) {
+    state.SkipWithError("Skipping expensive benchmark");
+    return;
+  }
+
+  ClusterUpdateTester tester(state.range(0), state.range(1));
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    state.PauseTiming();
+    tester.prepareChurn(1);
+    state.ResumeTiming();
+
+    tester.applyChurn();
+  }
+}
+BENCHMARK(BM_ClusterMembershipUpdate)
+    ->Args({1000, 8})
+    ->Args({10000, 8})
+    ->Args({10000, 32})
+    ->Args({50000, 32})
+    ->Unit(benchmark::kMillisecond);
+
+} // namespace
+} // namespace Upstream
+} // namespace Envoy
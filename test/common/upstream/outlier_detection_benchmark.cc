@@ -0,0 +1,101 @@
+#include <memory>
+#include <string>
+
+#include "envoy/config/cluster/v3/outlier_detection.pb.h"
+
+#include "source/common/common/fmt.h"
+#include "source/common/common/utility.h"
+#include "source/common/upstream/outlier_detection_impl.h"
+
+#include "test/benchmark/main.h"
+#include "test/common/upstream/utility.h"
+#include "test/mocks/common.h"
+#include "test/mocks/event/mocks.h"
+#include "test/mocks/runtime/mocks.h"
+#include "test/mocks/upstream/cluster_info.h"
+#include "test/mocks/upstream/cluster_priority_set.h"
+#include "test/mocks/upstream/host_set.h"
+#include "test/test_common/utility.h"
+
+#include "benchmark/benchmark.h"
+
+namespace Envoy {
+namespace Upstream {
+namespace Outlier {
+namespace {
+
+class OutlierDetectionTester {
+public:
+  explicit OutlierDetectionTester(uint64_t num_hosts) {
+    HostVector& hosts = cluster_.prioritySet().getMockHostSet(0)->hosts_;
+    for (uint64_t i = 0; i < num_hosts; i++) {
+      hosts.push_back(
+          makeTestHost(cluster_.info_, fmt::format("tcp://10.{}.{}.1:80", i / 256, i % 256)));
+    }
+
+    // Success rate outliers are detected but never enforced, so every interval walks all hosts.
+    const std::string yaml = R"EOF(
+success_rate_request_volume: 10
+failure_percentage_request_volume: 10
+enforcing_success_rate: 0
+  )EOF";
+    envoy::config::cluster::v3::OutlierDetection outlier_detection;
+    TestUtility::loadFromYaml(yaml, outlier_detection);
+    interval_timer_ = new testing::NiceMock<Event::MockTimer>(&dispatcher_);
+    detector_ = DetectorImpl::create(cluster_, outlier_detection, dispatcher_, runtime_,
+                                     time_source_, nullptr, random_)
+                    .value();
+  }
+
+  // Reports a few requests for every host, with every tenth host failing some of them.
+  void loadRequests() {
+    const HostVector& hosts = cluster_.prioritySet().getMockHostSet(0)->hosts_;
+    for (size_t i = 0; i < hosts.size(); i++) {
+      for (uint64_t j = 0; j < 20; j++) {
+        const bool failed = (i % 10 == 0) && (j % 4 == 0);
+        hosts[i]->outlierDetector().putResult(
+            failed ? Result::ExtOriginRequestFailed : Result::ExtOriginRequestSuccess,
+            failed ? 503 : 200);
+      }
+    }
+  }
+
+  testing::NiceMock<MockClusterMockPrioritySet> cluster_;
+  testing::NiceMock<Event::MockDispatcher> dispatcher_;
+  testing::NiceMock<Runtime::MockLoader> runtime_;
+  testing::NiceMock<Random::MockRandomGenerator> random_;
+  RealTimeSource time_source_;
+  testing::NiceMock<Event::MockTimer>* interval_timer_;
+  std::shared_ptr<DetectorImpl> detector_;
+};
+
+// Measures the cost of a single outlier detection interval, depending on the number of hosts in
+// the cluster.
+// NOLINTNEXTLINE(readability-identifier-naming)
+void BM_OutlierDetectionInterval(benchmark::State& state) {
+  if (benchmark::skipExpensiveBenchmarks() && state.range(0) > 1000) {
+    state.SkipWithError("Skipping expensive benchmark");
+    return;
+  }
+
+  OutlierDetectionTester tester(state.range(0));
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    state.PauseTiming();
+    tester.loadRequests();
+    state.ResumeTiming();
+
+    tester.interval_timer_->invokeCallback();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_OutlierDetectionInterval)
+    ->Arg(100)
+    ->Arg(1000)
+    ->Arg(10000)
+    ->Arg(20000)
+    ->Unit(benchmark::kMicrosecond);
+
+} // namespace
+} // namespace Outlier
+} // namespace Upstream
+} // namespace Envoy
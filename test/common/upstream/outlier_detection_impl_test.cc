@@ -172,6 +172,7 @@ max_ejection_time: 400s
   EXPECT_EQ(25UL, detector->config().failurePercentageRequestVolume());
   EXPECT_EQ(70UL, detector->config().failurePercentageThreshold());
   EXPECT_EQ(400000UL, detector->config().maxEjectionTimeMs());
+  EXPECT_EQ(0UL, detector->config().maxHostsPerIteration());
 }
 
 // Test verifies that detector is properly initialized with
@@ -1276,6 +1277,76 @@ TEST_F(OutlierDetectorImplTest, BasicFlowSuccessRateExternalOrigin) {
                     DetectorHostMonitor::SuccessRateMonitorType::ExternalOrigin));
 }
 
+// Test verifies that the interval sweep can be split across event loop iterations and that hosts
+// removed while the sweep is in progress are not taken into account.
+TEST_F(OutlierDetectorImplTest, SuccessRateSweepAcrossIterations) {
+  ON_CALL(runtime_.snapshot_, getInteger(MaxEjectionPercentRuntime, _)).WillByDefault(Return(100));
+  EXPECT_CALL(cluster_.prioritySet(), addMemberUpdateCb(_));
+  addHosts({
+      "tcp://127.0.0.1:80",
+      "tcp://127.0.0.1:81",
+      "tcp://127.0.0.1:82",
+      "tcp://127.0.0.1:83",
+      "tcp://127.0.0.1:84",
+      "tcp://127.0.0.1:85",
+  });
+
+  const std::string yaml = R"EOF(
+max_hosts_per_iteration: 2
+  )EOF";
+  envoy::config::cluster::v3::OutlierDetection outlier_detection;
+  TestUtility::loadFromYaml(yaml, outlier_detection);
+  auto* interval_continuation = new Event::MockSchedulableCallback(&dispatcher_);
+  EXPECT_CALL(*interval_timer_, enableTimer(std::chrono::milliseconds(10000), _));
+  std::shared_ptr<DetectorImpl> detector(DetectorImpl::create(cluster_, outlier_detection,
+                                                              dispatcher_, runtime_, time_system_,
+                                                              event_logger_, random_)
+                                             .value());
+  EXPECT_EQ(2UL, detector->config().maxHostsPerIteration());
+  detector->addChangedStateCb([&](HostSharedPtr host) -> void { checker_.check(host); });
+
+  // Alternate the responses of the last host so that it has a 50% success rate without tripping
+  // the consecutive 5xx detection.
+  for (size_t i = 0; i < 5; i++) {
+    loadRq(hosts_[i], 200, 200);
+  }
+  for (int i = 0; i < 100; i++) {
+    loadRq(hosts_[5], 1, 503);
+    loadRq(hosts_[5], 1, 200);
+  }
+
+  // The first iteration only visits two hosts and schedules the next one.
+  time_system_.setMonotonicTime(std::chrono::milliseconds(10000));
+  ON_CALL(runtime_.snapshot_, getInteger(SuccessRateStdevFactorRuntime, 1900))
+      .WillByDefault(Return(1900));
+  EXPECT_CALL(*interval_continuation, scheduleCallbackNextIteration()).Times(2);
+  interval_timer_->invokeCallback();
+  EXPECT_TRUE(interval_continuation->enabled_);
+  EXPECT_EQ(-1, detector->successRateAverage(
+                    DetectorHostMonitor::SuccessRateMonitorType::ExternalOrigin));
+
+  // Remove one of the perfect hosts in the middle of the sweep.
+  cluster_.prioritySet().getMockHostSet(0)->runCallbacks({}, {hosts_[0]});
+  interval_continuation->invokeCallback();
+  EXPECT_FALSE(hosts_[5]->healthFlagGet(Host::HealthFlag::FAILED_OUTLIER_CHECK));
+
+  // The last iteration evaluates the remaining five hosts and re-arms the interval timer.
+  EXPECT_CALL(checker_, check(hosts_[5]));
+  EXPECT_CALL(*event_logger_, logEject(std::static_pointer_cast<const HostDescription>(hosts_[5]),
+                                       _, envoy::data::cluster::v3::SUCCESS_RATE, true));
+  EXPECT_CALL(*interval_timer_, enableTimer(std::chrono::milliseconds(10000), _));
+  interval_continuation->invokeCallback();
+  EXPECT_FALSE(interval_continuation->enabled_);
+  EXPECT_EQ(50, hosts_[5]->outlierDetector().successRate(
+                    DetectorHostMonitor::SuccessRateMonitorType::ExternalOrigin));
+  EXPECT_EQ(90, detector->successRateAverage(
+                    DetectorHostMonitor::SuccessRateMonitorType::ExternalOrigin));
+  EXPECT_EQ(52, detector->successRateEjectionThreshold(
+                    DetectorHostMonitor::SuccessRateMonitorType::ExternalOrigin));
+  EXPECT_TRUE(hosts_[5]->healthFlagGet(Host::HealthFlag::FAILED_OUTLIER_CHECK));
+  EXPECT_EQ(1UL, outlier_detection_ejections_active_.value());
+}
+
 // Test verifies that EXT_ORIGIN_REQUEST_FAILED and EXT_ORIGIN_REQUEST_SUCCESS cancel
 // each other in split mode.
 TEST_F(OutlierDetectorImplTest, ExternalOriginEventsWithSplit) {
@@ -2747,15 +2818,10 @@ TEST(OutlierDetectionEventLoggerImplTest, All) {
 }
 
 TEST(OutlierUtility, SRThreshold) {
-  std::vector<HostSuccessRatePair> data = {
-      HostSuccessRatePair(nullptr, 50),  HostSuccessRatePair(nullptr, 100),
-      HostSuccessRatePair(nullptr, 100), HostSuccessRatePair(nullptr, 100),
-      HostSuccessRatePair(nullptr, 100),
-  };
-  double sum = 450;
+  std::vector<double> data = {50, 100, 100, 100, 100};
 
   DetectorImpl::EjectionPair success_rate_nums =
-      DetectorImpl::successRateEjectionThreshold(sum, data, 1.9);
+      DetectorImpl::successRateEjectionThreshold(data, 1.9);
   EXPECT_EQ(90.0, success_rate_nums.success_rate_average_); // average success rate
   EXPECT_EQ(52.0, success_rate_nums.ejection_threshold_);   //  ejection threshold
 }
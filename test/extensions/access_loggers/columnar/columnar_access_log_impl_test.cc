@@ -0,0 +1,168 @@
+#include <string>
+
+#include "envoy/config/accesslog/v3/accesslog.pb.h"
+#include "envoy/extensions/access_loggers/columnar/v3/columnar.pb.h"
+
+#include "source/common/access_log/access_log_impl.h"
+#include "source/extensions/access_loggers/columnar/columnar_access_log_impl.h"
+#include "source/extensions/access_loggers/columnar/config.h"
+
+#include "test/mocks/access_log/mocks.h"
+#include "test/mocks/event/mocks.h"
+#include "test/mocks/server/factory_context.h"
+#include "test/mocks/stream_info/mocks.h"
+#include "test/mocks/thread_local/mocks.h"
+#include "test/test_common/utility.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+using testing::_;
+using testing::Invoke;
+using testing::NiceMock;
+
+namespace Envoy {
+namespace Extensions {
+namespace AccessLoggers {
+namespace Columnar {
+namespace {
+
+using ColumnarAccessLogProto = envoy::extensions::access_loggers::columnar::v3::ColumnarAccessLog;
+using Value = DecodedBlock::Value;
+
+class ColumnarAccessLogTest : public testing::Test {
+public:
+  ColumnarAccessLogTest() {
+    ON_CALL(*file_, write(_)).WillByDefault(Invoke([this](absl::string_view data) {
+      written_.append(data);
+    }));
+    stream_info_.start_time_ = SystemTime(std::chrono::microseconds(1234));
+    stream_info_.response_code_ = 200;
+    stream_info_.response_code_details_ = "via_upstream";
+    stream_info_.bytes_sent_ = 42;
+  }
+
+  void createLog(uint32_t max_entries_per_block) {
+    auto config = std::make_shared<ColumnarAccessLogConfig>();
+    config->fields_ = {ColumnarAccessLogProto::START_TIME, ColumnarAccessLogProto::RESPONSE_CODE,
+                       ColumnarAccessLogProto::RESPONSE_CODE_DETAILS,
+                       ColumnarAccessLogProto::BYTES_SENT, ColumnarAccessLogProto::ROUTE_NAME};
+    config->max_entries_per_block_ = max_entries_per_block;
+    config->flush_interval_ = std::chrono::milliseconds(1000);
+    config->compression_level_ = 3;
+    config->log_file_ = file_;
+    timer_ = new NiceMock<Event::MockTimer>(&tls_.dispatcher_);
+    log_ = std::make_unique<ColumnarAccessLog>(nullptr, std::move(config), tls_);
+  }
+
+  std::vector<DecodedBlock> decodeWritten() {
+    std::vector<DecodedBlock> blocks;
+    absl::string_view input = written_;
+    while (!input.empty()) {
+      auto block = decodeBlock(input);
+      EXPECT_TRUE(block.ok()) << block.status();
+      if (!block.ok()) {
+        break;
+      }
+      blocks.push_back(std::move(block.value()));
+    }
+    return blocks;
+  }
+
+  NiceMock<ThreadLocal::MockInstance> tls_;
+  std::shared_ptr<NiceMock<AccessLog::MockAccessLogFile>> file_{
+      std::make_shared<NiceMock<AccessLog::MockAccessLogFile>>()};
+  std::string written_;
+  NiceMock<StreamInfo::MockStreamInfo> stream_info_;
+  Event::MockTimer* timer_{};
+  std::unique_ptr<ColumnarAccessLog> log_;
+};
+
+TEST_F(ColumnarAccessLogTest, WritesFullBlock) {
+  createLog(2);
+
+  log_->log({}, stream_info_);
+  EXPECT_TRUE(timer_->enabled());
+  EXPECT_TRUE(written_.empty());
+
+  stream_info_.response_code_ = absl::nullopt;
+  stream_info_.route_name_ = "route";
+  log_->log({}, stream_info_);
+  EXPECT_FALSE(timer_->enabled());
+
+  const std::vector<DecodedBlock> blocks = decodeWritten();
+  ASSERT_EQ(1U, blocks.size());
+  const DecodedBlock& block = blocks[0];
+  ASSERT_EQ(2U, block.rows);
+  ASSERT_EQ(5U, block.schema.size());
+  EXPECT_EQ("START_TIME", block.schema[0].name);
+  EXPECT_EQ(ColumnType::UInt64, block.schema[0].type);
+  EXPECT_EQ("ROUTE_NAME", block.schema[4].name);
+  EXPECT_EQ(ColumnType::String, block.schema[4].type);
+
+  EXPECT_EQ(Value(uint64_t(1234)), block.columns[0][0]);
+  EXPECT_EQ(Value(uint64_t(200)), block.columns[1][0]);
+  EXPECT_EQ(Value(), block.columns[1][1]);
+  EXPECT_EQ(Value(std::string("via_upstream")), block.columns[2][1]);
+  EXPECT_EQ(Value(uint64_t(42)), block.columns[3][1]);
+  EXPECT_EQ(Value(), block.columns[4][0]);
+  EXPECT_EQ(Value(std::string("route")), block.columns[4][1]);
+}
+
+TEST_F(ColumnarAccessLogTest, WritesPartialBlockOnTimerAndDestruction) {
+  createLog(1024);
+
+  log_->log({}, stream_info_);
+  EXPECT_TRUE(written_.empty());
+  timer_->invokeCallback();
+  ASSERT_EQ(1U, decodeWritten().size());
+
+  log_->log({}, stream_info_);
+  log_.reset();
+  const std::vector<DecodedBlock> blocks = decodeWritten();
+  ASSERT_EQ(2U, blocks.size());
+  EXPECT_EQ(1U, blocks[1].rows);
+}
+
+TEST(ColumnarAccessLogFactoryTest, CreatesFromConfig) {
+  envoy::config::accesslog::v3::AccessLog config;
+  const std::string yaml = R"EOF(
+name: envoy.access_loggers.columnar
+typed_config:
+  "@type": type.googleapis.com/envoy.extensions.access_loggers.columnar.v3.ColumnarAccessLog
+  path: /dev/null
+  fields: [START_TIME, DURATION, UPSTREAM_CLUSTER]
+  max_entries_per_block: 16
+)EOF";
+  TestUtility::loadFromYaml(yaml, config);
+
+  NiceMock<Server::Configuration::MockFactoryContext> context;
+  EXPECT_CALL(context.server_factory_context_.access_log_manager_, createAccessLog(_));
+  AccessLog::InstanceSharedPtr log = AccessLog::AccessLogFactory::fromProto(config, context);
+  EXPECT_NE(nullptr, dynamic_cast<ColumnarAccessLog*>(log.get()));
+}
+
+TEST(ColumnarAccessLogFactoryTest, RejectsEmptyFields) {
+  NiceMock<Server::Configuration::MockFactoryContext> context;
+  ColumnarAccessLogProto config;
+  config.set_path("/dev/null");
+  EXPECT_THROW(ColumnarAccessLogFactory().createAccessLogInstance(config, nullptr, context),
+               ProtoValidationException);
+}
+
+// A flush interval below 1ms would be truncated to 0ms, so the flush timer would fire in a loop.
+TEST(ColumnarAccessLogFactoryTest, RejectsSubMillisecondFlushInterval) {
+  NiceMock<Server::Configuration::MockFactoryContext> context;
+  ColumnarAccessLogProto config;
+  config.set_path("/dev/null");
+  config.add_fields(ColumnarAccessLogProto::DURATION);
+  config.mutable_flush_interval()->set_nanos(999999);
+  EXPECT_THROW(ColumnarAccessLogFactory().createAccessLogInstance(config, nullptr, context),
+               ProtoValidationException);
+}
+
+} // namespace
+} // namespace Columnar
+} // namespace AccessLoggers
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,122 @@
+// Compares the cost of logging an entry with the columnar access log against the file access log
+// with a text format of the same fields. Both write to a file that discards the data, so only
+// formatting, encoding and compression are measured.
+
+#include "envoy/access_log/access_log.h"
+
+#include "source/common/formatter/substitution_formatter.h"
+#include "source/common/network/address_impl.h"
+#include "source/extensions/access_loggers/columnar/columnar_access_log_impl.h"
+#include "source/extensions/access_loggers/common/file_access_log_impl.h"
+
+#include "test/common/stream_info/test_util.h"
+#include "test/mocks/common.h"
+#include "test/mocks/thread_local/mocks.h"
+
+#include "benchmark/benchmark.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace AccessLoggers {
+namespace Columnar {
+namespace {
+
+using ColumnarAccessLogProto = envoy::extensions::access_loggers::columnar::v3::ColumnarAccessLog;
+
+class NullAccessLogFile : public AccessLog::AccessLogFile {
+public:
+  // AccessLog::AccessLogFile
+  void write(absl::string_view data) override { bytes_written_ += data.size(); }
+  void reopen() override {}
+  void flush() override {}
+
+  uint64_t bytes_written_{};
+};
+
+class NullAccessLogManager : public AccessLog::AccessLogManager {
+public:
+  // AccessLog::AccessLogManager
+  void reopen() override {}
+  absl::StatusOr<AccessLog::AccessLogFileSharedPtr>
+  createAccessLog(const Filesystem::FilePathAndType&) override {
+    return file_;
+  }
+
+  std::shared_ptr<NullAccessLogFile> file_{std::make_shared<NullAccessLogFile>()};
+};
+
+constexpr absl::string_view TextLogFormat =
+    "%START_TIME% %DURATION% %RESPONSE_CODE% %RESPONSE_CODE_DETAILS% %RESPONSE_FLAGS% "
+    "%BYTES_RECEIVED% %BYTES_SENT% %PROTOCOL% %DOWNSTREAM_REMOTE_ADDRESS% %UPSTREAM_HOST% "
+    "%UPSTREAM_CLUSTER% %ROUTE_NAME% %STREAM_ID%\n";
+
+std::unique_ptr<TestStreamInfo> makeStreamInfo(TimeSource& time_source) {
+  auto stream_info = std::make_unique<TestStreamInfo>(time_source);
+  stream_info->downstream_connection_info_provider_->setRemoteAddress(
+      std::make_shared<Network::Address::Ipv4Instance>("203.0.113.1", 41234));
+  stream_info->setResponseCode(200);
+  stream_info->setResponseCodeDetails("via_upstream");
+  stream_info->addBytesReceived(512);
+  stream_info->addBytesSent(4096);
+  stream_info->protocol(Http::Protocol::Http2);
+  return stream_info;
+}
+
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void BM_FileAccessLogText(benchmark::State& state) {
+  testing::NiceMock<MockTimeSystem> time_system;
+  std::unique_ptr<TestStreamInfo> stream_info = makeStreamInfo(time_system);
+  NullAccessLogManager log_manager;
+  File::FileAccessLog log(
+      Filesystem::FilePathAndType{Filesystem::DestinationType::File, "/dev/null"}, nullptr,
+      *Formatter::FormatterImpl::create(TextLogFormat, false), log_manager);
+
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    log.log({}, *stream_info);
+  }
+  state.counters["bytes_per_entry"] = benchmark::Counter(
+      log_manager.file_->bytes_written_, benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_FileAccessLogText);
+
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void BM_ColumnarAccessLog(benchmark::State& state) {
+  testing::NiceMock<MockTimeSystem> time_system;
+  std::unique_ptr<TestStreamInfo> stream_info = makeStreamInfo(time_system);
+  testing::NiceMock<ThreadLocal::MockInstance> tls;
+  auto file = std::make_shared<NullAccessLogFile>();
+
+  auto config = std::make_shared<ColumnarAccessLogConfig>();
+  config->fields_ = {ColumnarAccessLogProto::START_TIME,
+                     ColumnarAccessLogProto::DURATION,
+                     ColumnarAccessLogProto::RESPONSE_CODE,
+                     ColumnarAccessLogProto::RESPONSE_CODE_DETAILS,
+                     ColumnarAccessLogProto::RESPONSE_FLAGS,
+                     ColumnarAccessLogProto::BYTES_RECEIVED,
+                     ColumnarAccessLogProto::BYTES_SENT,
+                     ColumnarAccessLogProto::PROTOCOL,
+                     ColumnarAccessLogProto::DOWNSTREAM_REMOTE_ADDRESS,
+                     ColumnarAccessLogProto::UPSTREAM_HOST,
+                     ColumnarAccessLogProto::UPSTREAM_CLUSTER,
+                     ColumnarAccessLogProto::ROUTE_NAME,
+                     ColumnarAccessLogProto::STREAM_ID};
+  config->max_entries_per_block_ = state.range(0);
+  config->flush_interval_ = std::chrono::milliseconds(1000);
+  config->compression_level_ = 3;
+  config->log_file_ = file;
+  {
+    ColumnarAccessLog log(nullptr, std::move(config), tls);
+    for (auto _ : state) { // NOLINT: Silences warning about dead store
+      log.log({}, *stream_info);
+    }
+  }
+  state.counters["bytes_per_entry"] =
+      benchmark::Counter(file->bytes_written_, benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_ColumnarAccessLog)->Arg(256)->Arg(1024)->Arg(8192);
+
+} // namespace
+} // namespace Columnar
+} // namespace AccessLoggers
+} // namespace Extensions
+} // namespace Envoy
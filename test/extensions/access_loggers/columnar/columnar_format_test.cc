@@ -0,0 +1,93 @@
+#include <string>
+
+#include "source/extensions/access_loggers/columnar/columnar_format.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace AccessLoggers {
+namespace Columnar {
+namespace {
+
+using Value = DecodedBlock::Value;
+
+Schema testSchema() {
+  return {Column{0, ColumnType::UInt64, "NUMBER"}, Column{3, ColumnType::String, "TEXT"}};
+}
+
+TEST(ColumnarFormatTest, RoundTripsBlocks) {
+  BlockEncoder encoder(testSchema(), 3);
+  std::string output;
+  encoder.finishBlock(output);
+  EXPECT_TRUE(output.empty());
+
+  // More rows than fit a byte of the validity bitmap.
+  for (uint64_t i = 0; i < 10; i++) {
+    if (i % 3 == 0) {
+      encoder.addNull();
+    } else {
+      encoder.addUInt64(i << 40);
+    }
+    if (i % 4 == 0) {
+      encoder.addNull();
+    } else {
+      encoder.addString(std::string(i, 'a'));
+    }
+  }
+  EXPECT_EQ(10U, encoder.rows());
+  encoder.finishBlock(output);
+  EXPECT_EQ(0U, encoder.rows());
+
+  encoder.addUInt64(1);
+  encoder.addString("second");
+  encoder.finishBlock(output);
+
+  absl::string_view input = output;
+  auto first = decodeBlock(input);
+  ASSERT_TRUE(first.ok()) << first.status();
+  ASSERT_EQ(2U, first->schema.size());
+  EXPECT_EQ("NUMBER", first->schema[0].name);
+  EXPECT_EQ(3U, first->schema[1].field);
+  EXPECT_EQ(ColumnType::String, first->schema[1].type);
+  ASSERT_EQ(10U, first->rows);
+  for (uint64_t i = 0; i < 10; i++) {
+    EXPECT_EQ(i % 3 == 0 ? Value() : Value(i << 40), first->columns[0][i]);
+    EXPECT_EQ(i % 4 == 0 ? Value() : Value(std::string(i, 'a')), first->columns[1][i]);
+  }
+
+  auto second = decodeBlock(input);
+  ASSERT_TRUE(second.ok()) << second.status();
+  ASSERT_EQ(1U, second->rows);
+  EXPECT_EQ(Value(uint64_t(1)), second->columns[0][0]);
+  EXPECT_EQ(Value(std::string("second")), second->columns[1][0]);
+  EXPECT_TRUE(input.empty());
+}
+
+TEST(ColumnarFormatTest, RejectsInvalidBlocks) {
+  absl::string_view bad_magic = "XXXX";
+  EXPECT_FALSE(decodeBlock(bad_magic).ok());
+
+  BlockEncoder encoder(testSchema(), 3);
+  encoder.addUInt64(1);
+  encoder.addString("value");
+  std::string output;
+  encoder.finishBlock(output);
+
+  // Every truncation of the block is rejected.
+  for (size_t size = 0; size < output.size(); size++) {
+    absl::string_view truncated = absl::string_view(output).substr(0, size);
+    EXPECT_FALSE(decodeBlock(truncated).ok()) << size;
+  }
+
+  // A corrupted payload fails the checksum.
+  output.back() ^= 0xff;
+  absl::string_view corrupted = output;
+  EXPECT_FALSE(decodeBlock(corrupted).ok());
+}
+
+} // namespace
+} // namespace Columnar
+} // namespace AccessLoggers
+} // namespace Extensions
+} // namespace Envoy
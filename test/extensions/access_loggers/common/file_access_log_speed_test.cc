@@ -0,0 +1,131 @@
+// Measures the cost of logging a line with the file access log, which formats each line into a
+// reused per-thread buffer, against formatting each line into a new string. The log file discards
+// the data, so only formatting and the hand-off to the file are measured.
+
+#include "envoy/access_log/access_log.h"
+
+#include "source/common/formatter/substitution_formatter.h"
+#include "source/common/network/address_impl.h"
+#include "source/extensions/access_loggers/common/file_access_log_impl.h"
+
+#include "test/common/stream_info/test_util.h"
+#include "test/mocks/common.h"
+#include "test/test_common/utility.h"
+
+#include "benchmark/benchmark.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace AccessLoggers {
+namespace File {
+namespace {
+
+class NullAccessLogFile : public AccessLog::AccessLogFile {
+public:
+  // AccessLog::AccessLogFile
+  void write(absl::string_view data) override { bytes_written_ += data.size(); }
+  void reopen() override {}
+  void flush() override {}
+
+  uint64_t bytes_written_{};
+};
+
+class NullAccessLogManager : public AccessLog::AccessLogManager {
+public:
+  // AccessLog::AccessLogManager
+  void reopen() override {}
+  absl::StatusOr<AccessLog::AccessLogFileSharedPtr>
+  createAccessLog(const Filesystem::FilePathAndType&) override {
+    return file_;
+  }
+
+  std::shared_ptr<NullAccessLogFile> file_{std::make_shared<NullAccessLogFile>()};
+};
+
+// Common text access log format, close to the default format.
+constexpr absl::string_view TextLogFormat =
+    "[%START_TIME%] \"%REQ(:METHOD)% %REQ(X-ENVOY-ORIGINAL-PATH?:PATH)% %PROTOCOL%\" "
+    "%RESPONSE_CODE% %RESPONSE_FLAGS% %BYTES_RECEIVED% %BYTES_SENT% %DURATION% "
+    "%RESP(X-ENVOY-UPSTREAM-SERVICE-TIME)% \"%REQ(X-FORWARDED-FOR)%\" \"%REQ(USER-AGENT)%\" "
+    "\"%REQ(X-REQUEST-ID)%\" \"%REQ(:AUTHORITY)%\" \"%UPSTREAM_HOST%\"\n";
+
+// The same fields as a JSON access log format.
+Formatter::FormatterPtr makeJsonFormatter() {
+  Protobuf::Struct struct_format;
+  const std::string format_yaml = R"EOF(
+    start_time: '%START_TIME%'
+    method: '%REQ(:METHOD)%'
+    path: '%REQ(X-ENVOY-ORIGINAL-PATH?:PATH)%'
+    protocol: '%PROTOCOL%'
+    response_code: '%RESPONSE_CODE%'
+    response_flags: '%RESPONSE_FLAGS%'
+    bytes_received: '%BYTES_RECEIVED%'
+    bytes_sent: '%BYTES_SENT%'
+    duration: '%DURATION%'
+    upstream_service_time: '%RESP(X-ENVOY-UPSTREAM-SERVICE-TIME)%'
+    x_forwarded_for: '%REQ(X-FORWARDED-FOR)%'
+    user_agent: '%REQ(USER-AGENT)%'
+    request_id: '%REQ(X-REQUEST-ID)%'
+    authority: '%REQ(:AUTHORITY)%'
+    upstream_host: '%UPSTREAM_HOST%'
+  )EOF";
+  TestUtility::loadFromYaml(format_yaml, struct_format);
+  return std::make_unique<Formatter::JsonFormatterImpl>(struct_format, false);
+}
+
+Formatter::FormatterPtr makeFormatter(bool json) {
+  if (json) {
+    return makeJsonFormatter();
+  }
+  return *Formatter::FormatterImpl::create(TextLogFormat, false);
+}
+
+// Logs lines either through FileAccessLog, which reuses its per-thread buffer, or by formatting
+// each line into a new string before writing it, as the file access log did before.
+void logLines(benchmark::State& state, bool json) {
+  testing::NiceMock<MockTimeSystem> time_system;
+  TestStreamInfo stream_info(time_system);
+  stream_info.downstream_connection_info_provider_->setRemoteAddress(
+      std::make_shared<Network::Address::Ipv4Instance>("203.0.113.1"));
+  stream_info.setResponseCode(200);
+  const Http::TestRequestHeaderMapImpl request_headers{
+      {":method", "GET"},
+      {":path", "/api/v1/resources/42?expand=true"},
+      {":authority", "api.example.com"},
+      {"x-forwarded-for", "203.0.113.1"},
+      {"user-agent", "Mozilla/5.0 (X11; Linux x86_64) AppleWebKit/537.36 (KHTML, like Gecko)"},
+      {"x-request-id", "4b6f3a1e-2c8d-4e5f-9a7b-1c2d3e4f5a6b"}};
+  const Http::TestResponseHeaderMapImpl response_headers{
+      {":status", "200"}, {"x-envoy-upstream-service-time", "12"}};
+  const Formatter::Context context(&request_headers, &response_headers);
+
+  NullAccessLogManager log_manager;
+  FileAccessLog log(Filesystem::FilePathAndType{Filesystem::DestinationType::File, "/dev/null"},
+                    nullptr, makeFormatter(json), log_manager);
+  const Formatter::FormatterPtr formatter = makeFormatter(json);
+  const bool reuse_buffer = state.range(0) != 0;
+
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    if (reuse_buffer) {
+      log.log(context, stream_info);
+    } else {
+      log_manager.file_->write(formatter->format(context, stream_info));
+    }
+  }
+  state.counters["bytes_per_line"] = benchmark::Counter(log_manager.file_->bytes_written_,
+                                                        benchmark::Counter::kAvgIterations);
+}
+
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void BM_FileAccessLogText(benchmark::State& state) { logLines(state, false); }
+BENCHMARK(BM_FileAccessLogText)->Arg(0)->Arg(1)->ArgName("reuse_buffer");
+
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void BM_FileAccessLogJson(benchmark::State& state) { logLines(state, true); }
+BENCHMARK(BM_FileAccessLogJson)->Arg(0)->Arg(1)->ArgName("reuse_buffer");
+
+} // namespace
+} // namespace File
+} // namespace AccessLoggers
+} // namespace Extensions
+} // namespace Envoy
@@ -19,9 +19,10 @@ using testing::HasSubstr;
 
 TEST(CdnLoopFilterFactoryTest, ValidValuesWork) {
   NiceMock<Server::Configuration::MockFactoryContext> context;
-  Http::StreamDecoderFilterSharedPtr filter;
+  Http::StatelessStreamDecoderFilterSharedPtr filter;
   Http::MockFilterChainFactoryCallbacks filter_callbacks;
-  EXPECT_CALL(filter_callbacks, addStreamDecoderFilter(_)).WillOnce(::testing::SaveArg<0>(&filter));
+  EXPECT_CALL(filter_callbacks, addStatelessStreamDecoderFilter(_))
+      .WillOnce(::testing::SaveArg<0>(&filter));
 
   envoy::extensions::filters::http::cdn_loop::v3::CdnLoopConfig config;
   config.set_cdn_id("cdn");
@@ -30,7 +31,14 @@ TEST(CdnLoopFilterFactoryTest, ValidValuesWork) {
   Http::FilterFactoryCb cb = factory.createFilterFactoryFromProto(config, "stats", context).value();
   cb(filter_callbacks);
   EXPECT_NE(filter.get(), nullptr);
-  EXPECT_NE(dynamic_cast<CdnLoopFilter*>(filter.get()), nullptr);
+  EXPECT_NE(dynamic_cast<const CdnLoopFilter*>(filter.get()), nullptr);
+
+  // The same filter is shared by all streams.
+  Http::StatelessStreamDecoderFilterSharedPtr second_filter;
+  EXPECT_CALL(filter_callbacks, addStatelessStreamDecoderFilter(_))
+      .WillOnce(::testing::SaveArg<0>(&second_filter));
+  cb(filter_callbacks);
+  EXPECT_EQ(filter.get(), second_filter.get());
 }
 
 TEST(CdnLoopFilterFactoryTest, BlankCdnIdThrows) {
@@ -18,11 +18,11 @@ namespace {
 TEST(CdnLoopFilterTest, TestNoHeader) {
   NiceMock<Http::MockStreamDecoderFilterCallbacks> decoder_callbacks;
   CdnLoopFilter filter("cdn", 0);
-  filter.setDecoderFilterCallbacks(decoder_callbacks);
 
   Http::TestRequestHeaderMapImpl request_headers{};
 
-  EXPECT_EQ(filter.decodeHeaders(request_headers, false), Http::FilterHeadersStatus::Continue);
+  EXPECT_EQ(filter.decodeHeaders(decoder_callbacks, request_headers, false),
+            Http::FilterHeadersStatus::Continue);
   EXPECT_EQ(request_headers.get(Http::LowerCaseString("CDN-Loop"))[0]->value().getStringView(),
             "cdn");
 }
@@ -30,11 +30,11 @@ TEST(CdnLoopFilterTest, TestNoHeader) {
 TEST(CdnLoopFilterTest, OtherCdnsInHeader) {
   NiceMock<Http::MockStreamDecoderFilterCallbacks> decoder_callbacks;
   CdnLoopFilter filter("cdn", 0);
-  filter.setDecoderFilterCallbacks(decoder_callbacks);
 
   Http::TestRequestHeaderMapImpl request_headers{{"CDN-Loop", "cdn1,cdn2"}};
 
-  EXPECT_EQ(filter.decodeHeaders(request_headers, false), Http::FilterHeadersStatus::Continue);
+  EXPECT_EQ(filter.decodeHeaders(decoder_callbacks, request_headers, false),
+            Http::FilterHeadersStatus::Continue);
   EXPECT_EQ(request_headers.get(Http::LowerCaseString("CDN-Loop"))[0]->value().getStringView(),
             "cdn1,cdn2,cdn");
 }
@@ -43,46 +43,49 @@ TEST(CdnLoopFilterTest, LoopDetected) {
   NiceMock<Http::MockStreamDecoderFilterCallbacks> decoder_callbacks;
   EXPECT_CALL(decoder_callbacks, sendLocalReply(Http::Code::BadGateway, _, _, _, _));
   CdnLoopFilter filter("cdn", 0);
-  filter.setDecoderFilterCallbacks(decoder_callbacks);
 
   Http::TestRequestHeaderMapImpl request_headers{{"CDN-Loop", "cdn"}};
 
-  EXPECT_EQ(filter.decodeHeaders(request_headers, false), Http::FilterHeadersStatus::StopIteration);
+  EXPECT_EQ(filter.decodeHeaders(decoder_callbacks, request_headers, false),
+            Http::FilterHeadersStatus::StopIteration);
 }
 
 TEST(CdnLoopFilterTest, MultipleTransitsAllowed) {
   NiceMock<Http::MockStreamDecoderFilterCallbacks> decoder_callbacks;
   EXPECT_CALL(decoder_callbacks, sendLocalReply(Http::Code::BadGateway, _, _, _, _));
   CdnLoopFilter filter("cdn", 3);
-  filter.setDecoderFilterCallbacks(decoder_callbacks);
 
   {
     Http::TestRequestHeaderMapImpl request_headers{};
-    EXPECT_EQ(filter.decodeHeaders(request_headers, false), Http::FilterHeadersStatus::Continue);
+    EXPECT_EQ(filter.decodeHeaders(decoder_callbacks, request_headers, false),
+              Http::FilterHeadersStatus::Continue);
     EXPECT_EQ(request_headers.get(Http::LowerCaseString("CDN-Loop"))[0]->value().getStringView(),
               "cdn");
   }
   {
     Http::TestRequestHeaderMapImpl request_headers{{"CDN-Loop", "cdn"}};
-    EXPECT_EQ(filter.decodeHeaders(request_headers, false), Http::FilterHeadersStatus::Continue);
+    EXPECT_EQ(filter.decodeHeaders(decoder_callbacks, request_headers, false),
+              Http::FilterHeadersStatus::Continue);
     EXPECT_EQ(request_headers.get(Http::LowerCaseString("CDN-Loop"))[0]->value().getStringView(),
               "cdn,cdn");
   }
   {
     Http::TestRequestHeaderMapImpl request_headers{{"CDN-Loop", "cdn,cdn"}};
-    EXPECT_EQ(filter.decodeHeaders(request_headers, false), Http::FilterHeadersStatus::Continue);
+    EXPECT_EQ(filter.decodeHeaders(decoder_callbacks, request_headers, false),
+              Http::FilterHeadersStatus::Continue);
     EXPECT_EQ(request_headers.get(Http::LowerCaseString("CDN-Loop"))[0]->value().getStringView(),
               "cdn,cdn,cdn");
   }
   {
     Http::TestRequestHeaderMapImpl request_headers{{"CDN-Loop", "cdn,cdn,cdn"}};
-    EXPECT_EQ(filter.decodeHeaders(request_headers, false), Http::FilterHeadersStatus::Continue);
+    EXPECT_EQ(filter.decodeHeaders(decoder_callbacks, request_headers, false),
+              Http::FilterHeadersStatus::Continue);
     EXPECT_EQ(request_headers.get(Http::LowerCaseString("CDN-Loop"))[0]->value().getStringView(),
               "cdn,cdn,cdn,cdn");
   }
   {
     Http::TestRequestHeaderMapImpl request_headers{{"CDN-Loop", "cdn,cdn,cdn,cdn"}};
-    EXPECT_EQ(filter.decodeHeaders(request_headers, false),
+    EXPECT_EQ(filter.decodeHeaders(decoder_callbacks, request_headers, false),
               Http::FilterHeadersStatus::StopIteration);
   }
 }
@@ -90,11 +93,11 @@ TEST(CdnLoopFilterTest, MultipleTransitsAllowed) {
 TEST(CdnLoopFilterTest, MultipleHeadersAllowed) {
   NiceMock<Http::MockStreamDecoderFilterCallbacks> decoder_callbacks;
   CdnLoopFilter filter("cdn", 0);
-  filter.setDecoderFilterCallbacks(decoder_callbacks);
 
   Http::TestRequestHeaderMapImpl request_headers{{"CDN-Loop", "cdn1"}, {"CDN-Loop", "cdn2"}};
 
-  EXPECT_EQ(filter.decodeHeaders(request_headers, false), Http::FilterHeadersStatus::Continue);
+  EXPECT_EQ(filter.decodeHeaders(decoder_callbacks, request_headers, false),
+            Http::FilterHeadersStatus::Continue);
   EXPECT_EQ(request_headers.get(Http::LowerCaseString("CDN-Loop"))[0]->value().getStringView(),
             "cdn1,cdn2,cdn");
 }
@@ -103,11 +106,11 @@ TEST(CdnLoopFilterTest, UnparseableHeader) {
   NiceMock<Http::MockStreamDecoderFilterCallbacks> decoder_callbacks;
   EXPECT_CALL(decoder_callbacks, sendLocalReply(Http::Code::BadRequest, _, _, _, _));
   CdnLoopFilter filter("cdn", 0);
-  filter.setDecoderFilterCallbacks(decoder_callbacks);
 
   Http::TestRequestHeaderMapImpl request_headers{{"CDN-Loop", ";"}};
 
-  EXPECT_EQ(filter.decodeHeaders(request_headers, false), Http::FilterHeadersStatus::StopIteration);
+  EXPECT_EQ(filter.decodeHeaders(decoder_callbacks, request_headers, false),
+            Http::FilterHeadersStatus::StopIteration);
 }
 
 } // namespace
@@ -4,6 +4,7 @@
 #include "source/common/config/utility.h"
 #include "source/common/event/dispatcher_impl.h"
 #include "source/common/http/message_impl.h"
+#include "source/common/http/stateless_filter_adapter.h"
 #include "source/common/http/utility.h"
 #include "source/common/protobuf/protobuf.h"
 #include "source/common/protobuf/utility.h"
@@ -50,6 +51,17 @@ UberFilterFuzzer::UberFilterFuzzer()
           decoder_filter_->onDestroy();
         };
       }));
+  // These are filters without per-stream state, which the filter manager wraps in an adapter.
+  ON_CALL(filter_callback_, addStatelessStreamDecoderFilter(_))
+      .WillByDefault(Invoke([&](Http::StatelessStreamDecoderFilterSharedPtr filter) -> void {
+        filter_callback_.addStreamDecoderFilter(
+            std::make_shared<Http::StatelessStreamDecoderFilterAdapter>(std::move(filter)));
+      }));
+  ON_CALL(filter_callback_, addStatelessStreamEncoderFilter(_))
+      .WillByDefault(Invoke([&](Http::StatelessStreamEncoderFilterSharedPtr filter) -> void {
+        filter_callback_.addStreamEncoderFilter(
+            std::make_shared<Http::StatelessStreamEncoderFilterAdapter>(std::move(filter)));
+      }));
   // This filter supports access logging.
   ON_CALL(filter_callback_, addAccessLogHandler(_))
       .WillByDefault(
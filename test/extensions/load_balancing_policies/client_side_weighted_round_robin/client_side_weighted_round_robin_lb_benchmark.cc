@@ -0,0 +1,116 @@
+#include <memory>
+#include <vector>
+
+#include "source/common/runtime/runtime_features.h"
+#include "source/extensions/load_balancing_policies/client_side_weighted_round_robin/client_side_weighted_round_robin_lb.h"
+
+#include "test/benchmark/main.h"
+#include "test/extensions/load_balancing_policies/common/benchmark_base_tester.h"
+#include "test/mocks/event/mocks.h"
+
+#include "absl/flags/reflection.h"
+
+namespace Envoy {
+namespace Upstream {
+
+class ClientSideWeightedRoundRobinLoadBalancerFriend {
+public:
+  static void updateWeightsOnMainThread(ClientSideWeightedRoundRobinLoadBalancer& lb) {
+    lb.updateWeightsOnMainThread();
+  }
+};
+
+namespace {
+
+using ClientSideHostLbPolicyData =
+    ClientSideWeightedRoundRobinLoadBalancer::ClientSideHostLbPolicyData;
+
+// Thread aware client side weighted round robin load balancer with one worker local load balancer
+// per simulated worker.
+class ClientSideWeightedRoundRobinTester : public BaseTester {
+public:
+  ClientSideWeightedRoundRobinTester(uint64_t num_hosts, uint64_t num_workers)
+      : BaseTester(num_hosts) {
+    ClientSideWeightedRoundRobinLbProto lb_proto;
+    // Make the reported weights valid as soon as they are reported.
+    lb_proto.mutable_blackout_period()->set_seconds(0);
+    lb_config_ = std::make_unique<ClientSideWeightedRoundRobinLbConfig>(lb_proto, dispatcher_);
+
+    lb_ = std::make_unique<ClientSideWeightedRoundRobinLoadBalancer>(
+        *lb_config_, *info_, priority_set_, runtime_, random_, simTime());
+    ThreadAwareLoadBalancer& thread_aware_lb = *lb_;
+    THROW_IF_NOT_OK(thread_aware_lb.initialize());
+    for (uint64_t i = 0; i < num_workers; i++) {
+      worker_lbs_.push_back(thread_aware_lb.factory()->create(lb_params_));
+    }
+  }
+
+  // Reports a new random weight for every host, as the ORCA load reports of the hosts would.
+  void reportWeights() {
+    const MonotonicTime now = simTime().monotonicTime();
+    for (const auto& host : priority_set_.hostSetsPerPriority()[0]->hosts()) {
+      host->typedLbPolicyData<ClientSideHostLbPolicyData>()->updateWeightNow(
+          1 + random_.random() % 100, now);
+    }
+  }
+
+  // Updates the host weights from the reported ones, as the weight update timer would.
+  void updateWeights() {
+    ClientSideWeightedRoundRobinLoadBalancerFriend::updateWeightsOnMainThread(*lb_);
+  }
+
+  NiceMock<Event::MockDispatcher> dispatcher_;
+  std::unique_ptr<ClientSideWeightedRoundRobinLbConfig> lb_config_;
+  std::unique_ptr<ClientSideWeightedRoundRobinLoadBalancer> lb_;
+  std::vector<LoadBalancerPtr> worker_lbs_;
+};
+
+// Measures a weight update followed by picks on every worker. The arguments are the number of
+// hosts, the number of workers, the number of picks per worker and weight update, and whether the
+// workers update their schedulers in place instead of rebuilding them. Every worker picks after
+// each update, so all of them are busy workers which apply every update on the request path.
+void benchmarkClientSideWeightedRoundRobinWeightChurn(::benchmark::State& state) {
+  const uint64_t num_hosts = state.range(0);
+  const uint64_t num_workers = state.range(1);
+  const uint64_t picks_per_update = state.range(2);
+  if (benchmark::skipExpensiveBenchmarks() && num_hosts > 1000) {
+    state.SkipWithError("Skipping expensive benchmark");
+    return;
+  }
+  absl::FlagSaver flag_saver;
+  Runtime::maybeSetRuntimeGuard(
+      "envoy.reloadable_features.client_side_weighted_round_robin_in_place_weights",
+      state.range(3) != 0);
+
+  ClientSideWeightedRoundRobinTester tester(num_hosts, num_workers);
+  TestLoadBalancerContext context;
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    state.PauseTiming();
+    tester.reportWeights();
+    state.ResumeTiming();
+
+    tester.updateWeights();
+    for (const auto& worker_lb : tester.worker_lbs_) {
+      for (uint64_t i = 0; i < picks_per_update; i++) {
+        ::benchmark::DoNotOptimize(worker_lb->chooseHost(&context).host);
+      }
+    }
+  }
+}
+BENCHMARK(benchmarkClientSideWeightedRoundRobinWeightChurn)
+    ->Args({100, 8, 100, 0})
+    ->Args({100, 8, 100, 1})
+    ->Args({1000, 8, 100, 0})
+    ->Args({1000, 8, 100, 1})
+    ->Args({1000, 8, 10000, 0})
+    ->Args({1000, 8, 10000, 1})
+    ->Args({10000, 8, 100, 0})
+    ->Args({10000, 8, 100, 1})
+    ->Args({10000, 32, 100, 0})
+    ->Args({10000, 32, 100, 1})
+    ->ArgNames({"hosts", "workers", "picks", "in_place"})
+    ->Unit(::benchmark::kMillisecond);
+
+} // namespace
+} // namespace Upstream
+} // namespace Envoy
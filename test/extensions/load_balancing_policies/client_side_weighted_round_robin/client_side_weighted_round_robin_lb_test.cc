@@ -31,6 +31,13 @@ public:
 
   void refreshWorkerLbWithPriority(int32_t priority) { worker_lb_->refresh(priority); }
 
+  ClientSideWeightedRoundRobinLoadBalancer::WorkerLocalLb& workerLb() { return *worker_lb_; }
+
+  static ClientSideWeightedRoundRobinLoadBalancer::WeightsVersionSharedPtr
+  weightsVersion(const ClientSideWeightedRoundRobinLoadBalancer& lb) {
+    return lb.factory_->weights_version_;
+  }
+
   absl::Status initialize() { return lb_->initialize(); }
 
   void updateWeightsOnMainThread() { lb_->updateWeightsOnMainThread(); }
@@ -111,13 +118,14 @@ public:
     client_side_weighted_round_robin_config_.mutable_metric_names_for_computing_utilization()->Add(
         "metric2");
 
-    EXPECT_CALL(mock_tls_, allocateSlot());
-    lb_ = std::make_shared<ClientSideWeightedRoundRobinLoadBalancerFriend>(
-        std::make_shared<ClientSideWeightedRoundRobinLoadBalancer>(
-            lb_config_, cluster_info_, priority_set_, runtime_, random_, simTime()),
-        std::make_shared<ClientSideWeightedRoundRobinLoadBalancer::WorkerLocalLb>(
-            priority_set_, local_priority_set_.get(), stats_, runtime_, random_, common_config_,
-            lb_config_.round_robin_overrides_, simTime(), /*tls_shim=*/absl::nullopt));
+    auto lb = std::make_shared<ClientSideWeightedRoundRobinLoadBalancer>(
+        lb_config_, cluster_info_, priority_set_, runtime_, random_, simTime());
+    auto worker_lb = std::make_shared<ClientSideWeightedRoundRobinLoadBalancer::WorkerLocalLb>(
+        priority_set_, local_priority_set_.get(), stats_, runtime_, random_, common_config_,
+        lb_config_.round_robin_overrides_, simTime(),
+        ClientSideWeightedRoundRobinLoadBalancerFriend::weightsVersion(*lb));
+    lb_ = std::make_shared<ClientSideWeightedRoundRobinLoadBalancerFriend>(std::move(lb),
+                                                                           std::move(worker_lb));
 
     // Initialize the thread aware load balancer from config.
     ASSERT_EQ(lb_->initialize(), absl::OkStatus());
@@ -152,10 +160,9 @@ public:
 
   NiceMock<MockLoadBalancerContext> lb_context_;
   NiceMock<Event::MockDispatcher> dispatcher_;
-  NiceMock<Envoy::ThreadLocal::MockInstance> mock_tls_;
   NiceMock<MockClusterInfo> cluster_info_;
-  ClientSideWeightedRoundRobinLbConfig lb_config_ = ClientSideWeightedRoundRobinLbConfig(
-      client_side_weighted_round_robin_config_, dispatcher_, mock_tls_);
+  ClientSideWeightedRoundRobinLbConfig lb_config_ =
+      ClientSideWeightedRoundRobinLbConfig(client_side_weighted_round_robin_config_, dispatcher_);
 };
 
 //////////////////////////////////////////////////////
@@ -301,6 +308,93 @@ TEST_P(ClientSideWeightedRoundRobinLoadBalancerTest, ChooseHostWithClientSideWei
   }
 }
 
+TEST_P(ClientSideWeightedRoundRobinLoadBalancerTest, WorkerLbPicksUpPublishedWeights) {
+  if (&hostSet() == &failover_host_set_) { // P = 1 does not support zone-aware routing.
+    return;
+  }
+  hostSet().healthy_hosts_ = {
+      makeTestHost(info_, "tcp://127.0.0.1:80"),
+      makeTestHost(info_, "tcp://127.0.0.1:81"),
+  };
+  hostSet().hosts_ = hostSet().healthy_hosts_;
+  init(false);
+  hostSet().runCallbacks({}, {});
+
+  simTime().setMonotonicTime(MonotonicTime(std::chrono::seconds(30)));
+  lb_->setHostClientSideWeight(hostSet().hosts_[0], 10, 5, 10);
+  lb_->setHostClientSideWeight(hostSet().hosts_[1], 30, 5, 10);
+  // The weights are published by the main thread, and picked up by the worker local load balancer
+  // on its next pick.
+  lb_->updateWeightsOnMainThread();
+
+  size_t host0_count = 0;
+  size_t host1_count = 0;
+  for (size_t i = 0; i < 40; ++i) {
+    const auto chosen = lb_->chooseHost(nullptr).host;
+    if (chosen == hostSet().hosts_[0]) {
+      ++host0_count;
+    } else if (chosen == hostSet().hosts_[1]) {
+      ++host1_count;
+    }
+  }
+  EXPECT_EQ(40, host0_count + host1_count);
+  EXPECT_GT(host1_count, 2 * host0_count);
+}
+
+TEST_P(ClientSideWeightedRoundRobinLoadBalancerTest, WorkerLbUpdatesWeightsInPlace) {
+  if (&hostSet() == &failover_host_set_) { // P = 1 does not support zone-aware routing.
+    return;
+  }
+  TestScopedRuntime scoped_runtime;
+  scoped_runtime.mergeValues(
+      {{"envoy.reloadable_features.client_side_weighted_round_robin_in_place_weights", "true"}});
+  hostSet().healthy_hosts_ = {
+      makeTestHost(info_, "tcp://127.0.0.1:80"),
+      makeTestHost(info_, "tcp://127.0.0.1:81"),
+  };
+  hostSet().hosts_ = hostSet().healthy_hosts_;
+  init(false);
+  hostSet().runCallbacks({}, {});
+  const auto count_picks = [this](size_t picks) {
+    std::pair<size_t, size_t> counts;
+    for (size_t i = 0; i < picks; ++i) {
+      const auto chosen = lb_->chooseHost(nullptr).host;
+      if (chosen == hostSet().hosts_[0]) {
+        ++counts.first;
+      } else if (chosen == hostSet().hosts_[1]) {
+        ++counts.second;
+      }
+    }
+    return counts;
+  };
+  // The hosts have equal weights, so they are picked unweighted.
+  count_picks(1);
+  EXPECT_EQ(nullptr,
+            EdfLoadBalancerBasePeer::healthyHostsEdf(lb_->workerLb(), hostSet().priority()));
+
+  // A scheduler is built once the weights differ.
+  simTime().setMonotonicTime(MonotonicTime(std::chrono::seconds(30)));
+  lb_->setHostClientSideWeight(hostSet().hosts_[0], 10, 5, 10);
+  lb_->setHostClientSideWeight(hostSet().hosts_[1], 30, 5, 10);
+  lb_->updateWeightsOnMainThread();
+  auto counts = count_picks(40);
+  EXPECT_EQ(40, counts.first + counts.second);
+  EXPECT_GT(counts.second, 2 * counts.first);
+  const EdfScheduler<Host>* edf =
+      EdfLoadBalancerBasePeer::healthyHostsEdf(lb_->workerLb(), hostSet().priority());
+  ASSERT_NE(nullptr, edf);
+
+  // Later updates keep the scheduler, which applies the new weight of each host when it is next
+  // picked.
+  lb_->setHostClientSideWeight(hostSet().hosts_[0], 30, 5, 10);
+  lb_->setHostClientSideWeight(hostSet().hosts_[1], 10, 5, 10);
+  lb_->updateWeightsOnMainThread();
+  counts = count_picks(40);
+  EXPECT_EQ(40, counts.first + counts.second);
+  EXPECT_GT(counts.first, 2 * counts.second);
+  EXPECT_EQ(edf, EdfLoadBalancerBasePeer::healthyHostsEdf(lb_->workerLb(), hostSet().priority()));
+}
+
 TEST_P(ClientSideWeightedRoundRobinLoadBalancerTest, RefreshWorkerLbWithPriority) {
   if (&hostSet() == &failover_host_set_) { // P = 1 does not support zone-aware routing.
     return;
@@ -498,8 +592,7 @@ TEST(ClientSideWeightedRoundRobinConfigTest, SlowStartConfigPropagatesToOverride
 
   // Construct typed config and validate that Round Robin overrides carry slow start config.
   NiceMock<Event::MockDispatcher> dispatcher;
-  ThreadLocal::MockInstance tls;
-  ClientSideWeightedRoundRobinLbConfig typed(proto, dispatcher, tls);
+  ClientSideWeightedRoundRobinLbConfig typed(proto, dispatcher);
   EXPECT_TRUE(typed.round_robin_overrides_.has_slow_start_config());
   EXPECT_EQ(typed.round_robin_overrides_.slow_start_config().slow_start_window().seconds(), 15);
   EXPECT_DOUBLE_EQ(typed.round_robin_overrides_.slow_start_config().min_weight_percent().value(),
@@ -36,5 +36,40 @@ BaseTester::BaseTester(uint64_t num_hosts, uint32_t weighted_subset_percent, uin
       absl::nullopt);
 }
 
+void BaseTester::replaceHosts(uint64_t num_hosts, bool healthy) {
+  const Upstream::HostVector& current_hosts = priority_set_.hostSetsPerPriority()[0]->hosts();
+  ASSERT(num_hosts <= current_hosts.size());
+  Upstream::HostVector hosts_removed(current_hosts.begin(), current_hosts.begin() + num_hosts);
+  Upstream::HostVector hosts_added;
+  for (uint64_t i = 0; i < num_hosts; i++) {
+    // The initial hosts use 10.0.0.0/16.
+    const uint64_t index = replaced_hosts_++;
+    const std::string url = fmt::format("tcp://10.{}.{}.{}:6379", 1 + ((index >> 16) % 255),
+                                        (index >> 8) & 0xff, index & 0xff);
+    Upstream::HostSharedPtr host = Upstream::makeTestHost(info_, url);
+    if (!healthy) {
+      host->healthFlagSet(Upstream::Host::HealthFlag::FAILED_ACTIVE_HC);
+    }
+    hosts_added.push_back(std::move(host));
+  }
+
+  Upstream::HostVector hosts;
+  hosts.reserve(current_hosts.size());
+  if (healthy) {
+    hosts.insert(hosts.end(), current_hosts.begin() + num_hosts, current_hosts.end());
+    hosts.insert(hosts.end(), hosts_added.begin(), hosts_added.end());
+  } else {
+    hosts.insert(hosts.end(), hosts_added.begin(), hosts_added.end());
+    hosts.insert(hosts.end(), current_hosts.begin() + num_hosts, current_hosts.end());
+  }
+
+  Upstream::HostVectorConstSharedPtr updated_hosts = std::make_shared<Upstream::HostVector>(hosts);
+  Upstream::HostsPerLocalityConstSharedPtr hosts_per_locality =
+      Upstream::makeHostsPerLocality({hosts});
+  priority_set_.updateHosts(
+      0, Upstream::HostSetImpl::partitionHosts(updated_hosts, hosts_per_locality), {},
+      hosts_added, hosts_removed, absl::nullopt);
+}
+
 } // namespace Upstream
 } // namespace Envoy
@@ -25,6 +25,11 @@ public:
   BaseTester(uint64_t num_hosts, uint32_t weighted_subset_percent = 0, uint32_t weight = 0,
              bool attach_metadata = false);
 
+  // Removes the first num_hosts hosts of priority 0 and adds as many new hosts in a single update.
+  // The new hosts are added at the front and failing active health checks if healthy is false, so
+  // that repeated calls only churn unhealthy hosts after the first one.
+  void replaceHosts(uint64_t num_hosts, bool healthy = true);
+
   Envoy::Thread::MutexBasicLockable lock_;
   // Reduce default log level to warn while running this benchmark to avoid problems due to
   // excessive debug logging in upstream_impl.cc
@@ -44,6 +49,7 @@ public:
   NiceMock<Runtime::MockLoader> runtime_;
   Random::RandomGeneratorImpl random_;
   std::shared_ptr<Upstream::MockClusterInfo> info_{new NiceMock<Upstream::MockClusterInfo>()};
+  uint64_t replaced_hosts_{};
 };
 
 class TestLoadBalancerContext : public Upstream::LoadBalancerContextBase {
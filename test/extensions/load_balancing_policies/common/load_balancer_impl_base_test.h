@@ -47,6 +47,14 @@ public:
   static double slowStartMinWeightPercent(const EdfLoadBalancerBase& edf_lb) {
     return edf_lb.slow_start_min_weight_percent_;
   }
+  // Returns the EDF scheduler of the healthy hosts of the priority, or nullptr if they are picked
+  // unweighted.
+  static const EdfScheduler<Host>* healthyHostsEdf(const EdfLoadBalancerBase& edf_lb,
+                                                   uint32_t priority) {
+    const auto it = edf_lb.scheduler_.find(EdfLoadBalancerBase::HostsSource(
+        priority, EdfLoadBalancerBase::HostsSource::SourceType::HealthyHosts));
+    return it != edf_lb.scheduler_.end() ? it->second.edf_.get() : nullptr;
+  }
 };
 
 class TestZoneAwareLoadBalancer : public ZoneAwareLoadBalancerBase {
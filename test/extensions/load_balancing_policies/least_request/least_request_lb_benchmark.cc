@@ -7,16 +7,28 @@ namespace Envoy {
 namespace Upstream {
 namespace {
 
+using LeastRequest = envoy::extensions::load_balancing_policies::least_request::v3::LeastRequest;
+
 class LeastRequestTester : public BaseTester {
 public:
-  LeastRequestTester(uint64_t num_hosts, uint32_t choice_count) : BaseTester(num_hosts) {
-    envoy::extensions::load_balancing_policies::least_request::v3::LeastRequest lr_lb_config;
+  LeastRequestTester(uint64_t num_hosts, uint32_t choice_count,
+                     LeastRequest::SelectionMethod selection_method = LeastRequest::N_CHOICES)
+      : BaseTester(num_hosts) {
+    LeastRequest lr_lb_config;
     lr_lb_config.mutable_choice_count()->set_value(choice_count);
+    lr_lb_config.set_selection_method(selection_method);
     lb_ =
         std::make_unique<LeastRequestLoadBalancer>(priority_set_, &local_priority_set_, stats_,
                                                    runtime_, random_, 50, lr_lb_config, simTime());
   }
 
+  // Gives every host between 0 and max_active_requests - 1 active requests.
+  void setActiveRequests(uint64_t max_active_requests) {
+    for (const auto& host : priority_set_.hostSetsPerPriority()[0]->hosts()) {
+      host->stats().rq_active_.set(random_.random() % max_active_requests);
+    }
+  }
+
   std::unique_ptr<LeastRequestLoadBalancer> lb_;
 };
 
@@ -62,6 +74,33 @@ BENCHMARK(benchmarkLeastRequestLoadBalancerChooseHost)
     ->Args({100, 100, 1000000})
     ->Unit(::benchmark::kMillisecond);
 
+// Measures the latency of a single pick. The arguments are the number of hosts and the number of
+// choices, where 0 choices selects the full scan selection method.
+void benchmarkLeastRequestLoadBalancerPick(::benchmark::State& state) {
+  const uint64_t num_hosts = state.range(0);
+  const uint64_t choice_count = state.range(1);
+  if (benchmark::skipExpensiveBenchmarks() && num_hosts > 1000) {
+    state.SkipWithError("Skipping expensive benchmark");
+    return;
+  }
+
+  LeastRequestTester tester(num_hosts, choice_count == 0 ? 2 : choice_count,
+                            choice_count == 0 ? LeastRequest::FULL_SCAN : LeastRequest::N_CHOICES);
+  tester.setActiveRequests(16);
+  TestLoadBalancerContext context;
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    ::benchmark::DoNotOptimize(tester.lb_->chooseHost(&context).host);
+  }
+}
+BENCHMARK(benchmarkLeastRequestLoadBalancerPick)
+    ->Args({1000, 2})
+    ->Args({1000, 10})
+    ->Args({1000, 0})
+    ->Args({10000, 2})
+    ->Args({10000, 10})
+    ->Args({10000, 0})
+    ->Unit(::benchmark::kNanosecond);
+
 } // namespace
 } // namespace Upstream
 } // namespace Envoy
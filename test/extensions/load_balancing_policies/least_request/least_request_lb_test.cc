@@ -221,6 +221,38 @@ TEST_P(LeastRequestLoadBalancerTest, FullScanMultipleHostsWithLeastRequests) {
   EXPECT_NEAR(expected_approx_selections_per_tied_host, host_4_counts, abs_error);
 }
 
+// The active requests compared by the picks follow both the gauges of the hosts and host updates.
+TEST_P(LeastRequestLoadBalancerTest, FullScanFollowsActiveRequestsAndHostUpdates) {
+  hostSet().healthy_hosts_ = {makeTestHost(info_, "tcp://127.0.0.1:80"),
+                              makeTestHost(info_, "tcp://127.0.0.1:81")};
+  hostSet().hosts_ = hostSet().healthy_hosts_;
+  hostSet().runCallbacks({}, {}); // Trigger callbacks. The added/removed lists are not relevant.
+
+  envoy::extensions::load_balancing_policies::least_request::v3::LeastRequest lr_lb_config;
+  lr_lb_config.set_selection_method(
+      envoy::extensions::load_balancing_policies::least_request::v3::LeastRequest::FULL_SCAN);
+  LeastRequestLoadBalancer lb{priority_set_, nullptr, stats_,       runtime_,
+                              random_,       1,       lr_lb_config, simTime()};
+
+  hostSet().healthy_hosts_[0]->stats().rq_active_.set(5);
+  hostSet().healthy_hosts_[1]->stats().rq_active_.set(1);
+  EXPECT_EQ(hostSet().healthy_hosts_[1], lb.chooseHost(nullptr).host);
+
+  hostSet().healthy_hosts_[1]->stats().rq_active_.set(6);
+  EXPECT_EQ(hostSet().healthy_hosts_[0], lb.chooseHost(nullptr).host);
+
+  // Replace the hosts with the same number of new hosts.
+  const HostVector hosts_removed = hostSet().hosts_;
+  hostSet().healthy_hosts_ = {makeTestHost(info_, "tcp://127.0.0.1:82"),
+                              makeTestHost(info_, "tcp://127.0.0.1:83")};
+  hostSet().hosts_ = hostSet().healthy_hosts_;
+  hostSet().runCallbacks(hostSet().hosts_, hosts_removed);
+
+  hostSet().healthy_hosts_[0]->stats().rq_active_.set(3);
+  hostSet().healthy_hosts_[1]->stats().rq_active_.set(0);
+  EXPECT_EQ(hostSet().healthy_hosts_[1], lb.chooseHost(nullptr).host);
+}
+
 TEST_P(LeastRequestLoadBalancerTest, WeightImbalance) {
   hostSet().healthy_hosts_ = {makeTestHost(info_, "tcp://127.0.0.1:80", 1),
                               makeTestHost(info_, "tcp://127.0.0.1:81", 2)};
@@ -77,6 +77,33 @@ BENCHMARK(benchmarkMaglevLoadBalancerBuildTable)
     ->Arg(500)
     ->Unit(::benchmark::kMillisecond);
 
+// Measures the cost of an update which replaces 1% of the hosts. The second argument selects
+// whether the new hosts are healthy (1) or still failing health checks (0), in which case the
+// hosts used by the table do not change.
+void benchmarkMaglevLoadBalancerChurn(::benchmark::State& state) {
+  const uint64_t num_hosts = state.range(0);
+  const bool healthy = state.range(1) != 0;
+  if (benchmark::skipExpensiveBenchmarks() && num_hosts > 1000) {
+    state.SkipWithError("Skipping expensive benchmark");
+    return;
+  }
+
+  MaglevTester tester(num_hosts);
+  ASSERT_TRUE(tester.maglev_lb_->initialize().ok());
+  const uint64_t hosts_to_replace = std::max<uint64_t>(1, num_hosts / 100);
+  tester.replaceHosts(hosts_to_replace, healthy);
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    tester.replaceHosts(hosts_to_replace, healthy);
+  }
+}
+BENCHMARK(benchmarkMaglevLoadBalancerChurn)
+    ->Args({100, 1})
+    ->Args({1000, 1})
+    ->Args({10000, 1})
+    ->Args({1000, 0})
+    ->Args({10000, 0})
+    ->Unit(::benchmark::kMillisecond);
+
 void benchmarkMaglevLoadBalancerHostLoss(::benchmark::State& state) {
   for (auto _ : state) { // NOLINT: Silences warning about dead store
     const uint64_t num_hosts = state.range(0);
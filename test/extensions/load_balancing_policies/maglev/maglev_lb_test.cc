@@ -282,6 +282,54 @@ TEST_F(MaglevLoadBalancerTest, BasicWithMetadataHashKey) {
   }
 }
 
+// The table is kept as long as the hosts it is built from do not change, and rebuilt when the hash
+// key of one of them is updated in place.
+TEST_F(MaglevLoadBalancerTest, ReuseUnchangedTable) {
+  host_set_.hosts_ = {makeTestHostWithHashKey(info_, "90", "tcp://127.0.0.1:90"),
+                      makeTestHostWithHashKey(info_, "91", "tcp://127.0.0.1:91"),
+                      makeTestHostWithHashKey(info_, "92", "tcp://127.0.0.1:92"),
+                      makeTestHostWithHashKey(info_, "93", "tcp://127.0.0.1:93"),
+                      makeTestHostWithHashKey(info_, "94", "tcp://127.0.0.1:94"),
+                      makeTestHostWithHashKey(info_, "95", "tcp://127.0.0.1:95")};
+  host_set_.healthy_hosts_ = host_set_.hosts_;
+  host_set_.runCallbacks({}, {});
+  init(7);
+
+  const std::vector<uint32_t> expected_assignments{2, 5, 0, 3, 4, 1, 0};
+  const auto check_assignments = [&](LoadBalancer& lb) {
+    for (uint32_t i = 0; i < expected_assignments.size(); ++i) {
+      TestLoadBalancerContext context(i);
+      EXPECT_EQ(host_set_.hosts_[expected_assignments[i]], lb.chooseHost(&context).host);
+    }
+  };
+  check_assignments(*lb_->factory()->create(lb_params_));
+
+  // Adding an unhealthy host leaves the table unchanged.
+  host_set_.hosts_.push_back(makeTestHostWithHashKey(info_, "96", "tcp://127.0.0.1:96"));
+  host_set_.runCallbacks({host_set_.hosts_.back()}, {});
+  EXPECT_EQ(1, lb_->stats().min_entries_per_host_.value());
+  EXPECT_EQ(2, lb_->stats().max_entries_per_host_.value());
+  check_assignments(*lb_->factory()->create(lb_params_));
+
+  envoy::config::core::v3::Metadata metadata;
+  Config::Metadata::mutableMetadataValue(metadata, Config::MetadataFilters::get().ENVOY_LB,
+                                         Config::MetadataEnvoyLbKeys::get().HASH_KEY)
+      .set_string_value("97");
+  host_set_.hosts_[0]->metadata(
+      std::make_shared<const envoy::config::core::v3::Metadata>(metadata));
+  host_set_.runCallbacks({}, {});
+  LoadBalancerPtr lb = lb_->factory()->create(lb_params_);
+
+  // Compare with a table built from scratch.
+  createLb();
+  EXPECT_TRUE(lb_->initialize().ok());
+  LoadBalancerPtr expected_lb = lb_->factory()->create(lb_params_);
+  for (uint32_t i = 0; i < 7; ++i) {
+    TestLoadBalancerContext context(i);
+    EXPECT_EQ(expected_lb->chooseHost(&context).host, lb->chooseHost(&context).host);
+  }
+}
+
 TEST_F(MaglevLoadBalancerTest, MaglevLbWithHashPolicy) {
   host_set_.hosts_ = {makeTestHostWithHashKey(info_, "90", "tcp://127.0.0.1:90"),
                       makeTestHostWithHashKey(info_, "91", "tcp://127.0.0.1:91"),
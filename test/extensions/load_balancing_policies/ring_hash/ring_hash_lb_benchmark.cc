@@ -48,6 +48,31 @@ BENCHMARK(benchmarkRingHashLoadBalancerBuildRing)
     ->Args({500, 256000})
     ->Unit(::benchmark::kMillisecond);
 
+// Measures the cost of an update which replaces 1% of the hosts, which splices the previous ring
+// instead of building the ring from scratch.
+void benchmarkRingHashLoadBalancerChurn(::benchmark::State& state) {
+  const uint64_t num_hosts = state.range(0);
+  const uint64_t min_ring_size = state.range(1);
+  if (benchmark::skipExpensiveBenchmarks() && (num_hosts > 1000 || min_ring_size > 65536)) {
+    state.SkipWithError("Skipping expensive benchmark");
+    return;
+  }
+
+  RingHashTester tester(num_hosts, min_ring_size);
+  ASSERT_TRUE(tester.ring_hash_lb_->initialize().ok());
+  const uint64_t hosts_to_replace = std::max<uint64_t>(1, num_hosts / 100);
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    tester.replaceHosts(hosts_to_replace);
+  }
+}
+BENCHMARK(benchmarkRingHashLoadBalancerChurn)
+    ->Args({100, 65536})
+    ->Args({1000, 65536})
+    ->Args({10000, 65536})
+    ->Args({1000, 256000})
+    ->Args({10000, 256000})
+    ->Unit(::benchmark::kMillisecond);
+
 void benchmarkRingHashLoadBalancerChooseHost(::benchmark::State& state) {
   for (auto _ : state) { // NOLINT: Silences warning about dead store
     // Do not time the creation of the ring.
@@ -748,6 +748,62 @@ TEST_P(RingHashLoadBalancerTest, UnevenHosts) {
   }
 }
 
+// Rings spliced from the previous ring of the priority must be the same as rings built from
+// scratch, when hosts are added and removed and when their number of hashes changes.
+TEST_P(RingHashLoadBalancerTest, IncrementalRebuild) {
+  HostVector hosts;
+  for (uint32_t i = 0; i < 10; ++i) {
+    hosts.push_back(makeTestHost(info_, fmt::format("tcp://127.0.0.1:{}", 90 + i), i == 5 ? 3 : 1));
+  }
+  hostSet().hosts_ = hosts;
+  hostSet().healthy_hosts_ = hostSet().hosts_;
+  hostSet().runCallbacks({}, {});
+  config_.mutable_minimum_ring_size()->set_value(64);
+  init();
+
+  const auto check_against_full_build = [&]() {
+    const uint64_t size = lb_->stats().size_.value();
+    const uint64_t min_hashes_per_host = lb_->stats().min_hashes_per_host_.value();
+    const uint64_t max_hashes_per_host = lb_->stats().max_hashes_per_host_.value();
+    LoadBalancerPtr lb = lb_->factory()->create(lb_params_);
+
+    absl::Status creation_status;
+    TypedRingHashLbConfig typed_config(config_, context_.regex_engine_, creation_status);
+    ASSERT(creation_status.ok());
+    RingHashLoadBalancer full_build_lb(priority_set_, stats_, *stats_store_.rootScope(),
+                                       context_.runtime_loader_, context_.api_.random_, 50,
+                                       typed_config.lb_config_, typed_config.hash_policy_);
+    EXPECT_TRUE(full_build_lb.initialize().ok());
+    EXPECT_EQ(size, full_build_lb.stats().size_.value());
+    EXPECT_EQ(min_hashes_per_host, full_build_lb.stats().min_hashes_per_host_.value());
+    EXPECT_EQ(max_hashes_per_host, full_build_lb.stats().max_hashes_per_host_.value());
+
+    LoadBalancerPtr expected_lb = full_build_lb.factory()->create(lb_params_);
+    for (uint64_t i = 0; i < 1000; ++i) {
+      TestLoadBalancerContext context(i * 0x9E3779B97F4A7C15);
+      EXPECT_EQ(expected_lb->chooseHost(&context).host, lb->chooseHost(&context).host);
+    }
+  };
+
+  // Replace two hosts, and change the weights of two others.
+  hosts.erase(hosts.begin(), hosts.begin() + 2);
+  hosts.push_back(makeTestHost(info_, "tcp://127.0.0.1:100"));
+  hosts.push_back(makeTestHost(info_, "tcp://127.0.0.1:101"));
+  hosts[1]->weight(2);
+  hosts[3]->weight(1);
+  hostSet().hosts_ = hosts;
+  hostSet().healthy_hosts_ = hostSet().hosts_;
+  hostSet().runCallbacks({}, {});
+  check_against_full_build();
+
+  // Remove a host without adding any.
+  hosts.pop_back();
+  hostSet().hosts_ = hosts;
+  hostSet().healthy_hosts_ = hostSet().hosts_;
+  hostSet().runCallbacks({}, {});
+  check_against_full_build();
+}
+
 // Given hosts with weights 1, 2 and 3, and a ring size of exactly 6, expect the correct number of
 // hashes for each host.
 TEST_P(RingHashLoadBalancerTest, HostWeightedTinyRing) {
@@ -8,7 +8,9 @@
 #include "envoy/extensions/load_balancing_policies/subset/v3/subset.pb.validate.h"
 
 #include "source/common/common/random_generator.h"
+#include "source/common/config/well_known_names.h"
 #include "source/common/memory/stats.h"
+#include "source/common/runtime/runtime_features.h"
 #include "source/common/upstream/upstream_impl.h"
 #include "source/extensions/load_balancing_policies/subset/subset_lb.h"
 
@@ -20,6 +22,8 @@
 #include "test/mocks/upstream/load_balancer.h"
 #include "test/test_common/simulated_time_system.h"
 
+#include "absl/flags/reflection.h"
+#include "absl/strings/str_cat.h"
 #include "absl/types/optional.h"
 #include "benchmark/benchmark.h"
 
@@ -29,16 +33,31 @@ namespace LoadBalancingPolicies {
 namespace Subset {
 namespace {
 
+// Number of distinct values of each of the keys used by the shared key selectors.
+constexpr uint64_t values_per_shared_key = 8;
+
 class SubsetLbTester : public Upstream::BaseTester {
 public:
-  SubsetLbTester(uint64_t num_hosts, bool single_host_per_subset)
+  // By default the subsets are defined by a single selector over a key which is unique to every
+  // host. With num_shared_key_selectors set, they are instead defined by that many selectors, each
+  // over its own key whose values are shared by 1/values_per_shared_key of the hosts.
+  SubsetLbTester(uint64_t num_hosts, bool single_host_per_subset,
+                 uint64_t num_shared_key_selectors = 0)
       : BaseTester(num_hosts, 0, 0, true /* attach metadata */) {
     envoy::extensions::load_balancing_policies::subset::v3::Subset subset_config_proto{};
     subset_config_proto.set_fallback_policy(
         envoy::extensions::load_balancing_policies::subset::v3::Subset::ANY_ENDPOINT);
-    auto* selector_proto = subset_config_proto.mutable_subset_selectors()->Add();
-    selector_proto->set_single_host_per_subset(single_host_per_subset);
-    *selector_proto->mutable_keys()->Add() = std::string(metadata_key);
+    if (num_shared_key_selectors == 0) {
+      auto* selector_proto = subset_config_proto.mutable_subset_selectors()->Add();
+      selector_proto->set_single_host_per_subset(single_host_per_subset);
+      *selector_proto->mutable_keys()->Add() = std::string(metadata_key);
+    } else {
+      for (uint64_t i = 0; i < num_shared_key_selectors; i++) {
+        auto* selector_proto = subset_config_proto.mutable_subset_selectors()->Add();
+        *selector_proto->mutable_keys()->Add() = sharedKey(i);
+      }
+      attachSharedKeys(num_shared_key_selectors);
+    }
 
     auto* child_lb = subset_config_proto.mutable_subset_lb_policy()->mutable_policies()->Add();
     child_lb->mutable_typed_extension_config()->set_name("envoy.load_balancing_policies.random");
@@ -64,6 +83,24 @@ public:
     smaller_locality_hosts_ = Upstream::makeHostsPerLocality({*smaller_hosts_});
   }
 
+  static std::string sharedKey(uint64_t i) { return absl::StrCat("shared_key_", i); }
+
+  // Replaces the metadata of every host with num_keys shared keys.
+  void attachSharedKeys(uint64_t num_keys) {
+    const Upstream::HostVector& hosts = priority_set_.getOrCreateHostSet(0).hosts();
+    for (uint64_t i = 0; i < hosts.size(); i++) {
+      envoy::config::core::v3::Metadata metadata;
+      Protobuf::Struct& map =
+          (*metadata.mutable_filter_metadata())[Config::MetadataFilters::get().ENVOY_LB];
+      for (uint64_t j = 0; j < num_keys; j++) {
+        Protobuf::Value value;
+        value.set_number_value((i + j) % values_per_shared_key);
+        (*map.mutable_fields())[sharedKey(j)] = value;
+      }
+      hosts[i]->metadata(std::make_shared<const envoy::config::core::v3::Metadata>(metadata));
+    }
+  }
+
   // Remove a host and add it back.
   void update() {
     priority_set_.updateHosts(
@@ -120,6 +157,63 @@ BENCHMARK(benchmarkSubsetLoadBalancerUpdate)
     ->Ranges({{false, true}, {50, 2500}})
     ->Unit(::benchmark::kMillisecond);
 
+// Measures updates of a subset load balancer with many selectors. The arguments are the number of
+// selectors, the number of hosts and whether the subsets are lazy. No request is routed to the
+// subsets, so lazy subsets are never materialized.
+void benchmarkSubsetLoadBalancerUpdateManySelectors(::benchmark::State& state) {
+  const uint64_t num_selectors = state.range(0);
+  const uint64_t num_hosts = state.range(1);
+  if (benchmark::skipExpensiveBenchmarks() && num_hosts > 100) {
+    state.SkipWithError("Skipping expensive benchmark");
+    return;
+  }
+
+  absl::FlagSaver flag_saver;
+  Runtime::maybeSetRuntimeGuard("envoy.reloadable_features.subset_lb_lazy_subsets",
+                                state.range(2) != 0);
+  SubsetLbTester tester(num_hosts, false, num_selectors);
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    tester.update();
+  }
+}
+
+BENCHMARK(benchmarkSubsetLoadBalancerUpdateManySelectors)
+    ->ArgsProduct({{10, 50}, {100, 10000}, {0, 1}})
+    ->ArgNames({"selectors", "hosts", "lazy"})
+    ->Unit(::benchmark::kMillisecond);
+
+// Measures the creation of a subset load balancer with many selectors, and the memory it holds
+// once created. The arguments are the same as for the update benchmark.
+void benchmarkSubsetLoadBalancerMemoryManySelectors(::benchmark::State& state) {
+  const uint64_t num_selectors = state.range(0);
+  const uint64_t num_hosts = state.range(1);
+  if (benchmark::skipExpensiveBenchmarks() && num_hosts > 100) {
+    state.SkipWithError("Skipping expensive benchmark");
+    return;
+  }
+
+  absl::FlagSaver flag_saver;
+  Runtime::maybeSetRuntimeGuard("envoy.reloadable_features.subset_lb_lazy_subsets",
+                                state.range(2) != 0);
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    SubsetLbTester tester(num_hosts, false, num_selectors);
+
+    // The memory held by the load balancer is the memory released when it is destroyed.
+    state.PauseTiming();
+    const size_t start_mem = Memory::Stats::totalCurrentlyAllocated();
+    tester.lb_.reset();
+    const size_t end_mem = Memory::Stats::totalCurrentlyAllocated();
+    state.counters["memory"] = start_mem - end_mem;
+    state.counters["memory_per_host"] = (start_mem - end_mem) / num_hosts;
+    state.ResumeTiming();
+  }
+}
+
+BENCHMARK(benchmarkSubsetLoadBalancerMemoryManySelectors)
+    ->ArgsProduct({{10, 50}, {100, 10000}, {0, 1}})
+    ->ArgNames({"selectors", "hosts", "lazy"})
+    ->Unit(::benchmark::kMillisecond);
+
 } // namespace
 } // namespace Subset
 } // namespace LoadBalancingPolicies
@@ -3,6 +3,7 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <tuple>
 #include <vector>
 
 #include "envoy/config/cluster/v3/cluster.pb.h"
@@ -29,7 +30,9 @@
 #include "test/mocks/upstream/load_balancer_context.h"
 #include "test/mocks/upstream/priority_set.h"
 #include "test/test_common/simulated_time_system.h"
+#include "test/test_common/test_runtime.h"
 
+#include "absl/container/flat_hash_set.h"
 #include "absl/types/optional.h"
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
@@ -1464,6 +1467,56 @@ TEST_P(SubsetLoadBalancerTest, UpdateRemovingLastSubsetHost) {
   EXPECT_EQ(1U, stats_.lb_subsets_removed_.value());
 }
 
+// With lazy subsets, a subset only gets its host sets on the first lookup, from the hosts of the
+// latest update, and is then updated like any other subset.
+TEST_P(SubsetLoadBalancerTest, LazySubsetsMaterializeOnFirstLookup) {
+  TestScopedRuntime scoped_runtime;
+  scoped_runtime.mergeValues({{"envoy.reloadable_features.subset_lb_lazy_subsets", "true"}});
+
+  EXPECT_CALL(subset_info_, fallbackPolicy())
+      .WillRepeatedly(Return(envoy::config::cluster::v3::Cluster::LbSubsetConfig::ANY_ENDPOINT));
+
+  std::vector<SubsetSelectorPtr> subset_selectors = {makeSelector(
+      {"version"},
+      envoy::config::cluster::v3::Cluster::LbSubsetConfig::LbSubsetSelector::NOT_DEFINED)};
+  EXPECT_CALL(subset_info_, subsetSelectors()).WillRepeatedly(ReturnRef(subset_selectors));
+
+  init({
+      {"tcp://127.0.0.1:80", {{"version", "1.0"}}},
+      {"tcp://127.0.0.1:81", {{"version", "1.1"}}},
+      {"tcp://127.0.0.1:82", {{"version", "1.0"}}},
+  });
+  EXPECT_EQ(2U, stats_.lb_subsets_active_.value());
+  EXPECT_EQ(2U, stats_.lb_subsets_created_.value());
+
+  HostSharedPtr host_v10 = host_set_.hosts_[0];
+  HostSharedPtr host_v11 = host_set_.hosts_[1];
+  HostSharedPtr other_host_v10 = host_set_.hosts_[2];
+  modifyHosts({}, {host_v10});
+
+  TestLoadBalancerContext context_10({{"version", "1.0"}});
+  for (int i = 0; i < 4; ++i) {
+    EXPECT_EQ(other_host_v10, lb_->chooseHost(&context_10).host);
+  }
+  EXPECT_EQ(4U, stats_.lb_subsets_selected_.value());
+
+  HostSharedPtr new_host_v11 = makeHost("tcp://127.0.0.1:83", {{"version", "1.1"}});
+  modifyHosts({new_host_v11}, {other_host_v10});
+
+  // The 1.0 subset is now empty and requests for it fall back to any endpoint.
+  EXPECT_NE(nullptr, lb_->chooseHost(&context_10).host);
+  EXPECT_EQ(1U, stats_.lb_subsets_fallback_.value());
+  EXPECT_EQ(1U, stats_.lb_subsets_active_.value());
+  EXPECT_EQ(1U, stats_.lb_subsets_removed_.value());
+
+  TestLoadBalancerContext context_11({{"version", "1.1"}});
+  absl::flat_hash_set<HostConstSharedPtr> chosen_hosts;
+  for (int i = 0; i < 4; ++i) {
+    chosen_hosts.insert(lb_->chooseHost(&context_11).host);
+  }
+  EXPECT_EQ((absl::flat_hash_set<HostConstSharedPtr>{host_v11, new_host_v11}), chosen_hosts);
+}
+
 TEST_P(SubsetLoadBalancerTest, UpdateRemovingUnknownHost) {
   EXPECT_CALL(subset_info_, fallbackPolicy())
       .WillRepeatedly(Return(envoy::config::cluster::v3::Cluster::LbSubsetConfig::NO_FALLBACK));
@@ -2480,6 +2533,62 @@ TEST_F(SubsetLoadBalancerTest, ScaleLocalityWeightsWithNoLocalityWeights) {
   initLbConfigAndLB();
 }
 
+// Hosts belonging to several overlapping subsets are distributed to every one of them, in each
+// of their localities.
+TEST_F(SubsetLoadBalancerTest, OverlappingSubsetsAcrossLocalities) {
+  std::vector<SubsetSelectorPtr> subset_selectors = {
+      makeSelector(
+          {"version"},
+          envoy::config::cluster::v3::Cluster::LbSubsetConfig::LbSubsetSelector::NOT_DEFINED),
+      makeSelector(
+          {"stage"},
+          envoy::config::cluster::v3::Cluster::LbSubsetConfig::LbSubsetSelector::NOT_DEFINED)};
+  EXPECT_CALL(subset_info_, subsetSelectors()).WillRepeatedly(ReturnRef(subset_selectors));
+  EXPECT_CALL(subset_info_, isEnabled()).WillRepeatedly(Return(true));
+  EXPECT_CALL(subset_info_, localityWeightAware()).WillRepeatedly(Return(true));
+  EXPECT_CALL(subset_info_, scaleLocalityWeight()).WillRepeatedly(Return(true));
+
+  configureWeightedHostSet(
+      {
+          {"tcp://127.0.0.1:80", {{"version", "1.0"}, {"stage", "prod"}}},
+          {"tcp://127.0.0.1:81", {{"version", "1.1"}, {"stage", "dev"}}},
+      },
+      {
+          {"tcp://127.0.0.1:82", {{"version", "1.0"}, {"stage", "dev"}}},
+          {"tcp://127.0.0.1:83", {{"version", "1.0"}, {"stage", "prod"}}},
+          {"tcp://127.0.0.1:84", {{"version", "1.1"}, {"stage", "prod"}}},
+          {"tcp://127.0.0.1:85", {{"version", "1.1"}, {"stage", "dev"}}},
+      },
+      host_set_, {50, 50});
+
+  auto* child_factory =
+      Config::Utility::getFactoryByName<Upstream::TypedLoadBalancerFactory>(child_lb_name_);
+  envoy::extensions::load_balancing_policies::round_robin::v3::RoundRobin rr_config;
+  rr_config.mutable_locality_lb_config()->mutable_locality_weighted_lb_config();
+  child_lb_config_ = child_factory->loadConfig(server_context_, rr_config).value();
+  initLbConfigAndLB();
+
+  const auto& localities = host_set_.hosts_per_locality_->get();
+  const std::vector<std::tuple<std::string, std::string, HostVector>> expected_subsets = {
+      {"version", "1.0", {localities[0][0], localities[1][0], localities[1][1]}},
+      {"version", "1.1", {localities[0][1], localities[1][2], localities[1][3]}},
+      {"stage", "prod", {localities[0][0], localities[1][1], localities[1][2]}},
+      {"stage", "dev", {localities[0][1], localities[1][0], localities[1][3]}},
+  };
+  for (const auto& [key, value, expected_hosts] : expected_subsets) {
+    TestLoadBalancerContext context({{key, value}});
+    absl::flat_hash_set<HostConstSharedPtr> chosen_hosts;
+    for (int i = 0; i < 12; ++i) {
+      HostConstSharedPtr host = lb_->chooseHost(&context).host;
+      EXPECT_NE(std::find(expected_hosts.begin(), expected_hosts.end(), host),
+                expected_hosts.end());
+      chosen_hosts.insert(host);
+    }
+    EXPECT_EQ(expected_hosts.size(), chosen_hosts.size());
+  }
+  EXPECT_EQ(4U, stats_.lb_subsets_active_.value());
+}
+
 TEST_P(SubsetLoadBalancerTest, GaugesUpdatedOnDestroy) {
   EXPECT_CALL(subset_info_, fallbackPolicy())
       .WillRepeatedly(Return(envoy::config::cluster::v3::Cluster::LbSubsetConfig::ANY_ENDPOINT));
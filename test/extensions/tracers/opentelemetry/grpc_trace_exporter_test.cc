@@ -1,5 +1,6 @@
 #include <sys/types.h>
 
+#include "source/common/buffer/buffer_impl.h"
 #include "source/common/buffer/zero_copy_input_stream_impl.h"
 #include "source/common/version/version.h"
 #include "source/extensions/tracers/opentelemetry/grpc_trace_exporter.h"
@@ -63,6 +64,21 @@ TEST_F(OpenTelemetryGrpcTraceExporterTest, CreateExporterAndExportSpan) {
             "OTel-OTLP-Exporter-Envoy/" + Envoy::VersionInfo::version());
 }
 
+TEST_F(OpenTelemetryGrpcTraceExporterTest, ExportSerializedRequest) {
+  OpenTelemetryGrpcTraceExporter exporter(Grpc::RawAsyncClientPtr{async_client_});
+
+  expectTraceExportMessage(R"EOF(
+    resource_spans:
+      scope_spans:
+        - spans:
+          - name: "test"
+  )EOF");
+  opentelemetry::proto::collector::trace::v1::ExportTraceServiceRequest request;
+  request.add_resource_spans()->add_scope_spans()->add_spans()->set_name("test");
+  EXPECT_TRUE(exporter.logSerialized(
+      std::make_unique<Buffer::OwnedImpl>(request.SerializeAsString()), 1));
+}
+
 TEST_F(OpenTelemetryGrpcTraceExporterTest, ExportWithRemoteClose) {
   OpenTelemetryGrpcTraceExporter exporter(Grpc::RawAsyncClientPtr{async_client_});
   std::string request_yaml = R"EOF(
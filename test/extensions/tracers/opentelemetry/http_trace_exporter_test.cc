@@ -1,5 +1,6 @@
 #include <sys/types.h>
 
+#include "source/common/buffer/buffer_impl.h"
 #include "source/common/buffer/zero_copy_input_stream_impl.h"
 #include "source/common/version/version.h"
 #include "source/extensions/tracers/opentelemetry/http_trace_exporter.h"
@@ -119,6 +120,43 @@ TEST_F(OpenTelemetryHttpTraceExporterTest, CreateExporterAndExportSpan) {
   callback->onFailure(request, Http::AsyncClient::FailureReason::Reset);
 }
 
+// Test exporting an already serialized OTLP message via HTTP
+TEST_F(OpenTelemetryHttpTraceExporterTest, CreateExporterAndExportSerializedRequest) {
+  std::string yaml_string = fmt::format(R"EOF(
+  http_uri:
+    uri: "https://some-o11y.com/otlp/v1/traces"
+    cluster: "my_o11y_backend"
+    timeout: 0.250s
+  )EOF");
+
+  envoy::config::core::v3::HttpService http_service;
+  TestUtility::loadFromYaml(yaml_string, http_service);
+  setup(http_service);
+
+  opentelemetry::proto::collector::trace::v1::ExportTraceServiceRequest
+      export_trace_service_request;
+  export_trace_service_request.add_resource_spans()->add_scope_spans()->add_spans()->set_name(
+      "test");
+  const std::string body = export_trace_service_request.SerializeAsString();
+
+  Http::MockAsyncClientRequest request(&cluster_manager_.thread_local_cluster_.async_client_);
+  EXPECT_CALL(cluster_manager_.thread_local_cluster_.async_client_, send_(_, _, _))
+      .WillOnce(
+          Invoke([&](Http::RequestMessagePtr& message, Http::AsyncClient::Callbacks&,
+                     const Http::AsyncClient::RequestOptions&) -> Http::AsyncClient::Request* {
+            EXPECT_EQ(Http::Headers::get().ContentTypeValues.Protobuf,
+                      message->headers().getContentTypeValue());
+            EXPECT_EQ(body, message->body().toString());
+            return &request;
+          }));
+
+  EXPECT_TRUE(trace_exporter_->logSerialized(std::make_unique<Buffer::OwnedImpl>(body), 1));
+
+  // The in-flight request is cancelled when the exporter goes away.
+  EXPECT_CALL(request, cancel());
+  trace_exporter_.reset();
+}
+
 // Test export is aborted when cluster is not found
 TEST_F(OpenTelemetryHttpTraceExporterTest, UnsuccessfulLogWithoutThreadLocalCluster) {
   std::string yaml_string = fmt::format(R"EOF(
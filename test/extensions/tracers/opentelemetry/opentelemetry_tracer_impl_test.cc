@@ -404,6 +404,71 @@ TEST_F(OpenTelemetryDriverTest, ExportOTLPSpanWithMaxCacheSize) {
   EXPECT_EQ(1U, stats_.counter("tracing.opentelemetry.spans_dropped").value());
 }
 
+// Verifies that pending spans are exported before the batch would exceed max_batch_bytes
+TEST_F(OpenTelemetryDriverTest, ExportOTLPSpanWithMaxBatchBytes) {
+  const std::string yaml_string = R"EOF(
+    grpc_service:
+      envoy_grpc:
+        cluster_name: fake-cluster
+      timeout: 0.250s
+    max_batch_bytes: 400
+    )EOF";
+  envoy::config::trace::v3::OpenTelemetryConfig opentelemetry_config;
+  TestUtility::loadFromYaml(yaml_string, opentelemetry_config);
+  setup(opentelemetry_config);
+
+  Tracing::TestTraceContextImpl request_headers{
+      {":authority", "test.com"}, {":path", "/"}, {":method", "GET"}};
+
+  // set min_flush_spans to 10 avoid automatic flushing.
+  EXPECT_CALL(runtime_.snapshot_, getInteger("tracing.opentelemetry.min_flush_spans", 5U))
+      .Times(2)
+      .WillRepeatedly(Return(10));
+
+  // Each span is a bit larger than 200 bytes, so only one of them fits into a batch.
+  Tracing::SpanPtr span1 = driver_->startSpan(mock_tracing_config_, request_headers, stream_info_,
+                                              operation_name_, {Tracing::Reason::Sampling, true});
+  span1->setTag("tag", std::string(200, 'a'));
+  EXPECT_CALL(*mock_client_, sendRaw(_, _, _, _, _, _)).Times(0);
+  span1->finishSpan();
+
+  Tracing::SpanPtr span2 = driver_->startSpan(mock_tracing_config_, request_headers, stream_info_,
+                                              operation_name_, {Tracing::Reason::Sampling, true});
+  span2->setTag("tag", std::string(200, 'b'));
+  EXPECT_CALL(*mock_client_, sendRaw(_, _, _, _, _, _));
+  span2->finishSpan();
+
+  EXPECT_EQ(1U, stats_.counter("tracing.opentelemetry.spans_sent").value());
+  EXPECT_EQ(0U, stats_.counter("tracing.opentelemetry.spans_dropped").value());
+}
+
+// Verifies that spans larger than max_batch_bytes are discarded
+TEST_F(OpenTelemetryDriverTest, ExportOTLPSpanLargerThanMaxBatchBytes) {
+  const std::string yaml_string = R"EOF(
+    grpc_service:
+      envoy_grpc:
+        cluster_name: fake-cluster
+      timeout: 0.250s
+    max_batch_bytes: 100
+    )EOF";
+  envoy::config::trace::v3::OpenTelemetryConfig opentelemetry_config;
+  TestUtility::loadFromYaml(yaml_string, opentelemetry_config);
+  setup(opentelemetry_config);
+
+  Tracing::TestTraceContextImpl request_headers{
+      {":authority", "test.com"}, {":path", "/"}, {":method", "GET"}};
+
+  Tracing::SpanPtr span = driver_->startSpan(mock_tracing_config_, request_headers, stream_info_,
+                                             operation_name_, {Tracing::Reason::Sampling, true});
+  span->setTag("tag", std::string(200, 'a'));
+  EXPECT_CALL(*mock_client_, sendRaw(_, _, _, _, _, _)).Times(0);
+  span->finishSpan();
+
+  EXPECT_EQ(0U, stats_.counter("tracing.opentelemetry.spans_sent").value());
+  EXPECT_EQ(1U, stats_.counter("tracing.opentelemetry.spans_dropped").value());
+  EXPECT_EQ(1U, stats_.counter("tracing.opentelemetry.spans_dropped_too_large").value());
+}
+
 // Verifies the export happens after a timeout
 TEST_F(OpenTelemetryDriverTest, ExportOTLPSpanWithFlushTimeout) {
   timer_ =
@@ -0,0 +1,98 @@
+#include "source/common/buffer/zero_copy_input_stream_impl.h"
+#include "source/common/version/version.h"
+#include "source/extensions/tracers/opentelemetry/otlp_span_batch.h"
+
+#include "test/test_common/utility.h"
+
+#include "gtest/gtest.h"
+#include "opentelemetry/proto/collector/trace/v1/trace_service.pb.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace Tracers {
+namespace OpenTelemetry {
+namespace {
+
+using opentelemetry::proto::collector::trace::v1::ExportTraceServiceRequest;
+
+ExportTraceServiceRequest parse(Buffer::InstancePtr&& buffer) {
+  ExportTraceServiceRequest request;
+  Buffer::ZeroCopyInputStreamImpl stream(std::move(buffer));
+  EXPECT_TRUE(request.ParseFromZeroCopyStream(&stream));
+  return request;
+}
+
+::opentelemetry::proto::trace::v1::Span makeSpan(absl::string_view name) {
+  ::opentelemetry::proto::trace::v1::Span span;
+  span.set_name(name);
+  span.set_trace_id(std::string(16, 'a'));
+  span.set_span_id(std::string(8, 'b'));
+  span.set_start_time_unix_nano(1000);
+  span.set_end_time_unix_nano(2000);
+  auto* attribute = span.add_attributes();
+  attribute->set_key("key");
+  attribute->mutable_value()->set_string_value(std::string(300, 'v'));
+  return span;
+}
+
+// The batch must serialize to the same request the protobuf library would produce.
+TEST(OtlpSpanBatchTest, MatchesProtoSerialization) {
+  Resource resource;
+  resource.schema_url_ = "https://opentelemetry.io/schemas/v1.0.0";
+  resource.attributes_["service.name"] = "test";
+  OtlpSpanBatch batch(resource);
+  EXPECT_TRUE(batch.empty());
+
+  ExportTraceServiceRequest expected;
+  auto* resource_spans = expected.add_resource_spans();
+  resource_spans->set_schema_url(resource.schema_url_);
+  auto* attribute = resource_spans->mutable_resource()->add_attributes();
+  attribute->set_key("service.name");
+  attribute->mutable_value()->set_string_value("test");
+  auto* scope_spans = resource_spans->add_scope_spans();
+  scope_spans->mutable_scope()->set_name("envoy");
+  scope_spans->mutable_scope()->set_version(Envoy::VersionInfo::version());
+
+  uint64_t expected_size = 0;
+  for (const std::string name : {"first", "second", "third"}) {
+    const auto span = makeSpan(name);
+    expected_size += OtlpSpanBatch::encodedSize(span);
+    batch.add(span);
+    *scope_spans->add_spans() = span;
+  }
+  EXPECT_EQ(3U, batch.spanCount());
+  EXPECT_EQ(expected_size, batch.byteSize());
+
+  Buffer::InstancePtr serialized = batch.release();
+  EXPECT_EQ(expected.ByteSizeLong(), serialized->length());
+  EXPECT_EQ(expected.SerializeAsString(), serialized->toString());
+  EXPECT_TRUE(TestUtility::protoEqual(expected, parse(std::move(serialized))));
+
+  // The batch can be reused after it was released.
+  EXPECT_TRUE(batch.empty());
+  EXPECT_EQ(0U, batch.byteSize());
+  batch.add(makeSpan("fourth"));
+  const ExportTraceServiceRequest request = parse(batch.release());
+  ASSERT_EQ(1, request.resource_spans(0).scope_spans(0).spans_size());
+  EXPECT_EQ("fourth", request.resource_spans(0).scope_spans(0).spans(0).name());
+}
+
+// Without resource attributes or schema url these fields are left out.
+TEST(OtlpSpanBatchTest, EmptyResource) {
+  OtlpSpanBatch batch(Resource{});
+  const auto span = makeSpan("span");
+  batch.add(span);
+
+  const ExportTraceServiceRequest request = parse(batch.release());
+  ASSERT_EQ(1, request.resource_spans_size());
+  EXPECT_FALSE(request.resource_spans(0).has_resource());
+  EXPECT_TRUE(request.resource_spans(0).schema_url().empty());
+  EXPECT_EQ("envoy", request.resource_spans(0).scope_spans(0).scope().name());
+  EXPECT_TRUE(TestUtility::protoEqual(span, request.resource_spans(0).scope_spans(0).spans(0)));
+}
+
+} // namespace
+} // namespace OpenTelemetry
+} // namespace Tracers
+} // namespace Extensions
+} // namespace Envoy
@@ -57,6 +57,21 @@ void setAllowHttp10WithDefaultHost(
   hcm.mutable_http_protocol_options()->set_default_host_for_http_10("default.com");
 }
 
+void setMaxPipelinedRequests(
+    envoy::extensions::filters::network::http_connection_manager::v3::HttpConnectionManager& hcm) {
+  hcm.mutable_http_protocol_options()->mutable_max_pipelined_requests()->set_value(4);
+}
+
+// Returns the number of responses with the given status line.
+size_t countResponses(absl::string_view response, absl::string_view status_line) {
+  size_t count = 0;
+  for (size_t pos = response.find(status_line); pos != absl::string_view::npos;
+       pos = response.find(status_line, pos + 1)) {
+    ++count;
+  }
+  return count;
+}
+
 std::string testParamToString(const testing::TestParamInfo<Network::Address::IpVersion>& params) {
   return TestUtility::ipVersionToString(params.param);
 }
@@ -1425,6 +1440,75 @@ TEST_P(IntegrationTest, PipelineInline) {
   connection->close();
 }
 
+// With concurrent pipelining, requests behind a request with "Connection: close" are not
+// processed.
+TEST_P(IntegrationTest, ConcurrentPipelineStopsAtConnectionClose) {
+  config_helper_.addConfigModifier(&setMaxPipelinedRequests);
+  autonomous_upstream_ = true;
+  initialize();
+
+  std::string response;
+  sendRawHttpAndWaitForResponse(lookupPort("http"),
+                                "GET / HTTP/1.1\r\nHost: host\r\n\r\n"
+                                "GET / HTTP/1.1\r\nHost: host\r\nConnection: close\r\n\r\n"
+                                "GET / HTTP/1.1\r\nHost: host\r\n\r\n",
+                                &response);
+  EXPECT_EQ(2, countResponses(response, "HTTP/1.1 200 OK\r\n"));
+  EXPECT_THAT(response, HasSubstr("connection: close\r\n"));
+  EXPECT_EQ(2, test_server_->counter("cluster.cluster_0.upstream_rq_total")->value());
+  EXPECT_EQ(1, test_server_->counter("http1.pipelined_requests")->value());
+}
+
+// Likewise for requests behind an HTTP/1.0 request without keep-alive.
+TEST_P(IntegrationTest, ConcurrentPipelineStopsAtHttp10) {
+  config_helper_.addConfigModifier(&setAllowHttp10WithDefaultHost);
+  config_helper_.addConfigModifier(&setMaxPipelinedRequests);
+  autonomous_upstream_ = true;
+  initialize();
+  // Frame the responses by length, so that the first one does not close the connection.
+  reinterpret_cast<AutonomousUpstream*>(fake_upstreams_.front().get())
+      ->setResponseHeaders(std::make_unique<Http::TestResponseHeaderMapImpl>(
+          Http::TestResponseHeaderMapImpl({{":status", "200"}, {"content-length", "10"}})));
+
+  std::string response;
+  sendRawHttpAndWaitForResponse(lookupPort("http"),
+                                "GET / HTTP/1.0\r\nConnection: keep-alive\r\n\r\n"
+                                "GET / HTTP/1.0\r\n\r\n"
+                                "GET / HTTP/1.0\r\n\r\n",
+                                &response);
+  EXPECT_EQ(2, countResponses(response, "HTTP/1.0 200 OK\r\n"));
+  EXPECT_EQ(2, test_server_->counter("cluster.cluster_0.upstream_rq_total")->value());
+  EXPECT_EQ(1, test_server_->counter("http1.pipelined_requests")->value());
+}
+
+// Likewise for requests behind the request that reaches max_requests_per_connection, after which
+// the connection manager drains the connection.
+TEST_P(IntegrationTest, ConcurrentPipelineStopsAtMaxRequestsPerConnection) {
+  config_helper_.addConfigModifier(&setMaxPipelinedRequests);
+  config_helper_.addConfigModifier(
+      [](envoy::extensions::filters::network::http_connection_manager::v3::HttpConnectionManager&
+             hcm) {
+        hcm.mutable_common_http_protocol_options()
+            ->mutable_max_requests_per_connection()
+            ->set_value(2);
+      });
+  autonomous_upstream_ = true;
+  initialize();
+
+  std::string response;
+  sendRawHttpAndWaitForResponse(lookupPort("http"),
+                                "GET / HTTP/1.1\r\nHost: host\r\n\r\n"
+                                "GET / HTTP/1.1\r\nHost: host\r\n\r\n"
+                                "GET / HTTP/1.1\r\nHost: host\r\n\r\n",
+                                &response);
+  EXPECT_EQ(2, countResponses(response, "HTTP/1.1 200 OK\r\n"));
+  EXPECT_THAT(response, HasSubstr("connection: close\r\n"));
+  EXPECT_EQ(2, test_server_->counter("cluster.cluster_0.upstream_rq_total")->value());
+  EXPECT_EQ(1, test_server_->counter("http1.pipelined_requests")->value());
+  EXPECT_EQ(1,
+            test_server_->counter("http.config_test.downstream_cx_max_requests_reached")->value());
+}
+
 TEST_P(IntegrationTest, NoHost) {
   disable_client_header_validation_ = true;
   initialize();
@@ -274,6 +274,56 @@ TEST_P(TcpProxyIntegrationTest, TcpProxyLargeWrite) {
   EXPECT_EQ(downstream_pauses, downstream_resumes);
 }
 
+// Test forwarding with splice(2), including byte accounting and half close in both directions.
+TEST_P(TcpProxyIntegrationTest, TcpProxySplice) {
+  setupByteMeterAccessLog();
+  config_helper_.addConfigModifier([&](envoy::config::bootstrap::v3::Bootstrap& bootstrap) -> void {
+    auto* listener = bootstrap.mutable_static_resources()->mutable_listeners(0);
+    auto* filter_chain = listener->mutable_filter_chains(0);
+    auto* config_blob = filter_chain->mutable_filters(0)->mutable_typed_config();
+
+    ASSERT_TRUE(config_blob->Is<envoy::extensions::filters::network::tcp_proxy::v3::TcpProxy>());
+    auto tcp_proxy_config =
+        MessageUtil::anyConvert<envoy::extensions::filters::network::tcp_proxy::v3::TcpProxy>(
+            *config_blob);
+    tcp_proxy_config.set_use_splice(true);
+    config_blob->PackFrom(tcp_proxy_config);
+  });
+  initialize();
+
+  IntegrationTcpClientPtr tcp_client = makeTcpConnection(lookupPort("tcp_proxy"));
+  FakeRawConnectionPtr fake_upstream_connection;
+  ASSERT_TRUE(fake_upstreams_[0]->waitForRawConnection(fake_upstream_connection));
+
+  const std::string data(1024 * 16, 'a');
+  ASSERT_TRUE(tcp_client->write(data));
+  ASSERT_TRUE(fake_upstream_connection->waitForData(data.size()));
+  ASSERT_TRUE(fake_upstream_connection->write("hello"));
+  tcp_client->waitForData("hello");
+
+  ASSERT_TRUE(fake_upstream_connection->write("", true));
+  tcp_client->waitForHalfClose();
+  ASSERT_TRUE(tcp_client->write("", true));
+  ASSERT_TRUE(fake_upstream_connection->waitForHalfClose());
+  ASSERT_TRUE(fake_upstream_connection->waitForDisconnect());
+
+#if defined(__linux__)
+  EXPECT_EQ(1, test_server_->counter("tcp.tcpproxy_stats.downstream_cx_splice_total")->value());
+  EXPECT_EQ(0, test_server_->counter("tcp.tcpproxy_stats.downstream_cx_splice_fallback")->value());
+#endif
+  EXPECT_EQ(data.size(),
+            test_server_->counter("tcp.tcpproxy_stats.downstream_cx_rx_bytes_total")->value());
+  EXPECT_EQ(5, test_server_->counter("tcp.tcpproxy_stats.downstream_cx_tx_bytes_total")->value());
+  EXPECT_EQ(data.size(),
+            test_server_->counter("cluster.cluster_0.upstream_cx_tx_bytes_total")->value());
+  EXPECT_EQ(5, test_server_->counter("cluster.cluster_0.upstream_cx_rx_bytes_total")->value());
+  test_server_.reset();
+
+  EXPECT_THAT(waitForAccessLog(listener_access_log_name_),
+              MatchesRegex(".*DOWNSTREAM_WIRE_BYTES_SENT=5 DOWNSTREAM_WIRE_BYTES_RECEIVED=16384 "
+                           "UPSTREAM_WIRE_BYTES_SENT=16384 UPSTREAM_WIRE_BYTES_RECEIVED=5.*"));
+}
+
 // Test that a downstream flush works correctly (all data is flushed)
 TEST_P(TcpProxyIntegrationTest, TcpProxyDownstreamFlush) {
   // Use a very large size to make sure it is larger than the kernel socket read buffer.
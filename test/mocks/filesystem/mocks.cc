@@ -3,6 +3,8 @@
 #include "source/common/common/assert.h"
 #include "source/common/common/lock_guard.h"
 
+#include "absl/strings/str_join.h"
+
 namespace Envoy {
 namespace Filesystem {
 
@@ -31,6 +33,10 @@ Api::IoCallSizeResult MockFile::write(absl::string_view buffer) {
   return result;
 }
 
+Api::IoCallSizeResult MockFile::writev(absl::Span<const absl::string_view> buffers) {
+  return write(absl::StrJoin(buffers, ""));
+}
+
 Api::IoCallSizeResult MockFile::pread(void* buf, uint64_t count, uint64_t offset) {
   absl::MutexLock lock(mutex_);
   if (!is_open_) {
@@ -18,6 +18,7 @@
 #include "source/common/http/conn_manager_config.h"
 #include "source/common/http/filter_manager.h"
 #include "source/common/http/header_map_impl.h"
+#include "source/common/http/stream_arena_impl.h"
 #include "source/common/http/utility.h"
 
 #include "test/mocks/common.h"
@@ -161,6 +162,9 @@ public:
   MOCK_METHOD(void, onUnderlyingConnectionAboveWriteBufferHighWatermark, ());
   MOCK_METHOD(void, onUnderlyingConnectionBelowWriteBufferLowWatermark, ());
 
+  // Http::ServerConnection
+  MOCK_METHOD(void, closeAfterActiveStreams, ());
+
   Protocol protocol_{Protocol::Http11};
 };
 
@@ -190,6 +194,10 @@ public:
   MOCK_METHOD(void, addStreamDecoderFilter, (Http::StreamDecoderFilterSharedPtr filter));
   MOCK_METHOD(void, addStreamEncoderFilter, (Http::StreamEncoderFilterSharedPtr filter));
   MOCK_METHOD(void, addStreamFilter, (Http::StreamFilterSharedPtr filter));
+  MOCK_METHOD(void, addStatelessStreamDecoderFilter,
+              (Http::StatelessStreamDecoderFilterSharedPtr filter));
+  MOCK_METHOD(void, addStatelessStreamEncoderFilter,
+              (Http::StatelessStreamEncoderFilterSharedPtr filter));
   MOCK_METHOD(void, addAccessLogHandler, (AccessLog::InstanceSharedPtr handler));
   MOCK_METHOD(Event::Dispatcher&, dispatcher, ());
 };
@@ -227,6 +235,7 @@ public:
   testing::NiceMock<StreamInfo::MockStreamInfo> stream_info_;
   std::shared_ptr<Router::MockRoute> route_;
   std::shared_ptr<Upstream::MockClusterInfo> cluster_info_;
+  StreamArenaImpl stream_arena_;
 };
 
 class MockDownstreamStreamFilterCallbacks : public DownstreamStreamFilterCallbacks {
@@ -289,6 +298,7 @@ public:
   MOCK_METHOD(OptRef<DownstreamStreamFilterCallbacks>, downstreamCallbacks, ());
   MOCK_METHOD(OptRef<UpstreamStreamFilterCallbacks>, upstreamCallbacks, ());
   MOCK_METHOD(absl::string_view, filterConfigName, (), (const override));
+  MOCK_METHOD(StreamArena&, streamArena, ());
   MOCK_METHOD(RequestHeaderMapOptRef, requestHeaders, ());
   MOCK_METHOD(RequestTrailerMapOptRef, requestTrailers, ());
   MOCK_METHOD(ResponseHeaderMapOptRef, informationalHeaders, ());
@@ -385,6 +395,7 @@ public:
   MOCK_METHOD(OptRef<DownstreamStreamFilterCallbacks>, downstreamCallbacks, ());
   MOCK_METHOD(OptRef<UpstreamStreamFilterCallbacks>, upstreamCallbacks, ());
   MOCK_METHOD(absl::string_view, filterConfigName, (), (const override));
+  MOCK_METHOD(StreamArena&, streamArena, ());
   MOCK_METHOD(RequestHeaderMapOptRef, requestHeaders, ());
   MOCK_METHOD(RequestTrailerMapOptRef, requestTrailers, ());
   MOCK_METHOD(ResponseHeaderMapOptRef, informationalHeaders, ());
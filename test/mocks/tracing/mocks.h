@@ -41,6 +41,7 @@ public:
               (Tracing::TraceContext & request_headers, const Tracing::UpstreamContext& upstream));
   MOCK_METHOD(void, setSampled, (bool sampled));
   MOCK_METHOD(bool, useLocalDecision, (), (const));
+  MOCK_METHOD(bool, isRecording, (), (const));
   MOCK_METHOD(void, setBaggage, (absl::string_view key, absl::string_view value));
   MOCK_METHOD(std::string, getBaggage, (absl::string_view key));
   MOCK_METHOD(std::string, getTraceId, (), (const));
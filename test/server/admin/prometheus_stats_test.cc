@@ -1025,5 +1025,112 @@ envoy_cluster_endpoint_c1{a_tag_name="a.tag-value",envoy_cluster_name="test_1",e
   }
 }
 
+class PrometheusStatsRequestTest : public PrometheusStatsFormatterTest {
+protected:
+  PrometheusStatsRequestTest() : store_(alloc_) {}
+
+  void createStats() {
+    Stats::Scope& scope = *store_.rootScope();
+    const Stats::StatNameTagVector c1_tags{{makeStat("cluster"), makeStat("c1")}};
+    const Stats::StatNameTagVector c2_tags{{makeStat("cluster"), makeStat("c2")}};
+    for (const auto& tags : {c1_tags, c2_tags}) {
+      scope.counterFromStatNameWithTags(makeStat("cluster.upstream.cx.total"), tags).add(10);
+      scope.counterFromStatNameWithTags(makeStat("cluster.upstream.rq.total"), tags).add(20);
+      scope
+          .gaugeFromStatNameWithTags(makeStat("cluster.upstream.cx.active"), tags,
+                                     Stats::Gauge::ImportMode::Accumulate)
+          .set(11);
+      scope.textReadoutFromStatNameWithTags(makeStat("control_plane.identifier"), tags)
+          .set("cp-1");
+    }
+    scope.counterFromString("server.untagged").inc();
+  }
+
+  // Renders all chunks of a request, and returns the number of chunks in num_chunks.
+  std::string render(const StatsParams& params, uint64_t chunk_size, uint32_t& num_chunks) {
+    PrometheusStatsRequest request(store_, params, endpoints_helper_->cm_, custom_namespaces_);
+    request.setChunkSize(chunk_size);
+    Http::TestResponseHeaderMapImpl response_headers;
+    EXPECT_EQ(Http::Code::OK, request.start(response_headers));
+    std::string output;
+    num_chunks = 0;
+    bool more = true;
+    while (more) {
+      Buffer::OwnedImpl data;
+      more = request.nextChunk(data);
+      output += data.toString();
+      ++num_chunks;
+    }
+    return output;
+  }
+
+  std::string statsAsPrometheus(const StatsParams& params) {
+    Buffer::OwnedImpl response;
+    PrometheusStatsFormatter::statsAsPrometheus(
+        store_.counters(), store_.gauges(), store_.histograms(),
+        params.prometheus_text_readouts_ ? store_.textReadouts()
+                                         : std::vector<Stats::TextReadoutSharedPtr>(),
+        endpoints_helper_->cm_, response, params, custom_namespaces_);
+    return response.toString();
+  }
+
+  Stats::CustomStatNamespacesImpl custom_namespaces_;
+  Stats::ThreadLocalStoreImpl store_;
+};
+
+TEST_F(PrometheusStatsRequestTest, MatchesStatsAsPrometheus) {
+  createStats();
+  addClusterEndpoints("cluster1", 2, {{"a.tag-name", "a.tag-value"}});
+
+  for (absl::string_view url : {"/stats", "/stats?text_readouts", "/stats?usedonly",
+                                "/stats?filter=cx", "/stats?histogram_buckets=summary"}) {
+    Buffer::OwnedImpl response;
+    StatsParams params;
+    ASSERT_EQ(Http::Code::OK, params.parse(url, response));
+    uint32_t num_chunks;
+    EXPECT_EQ(statsAsPrometheus(params),
+              render(params, PrometheusStatsRequest::DefaultChunkSize, num_chunks))
+        << url;
+    EXPECT_EQ(1, num_chunks);
+  }
+}
+
+TEST_F(PrometheusStatsRequestTest, Output) {
+  createStats();
+
+  Buffer::OwnedImpl response;
+  StatsParams params;
+  ASSERT_EQ(Http::Code::OK, params.parse("/stats?text_readouts", response));
+  uint32_t num_chunks;
+  const std::string expected = R"EOF(# TYPE envoy_cluster_upstream_cx_total counter
+envoy_cluster_upstream_cx_total{cluster="c1"} 10
+envoy_cluster_upstream_cx_total{cluster="c2"} 10
+# TYPE envoy_cluster_upstream_rq_total counter
+envoy_cluster_upstream_rq_total{cluster="c1"} 20
+envoy_cluster_upstream_rq_total{cluster="c2"} 20
+# TYPE envoy_server_untagged counter
+envoy_server_untagged{} 1
+# TYPE envoy_cluster_upstream_cx_active gauge
+envoy_cluster_upstream_cx_active{cluster="c1"} 11
+envoy_cluster_upstream_cx_active{cluster="c2"} 11
+# TYPE envoy_control_plane_identifier gauge
+envoy_control_plane_identifier{cluster="c1",text_value="cp-1"} 0
+envoy_control_plane_identifier{cluster="c2",text_value="cp-1"} 0
+)EOF";
+  EXPECT_EQ(expected, render(params, PrometheusStatsRequest::DefaultChunkSize, num_chunks));
+}
+
+TEST_F(PrometheusStatsRequestTest, SmallChunks) {
+  createStats();
+
+  Buffer::OwnedImpl response;
+  StatsParams params;
+  ASSERT_EQ(Http::Code::OK, params.parse("/stats?text_readouts", response));
+  uint32_t num_chunks;
+  EXPECT_EQ(statsAsPrometheus(params), render(params, 1, num_chunks));
+  // Each chunk holds one group, and the last chunk is empty as there are no host metrics.
+  EXPECT_EQ(6, num_chunks);
+}
+
 } // namespace Server
 } // namespace Envoy
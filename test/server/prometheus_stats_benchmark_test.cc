@@ -0,0 +1,125 @@
+// Note: this should be run with --compilation_mode=opt, and would benefit from a
+// quiescent system with disabled cstate power management.
+
+#include <cstdint>
+#include <memory>
+
+#include "source/common/buffer/buffer_impl.h"
+#include "source/common/http/header_map_impl.h"
+#include "source/common/stats/custom_stat_namespaces_impl.h"
+#include "source/common/stats/thread_local_store.h"
+#include "source/server/admin/prometheus_stats.h"
+
+#include "test/benchmark/main.h"
+#include "test/mocks/upstream/cluster_manager.h"
+
+#include "absl/strings/str_cat.h"
+#include "benchmark/benchmark.h"
+
+namespace Envoy {
+
+// Override the one method used by this test so that using a mock doesn't affect performance.
+class FastMockClusterManager : public testing::StrictMock<Upstream::MockClusterManager> {
+public:
+  ClusterInfoMaps clusters() const override { return ClusterInfoMaps{}; }
+};
+
+// Store holding num_counters counters, spread over 1000 names and tagged with one of
+// num_counters / 1000 cluster names, plus 100 histogram names tagged with 10 cluster names.
+class PrometheusStatsSpeedTest {
+public:
+  explicit PrometheusStatsSpeedTest(uint64_t num_counters)
+      : pool_(symbol_table_), stats_allocator_(symbol_table_), stats_store_(stats_allocator_) {
+    Buffer::OwnedImpl response;
+    params_.parse("?format=prometheus", response);
+
+    const Stats::StatName cluster_tag = pool_.add("envoy_cluster_name");
+    for (uint64_t idx = 0; idx < num_counters; ++idx) {
+      const Stats::StatNameTagVector tags{{cluster_tag, pool_.add(absl::StrCat("c", idx / 1000))}};
+      stats_store_.rootScope()
+          ->counterFromStatNameWithTags(pool_.add(absl::StrCat("rq_", idx % 1000)), tags)
+          .inc();
+    }
+    for (uint64_t idx = 0; idx < 1000; ++idx) {
+      const Stats::StatNameTagVector tags{{cluster_tag, pool_.add(absl::StrCat("c", idx / 100))}};
+      stats_store_.rootScope()->histogramFromStatNameWithTags(
+          pool_.add(absl::StrCat("rq_time_", idx % 100)), tags,
+          Stats::Histogram::Unit::Milliseconds);
+    }
+  }
+
+  // Renders the whole exposition into one buffer.
+  uint64_t buffered() {
+    Buffer::OwnedImpl response;
+    Server::PrometheusStatsFormatter::statsAsPrometheus(
+        stats_store_.counters(), stats_store_.gauges(), stats_store_.histograms(),
+        stats_store_.textReadouts(), cm_, response, params_, custom_namespaces_);
+    return response.length();
+  }
+
+  // Streams the exposition, draining each chunk as it is produced, as the admin server does.
+  uint64_t streamed() {
+    Buffer::OwnedImpl response;
+    Server::PrometheusStatsRequest request(stats_store_, params_, cm_, custom_namespaces_);
+    auto response_headers = Http::ResponseHeaderMapImpl::create();
+    request.start(*response_headers);
+    uint64_t length = 0;
+    bool more = true;
+    do {
+      more = request.nextChunk(response);
+      length += response.length();
+      response.drain(response.length());
+    } while (more);
+    return length;
+  }
+
+private:
+  Stats::SymbolTableImpl symbol_table_;
+  Stats::StatNamePool pool_;
+  Stats::AllocatorImpl stats_allocator_;
+  Stats::ThreadLocalStoreImpl stats_store_;
+  Stats::CustomStatNamespacesImpl custom_namespaces_;
+  Server::StatsParams params_;
+  FastMockClusterManager cm_;
+};
+
+static void bmPrometheusBuffered(::benchmark::State& state) {
+  // Skip expensive benchmarks for unit tests.
+  if (benchmark::skipExpensiveBenchmarks() && state.range(0) > 1000) {
+    state.SkipWithError("Skipping expensive benchmark");
+    return;
+  }
+
+  PrometheusStatsSpeedTest speed_test(state.range(0));
+  uint64_t length = 0;
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    length = speed_test.buffered();
+  }
+  state.SetLabel(absl::StrCat("output per iteration: ", length));
+}
+
+static void bmPrometheusStreamed(::benchmark::State& state) {
+  // Skip expensive benchmarks for unit tests.
+  if (benchmark::skipExpensiveBenchmarks() && state.range(0) > 1000) {
+    state.SkipWithError("Skipping expensive benchmark");
+    return;
+  }
+
+  PrometheusStatsSpeedTest speed_test(state.range(0));
+  uint64_t length = 0;
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    length = speed_test.streamed();
+  }
+  state.SetLabel(absl::StrCat("output per iteration: ", length));
+}
+
+BENCHMARK(bmPrometheusBuffered)
+    ->Unit(::benchmark::kMillisecond)
+    ->RangeMultiplier(10)
+    ->Range(1000, 1000000);
+BENCHMARK(bmPrometheusStreamed)
+    ->Unit(::benchmark::kMillisecond)
+    ->RangeMultiplier(10)
+    ->Range(1000, 1000000);
+
+} // namespace Envoy
@@ -935,6 +935,19 @@ TEST_P(ServerStatsTest, FlushStats) {
   Stats::StatNameDynamicStorage dynamic_stat("c.d", stats_store_.symbolTable());
   flushStats();
   EXPECT_EQ(recent_lookups.value(), strobed_recent_lookups);
+
+  // Creating symbols takes the symbol table lock exclusively, but looking up
+  // existing ones does not.
+  Stats::Gauge& exclusive_locks = stats_store_.gaugeFromString(
+      "server.stats_symbol_table_exclusive_locks", Stats::Gauge::ImportMode::NeverImport);
+  const uint64_t strobed_exclusive_locks = exclusive_locks.value();
+  EXPECT_LT(0, strobed_exclusive_locks);
+  Stats::StatNameManagedStorage new_stat("e.f", stats_store_.symbolTable());
+  flushStats();
+  EXPECT_EQ(1, exclusive_locks.value() - strobed_exclusive_locks);
+  Stats::StatNameManagedStorage existing_stat("e.f", stats_store_.symbolTable());
+  flushStats();
+  EXPECT_EQ(1, exclusive_locks.value() - strobed_exclusive_locks);
 }
 
 TEST_P(ServerInstanceImplTest, FlushStatsOnAdmin) {